@@ -471,6 +471,7 @@ set(BASE_CMN_SRC
     src/common/tarstrm.cpp
     src/common/textbuf.cpp
     src/common/textfile.cpp
+    src/common/threadpool.cpp
     src/common/time.cpp
     src/common/timercmn.cpp
     src/common/timerimpl.cpp
@@ -616,12 +617,14 @@ set(BASE_CMN_HDR
     wx/stream.h
     wx/string.h
     wx/stringops.h
+    wx/stringview.h
     wx/strvararg.h
     wx/sysopt.h
     wx/tarstrm.h
     wx/textbuf.h
     wx/textfile.h
     wx/thread.h
+    wx/threadpool.h
     wx/thrimpl.cpp
     wx/time.h
     wx/timer.h
@@ -531,6 +531,12 @@ protected:
     wxCriticalSection m_handlersWithPendingEventsLocker;
 #endif
 
+    // lock-free LIFO list of the handlers to which new events were queued,
+    // linked using wxEvtHandler::m_nextWithNewPendingEvents: the handlers are
+    // added to it from any thread without locking and then moved to
+    // m_handlersWithPendingEvents by MoveNewPendingEventHandlers()
+    std::atomic<wxEvtHandler*> m_newHandlersWithPendingEvents{nullptr};
+
     // flag modified by Suspend/ResumeProcessingOfPendingEvents()
     bool m_bDoPendingEventProcessing = true;
 
@@ -539,6 +545,14 @@ private:
     // set it
     bool m_fullyConstructed = false;
 
+    // add the handler to m_newHandlersWithPendingEvents, can be called from
+    // any thread
+    void AddNewPendingEventHandler(wxEvtHandler* handler);
+
+    // move the handlers from m_newHandlersWithPendingEvents to the end of
+    // m_handlersWithPendingEvents, must be called with the lock held
+    void MoveNewPendingEventHandlers();
+
     friend class WXDLLIMPEXP_FWD_BASE wxEvtHandler;
 
     // the application object is a singleton anyhow, there is no sense in
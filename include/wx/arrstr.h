@@ -86,6 +86,7 @@ public:
     int Index(const wxString& str, bool bCase = true, bool bFromEnd = false) const;
 
     void Sort(bool reverseOrder = false);
+    void SortNoCase(bool reverseOrder = false);
     void Sort(CompareFunction function);
     void Sort(CMPFUNCwxString function) { wxBaseArray<wxString>::Sort(function); }
 
@@ -126,10 +127,7 @@ public:
     wxSortedArrayString(const wxArrayString& src)
         : wxSortedArrayStringBase(wxStringSortAscending)
     {
-        reserve(src.size());
-
-        for ( size_t n = 0; n < src.size(); n++ )
-            Add(src[n]);
+        DoMerge(src, true /* using default comparison */);
     }
     explicit wxSortedArrayString(wxArrayString::CompareFunction compareFunction)
         : wxSortedArrayStringBase(compareFunction)
@@ -137,7 +135,13 @@ public:
 
     int Index(const wxString& str, bool bCase = true, bool bFromEnd = false) const;
 
+    // add all the given strings at once, this is much faster than adding them
+    // one by one for big arrays
+    void Merge(const wxArrayString& strings) { DoMerge(strings, false); }
+
 private:
+    void DoMerge(const wxArrayString& strings, bool defaultCompare);
+
     void Insert()
     {
         wxFAIL_MSG( "wxSortedArrayString::Insert() is not to be used" );
@@ -147,6 +151,11 @@ private:
     {
         wxFAIL_MSG( "wxSortedArrayString::Sort() is not to be used" );
     }
+
+    void SortNoCase()
+    {
+        wxFAIL_MSG( "wxSortedArrayString::SortNoCase() is not to be used" );
+    }
 };
 
 #else // if !wxUSE_STD_CONTAINERS
@@ -266,6 +275,9 @@ public:
     // sort array elements in alphabetical order (or reversed alphabetical
     // order if reverseOrder parameter is true)
   void Sort(bool reverseOrder = false);
+    // sort array elements in case-insensitive alphabetical order, strings
+    // differing in case only are sorted in case-sensitive order
+  void SortNoCase(bool reverseOrder = false);
     // sort array elements using specified comparison function
   void Sort(CompareFunction compareFunction);
   void Sort(CompareFunction2 compareFunction);
@@ -402,6 +414,9 @@ public:
 protected:
   void Copy(const wxArrayString& src);  // copies the contents of another array
 
+  // add all strings from src to this sorted array and restore its order
+  void DoMerge(const wxArrayString& src);
+
   CompareFunction m_compareFunction = nullptr; // set only from wxSortedArrayString
 
 private:
@@ -434,6 +449,10 @@ public:
   explicit wxSortedArrayString(CompareFunction compareFunction)
       : wxArrayString(true)
     { m_compareFunction = compareFunction; }
+
+    // add all the given strings at once, this is much faster than adding them
+    // one by one for big arrays
+  void Merge(const wxArrayString& strings) { DoMerge(strings); }
 };
 
 #endif // !wxUSE_STD_CONTAINERS
@@ -471,6 +490,49 @@ private:
     wxString* m_strings;
 };
 
+// ----------------------------------------------------------------------------
+// wxArrayStringIndex: hash table allowing to find strings in an array quickly
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxArrayStringIndex
+{
+public:
+    // The array must exist for as long as this object does and Rebuild() must
+    // be called after modifying it.
+    explicit wxArrayStringIndex(const wxArrayString& array, bool bCase = true)
+        : m_array(array), m_caseSensitive(bCase)
+    {
+        Rebuild();
+    }
+
+    // Update the index after the array contents changed.
+    void Rebuild();
+
+    // Same as wxArrayString::Index(str, bCase), but in constant time.
+    int Index(const wxString& str) const;
+
+private:
+    size_t GetHash(const wxString& str) const;
+
+    // The hash of the string and its index or wxNOT_FOUND for the free slots.
+    struct Slot
+    {
+        size_t hash;
+        int index;
+    };
+
+    const wxArrayString& m_array;
+    const bool m_caseSensitive;
+
+    // Open addressing table with power of 2 size, using linear probing.
+    std::vector<Slot> m_slots;
+
+    // The number of items in the array when the index was built.
+    size_t m_count = 0;
+
+    wxDECLARE_NO_COPY_CLASS(wxArrayStringIndex);
+};
+
 
 // ----------------------------------------------------------------------------
 // helper functions for working with arrays
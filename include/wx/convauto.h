@@ -76,7 +76,10 @@ public:
     virtual size_t FromWChar(char *dst, size_t dstLen,
                              const wchar_t *src, size_t srcLen = wxNO_LEN) const override;
 
-    virtual size_t GetMBNulLen() const override { return m_conv->GetMBNulLen(); }
+    // the encoding, and hence the length of NUL in it, is only known after
+    // the input has been examined
+    virtual size_t GetMBNulLen() const override
+        { return m_conv ? m_conv->GetMBNulLen() : wxCONV_FAILED; }
 
     virtual bool IsUTF8() const override { return m_conv && m_conv->IsUTF8(); }
 
@@ -467,6 +467,80 @@ private:
 };
 #endif
 
+// ---------------------------------------------------------
+// wxDataViewFilterListModel
+// ---------------------------------------------------------
+
+// A list model showing only the rows of another list model, called the source
+// model, passing the filter defined by IsRowShown() in the derived class.
+class WXDLLIMPEXP_CORE wxDataViewFilterListModel : public wxDataViewVirtualListModel
+{
+public:
+    // The source model must be non-null, its reference count is incremented
+    // here and decremented in the dtor.
+    explicit wxDataViewFilterListModel(wxDataViewListModel* source);
+    virtual ~wxDataViewFilterListModel();
+
+    wxDataViewListModel* GetSourceModel() const { return m_source; }
+
+    // Must be overridden to return true if the given row of the source model
+    // should be shown.
+    virtual bool IsRowShown(unsigned int sourceRow) const = 0;
+
+    // Re-evaluate the filter for all the rows of the source model.
+    void Refilter();
+
+    // Re-evaluate the filter only for the currently shown rows, this is much
+    // faster than Refilter() but can only be used when the filter has become
+    // more restrictive, e.g. when a character was appended to the search
+    // string.
+    void RefineFilter();
+
+    // Show all the rows of the source model without calling IsRowShown().
+    void ResetFilter();
+
+    // Convert between the rows of this model and the source model. FindRow()
+    // returns wxNOT_FOUND if the source row is not shown.
+    unsigned int GetSourceRow(unsigned int row) const { return m_rows[row]; }
+    int FindRow(unsigned int sourceRow) const;
+
+    // Implement the base class methods by forwarding them to the source model.
+    virtual void GetValueByRow(wxVariant& variant,
+                               unsigned int row, unsigned int col) const override;
+    virtual bool SetValueByRow(const wxVariant& variant,
+                               unsigned int row, unsigned int col) override;
+    virtual bool GetAttrByRow(unsigned int row, unsigned int col,
+                              wxDataViewItemAttr& attr) const override;
+    virtual bool IsEnabledByRow(unsigned int row,
+                                unsigned int col) const override;
+
+private:
+    class SourceNotifier;
+    friend class SourceNotifier;
+
+    // Replace the currently shown rows with the given ones.
+    void SetRows(wxVector<unsigned int>& rows);
+
+    // Called by SourceNotifier when the given source row has changed.
+    void OnSourceRowChanged(unsigned int sourceRow, int col);
+
+    // Called by SourceNotifier when the given source rows, in increasing
+    // order, have been added to or deleted from the source model. For the
+    // added rows, their new indices are given and for the deleted ones, the
+    // indices they had before being deleted.
+    void OnSourceRowsAdded(const wxVector<unsigned int>& sourceRows);
+    void OnSourceRowsDeleted(const wxVector<unsigned int>& sourceRows);
+
+
+    wxDataViewListModel* const m_source;
+    SourceNotifier* m_notifier;
+
+    // The indices of the shown rows in the source model, in increasing order.
+    wxVector<unsigned int> m_rows;
+
+    wxDECLARE_NO_COPY_CLASS(wxDataViewFilterListModel);
+};
+
 // ----------------------------------------------------------------------------
 // wxDataViewRenderer and related classes
 // ----------------------------------------------------------------------------
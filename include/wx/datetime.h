@@ -967,6 +967,12 @@ public:
     bool ParseRfc822Date(const wxString& date,
                          wxString::const_iterator *end);
 
+        // parse a string in RFC 3339 format, i.e. ISO 8601 combined date and
+        // time with optional fractional seconds and the time zone offset, e.g.
+        // "2024-02-29T13:14:15.678+01:00"
+    bool ParseRfc3339Date(const wxString& date,
+                          wxString::const_iterator *end);
+
         // parse a date/time in the given format (see strptime(3)), fill in
         // the missing (in the string) fields with the values of dateDef (by
         // default, they will not change if they had valid values or will
@@ -993,24 +999,20 @@ public:
         //
         // notice that these functions are new in wx 3.0 and so we don't
         // provide compatibility overloads for them
-    bool ParseISODate(const wxString& date)
-    {
-        wxString::const_iterator end;
-        return ParseFormat(date, wxS("%Y-%m-%d"), &end) && end == date.end();
-    }
+    bool ParseISODate(const wxString& date);
+    bool ParseISOTime(const wxString& time);
+    bool ParseISOCombined(const wxString& datetime, char sep = 'T');
 
-    bool ParseISOTime(const wxString& time)
-    {
-        wxString::const_iterator end;
-        return ParseFormat(time, wxS("%H:%M:%S"), &end) && end == time.end();
-    }
+        // versions of the functions above working with the characters in
+        // [date, end) range of a buffer, e.g. a field of a CSV file, they
+        // don't allocate any memory and so are much faster
+    bool ParseISODate(const char* date, const char* end);
+    bool ParseISOTime(const char* time, const char* end);
+    bool ParseISOCombined(const char* datetime, const char* end, char sep = 'T');
 
-    bool ParseISOCombined(const wxString& datetime, char sep = 'T')
-    {
-        wxString::const_iterator end;
-        const wxString fmt = wxS("%Y-%m-%d") + wxString(sep) + wxS("%H:%M:%S");
-        return ParseFormat(datetime, fmt, &end) && end == datetime.end();
-    }
+        // and the same for RFC 3339, returns the pointer to the character
+        // following the parsed part or nullptr on failure
+    const char* ParseRfc3339Date(const char* date, const char* end);
 
         // parse a string containing the date/time in "free" format, this
         // function will try to make an educated guess at the string contents
@@ -1039,15 +1041,14 @@ public:
     wxString FormatTime() const { return Format(wxS("%X")); }
         // returns the string representing the date in ISO 8601 format
         // (YYYY-MM-DD)
-    wxString FormatISODate() const { return Format(wxS("%Y-%m-%d")); }
+    wxString FormatISODate() const;
         // returns the string representing the time in ISO 8601 format
         // (HH:MM:SS)
-    wxString FormatISOTime() const { return Format(wxS("%H:%M:%S")); }
+    wxString FormatISOTime() const;
         // return the combined date time representation in ISO 8601 format; the
         // separator character should be 'T' according to the standard but it
         // can also be useful to set it to ' '
-    wxString FormatISOCombined(char sep = 'T') const
-        { return FormatISODate() + sep + FormatISOTime(); }
+    wxString FormatISOCombined(char sep = 'T') const;
 
 
     // backwards compatible versions of the parsing functions: they return an
@@ -1555,6 +1556,74 @@ private:
         m_days;
 };
 
+// ----------------------------------------------------------------------------
+// wxDateTimeFormat: format string for wxDateTime::Format() and ParseFormat()
+// analysed only once, to speed up formatting or parsing many dates using it.
+//
+// Only the numeric fields ("%Y", "%y", "%m", "%d", "%H", "%M", "%S", "%l",
+// "%F" and "%T") are handled by this class itself, formats using any other
+// specifiers still work, but are not any faster than using wxDateTime.
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxDateTimeFormat
+{
+public:
+    explicit wxDateTimeFormat(const wxString& format);
+
+    const wxString& GetFormat() const { return m_format; }
+
+    // same as dt.Format(GetFormat(), tz)
+    wxString Format(const wxDateTime& dt,
+                    const wxDateTime::TimeZone& tz = wxDateTime::Local) const;
+
+    // same as dt.ParseFormat(date, GetFormat(), dateDef, end)
+    bool Parse(wxDateTime& dt,
+               const wxString& date,
+               const wxDateTime& dateDef,
+               wxString::const_iterator *end) const;
+
+    bool Parse(wxDateTime& dt,
+               const wxString& date,
+               wxString::const_iterator *end) const
+    {
+        return Parse(dt, date, wxDefaultDateTime, end);
+    }
+
+    // parse the characters in [date, end) range of the buffer, returns the
+    // pointer to the character following the parsed part or nullptr on failure
+    const char* Parse(wxDateTime& dt,
+                      const char* date,
+                      const char* end,
+                      const wxDateTime& dateDef = wxDefaultDateTime) const;
+
+private:
+    // Either a literal character or a format specifier.
+    struct Field
+    {
+        // The format specifier character, ' ' for a white space matching any
+        // number of spaces when parsing or 0 for a literal character.
+        char spec;
+
+        // The literal character if spec is 0.
+        wxUniChar ch;
+    };
+
+    template <typename Iter>
+    bool DoParse(wxDateTime& dt,
+                 Iter& p,
+                 const Iter& end,
+                 const wxDateTime& dateDef) const;
+
+    wxString m_format;
+
+    // The parsed format, empty if it uses any unsupported specifiers.
+    std::vector<Field> m_fields;
+
+    // True if all literal characters in the format are ASCII, so that it can
+    // be matched against char buffers directly.
+    bool m_isASCII;
+};
+
 // ----------------------------------------------------------------------------
 // wxDateTimeArray: array of dates.
 // ----------------------------------------------------------------------------
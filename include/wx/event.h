@@ -32,6 +32,8 @@
 #include "wx/meta/convertible.h"
 #include "wx/meta/removeref.h"
 
+#include <atomic>
+
 // This is now always defined, but keep it for backwards compatibility.
 #define wxHAS_CALL_AFTER
 
@@ -42,6 +44,8 @@
 class WXDLLIMPEXP_FWD_BASE wxList;
 class WXDLLIMPEXP_FWD_BASE wxEvent;
 class WXDLLIMPEXP_FWD_BASE wxEventFilter;
+class wxEventCoalescer;
+class wxDynamicEventIndex;
 #if wxUSE_GUI
     class WXDLLIMPEXP_FWD_CORE wxDC;
     class WXDLLIMPEXP_FWD_CORE wxMenu;
@@ -1101,6 +1105,10 @@ private:
     // If this handler
     wxEvtHandler *m_handlerToProcessOnlyIn;
 
+    // The next event in the list of the pending events of the handler this
+    // event was queued for, only used by wxEvtHandler.
+    wxEvent *m_nextPending;
+
 protected:
     // the propagation level: while it is positive, we propagate the event to
     // the parent window (if any)
@@ -1135,6 +1143,9 @@ private:
     // and this one needs to access our m_handlerToProcessOnlyIn
     friend class WXDLLIMPEXP_FWD_BASE wxEventProcessInHandlerOnly;
 
+    // and this one uses m_nextPending for its pending events list
+    friend class WXDLLIMPEXP_FWD_BASE wxEvtHandler;
+
 
     wxDECLARE_ABSTRACT_CLASS(wxEvent);
 };
@@ -3700,6 +3711,22 @@ public:
         QueueEvent(event.Clone());
     }
 
+    // Schedule the given event to be processed later, as QueueEvent(), but if
+    // an event with the same type and id queued for this handler by this
+    // function hasn't been processed yet, replace it with the new one instead
+    // of processing both of them. This is useful for the events carrying some
+    // state, e.g. progress updates, when only the latest value matters. Just
+    // as QueueEvent(), this function can be called from any thread.
+    void QueueCoalescedEvent(wxEvent *event);
+
+    // Don't process the events with the given type and id queued using
+    // QueueCoalescedEvent() more often than once per the given interval: the
+    // events queued in the meanwhile are coalesced and the last one of them
+    // is processed when the interval expires. Use 0 to remove the limit.
+    void SetCoalescedEventMinInterval(wxEventType eventType,
+                                      int winid,
+                                      int milliseconds);
+
     void ProcessPendingEvents();
         // NOTE: uses ProcessEvent()
 
@@ -4018,13 +4045,34 @@ protected:
     typedef wxVector<wxDynamicEventTableEntry*> DynamicEvents;
     DynamicEvents* m_dynamicEvents;
 
-    wxList*             m_pendingEvents;
+    // Index of m_dynamicEvents by event type, only created when there are many
+    // dynamic event handlers as it's not worth it for just a few of them.
+    wxDynamicEventIndex* m_dynamicEventsIndex;
+
+    // The events queued by QueueEvent() and not yet taken by
+    // ProcessPendingEvents(): this is a lock-free LIFO stack, linked using
+    // wxEvent::m_nextPending, to which the events can be added from any thread.
+    std::atomic<wxEvent*> m_newPendingEvents;
+
+    // FIFO list of the events taken from m_newPendingEvents, only accessed by
+    // the thread processing the pending events.
+    wxEvent*            m_pendingEventsFirst;
+    wxEvent*            m_pendingEventsLast;
 
 #if wxUSE_THREADS
-    // critical section protecting m_pendingEvents
+    // critical section protecting the list above
     wxCriticalSection m_pendingEventsLock;
 #endif // wxUSE_THREADS
 
+    // The next handler in wxAppConsole lock-free list of the handlers with new
+    // pending events and the flag set while this handler is in this list.
+    wxEvtHandler*       m_nextWithNewPendingEvents;
+    std::atomic<bool>   m_isInNewPendingHandlers;
+
+    // The object managing the events queued by QueueCoalescedEvent(), only
+    // created when this function is used for the first time.
+    std::atomic<wxEventCoalescer*> m_coalescer;
+
     // Is event handler enabled?
     bool                m_enabled;
 
@@ -4060,9 +4108,27 @@ private:
     // try to process events in all handlers chained to this one
     bool DoTryChain(wxEvent& event);
 
+    // add the entry to m_dynamicEventsIndex, creating it if necessary, or mark
+    // it as removed from it
+    void AddToDynamicEventsIndex(wxDynamicEventTableEntry* entry);
+    void RemoveFromDynamicEventsIndex(wxDynamicEventTableEntry* entry);
+
+    // remove the null entries from m_dynamicEvents and m_dynamicEventsIndex
+    void PruneDynamicEvents();
+
+    // move the events from m_newPendingEvents to the end of the pending events
+    // list, must be called with m_pendingEventsLock held
+    void TakeNewPendingEvents();
+
+    // return m_coalescer, creating it if necessary
+    wxEventCoalescer& GetCoalescer();
+
     // Head of the event filter linked list.
     static wxEventFilter* ms_filterList;
 
+    // It manages the list linked using m_nextWithNewPendingEvents.
+    friend class WXDLLIMPEXP_FWD_BASE wxAppConsoleBase;
+
     wxDECLARE_DYNAMIC_CLASS_NO_COPY(wxEvtHandler);
 };
 
@@ -304,6 +304,19 @@ public:
     // This method is only available in the generic versions.
     wxHeaderCtrl* GenericGetHeader() const;
 
+    // Extend the range of wxEVT_DATAVIEW_CACHE_HINT events by the given number
+    // of rows on both sides and don't send them again while the rows being
+    // painted remain inside the range of the last one.
+    //
+    // This method is only available in the generic versions.
+    void SetCacheHintLookAhead(unsigned int count);
+
+    // Refresh the given rows after their values became available. Unlike all
+    // the other methods, this one may be called from any thread.
+    //
+    // This method is only available in the generic versions.
+    void NotifyRowsReady(unsigned int from, unsigned int to);
+
 protected:
     void EnsureVisibleRowCol( int row, int column );
 
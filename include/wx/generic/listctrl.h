@@ -163,6 +163,14 @@ public:
     void RefreshItem(long item);
     void RefreshItems(long itemFrom, long itemTo);
 
+    // extend the range of wxEVT_LIST_CACHE_HINT events for virtual controls
+    // by the given number of items on both sides of the visible range
+    void SetCacheHintLookAhead(long count);
+
+    // refresh the items whose data became available, unlike RefreshItems()
+    // this function may be called from any thread
+    void NotifyItemsReady(long itemFrom, long itemTo);
+
     virtual void EnableBellOnNoMatch(bool on = true) override;
 
     // overridden base class virtuals
@@ -18,6 +18,7 @@
 #include "wx/selstore.h"
 #include "wx/timer.h"
 #include "wx/settings.h"
+#include "wx/thread.h"
 
 #include <memory>
 
@@ -32,8 +33,8 @@
 struct wxColWidthInfo
 {
     int     nMaxWidth;
-    bool    bNeedsUpdate;   //  only set to true when an item whose
-                            //  width == nMaxWidth is removed
+    bool    bNeedsUpdate;   //  set to true when the items in the column
+                            //  change and nMaxWidth must be recomputed
 
     wxColWidthInfo(int w = 0, bool needsUpdate = false)
     {
@@ -53,9 +54,9 @@ class wxListItemData
 public:
     wxListItemData(wxListMainWindow *owner);
     wxListItemData(const wxListItemData&) = delete;
-    wxListItemData(wxListItemData&&);
+    wxListItemData(wxListItemData&&) noexcept;
     wxListItemData& operator=(const wxListItemData&) = delete;
-    wxListItemData& operator=(wxListItemData&&);
+    wxListItemData& operator=(wxListItemData&&) noexcept;
     ~wxListItemData();
 
     void SetItem( const wxListItem &info );
@@ -64,9 +65,9 @@ public:
     void SetPosition( int x, int y );
     void SetSize( int width, int height );
 
-    bool HasText() const { return !m_text.empty(); }
-    const wxString& GetText() const { return m_text; }
-    void SetText(const wxString& text) { m_text = text; }
+    bool HasText() const { return m_text != nullptr; }
+    const wxString& GetText() const;
+    void SetText(const wxString& text);
 
     // we can't use empty string for measuring the string width/height, so
     // always return something
@@ -91,13 +92,20 @@ public:
 
     void GetItem( wxListItem &info ) const;
 
-    void SetAttr(wxItemAttr *attr) { m_attr = attr; }
-    wxItemAttr *GetAttr() const { return m_attr; }
+    void SetAttr(const wxItemAttr *attr) { m_attr = attr; }
+    const wxItemAttr *GetAttr() const { return m_attr; }
 
 public:
     // the item image or -1
     int m_image = -1;
 
+    // true if m_attr comes from the shared attributes pool and must be
+    // released by us, which is the case unless the control is virtual as then
+    // the attributes are managed by the program itself (this is stored
+    // instead of the owner window pointer to avoid increasing the size of
+    // each cell, as there may be very many of them)
+    bool m_ownsAttr;
+
     // user data associated with the item
     wxUIntPtr m_data = 0;
 
@@ -105,14 +113,12 @@ public:
     // null and the owner window is used to retrieve the item position and size
     wxRect *m_rect = nullptr;
 
-    // the list ctrl we are in
-    wxListMainWindow *m_owner;
-
     // custom attributes or nullptr
-    wxItemAttr *m_attr = nullptr;
+    const wxItemAttr *m_attr = nullptr;
 
 protected:
-    wxString m_text;
+    // the item text, stored in the shared strings pool, or nullptr if empty
+    const wxString *m_text = nullptr;
 };
 
 //-----------------------------------------------------------------------------
@@ -163,6 +169,12 @@ private:
 //  wxListLineData (internal)
 //-----------------------------------------------------------------------------
 
+// Each line owns the items for all of its columns, which only refer to their
+// text and attributes stored, once per distinct value, in the pools shared by
+// all controls: this keeps the items small while still allowing to insert,
+// delete and sort the lines by moving just the line objects. For very big
+// numbers of items, wxLC_VIRTUAL should be used instead as it stores nothing
+// per line.
 class wxListLineData
 {
 public:
@@ -259,8 +271,8 @@ public:
     wxString GetText(int index) const;
     void SetText( int index, const wxString& s );
 
-    wxItemAttr *GetAttr() const;
-    void SetAttr(wxItemAttr *attr);
+    const wxItemAttr *GetAttr() const;
+    void SetAttr(const wxItemAttr *attr);
 
     // return true if the highlighting really changed
     bool Highlight( bool on );
@@ -874,9 +886,32 @@ protected:
     // force us to recalculate the range of visible lines
     void ResetVisibleLinesRange() { m_lineFrom = (size_t)-1; }
 
+    // set the number of lines to add on both sides of the visible range in
+    // wxEVT_LIST_CACHE_HINT events, 0 means to use the visible range only
+    void SetCacheHintLookAhead(size_t count)
+    {
+        m_cacheHintLookAhead = count;
+        ResetCacheHint();
+    }
+
+    // forget the range of lines of the last cache hint, so that the next one
+    // is sent even if the visible lines are still inside it
+    void ResetCacheHint() { m_cacheHintFrom = m_cacheHintTo = (size_t)-1; }
+
+    // called, possibly from another thread, when the data for the given lines
+    // becomes available to refresh them later from the main thread
+    void OnLinesReady(size_t lineFrom, size_t lineTo);
+
     // find the first item starting with the given prefix after the given item
     size_t PrefixFindItem(size_t item, const wxString& prefix) const;
 
+    // return true if the label of the given line starts with (or is equal
+    // to, if partial is false) the given string, which must be in lower case,
+    // ignoring the case of the label; this is much cheaper than using
+    // GetLine(line)->GetText(0) for virtual controls, as it doesn't retrieve
+    // the other columns and attributes
+    bool LineMatches(size_t line, const wxString& strLower, bool partial) const;
+
     // get the colour to be used for drawing the rules
     wxColour GetRuleColour() const
     {
@@ -911,6 +946,13 @@ private:
     // Compute the minimal width needed to fully display the column header.
     int ComputeMinHeaderWidth(const wxListHeaderData* header) const;
 
+    // send wxEVT_LIST_CACHE_HINT for the given visible lines unless the range
+    // of the last cache hint sent still covers them
+    void SendCacheHint(size_t visibleFrom, size_t visibleTo);
+
+    // refresh the lines accumulated by OnLinesReady()
+    void RefreshReadyLines();
+
     // Check if the given point is inside the checkbox of this item.
     //
     // Always returns false if there are no checkboxes.
@@ -940,6 +982,24 @@ private:
     // rulers on empty rows
     bool m_extendRulesAndAlternateColour;
 
+    // the number of lines to add to the visible lines range in the cache hint
+    // events: if it is non-zero, the hints are also coalesced, i.e. not sent
+    // again while the visible lines remain in the range of the last one
+    size_t m_cacheHintLookAhead;
+
+    // the range of lines of the last cache hint sent or -1
+    size_t m_cacheHintFrom,
+           m_cacheHintTo;
+
+    // the range of lines which became ready and must be refreshed or -1 if
+    // none, this is protected by m_readyLinesCS as it is modified by
+    // OnLinesReady() which can be called from any thread
+    size_t m_readyFrom,
+           m_readyTo;
+#if wxUSE_THREADS
+    wxCriticalSection m_readyLinesCS;
+#endif // wxUSE_THREADS
+
     wxDECLARE_EVENT_TABLE();
 
     friend class wxGenericListCtrl;
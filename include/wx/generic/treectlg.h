@@ -250,6 +250,8 @@ protected:
                          m_hilightUnfocusedBrush;
     bool                 m_hasFocus;
     bool                 m_dirty;
+    bool                 m_layoutValid; // items positions and extents are
+                                        // up to date if not m_dirty
     bool                 m_isDragging; // true between BEGIN/END drag events
     bool                 m_lastOnSame;  // last click on the same item as prev
 
@@ -327,11 +329,20 @@ protected:
     void CalculateLineHeight();
     int  GetLineHeight(wxGenericTreeItem *item) const;
     void PaintLevel( wxGenericTreeItem *item, wxDC& dc, int level, int &y );
+    void PaintChildren( wxGenericTreeItem *item, wxDC& dc, int level,
+                        int &y, int &lastY );
     void PaintItem( wxGenericTreeItem *item, wxDC& dc);
 
     void CalculateLevel( wxGenericTreeItem *item, wxDC &dc, int level, int &y );
     void CalculatePositions();
 
+    // update the layout after expanding or collapsing the given item: this
+    // only recalculates the positions of the items in its subtree if possible
+    void UpdateLayoutOfSubtree( wxGenericTreeItem *item );
+
+    // return true if the cached positions of the items can be used
+    bool IsLayoutValid() const { return m_layoutValid && !m_dirty; }
+
     void RefreshSubtree( wxGenericTreeItem *item );
     void RefreshLine( wxGenericTreeItem *item );
 
@@ -556,6 +556,23 @@ struct WXDLLIMPEXP_BASE wxStringEqual
         { return strcmp( a, b ) == 0; }
 };
 
+// case-insensitive versions of the above, for wxString only
+struct WXDLLIMPEXP_BASE wxStringHashNoCase
+{
+    wxStringHashNoCase() noexcept = default;
+    unsigned long operator()( const wxString& x ) const noexcept
+        { return stringHash( x ); }
+
+    static unsigned long stringHash( const wxString& );
+};
+
+struct WXDLLIMPEXP_BASE wxStringEqualNoCase
+{
+    wxStringEqualNoCase() noexcept = default;
+    bool operator()( const wxString& a, const wxString& b ) const noexcept
+        { return a.IsSameAs( b, false ); }
+};
+
 #ifdef wxNEEDS_WX_HASH_MAP
 
 #define wxPTROP_NORMAL(pointer) \
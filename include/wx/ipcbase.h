@@ -80,6 +80,11 @@ public:
                               size_t *size = nullptr,
                               wxIPCFormat format = wxIPC_TEXT) = 0;
 
+  // send the request without waiting for the reply which is passed to
+  // OnRequestReply() later, returns the request ID or 0 on failure
+  virtual int RequestAsync(const wxString& item,
+                           wxIPCFormat format = wxIPC_TEXT);
+
   bool Poke(const wxString& item, const void *data, size_t size,
             wxIPCFormat fmt = wxIPC_PRIVATE)
       { return DoPoke(item, data, size, fmt); }
@@ -123,6 +128,10 @@ public:
   // Calls that both can make
   virtual bool Disconnect() = 0;
 
+  // don't send the messages until EndBatch() is called
+  virtual void BeginBatch() { }
+  virtual bool EndBatch() { return true; }
+
 
   // Callbacks to SERVER - override at will
   virtual bool OnExec(const wxString& WXUNUSED(topic),
@@ -174,6 +183,13 @@ public:
                         wxIPCFormat WXUNUSED(format))
       { return false; }
 
+  // data is null if the request failed
+  virtual bool OnRequestReply(int WXUNUSED(requestId),
+                              const void *WXUNUSED(data),
+                              size_t WXUNUSED(size),
+                              wxIPCFormat WXUNUSED(format))
+      { return false; }
+
   // Callbacks to BOTH
   virtual bool OnDisconnect() { delete this; return true; }
 
@@ -211,11 +227,14 @@ protected:
   virtual bool DoAdvise(const wxString& item, const void *data, size_t size,
                         wxIPCFormat format) = 0;
 
+  // return the ID to use for the next asynchronous request
+  int GetNextRequestId();
 
 private:
   char         *m_buffer;
   size_t        m_buffersize;
   bool          m_deletebufferwhendone;
+  int           m_lastRequestId;
 
 protected:
   bool          m_connected;
@@ -20,7 +20,18 @@ enum wxFDIODispatcherEntryFlags
     wxFDIO_INPUT = 1,
     wxFDIO_OUTPUT = 2,
     wxFDIO_EXCEPTION = 4,
-    wxFDIO_ALL = wxFDIO_INPUT | wxFDIO_OUTPUT | wxFDIO_EXCEPTION
+    wxFDIO_ALL = wxFDIO_INPUT | wxFDIO_OUTPUT | wxFDIO_EXCEPTION,
+
+    // this is not a set but a hint that the handler always consumes all the
+    // available data (or writes as much as possible) when notified, so that
+    // it doesn't need to be notified again until the descriptor state changes:
+    // this allows wxEpollDispatcher to use edge-triggered notifications for
+    // it, which are more efficient, while the other dispatchers ignore it
+    //
+    // notice that edge-triggered handlers registered for both input and
+    // output may be notified about both of them at once, so they must not be
+    // destroyed from their OnReadWaiting()
+    wxFDIO_EDGE_TRIGGERED = 8
 };
 
 // base class for wxSelectDispatcher and wxEpollDispatcher
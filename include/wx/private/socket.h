@@ -41,6 +41,7 @@
 #if wxUSE_SOCKETS
 
 #include "wx/socket.h"
+#include "wx/filefn.h"
 #include "wx/private/sckaddr.h"
 
 #include <stddef.h>
@@ -87,6 +88,11 @@
     #define INVALID_SOCKET (-1)
 #endif
 
+// sendfile() is used by wxSocketBase::WriteFile() if available
+#ifdef __LINUX__
+    #define wxHAS_SOCKET_SENDFILE
+#endif
+
 #ifndef SOCKET_ERROR
     #define SOCKET_ERROR (-1)
 #endif
@@ -256,6 +262,25 @@ public:
     int Read(void *buffer, int size);
     int Write(const void *buffer, int size);
 
+    // vectored IO, only works for TCP sockets: transfer as much data as
+    // possible from/to the given buffers, skipping the first offset bytes of
+    // the first one, and return the same value as Read/Write()
+    //
+    // notice that not all buffers may be used by a single call even if the
+    // data is available, it is only guaranteed that the first one is
+    int ReadV(const wxSocketIOVec *vec, int count, wxUint32 offset);
+    int WriteV(const wxSocketIOVec *vec, int count, wxUint32 offset);
+
+#ifdef wxHAS_SOCKET_SENDFILE
+    // send up to size bytes of the file with the given descriptor starting at
+    // the given offset, which is updated, to a TCP socket without copying
+    // them to the user space
+    //
+    // returns the same value as Write() and sets m_error to wxSOCKET_INVOP if
+    // the file can't be sent in this way
+    int SendFile(int fd, wxFileOffset *offset, wxUint32 size);
+#endif // wxHAS_SOCKET_SENDFILE
+
     // basically a wrapper for select(): returns the condition of the socket,
     // blocking for not longer than timeout if it is specified (otherwise just
     // poll without blocking at all)
@@ -358,6 +383,9 @@ private:
     // update local address after binding/connecting
     wxSocketError UpdateLocalAddress();
 
+    // called when the peer closed the connection of a TCP socket
+    void OnStreamClosed();
+
     // functions used to implement Read/Write()
     int RecvStream(void *buffer, int size);
     int RecvDgram(void *buffer, int size);
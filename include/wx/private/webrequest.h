@@ -70,6 +70,11 @@ public:
 
     wxWebRequest::Storage GetStorage() const { return m_storage; }
 
+    virtual bool SetDataConsumer(wxWebResponseConsumer* WXUNUSED(consumer))
+        { return false; }
+
+    virtual void ResumeTransfer() { }
+
     // Precondition for this method checked by caller: current state is idle.
     virtual void Start() = 0;
 
@@ -182,6 +187,9 @@ public:
 
     virtual wxString GetDataFile() const;
 
+    virtual wxLongLong GetTiming(wxWebResponse::Timing WXUNUSED(timing)) const
+        { return -1; }
+
 protected:
     wxWebRequestImpl& m_request;
     size_t m_readSize;
@@ -256,6 +264,16 @@ public:
 
     virtual bool EnablePersistentStorage(bool WXUNUSED(enable)) { return false; }
 
+    virtual bool SetMaxConnectionsPerHost(int WXUNUSED(maxConnections))
+        { return false; }
+
+    virtual bool SetMaxConnections(int WXUNUSED(maxConnections))
+        { return false; }
+
+    virtual bool EnableConnectionReuse(bool WXUNUSED(enable)) { return false; }
+
+    virtual bool EnableMultiplexing(bool WXUNUSED(enable)) { return false; }
+
 protected:
     wxWebSessionImpl();
 
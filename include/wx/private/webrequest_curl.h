@@ -64,6 +64,15 @@ public:
 
     wxFileOffset GetBytesExpectedToSend() const override;
 
+    bool SetDataConsumer(wxWebResponseConsumer* consumer) override;
+
+    void ResumeTransfer() override;
+
+    wxWebResponseConsumer* GetDataConsumer() const { return m_consumer; }
+
+    // Called when the consumer refuses the data and the transfer is paused.
+    void OnTransferPaused() { m_paused = true; }
+
     CURL* GetHandle() const { return m_handle; }
 
     wxWebRequestHandle GetNativeHandle() const override
@@ -83,6 +92,10 @@ public:
 private:
     void DoCancel() override;
 
+    // Resume the transfer paused by the consumer, must be called in the main
+    // thread.
+    void DoResumeTransfer();
+
     wxWebSessionCURL& m_sessionImpl;
 
     CURL* m_handle;
@@ -92,6 +105,12 @@ private:
     wxObjectDataPtr<wxWebAuthChallengeCURL> m_authChallenge;
     wxFileOffset m_bytesSent;
 
+    // Consumer receiving the data directly, may be null.
+    wxWebResponseConsumer* m_consumer = nullptr;
+
+    // True if the transfer is currently paused because of the consumer.
+    bool m_paused = false;
+
     void DestroyHeaderList();
 
     wxDECLARE_NO_COPY_CLASS(wxWebRequestCURL);
@@ -112,6 +131,7 @@ public:
 
     wxString GetStatusText() const override { return m_statusText; }
 
+    wxLongLong GetTiming(wxWebResponse::Timing timing) const override;
 
     // Methods called from libcurl callbacks
     size_t CURLOnWrite(void *buffer, size_t size);
@@ -149,6 +169,17 @@ public:
         return (wxWebSessionHandle)m_handle;
     }
 
+    bool SetMaxConnectionsPerHost(int maxConnections) override;
+
+    bool SetMaxConnections(int maxConnections) override;
+
+    bool EnableConnectionReuse(bool enable) override;
+
+    bool EnableMultiplexing(bool enable) override;
+
+    // Set the options depending on the session settings for the new request.
+    void SetupRequestHandle(CURL* curl) const;
+
     bool StartRequest(wxWebRequestCURL& request);
 
     void CancelRequest(wxWebRequestCURL* request);
@@ -171,6 +202,7 @@ private:
     void FailRequest(CURL*, const wxString&);
     void StopActiveTransfer(CURL*);
     void RemoveActiveSocket(CURL*);
+    void ApplyConnectionOptions();
 
     using TransferSet = std::unordered_map<CURL*, wxWebRequestCURL*>;
     using CurlSocketMap = std::unordered_map<CURL*, curl_socket_t>;
@@ -182,6 +214,13 @@ private:
     wxTimer m_timeoutTimer;
     CURLM* m_handle;
 
+    // Connection options, 0 for the limits means no limit and -1 for
+    // multiplexing means using libcurl default behaviour.
+    long m_maxHostConnections = 0;
+    long m_maxConnections = 0;
+    int m_multiplexing = -1;
+    bool m_reuseConnections = true;
+
     static int ms_activeSessions;
     static unsigned int ms_runtimeVersion;
 
@@ -45,6 +45,10 @@ enum
     // after/before it regardless of the setting of wxRE_NOT[BE]OL
     wxRE_NEWLINE  = 16,
 
+    // use JIT compilation if available: compiling becomes slower but matching
+    // is much faster, which is worth it for the patterns used many times
+    wxRE_JIT      = 256,
+
     // default flags
     wxRE_DEFAULT  = wxRE_EXTENDED
 };
@@ -99,8 +103,16 @@ public:
     //
     // may only be called after successful call to Compile()
     bool Matches(const wxString& text, int flags = 0) const;
-    bool Matches(const wxChar *text, int flags, size_t len) const
-        { return Matches(wxString(text, len), flags); }
+
+    // matches the text in the given buffer, which doesn't need to be
+    // NUL-terminated, without copying it unless the library uses a different
+    // representation (only the case for wxUSE_UNICODE_UTF8 build currently)
+    bool Matches(const wxChar *text, int flags, size_t len) const;
+
+    // matches the text referenced by the view without copying it in any
+    // build, the positions returned by GetMatch() are then relative to the
+    // start of the view and in units of wxStringCharType
+    bool Matches(const wxStringView& text, int flags = 0) const;
 
     // get the start index and the length of the match of the expression
     // (index 0) or a bracketed subexpression (index != 0)
@@ -149,6 +161,10 @@ public:
     // return the extended RE corresponding to the given basic RE
     static wxString ConvertFromBasic(const wxString& bre);
 
+    // set the maximal number of compiled patterns kept in the process-wide
+    // cache, 0 disables caching
+    static void SetCacheSize(size_t size);
+
     // return version information for the underlying regex library
     static wxVersionInfo GetLibraryVersionInfo();
 
@@ -69,9 +69,13 @@ public:
     virtual const void *Request(const wxString& item,
                                 size_t *size = nullptr,
                                 wxIPCFormat format = wxIPC_TEXT) override;
+    virtual int RequestAsync(const wxString& item,
+                             wxIPCFormat format = wxIPC_TEXT) override;
     virtual bool StartAdvise(const wxString& item) override;
     virtual bool StopAdvise(const wxString& item) override;
     virtual bool Disconnect() override;
+    virtual void BeginBatch() override;
+    virtual bool EndBatch() override;
 
     // Will be used in the future to enable the compression but does nothing
     // for now.
@@ -104,6 +108,10 @@ private:
     // common part of both ctors
     void Init();
 
+    // read the reply to a synchronous call, handling any other messages
+    // received before it
+    int ReadReply();
+
     friend class wxTCPServer;
     friend class wxTCPClient;
     friend class wxTCPEventHandler;
@@ -24,6 +24,10 @@
 
 class wxSocketImpl;
 
+#if wxUSE_FILE
+class WXDLLIMPEXP_FWD_BASE wxFile;
+#endif
+
 // ------------------------------------------------------------------------
 // Types and constants
 // ------------------------------------------------------------------------
@@ -94,6 +98,14 @@ enum
 
 typedef int wxSocketFlags;
 
+// buffer descriptor used by the vectored IO functions, this is similar to the
+// standard struct iovec (notice that the data is not modified when writing)
+struct wxSocketIOVec
+{
+    void *data;
+    wxUint32 size;
+};
+
 // socket kind values (badly defined, don't use)
 enum wxSocketType
 {
@@ -157,6 +169,15 @@ public:
     wxSocketBase& Write(const void *buffer, wxUint32 nbytes);
     wxSocketBase& WriteMsg(const void *buffer, wxUint32 nbytes);
 
+    // vectored IO, only for stream sockets
+    wxSocketBase& ReadV(const wxSocketIOVec *vec, int count);
+    wxSocketBase& WriteV(const wxSocketIOVec *vec, int count);
+
+#if wxUSE_FILE
+    // write the given number of bytes from the current position of the file
+    wxSocketBase& WriteFile(wxFile& file, wxUint32 nbytes);
+#endif // wxUSE_FILE
+
     // all Wait() functions wait until their condition is satisfied or the
     // timeout expires; if seconds == -1 (default) then m_timeout value is used
     //
@@ -242,6 +263,11 @@ private:
     // low level IO
     wxUint32 DoRead(void* buffer, wxUint32 nbytes);
     wxUint32 DoWrite(const void *buffer, wxUint32 nbytes);
+    wxUint32 DoReadV(const wxSocketIOVec *vec, int count);
+    wxUint32 DoWriteV(const wxSocketIOVec *vec, int count);
+#if wxUSE_FILE
+    wxUint32 DoWriteFile(wxFile& file, wxUint32 nbytes);
+#endif // wxUSE_FILE
 
     // wait until the given flags are set for this socket or the given timeout
     // (or m_timeout) expires
@@ -292,7 +318,8 @@ private:
     bool          m_beingDeleted;     // marked for delayed deletion?
     wxIPV4address m_localAddress;     // bind to local address?
 
-    // pushback buffer
+    // pushback buffer: the data is stored at its end, in [m_unrd_cur,
+    // m_unrd_size) range, so that more of it can be prepended without moving
     void         *m_unread;           // pushback buffer
     wxUint32      m_unrd_size;        // pushback buffer size
     wxUint32      m_unrd_cur;         // pushback pointer (index into buffer)
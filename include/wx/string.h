@@ -54,6 +54,8 @@
 
 #include "wx/afterstd.h"
 
+#include "wx/stringview.h"
+
 // by default we cache the mapping of the positions in UTF-8 string to the byte
 // offset as this results in noticeable performance improvements for loops over
 // strings using indices; comment out this line to disable this
@@ -457,6 +459,8 @@ private:
   #define wxSTRING_INVALIDATE_CACHED_LENGTH()
   #define wxSTRING_UPDATE_CACHED_LENGTH(n)
   #define wxSTRING_SET_CACHED_LENGTH(n)
+  #define wxSTRING_APPEND_INVALIDATE_CACHED_LENGTH()
+  #define wxSTRING_APPEND_UPDATE_CACHED_LENGTH(n)
 
 #else // wxUSE_UNICODE_UTF8
 
@@ -477,23 +481,42 @@ private:
   // contains the string it applies to and the index corresponding to the last
   // used position in this wxString in its m_impl string
   //
-  // NB: notice that this struct (and nested Element one) must be a POD or we
-  //     wouldn't be able to use a thread-local variable of this type, in
+  // besides the last used position, each element also remembers the length of
+  // the string prefix known to consist of ASCII characters only, for which
+  // the positions in the string and m_impl are the same, and, for the long
+  // strings accessed non-sequentially, the positions in m_impl of every
+  // MARK_STEP-th character, allowing to find the position of any character
+  // without scanning more than MARK_STEP characters
+  //
+  // all this information is only computed for the part of the string before
+  // the last position passed to PosToImpl() and is reset whenever the string
+  // is modified, which allows the modifying functions to use PosToImpl()
+  // before changing the string after this position, except when appending to
+  // it as this can't affect anything before the old end of the string
+  //
+  // NB: notice that this struct (and nested Element one) must be a POD, in
   //     particular it should have no ctor -- we rely on statics being
-  //     initialized to 0 instead
+  //     initialized to 0 instead -- and no dtor, as accessing thread-local
+  //     variables of such types is more expensive
   struct Cache
   {
-      enum { SIZE = 8 };
+      enum { SIZE = 8, MARK_STEP = 64 };
 
       struct Element
       {
           const wxString *str;  // the string to which this element applies
           size_t pos,           // the cached index in this string
                  impl,          // the corresponding position in its m_impl
-                 len;           // cached length or npos if unknown
+                 len,           // cached length or npos if unknown
+                 ascii,         // length of the known ASCII-only prefix
+                 numMarks,      // number of valid elements in marks
+                 maxMarks;      // number of allocated elements in marks
+          size_t *marks;        // marks[n] is the position in m_impl of the
+                                // character with index (n + 1)*MARK_STEP
 
-          // reset cached index to 0
-          void ResetPos() { pos = impl = 0; }
+          // reset cached index to 0 and forget everything known about the
+          // string contents, but keep the marks buffer for reuse
+          void ResetPos() { pos = impl = ascii = numMarks = 0; }
 
           // reset position and length
           void Reset() { ResetPos(); len = npos; }
@@ -510,13 +533,15 @@ private:
   static Cache& GetCache();
 
   static Cache::Element *GetCacheBegin() { return GetCache().cached; }
-  static Cache::Element *GetCacheEnd() { return GetCacheBegin() + Cache::SIZE; }
   static unsigned& LastUsedCacheElement() { return GetCache().lastUsed; }
 
   // this is used in debug builds only to provide a convenient function,
   // callable from a debugger, to show the cache contents
   friend struct wxStrCacheDumper;
 
+  // and this one frees the memory used by the marks on thread exit
+  friend struct wxStrCacheMarksDeleter;
+
   // uncomment this to have access to some profiling statistics on program
   // termination
   //#define wxPROFILE_STRING_CACHE
@@ -527,6 +552,8 @@ private:
       unsigned postot,  // total non-trivial calls to PosToImpl
                poshits, // cache hits from PosToImpl()
                mishits, // cached position beyond the needed one
+               asciihits, // position found in the ASCII-only prefix
+               markhits,  // position found starting from a mark
                sumpos,  // sum of all positions, used to compute the
                         // average position after dividing by postot
                sumofs,  // sum of all offsets after using the cache, used to
@@ -558,13 +585,13 @@ private:
       // simple loop instead of starting from the last used element (there are
       // a lot of misses in this function...)
       Cache::Element * const cacheBegin = GetCacheBegin();
+      Cache::Element * const cacheEnd = cacheBegin + Cache::SIZE;
 
       // gcc 7 warns about not being able to optimize this loop because of
       // possible loop variable overflow, really not sure what to do about
       // this, so just disable this warnings for now
       wxGCC_ONLY_WARNING_SUPPRESS(unsafe-loop-optimizations)
 
-      Cache::Element * const cacheEnd = GetCacheEnd();
       for ( Cache::Element *c = cacheBegin; c != cacheEnd; c++ )
       {
           if ( c->str == this )
@@ -587,9 +614,11 @@ private:
       wxGCC_ONLY_WARNING_SUPPRESS(null-dereference)
 #endif
 
-      Cache::Element * const cacheBegin = GetCacheBegin();
-      Cache::Element * const cacheEnd = GetCacheEnd();
-      Cache::Element * const cacheStart = cacheBegin + LastUsedCacheElement();
+      // GetCache() is not inline, so call it only once
+      Cache& cacheAll = GetCache();
+      Cache::Element * const cacheBegin = cacheAll.cached;
+      Cache::Element * const cacheEnd = cacheBegin + Cache::SIZE;
+      Cache::Element * const cacheStart = cacheBegin + cacheAll.lastUsed;
 
       // check the last used first, this does no (measurable) harm for a miss
       // but does help for simple loops addressing the same string all the time
@@ -612,7 +641,7 @@ private:
           c->Reset();
 
           // and remember the last used element
-          LastUsedCacheElement() = static_cast<unsigned int>(c - cacheBegin);
+          cacheAll.lastUsed = static_cast<unsigned int>(c - cacheBegin);
       }
 
       return c;
@@ -635,6 +664,14 @@ private:
 
       Cache::Element * const cache = GetCacheElement();
 
+      // all characters in the ASCII prefix are represented by a single byte
+      if ( pos <= cache->ascii )
+      {
+          wxCACHE_PROFILE_FIELD_INC(asciihits);
+
+          return pos;
+      }
+
       // cached position can't be 0 so if it is, it means that this entry was
       // used for length caching only so far, i.e. it doesn't count as a hit
       // from our point of view
@@ -646,21 +683,45 @@ private:
       if ( pos == cache->pos )
           return cache->impl;
 
-      // this seems to happen only rarely so just reset the cache in this case
-      // instead of complicating code even further by seeking backwards in this
-      // case
-      if ( cache->pos > pos )
+      // start either from the cached position or from the end of the ASCII
+      // prefix, whichever is closer
+      size_t from,
+             fromImpl;
+      if ( cache->pos > cache->ascii && cache->pos < pos )
       {
-          wxCACHE_PROFILE_FIELD_INC(mishits);
+          from = cache->pos;
+          fromImpl = cache->impl;
+      }
+      else
+      {
+          if ( cache->pos > pos )
+          {
+              wxCACHE_PROFILE_FIELD_INC(mishits);
+          }
 
-          cache->ResetPos();
+          // check if the ASCII prefix extends up to the requested position
+          // (but not beyond it, see the comment before Cache)
+          from = cache->ascii;
+          while ( from < pos &&
+                    !(static_cast<unsigned char>(m_impl[from]) & 0x80) )
+              from++;
+
+          cache->ascii = from;
+          if ( from == pos )
+              return pos;
+
+          fromImpl = from;
       }
 
-      wxCACHE_PROFILE_FIELD_ADD(sumofs, pos - cache->pos);
+      // for the long strings, use the marks instead of scanning them from the
+      // start every time
+      if ( pos - from > Cache::MARK_STEP )
+          return DoPosToImplUsingMarks(cache, pos, from, fromImpl);
 
+      wxCACHE_PROFILE_FIELD_ADD(sumofs, pos - from);
 
-      wxStringImpl::const_iterator i(m_impl.begin() + cache->impl);
-      for ( size_t n = cache->pos; n < pos; n++ )
+      wxStringImpl::const_iterator i(m_impl.begin() + fromImpl);
+      for ( size_t n = from; n < pos; n++ )
           wxStringOperations::IncIter(i);
 
       cache->pos = pos;
@@ -672,6 +733,16 @@ private:
       return cache->impl;
   }
 
+  // slow part of DoPosToImpl(), used when the requested position is too far
+  // from the starting point
+  size_t DoPosToImplUsingMarks(Cache::Element *cache,
+                               size_t pos,
+                               size_t from,
+                               size_t fromImpl) const;
+
+  // append a new mark to the cache element, return false if out of memory
+  static bool AddCacheMark(Cache::Element *cache, size_t impl);
+
   void InvalidateCache()
   {
       Cache::Element * const cache = FindCacheElement();
@@ -679,11 +750,15 @@ private:
           cache->Reset();
   }
 
+  // the functions below are called before modifying the string and, as the
+  // caller may use PosToImpl() after calling them, they must reset the cached
+  // position, which may be beyond the modification point
+
   void InvalidateCachedLength()
   {
       Cache::Element * const cache = FindCacheElement();
       if ( cache )
-          cache->len = npos;
+          cache->Reset();
   }
 
   void SetCachedLength(size_t len)
@@ -692,24 +767,52 @@ private:
       // present in the cache before, this seems to do no harm and the
       // potential for avoiding length recomputation for long strings looks
       // interesting
-      GetCacheElement()->len = len;
+      Cache::Element * const cache = GetCacheElement();
+      cache->ResetPos();
+      cache->len = len;
   }
 
   void UpdateCachedLength(ptrdiff_t delta)
   {
       Cache::Element * const cache = FindCacheElement();
-      if ( cache && cache->len != npos )
+      if ( cache )
       {
-          wxSTRING_CACHE_ASSERT( (ptrdiff_t)cache->len + delta >= 0 );
+          cache->ResetPos();
+
+          if ( cache->len != npos )
+          {
+              wxSTRING_CACHE_ASSERT( (ptrdiff_t)cache->len + delta >= 0 );
 
-          cache->len += delta;
+              cache->len += delta;
+          }
       }
   }
 
+  // appending to the string doesn't change anything before its old end, so
+  // the cached position, ASCII prefix and marks all remain valid and only
+  // the length needs to be updated
+
+  void AppendInvalidateCachedLength()
+  {
+      Cache::Element * const cache = FindCacheElement();
+      if ( cache )
+          cache->len = npos;
+  }
+
+  void AppendUpdateCachedLength(size_t n)
+  {
+      Cache::Element * const cache = FindCacheElement();
+      if ( cache && cache->len != npos )
+          cache->len += n;
+  }
+
   #define wxSTRING_INVALIDATE_CACHE() InvalidateCache()
   #define wxSTRING_INVALIDATE_CACHED_LENGTH() InvalidateCachedLength()
   #define wxSTRING_UPDATE_CACHED_LENGTH(n) UpdateCachedLength(n)
   #define wxSTRING_SET_CACHED_LENGTH(n) SetCachedLength(n)
+  #define wxSTRING_APPEND_INVALIDATE_CACHED_LENGTH() \
+      AppendInvalidateCachedLength()
+  #define wxSTRING_APPEND_UPDATE_CACHED_LENGTH(n) AppendUpdateCachedLength(n)
 #else // !wxUSE_STRING_POS_CACHE
   size_t DoPosToImpl(size_t pos) const
   {
@@ -720,6 +823,8 @@ private:
   #define wxSTRING_INVALIDATE_CACHED_LENGTH()
   #define wxSTRING_UPDATE_CACHED_LENGTH(n)
   #define wxSTRING_SET_CACHED_LENGTH(n)
+  #define wxSTRING_APPEND_INVALIDATE_CACHED_LENGTH()
+  #define wxSTRING_APPEND_UPDATE_CACHED_LENGTH(n)
 #endif // wxUSE_STRING_POS_CACHE/!wxUSE_STRING_POS_CACHE
 
   size_t PosToImpl(size_t pos) const
@@ -1313,6 +1418,10 @@ public:
         { assign(view.data(), view.length()); }
 #endif  // wxHAS_STD_STRING_VIEW
 
+    // the view data is in our internal representation, so just copy it
+    explicit wxString(const wxStringView& view)
+        : m_impl(view.data(), view.length()) { }
+
 #ifndef wxNO_IMPLICIT_WXSTRING_ENCODING
   wxString(const std::string& str)
       { assign(str.c_str(), str.length()); }
@@ -1424,6 +1533,10 @@ public:
           // here as it's probably 0 anyhow -- you usually call length() before
           // starting to index the string
           cache->len = end() - begin();
+
+          // if all characters take a single byte, the string is pure ASCII
+          if ( cache->len == m_impl.length() )
+              cache->ascii = cache->len;
       }
       else
       {
@@ -1475,12 +1588,19 @@ public:
     {
         append(nSize - len, ch);
     }
-    else // can use (presumably faster) resize() version
+    else // can append the ASCII characters to the underlying string directly
 #endif // wxUSE_UNICODE_UTF8
     {
         wxSTRING_INVALIDATE_CACHED_LENGTH();
 
+#if wxUSE_UNICODE_UTF8
+        // notice that we can't use m_impl.resize(nSize) here as it counts
+        // in bytes and the string may contain non-ASCII characters taking
+        // more than one byte
+        m_impl.append(nSize - len, (wxStringCharType)ch);
+#else
         m_impl.resize(nSize, (wxStringCharType)ch);
+#endif
     }
   }
 
@@ -2157,6 +2277,8 @@ public:
 #endif
       return (compareWithCase ? Cmp(str) : CmpNoCase(str)) == 0;
   }
+  bool IsSameAs(const wxStringView& str, bool compareWithCase = true) const
+    { return wxStringView(*this).IsSameAs(str, compareWithCase); }
 #ifndef wxNO_IMPLICIT_WXSTRING_ENCODING
   bool IsSameAs(const char *str, bool compareWithCase = true) const
     { return (compareWithCase ? Cmp(str) : CmpNoCase(str)) == 0; }
@@ -2283,6 +2405,39 @@ public:
       // it is not null; otherwise return false
   bool EndsWith(const wxString& suffix, wxString *rest = nullptr) const;
 
+      // versions of the functions above using views and not allocating
+      // anything, the returned rest refers to this string data
+  bool StartsWith(const wxStringView& prefix, wxStringView *rest) const
+  {
+      const wxStringView self(*this);
+      if ( !self.StartsWith(prefix) )
+          return false;
+
+      if ( rest )
+          *rest = self.substr(prefix.length());
+
+      return true;
+  }
+
+  bool EndsWith(const wxStringView& suffix, wxStringView *rest) const
+  {
+      const wxStringView self(*this);
+      if ( !self.EndsWith(suffix) )
+          return false;
+
+      if ( rest )
+          *rest = self.substr(0, self.length() - suffix.length());
+
+      return true;
+  }
+
+      // get the view of the part of this string between the given iterators
+  wxStringView GetView(const_iterator first, const_iterator last) const
+  {
+      return wxStringView(m_impl.data() + (first.impl() - m_impl.begin()),
+                          last.impl() - first.impl());
+  }
+
       // get first nCount characters
   wxString Left(size_t nCount) const;
       // get last nCount characters
@@ -2345,6 +2500,11 @@ public:
     const size_type idx = find(sub);
     return (idx == npos) ? wxNOT_FOUND : (int)idx;
   }
+  int Find(const wxStringView& sub) const
+  {
+    const size_type idx = m_impl.find(sub.data(), 0, sub.length());
+    return (idx == npos) ? wxNOT_FOUND : (int)PosFromImpl(idx);
+  }
 #ifndef wxNO_IMPLICIT_WXSTRING_ENCODING
   int Find(const char *sub) const               // like strstr
   {
@@ -2546,7 +2706,7 @@ public:
     // append elements str[pos], ..., str[pos+n]
   wxString& append(const wxString& str, size_t pos, size_t n)
   {
-      wxSTRING_UPDATE_CACHED_LENGTH(n);
+      wxSTRING_APPEND_UPDATE_CACHED_LENGTH(n);
 
       size_t from, len;
       str.PosLenToImpl(pos, n, &from, &len);
@@ -2556,7 +2716,7 @@ public:
     // append a string
   wxString& append(const wxString& str)
   {
-      wxSTRING_UPDATE_CACHED_LENGTH(str.length());
+      wxSTRING_APPEND_UPDATE_CACHED_LENGTH(str.length());
 
       m_impl.append(str.m_impl);
       return *this;
@@ -2566,7 +2726,7 @@ public:
 #ifndef wxNO_IMPLICIT_WXSTRING_ENCODING
   wxString& append(const char *sz)
   {
-      wxSTRING_INVALIDATE_CACHED_LENGTH();
+      wxSTRING_APPEND_INVALIDATE_CACHED_LENGTH();
 
       m_impl.append(ImplStr(sz));
       return *this;
@@ -2575,7 +2735,7 @@ public:
 
   wxString& append(const wchar_t *sz)
   {
-      wxSTRING_INVALIDATE_CACHED_LENGTH();
+      wxSTRING_APPEND_INVALIDATE_CACHED_LENGTH();
 
       m_impl.append(ImplStr(sz));
       return *this;
@@ -2584,7 +2744,7 @@ public:
 #ifndef wxNO_IMPLICIT_WXSTRING_ENCODING
   wxString& append(const char *sz, size_t n)
   {
-      wxSTRING_INVALIDATE_CACHED_LENGTH();
+      wxSTRING_APPEND_INVALIDATE_CACHED_LENGTH();
 
       SubstrBufFromMB str(ImplStr(sz, n));
       m_impl.append(str.data, str.len);
@@ -2593,7 +2753,7 @@ public:
 #endif // wxNO_IMPLICIT_WXSTRING_ENCODING
   wxString& append(const wchar_t *sz, size_t n)
   {
-      wxSTRING_UPDATE_CACHED_LENGTH(n);
+      wxSTRING_APPEND_UPDATE_CACHED_LENGTH(n);
 
       SubstrBufFromWC str(ImplStr(sz, n));
       m_impl.append(str.data, str.len);
@@ -2622,13 +2782,13 @@ public:
   {
       if ( wxStringOperations::IsSingleCodeUnitCharacter(ch) )
       {
-          wxSTRING_UPDATE_CACHED_LENGTH(n);
+          wxSTRING_APPEND_UPDATE_CACHED_LENGTH(n);
 
           m_impl.append(n, (wxStringCharType)ch);
       }
       else
       {
-          wxSTRING_INVALIDATE_CACHED_LENGTH();
+          wxSTRING_APPEND_INVALIDATE_CACHED_LENGTH();
 
           m_impl.append(wxStringOperations::EncodeNChars(n, ch));
       }
@@ -2648,7 +2808,7 @@ public:
     // append from first to last
   wxString& append(const_iterator first, const_iterator last)
   {
-      wxSTRING_INVALIDATE_CACHED_LENGTH();
+      wxSTRING_APPEND_INVALIDATE_CACHED_LENGTH();
 
       m_impl.append(first.impl(), last.impl());
       return *this;
@@ -3580,16 +3740,24 @@ public:
       // string += string
   wxString& operator+=(const wxString& s)
   {
-      wxSTRING_INVALIDATE_CACHED_LENGTH();
+      wxSTRING_APPEND_INVALIDATE_CACHED_LENGTH();
 
       m_impl += s.m_impl;
       return *this;
+  }
+      // string += string view
+  wxString& operator+=(const wxStringView& view)
+  {
+      wxSTRING_APPEND_INVALIDATE_CACHED_LENGTH();
+
+      m_impl.append(view.data(), view.length());
+      return *this;
   }
       // string += C string
 #ifndef wxNO_IMPLICIT_WXSTRING_ENCODING
   wxString& operator+=(const char *psz)
   {
-      wxSTRING_INVALIDATE_CACHED_LENGTH();
+      wxSTRING_APPEND_INVALIDATE_CACHED_LENGTH();
 
       m_impl += ImplStr(psz);
       return *this;
@@ -3597,14 +3765,14 @@ public:
 #endif // wxNO_IMPLICIT_WXSTRING_ENCODING
   wxString& operator+=(const wchar_t *pwz)
   {
-      wxSTRING_INVALIDATE_CACHED_LENGTH();
+      wxSTRING_APPEND_INVALIDATE_CACHED_LENGTH();
 
       m_impl += ImplStr(pwz);
       return *this;
   }
   wxString& operator+=(const wxCStrData& s)
   {
-      wxSTRING_INVALIDATE_CACHED_LENGTH();
+      wxSTRING_APPEND_INVALIDATE_CACHED_LENGTH();
 
       m_impl += s.AsString().m_impl;
       return *this;
@@ -3618,7 +3786,7 @@ public:
       // string += char
   wxString& operator+=(wxUniChar ch)
   {
-      wxSTRING_UPDATE_CACHED_LENGTH(1);
+      wxSTRING_APPEND_UPDATE_CACHED_LENGTH(1);
 
       if ( wxStringOperations::IsSingleCodeUnitCharacter(ch) )
           m_impl += (wxStringCharType)ch;
@@ -3648,9 +3816,16 @@ private:
   int DoPrintfUtf8(const char *format, ...);
   #endif
 
+  // common part of MakeLower() and MakeUpper(), only used in string.cpp
+  template <typename Converter>
+  void DoChangeCase();
+
 private:
   wxStringImpl m_impl;
 
+  // wxStringView needs to access the internal representation directly
+  friend class WXDLLIMPEXP_FWD_BASE wxStringView;
+
   // buffers for compatibility conversion from (char*)c_str() and
   // (wchar_t*)c_str(): the pointers returned by these functions should remain
   // valid until the string itself is modified for compatibility with the
@@ -4326,6 +4501,20 @@ void wxStringIteratorNode::clear()
 }
 #endif // wxUSE_UNICODE_UTF8
 
+// ----------------------------------------------------------------------------
+// wxStringView functions which need wxString declaration
+// ----------------------------------------------------------------------------
+
+inline wxStringView::wxStringView(const wxString& str)
+    : m_data(str.m_impl.data()), m_len(str.m_impl.length())
+{
+}
+
+inline wxString wxStringView::ToString() const
+{
+    return wxString(*this);
+}
+
 // ----------------------------------------------------------------------------
 // Checks on wxString characters
 // ----------------------------------------------------------------------------
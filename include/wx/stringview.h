@@ -0,0 +1,243 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/stringview.h
+// Purpose:     wxStringView class: non-owning reference to string data
+// Author:      wxWidgets team
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_STRINGVIEW_H_
+#define _WX_STRINGVIEW_H_
+
+// This header is included by wx/string.h and shouldn't be included directly.
+
+#include "wx/defs.h"
+#include "wx/chartype.h"
+#include "wx/buffer.h"
+
+#include <string>
+
+class WXDLLIMPEXP_FWD_BASE wxString;
+
+// ----------------------------------------------------------------------------
+// wxStringView: a pointer and a length of (a part of) some string
+// ----------------------------------------------------------------------------
+
+// The data is in wxString internal representation, i.e. wchar_t by default and
+// UTF-8 in wxUSE_UNICODE_UTF8 build, and all positions and lengths are in
+// units of wxStringCharType, which are not the same as characters in UTF-8
+// build.
+//
+// Notice that, unlike wxString, wxStringView can't be implicitly constructed
+// from a raw pointer to avoid ambiguities in the functions overloaded for both
+// wxString and wxStringView.
+class WXDLLIMPEXP_BASE wxStringView
+{
+public:
+    typedef wxStringCharType value_type;
+    typedef size_t size_type;
+    typedef const wxStringCharType* const_iterator;
+    typedef const_iterator iterator;
+
+    static const size_t npos;
+
+    wxStringView() : m_data(nullptr), m_len(0) { }
+
+    wxStringView(const wxStringCharType* data, size_t len)
+        : m_data(data), m_len(len)
+    {
+    }
+
+    explicit wxStringView(const wxStringCharType* data)
+        : m_data(data), m_len(data ? Traits::length(data) : 0)
+    {
+    }
+
+    explicit wxStringView(const wxScopedCharTypeBuffer<wxStringCharType>& buf)
+        : m_data(buf.data()), m_len(buf.length())
+    {
+    }
+
+    explicit wxStringView(const std::basic_string<wxStringCharType>& str)
+        : m_data(str.data()), m_len(str.length())
+    {
+    }
+
+    // This ctor is defined in wx/string.h.
+    inline wxStringView(const wxString& str);
+
+#ifdef wxHAS_STD_STRING_VIEW
+    explicit wxStringView(std::basic_string_view<wxStringCharType> view)
+        : m_data(view.data()), m_len(view.length())
+    {
+    }
+
+    operator std::basic_string_view<wxStringCharType>() const
+        { return std::basic_string_view<wxStringCharType>(m_data, m_len); }
+#endif // wxHAS_STD_STRING_VIEW
+
+    // Accessors.
+    const wxStringCharType* data() const { return m_data; }
+    size_t length() const { return m_len; }
+    size_t size() const { return m_len; }
+    bool empty() const { return m_len == 0; }
+
+    const_iterator begin() const { return m_data; }
+    const_iterator end() const { return m_data + m_len; }
+
+    wxStringCharType operator[](size_t n) const
+    {
+        wxASSERT_MSG( n < m_len, "invalid index in wxStringView" );
+
+        return m_data[n];
+    }
+
+    // Return a new string containing the same data.
+    inline wxString ToString() const;
+
+    // Return the view of the part of this one, n may be npos or, more
+    // generally, exceed the remaining length.
+    wxStringView substr(size_t pos, size_t n = npos) const
+    {
+        wxCHECK_MSG( pos <= m_len, wxStringView(), "invalid index in substr" );
+
+        return wxStringView(m_data + pos, n < m_len - pos ? n : m_len - pos);
+    }
+
+    void remove_prefix(size_t n)
+    {
+        wxASSERT_MSG( n <= m_len, "invalid length in remove_prefix" );
+
+        m_data += n;
+        m_len -= n;
+    }
+
+    void remove_suffix(size_t n)
+    {
+        wxASSERT_MSG( n <= m_len, "invalid length in remove_suffix" );
+
+        m_len -= n;
+    }
+
+    // Comparison.
+    int compare(const wxStringView& other) const
+    {
+        const size_t len = m_len < other.m_len ? m_len : other.m_len;
+        const int rc = len ? Traits::compare(m_data, other.m_data, len) : 0;
+        if ( rc )
+            return rc;
+
+        return m_len < other.m_len ? -1 : m_len > other.m_len ? 1 : 0;
+    }
+
+    bool IsSameAs(const wxStringView& other, bool caseSensitive = true) const
+    {
+        if ( caseSensitive )
+            return m_len == other.m_len && compare(other) == 0;
+
+        return DoIsSameAsNoCase(other);
+    }
+
+    bool StartsWith(const wxStringView& prefix) const
+    {
+        return prefix.m_len <= m_len &&
+                substr(0, prefix.m_len).compare(prefix) == 0;
+    }
+
+    bool EndsWith(const wxStringView& suffix) const
+    {
+        return suffix.m_len <= m_len &&
+                substr(m_len - suffix.m_len).compare(suffix) == 0;
+    }
+
+    // Searching: all functions return npos if nothing was found.
+    size_t find(wxStringCharType ch, size_t pos = 0) const
+    {
+        if ( pos >= m_len )
+            return npos;
+
+        const wxStringCharType* const
+            p = Traits::find(m_data + pos, m_len - pos, ch);
+
+        return p ? static_cast<size_t>(p - m_data) : npos;
+    }
+
+    size_t find(const wxStringView& sub, size_t pos = 0) const;
+
+    size_t rfind(wxStringCharType ch, size_t pos = npos) const
+    {
+        if ( !m_len )
+            return npos;
+
+        for ( size_t n = pos < m_len ? pos + 1 : m_len; n > 0; n-- )
+        {
+            if ( Traits::eq(m_data[n - 1], ch) )
+                return n - 1;
+        }
+
+        return npos;
+    }
+
+    size_t find_first_of(const wxStringView& chars, size_t pos = 0) const
+    {
+        for ( size_t n = pos; n < m_len; n++ )
+        {
+            if ( chars.find(m_data[n]) != npos )
+                return n;
+        }
+
+        return npos;
+    }
+
+    size_t find_first_not_of(const wxStringView& chars, size_t pos = 0) const
+    {
+        for ( size_t n = pos; n < m_len; n++ )
+        {
+            if ( chars.find(m_data[n]) == npos )
+                return n;
+        }
+
+        return npos;
+    }
+
+    // Conversions to numbers, with the same semantics as the wxString
+    // functions with the same names.
+    bool ToLong(long *val, int base = 10) const;
+    bool ToULong(unsigned long *val, int base = 10) const;
+    bool ToDouble(double *val) const;
+
+private:
+    typedef std::char_traits<wxStringCharType> Traits;
+
+    bool DoIsSameAsNoCase(const wxStringView& other) const;
+
+    const wxStringCharType* m_data;
+    size_t m_len;
+};
+
+inline bool operator==(const wxStringView& v1, const wxStringView& v2)
+    { return v1.IsSameAs(v2); }
+inline bool operator!=(const wxStringView& v1, const wxStringView& v2)
+    { return !v1.IsSameAs(v2); }
+inline bool operator<(const wxStringView& v1, const wxStringView& v2)
+    { return v1.compare(v2) < 0; }
+inline bool operator>(const wxStringView& v1, const wxStringView& v2)
+    { return v1.compare(v2) > 0; }
+inline bool operator<=(const wxStringView& v1, const wxStringView& v2)
+    { return v1.compare(v2) <= 0; }
+inline bool operator>=(const wxStringView& v1, const wxStringView& v2)
+    { return v1.compare(v2) >= 0; }
+
+// Comparison with raw strings needs to be defined separately as there is no
+// implicit conversion from them.
+inline bool operator==(const wxStringView& v, const wxStringCharType* s)
+    { return v.IsSameAs(wxStringView(s)); }
+inline bool operator==(const wxStringCharType* s, const wxStringView& v)
+    { return v.IsSameAs(wxStringView(s)); }
+inline bool operator!=(const wxStringView& v, const wxStringCharType* s)
+    { return !v.IsSameAs(wxStringView(s)); }
+inline bool operator!=(const wxStringCharType* s, const wxStringView& v)
+    { return !v.IsSameAs(wxStringView(s)); }
+
+#endif // _WX_STRINGVIEW_H_
@@ -29,6 +29,7 @@
 #include "wx/buffer.h"
 #include "wx/unichar.h"
 
+#include <initializer_list>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -40,6 +41,8 @@
 class WXDLLIMPEXP_FWD_BASE wxCStrData;
 class WXDLLIMPEXP_FWD_BASE wxString;
 
+struct wxFormatStringInfo;
+
 // There are a lot of structs with intentionally private ctors in this file,
 // suppress gcc warnings about this.
 wxGCC_WARNING_SUPPRESS(ctor-dtor-privacy)
@@ -207,8 +210,9 @@ public:
         Arg_Unknown     = 0x8000     // unrecognized specifier (likely error)
     };
 
-    // Validate all format string parameters at once: the vector contains the
+    // Validate all format string parameters at once: the list contains the
     // format specifiers corresponding to the actually given arguments.
+    void Validate(std::initializer_list<int> argTypes) const;
     void Validate(const std::vector<int>& argTypes) const;
 
     // returns the type of format specifier for n-th variadic argument (this is
@@ -245,6 +249,10 @@ private:
 #endif // !wxUSE_UTF8_LOCALE_ONLY
 
 private:
+    // Returns the information about this format string, which is cached to
+    // avoid parsing the same format string every time it's used.
+    wxFormatStringInfo& GetInfo() const;
+
     wxScopedCharBuffer  m_char;
     wxScopedWCharBuffer m_wchar;
 
@@ -354,6 +362,11 @@ struct wxFormatStringArgumentFinder<wxWCharBuffer>
 
     // Also provide a trivial implementation of Validate() doing nothing in
     // this case.
+    inline void
+    wxFormatString::Validate(std::initializer_list<int> WXUNUSED(argTypes)) const
+    {
+    }
+
     inline void
     wxFormatString::Validate(const std::vector<int>& WXUNUSED(argTypes)) const
     {
@@ -47,6 +47,89 @@ private:
     wxDECLARE_NO_COPY_CLASS(wxTextFile);
 };
 
+// ----------------------------------------------------------------------------
+// wxTextFileReader: reads the lines of a text file one by one
+// ----------------------------------------------------------------------------
+
+// Unlike wxTextFile, this class doesn't load the entire file in memory but
+// reads and decodes it in chunks of fixed size and returns the lines as views
+// into the decoded chunk, so that the memory used by it doesn't depend on the
+// file size.
+class WXDLLIMPEXP_BASE wxTextFileReader
+{
+public:
+    // The file must be opened for reading and remain opened while this
+    // object is used.
+    explicit wxTextFileReader(wxFile& file, const wxMBConv& conv = wxConvAuto());
+    ~wxTextFileReader();
+
+    // Get the next line, without the line terminator, and, optionally, its
+    // type. Return false if there are no more lines or if an error occurred.
+    //
+    // The returned view is only valid until the next call to this function.
+    bool GetNextLine(wxStringView* line, wxTextFileType* type = nullptr);
+
+    // Return true if reading stopped due to an error and not end of file.
+    bool Error() const { return m_error; }
+
+    // Return true if wxConvAuto switched to its fallback encoding after some
+    // non-ASCII text had been already returned decoded as UTF-8.
+    bool EncodingChanged() const { return m_encodingChanged; }
+
+    // Restart reading from the initial position in the file, keeping the
+    // encoding currently used by the conversion.
+    bool Rewind();
+
+private:
+    // Read and decode the next part of the file, return false if there is
+    // nothing more to read.
+    bool ReadMore();
+
+    // Find out the code unit size and the representation of CR and LF in the
+    // encoding used, return false if it's not possible to do it yet.
+    bool InitEOL();
+
+    // Return the offset just after the last line terminator in the given
+    // bytes or 0 if there is none. Only the bytes starting from the last
+    // code unit before "from" need to be examined, as the previous ones had
+    // been already checked.
+    size_t FindLastEOL(const char* data, size_t len, size_t from) const;
+
+
+    wxFile& m_file;
+    wxMBConv* const m_conv;
+
+    // Position in the file at which we started reading.
+    const wxFileOffset m_start;
+
+    // Raw data read from the file but not decoded yet: this is always just
+    // the beginning of a line.
+    wxMemoryBuffer m_raw;
+
+    // Decoded text containing only complete lines and the part of it which
+    // hasn't been returned yet.
+    wxString m_text;
+    wxStringView m_rest;
+
+    // Size of a code unit in the file encoding and the representations of CR
+    // and LF in it or 0 if not determined yet.
+    size_t m_unitLen;
+    char m_cr[4],
+         m_lf[4];
+
+    bool m_started,
+         m_eof,
+         m_error;
+
+    // True if any non-ASCII text was decoded as UTF-8 by wxConvAuto, which
+    // could still switch to its fallback encoding later.
+    bool m_nonASCII;
+
+    bool m_encodingChanged;
+
+    wxDECLARE_NO_COPY_CLASS(wxTextFileReader);
+};
+
 #else // !wxUSE_TEXTFILE
 
 // old code relies on the static methods of wxTextFile being always available
@@ -0,0 +1,395 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/threadpool.h
+// Purpose:     wxThreadPool, wxTaskGroup and wxFuture classes
+// Author:      wxWidgets team
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_THREADPOOL_H_
+#define _WX_THREADPOOL_H_
+
+#include "wx/defs.h"
+
+#if wxUSE_THREADS
+
+#include "wx/event.h"
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#if wxUSE_EXCEPTIONS
+    #include <exception>
+#endif
+
+class WXDLLIMPEXP_FWD_BASE wxTaskGroup;
+class WXDLLIMPEXP_FWD_BASE wxThreadPool;
+
+// Event sent to the handler specified with wxFuture::NotifyOnCompletion().
+wxDECLARE_EXPORTED_EVENT(WXDLLIMPEXP_BASE, wxEVT_TASK_COMPLETED, wxThreadEvent);
+
+// Possible states of a task.
+enum wxTaskStatus
+{
+    wxTASK_PENDING,     // Waiting to be executed.
+    wxTASK_RUNNING,     // Currently executing.
+    wxTASK_DONE,        // Finished executing.
+    wxTASK_CANCELLED    // Cancelled before it could start executing.
+};
+
+namespace wxPrivate
+{
+
+// Base class for all tasks, containing everything not depending on the task
+// function and its result type.
+class WXDLLIMPEXP_BASE wxTaskBase
+{
+public:
+    virtual ~wxTaskBase() = default;
+
+    wxTaskStatus GetStatus() const
+    {
+        return static_cast<wxTaskStatus>(m_status.load());
+    }
+
+    bool IsFinished() const
+    {
+        const wxTaskStatus status = GetStatus();
+        return status == wxTASK_DONE || status == wxTASK_CANCELLED;
+    }
+
+    // Cancel the task if it hasn't started running yet.
+    bool Cancel();
+
+    // Wait until the task finishes, return true if it was executed or false
+    // if it was cancelled.
+    bool Wait();
+
+    // Post wxEVT_TASK_COMPLETED to the given handler when the task finishes.
+    void NotifyOnCompletion(wxEvtHandler* handler, int id);
+
+    // Called by wxThreadPool to execute the task.
+    void Execute();
+
+    // Rethrow the exception thrown by the task function, if any.
+    void RethrowIfFailed();
+
+protected:
+    wxTaskBase(wxThreadPool& pool, wxTaskGroup* group)
+        : m_pool(pool),
+          m_group(group),
+          m_status(wxTASK_PENDING),
+          m_handler(nullptr),
+          m_id(wxID_ANY),
+          m_notified(false)
+    {
+    }
+
+    virtual void DoExecute() = 0;
+
+private:
+    void Finish();
+    void DoNotify();
+
+    wxThreadPool& m_pool;
+    wxTaskGroup* const m_group;
+
+    std::atomic<int> m_status;
+
+    std::atomic<wxEvtHandler*> m_handler;
+    int m_id;
+    std::atomic<bool> m_notified;
+
+#if wxUSE_EXCEPTIONS
+    // The exception thrown by DoExecute(), it is set before changing the
+    // status to wxTASK_DONE and so can be accessed after it without locking.
+    std::exception_ptr m_exception;
+#endif // wxUSE_EXCEPTIONS
+
+    wxDECLARE_NO_COPY_CLASS(wxTaskBase);
+};
+
+// Intermediate class containing the task result.
+template <typename R>
+class wxTaskResult : public wxTaskBase
+{
+public:
+    R& GetResult() { return m_result; }
+
+protected:
+    wxTaskResult(wxThreadPool& pool, wxTaskGroup* group)
+        : wxTaskBase(pool, group),
+          m_result()
+    {
+    }
+
+    R m_result;
+};
+
+template <>
+class wxTaskResult<void> : public wxTaskBase
+{
+public:
+    void GetResult() { }
+
+protected:
+    wxTaskResult(wxThreadPool& pool, wxTaskGroup* group)
+        : wxTaskBase(pool, group)
+    {
+    }
+};
+
+// Finally the class storing the task function itself.
+template <typename R, typename F>
+class wxTask : public wxTaskResult<R>
+{
+public:
+    wxTask(wxThreadPool& pool, wxTaskGroup* group, F&& func)
+        : wxTaskResult<R>(pool, group),
+          m_func(std::move(func))
+    {
+    }
+
+protected:
+    virtual void DoExecute() override { this->m_result = m_func(); }
+
+private:
+    F m_func;
+};
+
+template <typename F>
+class wxTask<void, F> : public wxTaskResult<void>
+{
+public:
+    wxTask(wxThreadPool& pool, wxTaskGroup* group, F&& func)
+        : wxTaskResult<void>(pool, group),
+          m_func(std::move(func))
+    {
+    }
+
+protected:
+    virtual void DoExecute() override { m_func(); }
+
+private:
+    F m_func;
+};
+
+// Return type of the given task function.
+template <typename F>
+struct wxTaskReturnType
+{
+    typedef decltype(std::declval<F&>()()) Type;
+};
+
+} // namespace wxPrivate
+
+// ----------------------------------------------------------------------------
+// wxFuture: result of a task executed by wxThreadPool
+// ----------------------------------------------------------------------------
+
+template <typename T>
+class wxFuture
+{
+public:
+    // Default ctor creates an invalid object, use wxThreadPool::Submit() to
+    // create valid ones.
+    wxFuture() = default;
+
+    bool IsOk() const { return m_task != nullptr; }
+
+    wxTaskStatus GetStatus() const
+    {
+        wxCHECK_MSG( m_task, wxTASK_CANCELLED, "invalid future" );
+
+        return m_task->GetStatus();
+    }
+
+    bool IsFinished() const
+    {
+        wxCHECK_MSG( m_task, true, "invalid future" );
+
+        return m_task->IsFinished();
+    }
+
+    // Prevent the task from running if it hasn't started yet, returns true if
+    // it was cancelled or false if it's too late to do it.
+    bool Cancel()
+    {
+        wxCHECK_MSG( m_task, false, "invalid future" );
+
+        return m_task->Cancel();
+    }
+
+    // Block until the task finishes, returns true if it was executed and
+    // false if it was cancelled.
+    bool Wait()
+    {
+        wxCHECK_MSG( m_task, false, "invalid future" );
+
+        return m_task->Wait();
+    }
+
+    // Wait for the task completion and return its result or rethrow the
+    // exception thrown by it.
+    //
+    // The task must not have been cancelled.
+    T Get()
+    {
+        wxCHECK_MSG( m_task, T(), "invalid future" );
+
+        if ( !m_task->Wait() )
+        {
+            wxFAIL_MSG( "can't get the result of a cancelled task" );
+        }
+
+        m_task->RethrowIfFailed();
+
+        return m_task->GetResult();
+    }
+
+    // Post wxEVT_TASK_COMPLETED event with the given id to the handler when
+    // the task finishes, either normally or because it was cancelled.
+    void NotifyOnCompletion(wxEvtHandler* handler, int id = wxID_ANY)
+    {
+        wxCHECK_RET( m_task, "invalid future" );
+
+        m_task->NotifyOnCompletion(handler, id);
+    }
+
+private:
+    explicit wxFuture(const std::shared_ptr<wxPrivate::wxTaskResult<T>>& task)
+        : m_task(task)
+    {
+    }
+
+    std::shared_ptr<wxPrivate::wxTaskResult<T>> m_task;
+
+    friend class wxThreadPool;
+};
+
+// ----------------------------------------------------------------------------
+// wxThreadPool: fixed set of worker threads executing the submitted tasks
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxThreadPool
+{
+public:
+    // Create the pool with the given number of threads, 0 means to use the
+    // number of CPUs.
+    explicit wxThreadPool(int numThreads = 0);
+
+    // Waits until all the tasks are finished.
+    ~wxThreadPool();
+
+    // Return the global pool, creating it on first use.
+    static wxThreadPool& GetDefault();
+
+    // Set the number of threads used by the default pool, must be called
+    // before it is created.
+    static void SetDefaultThreadCount(int numThreads);
+
+    int GetThreadCount() const;
+
+    // Execute the given function in one of the pool threads.
+    template <typename F>
+    wxFuture<typename wxPrivate::wxTaskReturnType<F>::Type> Submit(F func)
+    {
+        return DoSubmit(nullptr, std::move(func));
+    }
+
+    // Return true if called from one of the threads of this pool.
+    bool IsWorkerThread() const;
+
+    // Implementation only from now on.
+    class Impl;
+
+private:
+    template <typename F>
+    wxFuture<typename wxPrivate::wxTaskReturnType<F>::Type>
+    DoSubmit(wxTaskGroup* group, F&& func)
+    {
+        typedef typename wxPrivate::wxTaskReturnType<F>::Type R;
+
+        std::shared_ptr<wxPrivate::wxTaskResult<R>>
+            task(std::make_shared<wxPrivate::wxTask<R, F>>(*this, group,
+                                                            std::move(func)));
+        Enqueue(task);
+
+        return wxFuture<R>(task);
+    }
+
+    void Enqueue(const std::shared_ptr<wxPrivate::wxTaskBase>& task);
+
+    // Wait until the given condition becomes true, executing other tasks in
+    // the meanwhile if called from a worker thread.
+    void WaitUntil(bool (*done)(const void*), const void* data);
+
+    // Wake up all the threads waiting in WaitUntil().
+    void NotifyWaiters();
+
+    std::unique_ptr<Impl> m_impl;
+
+    friend class wxPrivate::wxTaskBase;
+    friend class wxTaskGroup;
+
+    wxDECLARE_NO_COPY_CLASS(wxThreadPool);
+};
+
+// ----------------------------------------------------------------------------
+// wxTaskGroup: allows to wait for or cancel a group of related tasks
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxTaskGroup
+{
+public:
+    explicit wxTaskGroup(wxThreadPool& pool = wxThreadPool::GetDefault())
+        : m_pool(pool),
+          m_pending(0),
+          m_cancelled(false)
+    {
+    }
+
+    // Waits until all the tasks in the group are finished.
+    ~wxTaskGroup() { Wait(); }
+
+    wxThreadPool& GetPool() const { return m_pool; }
+
+    // Execute the given function as part of this group.
+    template <typename F>
+    wxFuture<typename wxPrivate::wxTaskReturnType<F>::Type> Run(F func)
+    {
+        m_pending++;
+
+        return m_pool.DoSubmit(this, std::move(func));
+    }
+
+    // Wait until all tasks of this group finish executing.
+    void Wait();
+
+    // Don't execute the tasks which haven't started yet and make IsCancelled()
+    // return true, to allow the already running tasks to stop too.
+    void Cancel() { m_cancelled = true; }
+
+    bool IsCancelled() const { return m_cancelled; }
+
+private:
+    // Called when a task of this group finishes.
+    void OnTaskFinished();
+
+    wxThreadPool& m_pool;
+
+    // The number of not yet finished tasks in this group.
+    std::atomic<int> m_pending;
+
+    std::atomic<bool> m_cancelled;
+
+    friend class wxPrivate::wxTaskBase;
+
+    wxDECLARE_NO_COPY_CLASS(wxTaskGroup);
+};
+
+#endif // wxUSE_THREADS
+
+#endif // _WX_THREADPOOL_H_
@@ -66,6 +66,10 @@ public:
     bool HasMoreTokens() const;
         // get the next token, will return empty string if !HasMoreTokens()
     wxString GetNextToken();
+        // same as GetNextToken() but returns a view of the tokenized string
+        // without allocating a new one, the view remains valid as long as
+        // this tokenizer object is not modified or destroyed
+    wxStringView GetNextTokenView();
         // get the delimiter which terminated the token last retrieved by
         // GetNextToken() or NUL if there had been no tokens yet or the last
         // one wasn't terminated (but ran to the end of the string)
@@ -84,6 +84,8 @@ class WXDLLIMPEXP_FWD_BASE wxArrayString;
 class WXDLLIMPEXP_FWD_BASE wxTranslationsLoader;
 class WXDLLIMPEXP_FWD_BASE wxLocale;
 
+class wxMsgCatalogFile;
+
 class wxPluralFormsCalculator;
 using wxPluralFormsCalculatorPtr = std::unique_ptr<wxPluralFormsCalculator>;
 
@@ -124,6 +126,10 @@ private:
     wxString                m_domain;   // name of the domain
 
     wxPluralFormsCalculatorPtr m_pluralFormsCalculator;
+
+    // if non-null, the messages are not stored in m_messages but retrieved
+    // from the catalog file on demand
+    std::unique_ptr<wxMsgCatalogFile> m_file;
 };
 
 // ----------------------------------------------------------------------------
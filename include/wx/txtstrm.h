@@ -107,10 +107,24 @@ protected:
     wchar_t m_lastWChar;
 #endif // SIZEOF_WCHAR_T == 2
 
+    // Raw bytes of the line being read by ReadLine(), only used when it can
+    // find the end of line without decoding the input, see ReadLineBytes().
+    wxMemoryBuffer m_lineBytes;
+
+    // True if we can read more data than needed from the stream and put the
+    // extra back, which is the case for the seekable streams, as this can't
+    // block waiting for more input.
+    bool m_canReadAhead;
+
     bool   EatEOL(const wxChar &c);
     void   UngetLast(); // should be used instead of wxInputStream::Ungetch() because of Unicode issues
     wxChar NextNonSeparators();
 
+    // Read the line without decoding it character by character, can only be
+    // used if CanReadLineBytes() returns true.
+    bool     CanReadLineBytes() const;
+    wxString ReadLineBytes();
+
     wxDECLARE_NO_COPY_CLASS(wxTextInputStream);
 };
 
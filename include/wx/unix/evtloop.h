@@ -18,6 +18,7 @@
 
 class wxEventLoopSource;
 class wxFDIODispatcher;
+class wxTimerFD;
 class wxWakeUpPipeMT;
 
 class WXDLLIMPEXP_BASE wxConsoleEventLoop
@@ -54,6 +55,9 @@ private:
     // either wxSelectDispatcher or wxEpollDispatcher
     wxFDIODispatcher *m_dispatcher;
 
+    // timerfd used for waiting for the timers if supported, may be null
+    wxTimerFD *m_timerFD;
+
     wxDECLARE_NO_COPY_CLASS(wxConsoleEventLoop);
 };
 
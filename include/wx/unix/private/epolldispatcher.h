@@ -16,6 +16,8 @@
 
 #include "wx/private/fdiodispatcher.h"
 
+#include <atomic>
+
 struct epoll_event;
 
 class WXDLLIMPEXP_BASE wxEpollDispatcher : public wxFDIODispatcher
@@ -36,6 +38,24 @@ public:
     virtual bool HasPending() const override;
     virtual int Dispatch(int timeout = TIMEOUT_INFINITE) override;
 
+    // statistics about the events dispatched by this object
+    struct Stats
+    {
+        // number of Dispatch() calls which dispatched at least one event
+        unsigned long wakeups = 0;
+
+        // total number of the events returned by epoll_wait()
+        unsigned long events = 0;
+
+        // maximal number of the events returned by a single epoll_wait() call
+        unsigned long maxEvents = 0;
+    };
+
+    // note that the returned value is a snapshot and as the dispatcher may
+    // be used by several threads at once, its fields may be not consistent
+    Stats GetStats() const;
+    void ResetStats();
+
 private:
     // ctor is private, use Create()
     wxEpollDispatcher(int epollDescriptor);
@@ -46,6 +66,14 @@ private:
 
 
     int m_epollDescriptor;
+
+    // the counters corresponding to Stats fields, they are updated from all
+    // the threads calling Dispatch()
+    std::atomic<unsigned long> m_wakeups,
+                               m_events,
+                               m_maxEvents;
+
+    wxDECLARE_NO_COPY_CLASS(wxEpollDispatcher);
 };
 
 #endif // wxUSE_EPOLL_DISPATCHER
@@ -14,7 +14,7 @@
 
 #include "wx/private/timer.h"
 
-#include <list>
+#include <vector>
 
 // the type used for milliseconds is large enough for microseconds too but
 // introduce a synonym for it to avoid confusion
@@ -47,6 +47,12 @@ public:
 
 private:
     bool m_isRunning;
+
+    // the position of this timer in wxTimerScheduler heap, only valid while
+    // the timer is running
+    size_t m_heapIndex;
+
+    friend class wxTimerScheduler;
 };
 
 // ----------------------------------------------------------------------------
@@ -55,21 +61,35 @@ private:
 
 struct wxTimerSchedule
 {
-    wxTimerSchedule(wxUnixTimerImpl *timer, wxUsecClock_t expiration)
+    wxTimerSchedule(wxUnixTimerImpl *timer,
+                    wxUsecClock_t expiration,
+                    wxUint64 order)
         : m_timer(timer),
-          m_expiration(expiration)
+          m_expiration(expiration),
+          m_order(order)
     {
     }
 
+    // the timers expiring at the same time are notified in the order in which
+    // they were added, as the heap is not stable this is ensured by comparing
+    // their insertion order too
+    bool ExpiresBefore(const wxTimerSchedule& other) const
+    {
+        if ( m_expiration != other.m_expiration )
+            return m_expiration < other.m_expiration;
+
+        return m_order < other.m_order;
+    }
+
     // the timer itself (we don't own this pointer)
     wxUnixTimerImpl *m_timer;
 
     // the time of its next expiration, in usec
     wxUsecClock_t m_expiration;
-};
 
-// the linked list of all active timers, we keep it sorted by expiration time
-using wxTimerList = std::list<wxTimerSchedule>;
+    // the sequential number of this schedule
+    wxUint64 m_order;
+};
 
 // ----------------------------------------------------------------------------
 // wxTimerScheduler: class responsible for updating all timers
@@ -113,6 +133,9 @@ public:
     // it returns false if there are no timers
     bool GetNext(wxUsecClock_t *remaining) const;
 
+    // same as GetNext() but returns the absolute time of the next expiration
+    bool GetNextExpiration(wxUsecClock_t *expiration) const;
+
     // trigger the timer event for all timers which have expired, return true
     // if any did
     bool NotifyExpired();
@@ -123,16 +146,79 @@ private:
     wxTimerScheduler() = default;
     ~wxTimerScheduler() = default;
 
-    // add the given timer schedule to the list in the right place
+    // add the given timer schedule to the heap
     void DoAddTimer(const wxTimerSchedule& s);
 
+    // remove the timer at the given position from the heap
+    void DoRemoveTimer(size_t n);
 
-    // the list of all currently active timers sorted by expiration
-    wxTimerList m_timers;
+    // functions restoring the heap property after changing the element at
+    // the given position
+    void SiftUp(size_t n);
+    void SiftDown(size_t n);
+
+    // store the schedule at the given position in the heap
+    void Place(size_t n, const wxTimerSchedule& s)
+    {
+        m_timers[n] = s;
+        s.m_timer->m_heapIndex = n;
+    }
+
+
+    // all currently active timers organized as a 4-ary min-heap ordered by
+    // expiration time: this makes adding and removing timers O(log(N)) while
+    // finding the next one to expire is still O(1)
+    std::vector<wxTimerSchedule> m_timers;
+
+    // the counter used for wxTimerSchedule::m_order
+    wxUint64 m_nextOrder = 0;
 
     static wxTimerScheduler *ms_instance;
 };
 
+#if wxUSE_EPOLL_DISPATCHER
+
+#include "wx/private/fdiohandler.h"
+
+// ----------------------------------------------------------------------------
+// wxTimerFD: timerfd used by the console event loop to wait for the timers
+// ----------------------------------------------------------------------------
+
+// Using timerfd allows to wait for the next timer expiration with microsecond
+// precision, instead of millisecond timeout, and to avoid computing the
+// timeout for each dispatcher call when the next expiration doesn't change.
+class wxTimerFD : public wxFDIOHandler
+{
+public:
+    // creates the timerfd, check IsOk() to see if it succeeded
+    wxTimerFD();
+    virtual ~wxTimerFD();
+
+    virtual bool IsOk() const override { return m_fd != -1; }
+
+    int GetFD() const { return m_fd; }
+
+    // arm the timer to expire at the next expiration of wxTimerScheduler
+    // timers or disarm it if there are none
+    void Update();
+
+    // wxFDIOHandler methods
+    virtual void OnReadWaiting() override;
+    virtual void OnWriteWaiting() override { }
+    virtual void OnExceptionWaiting() override { }
+
+private:
+    // the timerfd descriptor or -1
+    int m_fd;
+
+    // the absolute time at which the timer is currently armed or 0 if it isn't
+    wxUsecClock_t m_expiration;
+
+    wxDECLARE_NO_COPY_CLASS(wxTimerFD);
+};
+
+#endif // wxUSE_EPOLL_DISPATCHER
+
 #endif // wxUSE_TIMER
 
 #endif // _WX_UNIX_PRIVATE_TIMER_H_
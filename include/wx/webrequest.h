@@ -37,6 +37,7 @@ private:
 #if wxUSE_WEBREQUEST
 
 #include "wx/event.h"
+#include "wx/longlong.h"
 #include "wx/object.h"
 #include "wx/stream.h"
 #include "wx/versioninfo.h"
@@ -89,6 +90,15 @@ private:
 class WXDLLIMPEXP_NET wxWebResponse
 {
 public:
+    enum Timing
+    {
+        Timing_NameLookup,
+        Timing_Connect,
+        Timing_TLSHandshake,
+        Timing_FirstByte,
+        Timing_Total
+    };
+
     wxWebResponse();
     wxWebResponse(const wxWebResponse& other);
     wxWebResponse& operator=(const wxWebResponse& other);
@@ -118,6 +128,8 @@ public:
 
     wxString GetDataFile() const;
 
+    wxLongLong GetTiming(Timing timing) const;
+
 protected:
     // Ctor is used by wxWebRequest and implementation classes to create public
     // objects from the existing implementation pointers.
@@ -129,6 +141,16 @@ protected:
     wxWebResponseImplPtr m_impl;
 };
 
+class WXDLLIMPEXP_NET wxWebResponseConsumer
+{
+public:
+    virtual ~wxWebResponseConsumer() = default;
+
+    // Return false to pause the transfer, the same data will be passed to
+    // this function again after wxWebRequest::ResumeTransfer() is called.
+    virtual bool OnData(const void* data, size_t size) = 0;
+};
+
 class WXDLLIMPEXP_NET wxWebRequest
 {
 public:
@@ -168,6 +190,10 @@ public:
 
     Storage GetStorage() const;
 
+    bool SetDataConsumer(wxWebResponseConsumer* consumer);
+
+    void ResumeTransfer();
+
     void Start();
 
     void Cancel();
@@ -248,6 +274,14 @@ public:
 
     bool EnablePersistentStorage(bool enable = true);
 
+    bool SetMaxConnectionsPerHost(int maxConnections);
+
+    bool SetMaxConnections(int maxConnections);
+
+    bool EnableConnectionReuse(bool enable = true);
+
+    bool EnableMultiplexing(bool enable = true);
+
     wxWebSessionHandle GetNativeHandle() const;
 
 private:
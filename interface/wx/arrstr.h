@@ -203,7 +203,8 @@ public:
         is @false or from the end otherwise. If @a bCase, comparison is case sensitive
         (default), otherwise the case is ignored.
 
-        This function uses linear search for wxArrayString.
+        This function uses linear search for wxArrayString, use
+        wxArrayStringIndex if many searches in a big array need to be done.
         Returns the index of the first item matched or @c wxNOT_FOUND if there is no match.
     */
     int Index(const wxString& str, bool bCase = true, bool bFromEnd = false) const;
@@ -273,9 +274,26 @@ public:
     /**
         Sorts the array in alphabetical order or in reverse alphabetical order if
         @a reverseOrder is @true. The sort is case-sensitive.
+
+        This function compares the strings contents directly, without calling
+        any comparison function, and so is significantly faster than sorting
+        the array using wxStringSortAscending() with the overload below.
     */
     void Sort(bool reverseOrder = false);
 
+    /**
+        Sorts the array in case-insensitive alphabetical order or in reverse
+        order if @a reverseOrder is @true.
+
+        The strings differing in case only are sorted in case-sensitive order,
+        i.e. the result is the same as when sorting using
+        wxDictionaryStringSortAscending() or wxDictionaryStringSortDescending(),
+        but this function is much faster for big arrays.
+
+        @since 3.3.0
+    */
+    void SortNoCase(bool reverseOrder = false);
+
     /**
         Sorts the array using the specified @a compareFunction for item comparison.
         @a CompareFunction is defined as a function taking two <em>const wxString&</em>
@@ -390,6 +408,18 @@ public:
     */
     size_t Add(const wxString& str, size_t copies = 1);
 
+    /**
+        Adds all the given strings to the array.
+
+        This function appends all the strings at once and then sorts them and
+        merges them with the existing array elements, which takes
+        O(N&nbsp;log(N)) time instead of O(N<sup>2</sup>) needed for adding
+        the strings one by one using Add(), so it should be preferred when
+        building big sorted arrays.
+
+        @since 3.3.0
+    */
+    void Merge(const wxArrayString& strings);
 
     /**
         @copydoc wxArrayString::Index()
@@ -420,10 +450,72 @@ public:
         @warning In STL mode, Sort is private and simply invokes wxFAIL_MSG.
     */
     void Sort(bool reverseOrder = false);
+    void SortNoCase(bool reverseOrder = false);
     void Sort(CompareFunction compareFunction);
     ///@}
 };
 
+/**
+    @class wxArrayStringIndex
+
+    Hash index allowing to find strings in a wxArrayString in constant time.
+
+    wxArrayString::Index() uses linear search, which is too slow if the array
+    is big and needs to be searched many times. This class can be used to
+    build a hash table of the array strings once and then find the strings in
+    it much faster:
+    @code
+    wxArrayString symbols = ...;
+    wxArrayStringIndex index(symbols);
+    for ( const auto& name : names )
+    {
+        if ( index.Index(name) == wxNOT_FOUND )
+            ... name is not present in symbols ...
+    }
+    @endcode
+
+    Note that the index refers to the array it was created for, which must
+    exist for as long as the index is used, and doesn't update automatically
+    when the array changes, so Rebuild() must be called after modifying it.
+
+    @library{wxbase}
+    @category{containers}
+
+    @see wxSortedArrayString
+
+    @since 3.3.0
+*/
+class wxArrayStringIndex
+{
+public:
+    /**
+        Creates the index of the strings in the given array.
+
+        If @a bCase is @false, Index() ignores the case of the strings.
+    */
+    explicit wxArrayStringIndex(const wxArrayString& array, bool bCase = true);
+
+    /**
+        Updates the index after modifying the array.
+
+        This takes time proportional to the array size.
+    */
+    void Rebuild();
+
+    /**
+        Returns the index of the first occurrence of the string in the array.
+
+        This function returns the same value as wxArrayString::Index() called
+        with the same string and @a bCase parameter passed to the constructor
+        of this object, but works in constant time.
+
+        It returns @c wxNOT_FOUND if the string is not found or if the array
+        has changed since the last call to Rebuild(), which is also an error
+        resulting in an assert failure.
+    */
+    int Index(const wxString& str) const;
+};
+
 /**
     Comparison function comparing strings in alphabetical order.
 
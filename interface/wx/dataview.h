@@ -679,6 +679,133 @@ public:
 };
 
 
+/**
+    @class wxDataViewFilterListModel
+
+    wxDataViewFilterListModel is a list model showing only some of the rows of
+    another list model, called the source model.
+
+    This class is abstract, the derived class must implement IsRowShown() to
+    define which rows of the source model should be shown, e.g.
+    @code
+    class MyFilterModel : public wxDataViewFilterListModel
+    {
+    public:
+        explicit MyFilterModel(wxDataViewListModel* source)
+            : wxDataViewFilterListModel(source)
+        {
+        }
+
+        void SetSearchString(const wxString& search)
+        {
+            const wxString searchLower = search.Lower();
+            const bool refine = searchLower.StartsWith(m_search);
+            m_search = searchLower;
+
+            // If the new search string extends the old one, only the rows
+            // which were already shown need to be checked.
+            if ( refine )
+                RefineFilter();
+            else
+                Refilter();
+        }
+
+        bool IsRowShown(unsigned int sourceRow) const override
+        {
+            wxVariant value;
+            GetSourceModel()->GetValueByRow(value, sourceRow, 0);
+            return value.GetString().Lower().Contains(m_search);
+        }
+
+    private:
+        wxString m_search;
+    };
+    @endcode
+
+    The changes to the source model are automatically reflected in this model
+    as long as the source model notifies about them in the usual way, e.g. by
+    calling wxDataViewVirtualListModel::RowValueChanged(). The filter is only
+    re-evaluated for the rows which have changed or were added, while deleting
+    rows from the source model doesn't require re-evaluating it at all. The
+    only exception is deleting rows from wxDataViewIndexListModel, as the
+    indices of the deleted rows can't be determined in this case and so the
+    filter is re-evaluated for all the rows.
+
+    Note that the order of the rows in this model is always the same as in the
+    source model.
+
+    @library{wxcore}
+    @category{dvc}
+
+    @since 3.3.0
+*/
+class wxDataViewFilterListModel : public wxDataViewVirtualListModel
+{
+public:
+    /**
+        Constructor.
+
+        Initially all the rows of the source model are shown, call Refilter()
+        to apply the filter after constructing the object.
+
+        @param source
+            The source model, must be non-null. Its reference count is
+            incremented by this object and decremented when it is destroyed.
+    */
+    explicit wxDataViewFilterListModel(wxDataViewListModel* source);
+
+    /**
+        Returns the source model specified in the constructor.
+    */
+    wxDataViewListModel* GetSourceModel() const;
+
+    /**
+        Must be overridden to return @true if the given row of the source model
+        should be shown.
+    */
+    virtual bool IsRowShown(unsigned int sourceRow) const = 0;
+
+    /**
+        Re-evaluate the filter for all the rows of the source model.
+
+        Call this function when the filter changes in an arbitrary way.
+    */
+    void Refilter();
+
+    /**
+        Re-evaluate the filter for the currently shown rows only.
+
+        This function is much faster than Refilter() when the filter matches
+        only a small subset of the rows, but can only be used when the new
+        filter is more restrictive than the previous one, i.e. when all the
+        rows passing the new filter also passed the old one. A typical example
+        is appending a character to the string being searched for.
+    */
+    void RefineFilter();
+
+    /**
+        Show all the rows of the source model.
+
+        This function doesn't call IsRowShown() at all.
+    */
+    void ResetFilter();
+
+    /**
+        Returns the index of the row of the source model shown at the given
+        row of this model.
+    */
+    unsigned int GetSourceRow(unsigned int row) const;
+
+    /**
+        Returns the row of this model showing the given row of the source
+        model or @c wxNOT_FOUND if it is not shown.
+
+        This function uses binary search and so is relatively efficient.
+    */
+    int FindRow(unsigned int sourceRow) const;
+};
+
+
 
 /**
     @class wxDataViewItemAttr
@@ -1645,6 +1772,43 @@ public:
      */
     bool SetAlternateRowColour(const wxColour& colour);
 
+    /**
+        Extend the range of rows in wxEVT_DATAVIEW_CACHE_HINT events.
+
+        By default, the cache hint events are sent every time the control is
+        repainted and only contain the rows being repainted. If this function
+        is called with non-zero @a count, the range of rows is extended by
+        this number of rows on both sides, allowing the application to start
+        fetching the data for the rows which will soon become visible when
+        scrolling, and the cache hint events are not sent again as long as
+        the rows being painted remain inside the range of the last event.
+
+        This is mostly useful with wxDataViewVirtualListModel when getting
+        the data is slow: in this case the model can return placeholder
+        values for the rows whose data is not available yet, start fetching
+        it in a worker thread and call NotifyRowsReady() when it is done.
+
+        @note This function is only available in the generic version.
+
+        @since 3.3.0
+     */
+    void SetCacheHintLookAhead(unsigned int count);
+
+    /**
+        Refresh the rows whose data has become available.
+
+        Unlike the other methods of this class, this one may be called from
+        any thread, typically the one fetching the data after receiving a
+        cache hint event, see SetCacheHintLookAhead(). The rows are refreshed
+        later by the main thread and multiple notifications received in the
+        meanwhile are merged together.
+
+        @note This function is only available in the generic version.
+
+        @since 3.3.0
+     */
+    void NotifyRowsReady(unsigned int from, unsigned int to);
+
     /**
         Set which column shall contain the tree-like expanders.
     */
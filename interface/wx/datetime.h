@@ -1096,6 +1096,43 @@ public:
     */
     bool ParseISOTime(const wxString& date);
 
+    /**
+        Parses the date in ISO 8601 format @c "YYYY-MM-DD" from the characters
+        in [@a date, @a end) range of a char buffer.
+
+        This overload is useful for parsing dates stored in a larger buffer,
+        e.g. a field of a CSV file or a JSON document, and is much faster than
+        the one taking wxString as it doesn't allocate any memory.
+
+        @return @true if the entire range was parsed successfully, @false
+                 otherwise.
+
+        @since 3.3.0
+    */
+    bool ParseISODate(const char* date, const char* end);
+
+    /**
+        Parses the time in ISO 8601 format @c "HH:MM:SS" from the characters
+        in [@a time, @a end) range of a char buffer.
+
+        @see ParseISODate(const char*, const char*)
+
+        @since 3.3.0
+    */
+    bool ParseISOTime(const char* time, const char* end);
+
+    /**
+        Parses the date and time in ISO 8601 combined format
+        @c "YYYY-MM-DDTHH:MM:SS" from the characters in [@a datetime, @a end)
+        range of a char buffer.
+
+        @see ParseISODate(const char*, const char*)
+
+        @since 3.3.0
+    */
+    bool ParseISOCombined(const char* datetime, const char* end,
+                          char sep = 'T');
+
     /**
         Parses the string @a date looking for a date formatted according to the
         RFC 822 in it. The exact description of this format may, of course, be
@@ -1119,6 +1156,33 @@ public:
     */
     bool ParseRfc822Date(const wxString& date, wxString::const_iterator *end);
 
+    /**
+        Parses the string @a date looking for a date formatted according to
+        RFC 3339, i.e. the Internet profile of ISO 8601, such as
+        @c "2024-02-29T13:14:15.678+01:00" or @c "2024-02-29 12:14:15Z".
+
+        The fractional part of seconds is optional and only its first 3 digits
+        are taken into account, the time zone offset (either @c "Z" or a
+        numeric one) must be always specified.
+
+        See ParseFormat() for the description of function parameters and return
+        value.
+
+        @since 3.3.0
+    */
+    bool ParseRfc3339Date(const wxString& date, wxString::const_iterator *end);
+
+    /**
+        Parses the date in RFC 3339 format from the characters in
+        [@a date, @a end) range of a char buffer without allocating any memory.
+
+        @return The pointer to the character following the parsed part of the
+            buffer or @NULL if parsing failed.
+
+        @since 3.3.0
+    */
+    const char* ParseRfc3339Date(const char* date, const char* end);
+
     /**
         This functions is like ParseDateTime(), but only allows the time to be
         specified in the input string.
@@ -1662,6 +1726,90 @@ public:
     static wxDateTime UNow();
 };
 
+/**
+    @class wxDateTimeFormat
+
+    Format string for wxDateTime::Format() and wxDateTime::ParseFormat()
+    analysed only once.
+
+    When formatting or parsing many dates using the same custom format, it is
+    more efficient to create an object of this class once and then use its
+    Format() and Parse() methods instead of calling the corresponding
+    wxDateTime functions, which interpret the format string anew every time.
+
+    Only the numeric specifiers, i.e. @c "%Y", @c "%y", @c "%m", @c "%d",
+    @c "%H", @c "%M", @c "%S", @c "%l" as well as @c "%F" and @c "%T", are
+    handled specially. Formats using any other specifiers still work, but are
+    not any faster than using wxDateTime functions directly.
+
+    Example:
+    @code
+        const wxDateTimeFormat fmt("%d/%m/%Y %H:%M");
+        for ( const auto& dt : dates )
+            file.AddLine(fmt.Format(dt));
+    @endcode
+
+    @library{wxbase}
+    @category{data}
+
+    @since 3.3.0
+*/
+class wxDateTimeFormat
+{
+public:
+    /**
+        Creates the object for the given format string.
+
+        See wxDateTime::Format() for the description of the format.
+    */
+    explicit wxDateTimeFormat(const wxString& format);
+
+    /**
+        Returns the format string passed to the constructor.
+    */
+    const wxString& GetFormat() const;
+
+    /**
+        Formats the date in the given time zone.
+
+        This is the same as @c dt.Format(GetFormat(), tz).
+    */
+    wxString Format(const wxDateTime& dt,
+                    const wxDateTime::TimeZone& tz = wxDateTime::Local) const;
+
+    /**
+        Parses the date using this format.
+
+        This is the same as @c dt.ParseFormat(date, GetFormat(), dateDef, end).
+    */
+    bool Parse(wxDateTime& dt,
+               const wxString& date,
+               const wxDateTime& dateDef,
+               wxString::const_iterator *end) const;
+
+    /**
+        @overload
+    */
+    bool Parse(wxDateTime& dt,
+               const wxString& date,
+               wxString::const_iterator *end) const;
+
+    /**
+        Parses the date in the characters in [@a date, @a end) range of a char
+        buffer.
+
+        This overload doesn't allocate any memory if the format contains only
+        the specifiers handled by this class and ASCII characters.
+
+        @return The pointer to the character following the parsed part of the
+            buffer or @NULL if parsing failed.
+    */
+    const char* Parse(wxDateTime& dt,
+                      const char* date,
+                      const char* end,
+                      const wxDateTime& dateDef = wxDefaultDateTime) const;
+};
+
 /**
     Global instance of an empty wxDateTime object.
 
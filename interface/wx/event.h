@@ -416,8 +416,8 @@ public:
         moment).
 
         QueueEvent() can be used for inter-thread communication from the worker
-        threads to the main thread, it is safe in the sense that it uses
-        locking internally and avoids the problem mentioned in AddPendingEvent()
+        threads to the main thread, it is safe in the sense that it can be
+        called from any thread and avoids the problem mentioned in AddPendingEvent()
         documentation by ensuring that the @a event object is not used by the
         calling thread any more. Care should still be taken to avoid that some
         fields of this object are used by it, notably any wxString members of
@@ -484,6 +484,68 @@ public:
     */
     virtual void AddPendingEvent(const wxEvent& event);
 
+    /**
+        Queue event for a later processing, replacing the previously queued
+        one with the same type and ID.
+
+        This function works like QueueEvent() and can also be called from any
+        thread, but if an event with the same type and ID was queued for this
+        handler using this function and hasn't been processed yet, the new
+        event replaces it and only the new one will be processed.
+
+        This is useful for the events carrying some state, e.g. the progress
+        of a long operation performed by a worker thread, when only the latest
+        value matters and processing all the intermediate ones would be just a
+        waste of time, e.g.:
+        @code
+            void MyWorkerThread::ReportProgress(int percent)
+            {
+                wxThreadEvent* evt = new wxThreadEvent(wxEVT_THREAD, ID_PROGRESS);
+                evt->SetInt(percent);
+                m_frame->QueueCoalescedEvent(evt);
+            }
+        @endcode
+
+        Use SetCoalescedEventMinInterval() to additionally limit the rate at
+        which such events are processed.
+
+        @since 3.3.0
+
+        @param event
+            A heap-allocated event to be queued, this function takes ownership
+            of it. This parameter shouldn't be @NULL.
+     */
+    void QueueCoalescedEvent(wxEvent *event);
+
+    /**
+        Set the minimal interval between processing the coalesced events with
+        the given type and ID.
+
+        After an event queued using QueueCoalescedEvent() is processed, the
+        events of the same type and with the same ID won't be processed until
+        the given interval expires. Any events queued before then are
+        coalesced and only the last of them is processed as soon as the
+        interval expires, so the latest event is never lost.
+
+        Delaying the events processing relies on wxTimer and so is only
+        available if @c wxUSE_TIMER is 1 and requires a running event loop.
+
+        This function can be called from any thread.
+
+        @since 3.3.0
+
+        @param eventType
+            The type of the events to limit.
+        @param winid
+            The ID of the events to limit.
+        @param milliseconds
+            The minimal interval between processing the events or 0 to remove
+            the limit, which is the default.
+     */
+    void SetCoalescedEventMinInterval(wxEventType eventType,
+                                      int winid,
+                                      int milliseconds);
+
     /**
          Asynchronously call the given method.
 
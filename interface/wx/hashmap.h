@@ -79,6 +79,12 @@
     any kind of pointer.
     Similarly three equality predicates: @c wxIntegerEqual, @c wxStringEqual,
     @c wxPointerEqual are provided.
+
+    Additionally, @c wxStringHashNoCase and @c wxStringEqualNoCase can be used
+    for the maps with wxString keys which should be compared case-insensitively,
+    in the same way as wxString::CmpNoCase() does (these types are available
+    since wxWidgets 3.3.0).
+
     Using this you could declare a hash map mapping int values to wxString like this:
 
     @code
@@ -80,6 +80,39 @@ public:
     */
     bool Disconnect();
 
+    /**
+        Starts batching the messages sent over this connection.
+
+        All messages sent after this call, e.g. using Execute(), Poke() or
+        RequestAsync(), are buffered and only sent to the other side when
+        EndBatch() is called. This allows to send many small messages much
+        more efficiently than sending each of them separately.
+
+        Note that calling any synchronous function, such as Request(), sends
+        all the messages buffered so far, as it needs to wait for the reply.
+
+        The calls to this function can be nested, the messages are only sent
+        when EndBatch() matching the outermost BeginBatch() call is called.
+
+        Batching is only supported by wxTCPConnection, this function does
+        nothing for wxDDEConnection.
+
+        @since 3.3.0
+    */
+    void BeginBatch();
+
+    /**
+        Ends batching the messages started by BeginBatch().
+
+        Sends all the messages buffered since the outermost BeginBatch() call
+        to the other side.
+
+        @return @true if successful, @false if sending the messages failed.
+
+        @since 3.3.0
+    */
+    bool EndBatch();
+
     ///@{
     /**
         Called by the client application to execute a command on the server.
@@ -144,6 +177,31 @@ public:
                                   size_t* size,
                                   wxIPCFormat format);
 
+    /**
+        Message sent to the client application when the reply to the request
+        made using RequestAsync() is received.
+
+        The requests are handled by the server in the order in which they
+        were made, so the replies are received in the same order too.
+
+        @param requestId
+            The ID returned by RequestAsync() for this request.
+        @param data
+            The data returned by the server OnRequest(), only valid until
+            this function returns. This pointer is @NULL if the request
+            failed, e.g. because OnRequest() returned @NULL.
+        @param size
+            The size of @a data, 0 if it is @NULL.
+        @param format
+            The format of @a data, @c wxIPC_INVALID if it is @NULL.
+
+        @since 3.3.0
+    */
+    virtual bool OnRequestReply(int requestId,
+                                const void* data,
+                                size_t size,
+                                wxIPCFormat format);
+
     /**
         Message sent to the server application by the client, when the client
         wishes to start an 'advise loop' for the given topic and item.
@@ -189,6 +247,32 @@ public:
     const void* Request(const wxString& item, size_t* size,
                         wxIPCFormat format = wxIPC_TEXT);
 
+    /**
+        Called by the client application to request data from the server
+        without waiting for the reply.
+
+        This function is similar to Request(), but it returns immediately and
+        the data is passed to OnRequestReply() when it is received. Using it
+        allows to have many requests in flight at the same time instead of
+        waiting for the reply to each of them before sending the next one,
+        which is much faster, especially when combined with BeginBatch().
+
+        For wxTCPConnection, both the client and the server must use
+        wxWidgets 3.3.0 or later for this function to work. A server built
+        with an earlier version doesn't understand the request and replies to
+        it with a generic failure message, so OnRequestReply() is never called
+        for it at all (and this failure could even be taken as the reply to
+        the next synchronous call, such as Request()). For the other
+        connection classes, it simply calls Request() and OnRequestReply()
+        synchronously.
+
+        @return The ID of this request, which is passed to OnRequestReply(),
+            always positive, or 0 if sending the request failed.
+
+        @since 3.3.0
+    */
+    int RequestAsync(const wxString& item, wxIPCFormat format = wxIPC_TEXT);
+
     /**
         Called by the client application to ask if an advise loop can be started
         with the server. Causes the server connection's OnStartAdvise()
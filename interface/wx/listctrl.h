@@ -1048,6 +1048,47 @@ public:
     */
     void RefreshItems(long itemFrom, long itemTo);
 
+    /**
+        Extend the range of items in @c wxEVT_LIST_CACHE_HINT events.
+
+        By default, the cache hint events sent by virtual list controls contain
+        just the visible items and are sent whenever the control is repainted.
+        If this function is called with non-zero @a count, the range is extended
+        by this number of items before and after the visible ones and the
+        events are not sent again while the visible items remain inside the
+        range of the last one, i.e. the hints are coalesced.
+
+        This allows the application to fetch the data of the items before
+        they actually become visible, e.g. in a worker thread, returning some
+        placeholder text from OnGetItemText() in the meanwhile and calling
+        NotifyItemsReady() when the real data becomes available.
+
+        @note This function is only available in the generic version of this
+            control, i.e. it is not available in wxMSW and wxQt.
+
+        @since 3.3.0
+    */
+    void SetCacheHintLookAhead(long count);
+
+    /**
+        Redraws the items between @a itemFrom and @a itemTo after their data
+        has become available.
+
+        Contrary to RefreshItems() and all the other methods of this class,
+        this one may be called from any thread. The items are redrawn later,
+        by the main thread, and the ranges passed to multiple calls to this
+        function before this happens are merged, so that the items are
+        refreshed only once.
+
+        @note This function is only available in the generic version of this
+            control, i.e. it is not available in wxMSW and wxQt.
+
+        @see SetCacheHintLookAhead()
+
+        @since 3.3.0
+    */
+    void NotifyItemsReady(long itemFrom, long itemTo);
+
     /**
         Scrolls the list control. If in icon, small icon or report view mode,
         @a dx specifies the number of pixels to scroll. If in list view mode,
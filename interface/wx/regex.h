@@ -54,6 +54,22 @@ enum
     */
     wxRE_NEWLINE  = 16,
 
+    /**
+        Use JIT compilation of the regular expression, if available.
+
+        Compiling the regular expression using just-in-time compiler takes
+        longer, but matching it is typically several times faster, so this
+        flag should be used for the expressions matched against big amounts
+        of text.
+
+        If JIT support is not available in PCRE library or not supported on
+        the current platform, this flag is silently ignored and the
+        expression is compiled as usual.
+
+        @since 3.3.0
+     */
+    wxRE_JIT      = 256,
+
     /** Default flags.*/
     wxRE_DEFAULT  = wxRE_EXTENDED
 };
@@ -291,6 +307,12 @@ public:
         form can be used instead, making it possible to avoid a wxStrlen() inside
         the loop.
 
+        Since wxWidgets 3.3.0 the <b>Matches(text, flags, len)</b> form doesn't
+        need @a text to be null-terminated and doesn't copy it, except in the
+        builds using UTF-8 for wxString representation, in which the text is
+        still converted to UTF-8 during each call. Use the overload taking
+        wxStringView to avoid copying the text in all builds.
+
         May only be called after successful call to Compile().
     */
     bool Matches(const wxChar* text, int flags = 0) const;
@@ -308,6 +330,29 @@ public:
     */
     bool Matches(const wxString& text, int flags = 0) const;
 
+    /**
+        Matches the precompiled regular expression against the text referenced
+        by the given view, returns @true if matches and @false otherwise.
+
+        This overload never copies nor converts the text, so it is the most
+        efficient way to match (parts of) a big string or buffer. Note that the
+        view must refer to the data using the same representation as wxString,
+        e.g. it must contain valid UTF-8 in the builds using UTF-8 for wxString.
+
+        The positions returned by GetMatch() after a successful match are
+        relative to the start of the view and, just as wxStringView positions,
+        are in units of @c wxStringCharType, i.e. they are byte offsets in
+        the builds using UTF-8.
+
+        @e Flags may be combination of @c wxRE_NOTBOL and @c wxRE_NOTEOL, see
+        @ref wxRE_NOT_FLAGS.
+
+        May only be called after successful call to Compile().
+
+        @since 3.3.0
+    */
+    bool Matches(const wxStringView& text, int flags = 0) const;
+
     /**
         Replaces the current regular expression in the string pointed to by
         @a text, with the text in @a replacement and return number of matches
@@ -374,6 +419,26 @@ public:
      */
     static wxString ConvertFromBasic(const wxString& bre);
 
+    /**
+        Set the maximal number of compiled regular expressions to cache.
+
+        Compiling a regular expression, especially with ::wxRE_JIT, is
+        relatively expensive, so wxRegEx keeps the compiled code of the
+        recently used expressions in a process-wide cache, indexed by the
+        expression itself and the flags used for compiling it, and Compile()
+        reuses it when the same expression is compiled again. This makes
+        creating temporary wxRegEx objects for the same expressions much
+        cheaper.
+
+        By default, up to 32 most recently used expressions are cached.
+
+        @param size
+            The maximal number of cached expressions, 0 disables the cache.
+
+        @since 3.3.0
+     */
+    static void SetCacheSize(size_t size);
+
     /**
         Return the version of PCRE used.
 
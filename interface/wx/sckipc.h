@@ -63,6 +63,11 @@ public:
         Under Unix, the string must contain an integer id which is used as an
         Internet port number. @false is returned if the call failed
         (for example, the port number is already in use).
+
+        Also under Unix, if the string contains a slash, it is used as the
+        path of a Unix domain socket instead. This is more efficient than
+        using TCP for the connections between the processes running on the
+        same machine, so it should be preferred when possible.
     */
     virtual bool Create(const wxString& service);
 
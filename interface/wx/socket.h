@@ -706,6 +706,25 @@ enum
 };
 
 
+/**
+    Describes a buffer used by wxSocketBase::ReadV() and wxSocketBase::WriteV().
+
+    This is similar to the standard @c iovec structure. Notice that @c data
+    is not modified when the buffer is used for writing, even though it is
+    non-const.
+
+    @since 3.3.0
+*/
+struct wxSocketIOVec
+{
+    /// Pointer to the buffer data.
+    void *data;
+
+    /// Size of the buffer in bytes, may be 0.
+    wxUint32 size;
+};
+
+
 /**
     @class wxSocketBase
 
@@ -1063,6 +1082,31 @@ public:
     */
     wxSocketBase& Read(void* buffer, wxUint32 nbytes);
 
+    /**
+        Read data into several buffers at once.
+
+        This function behaves as Read() called with a buffer formed by
+        concatenating all the given buffers, but avoids copying the data and
+        uses a single system call to fill as many buffers as possible when
+        the platform supports it.
+
+        This function can only be used with stream, i.e. TCP, sockets.
+
+        Use LastReadCount() to get the total number of bytes read.
+
+        @param vec
+            Pointer to the array of buffers, filled in order.
+        @param count
+            Number of elements in @a vec array.
+
+        @return Returns a reference to the current object.
+
+        @since 3.3.0
+
+        @see Read(), WriteV()
+    */
+    wxSocketBase& ReadV(const wxSocketIOVec* vec, int count);
+
     /**
         Receive a message sent by WriteMsg().
 
@@ -1298,11 +1342,67 @@ public:
     */
     wxSocketBase& Write(const void* buffer, wxUint32 nbytes);
 
+    /**
+        Write data from several buffers at once.
+
+        This function behaves as Write() called with a buffer formed by
+        concatenating all the given buffers, but avoids copying the data into
+        such buffer and uses a single system call to send as many of them as
+        possible when the platform supports it. This is useful for sending a
+        header and the data following it, for example.
+
+        This function can only be used with stream, i.e. TCP, sockets.
+
+        Use LastWriteCount() to get the total number of bytes written.
+
+        @param vec
+            Pointer to the array of buffers, sent in order.
+        @param count
+            Number of elements in @a vec array.
+
+        @return Returns a reference to the current object.
+
+        @since 3.3.0
+
+        @see Write(), ReadV()
+    */
+    wxSocketBase& WriteV(const wxSocketIOVec* vec, int count);
+
+    /**
+        Write the contents of a file to the socket.
+
+        Writes up to @a nbytes from the current position of the given file,
+        which is advanced by the number of bytes written. Less data is written
+        if the end of file is reached, and also possibly if neither
+        @c wxSOCKET_WAITALL nor @c wxSOCKET_WAITALL_WRITE flag is used, as
+        with Write().
+
+        Under Linux, the data is sent directly from the file by the kernel,
+        without copying it to the user space, for stream sockets. Otherwise,
+        the file data is read into a temporary buffer and written from it.
+
+        Use LastWriteCount() to get the number of bytes written.
+
+        @param file
+            The file to read the data from, must be opened.
+        @param nbytes
+            The maximal number of bytes to write.
+
+        @return Returns a reference to the current object.
+
+        @since 3.3.0
+
+        @see Write()
+    */
+    wxSocketBase& WriteFile(wxFile& file, wxUint32 nbytes);
+
     /**
         Sends a buffer which can be read using ReadMsg().
 
         WriteMsg() sends a short header before the data so that ReadMsg()
-        knows how much data should be actually read.
+        knows how much data should be actually read. For stream sockets, the
+        header, the data and the trailer following it are sent together, as
+        if by WriteV().
 
         This function always waits for the entire buffer to be sent, unless an
         error occurs.
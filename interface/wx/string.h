@@ -510,6 +510,13 @@ public:
     */
     wxString(std::wstring_view str);
 
+    /**
+       Constructs a string from the data referenced by the given view.
+
+       @since 3.3.0
+    */
+    explicit wxString(const wxStringView& view);
+
     /**
         String destructor.
 
@@ -947,6 +954,13 @@ public:
     */
     void operator +=(wxUniChar c);
 
+    /**
+        @overload
+
+        @since 3.3.0
+    */
+    wxString& operator+=(const wxStringView& view);
+
     ///@}
 
 
@@ -987,6 +1001,10 @@ public:
         zero if it is equal to it or a negative value if it is less than the
         argument (same semantics as the standard @c strcmp() function).
 
+        Note that ASCII letters are always compared in the same way, i.e.
+        without using any locale-specific rules, and the characters are
+        compared using their lower case versions.
+
         @see Cmp(), IsSameAs().
     */
     int CmpNoCase(const wxString& s) const;
@@ -1015,6 +1033,16 @@ public:
     */
     bool IsSameAs(wxUniChar ch, bool caseSensitive = true) const;
 
+    /**
+        Test whether the string is equal to the string referenced by the view.
+
+        This is the same as IsSameAs() taking wxString, but doesn't require
+        creating a temporary string.
+
+        @since 3.3.0
+    */
+    bool IsSameAs(const wxStringView& view, bool caseSensitive = true) const;
+
     ///@{
     /**
         Comparison operator for string types.
@@ -1087,6 +1115,36 @@ public:
     */
     bool EndsWith(const wxString& suffix, wxString *rest = nullptr) const;
 
+    /**
+        Overload of StartsWith() not allocating any memory.
+
+        The @a rest view, if it is not @NULL, refers to this string data and
+        so is only valid as long as this string is not modified.
+
+        @since 3.3.0
+    */
+    bool StartsWith(const wxStringView& prefix, wxStringView *rest) const;
+
+    /**
+        Overload of EndsWith() not allocating any memory.
+
+        The @a rest view, if it is not @NULL, refers to this string data and
+        so is only valid as long as this string is not modified.
+
+        @since 3.3.0
+    */
+    bool EndsWith(const wxStringView& suffix, wxStringView *rest) const;
+
+    /**
+        Returns the view of the part of the string between the given iterators.
+
+        The returned view refers to this string data and is only valid as long
+        as this string is not modified.
+
+        @since 3.3.0
+    */
+    wxStringView GetView(const_iterator first, const_iterator last) const;
+
     ///@}
 
 
@@ -1275,6 +1333,15 @@ public:
     */
     int Find(const wxString& sub) const;
 
+    /**
+        Searches for the string referenced by the given view.
+
+        Returns the starting position or @c wxNOT_FOUND if not found.
+
+        @since 3.3.0
+    */
+    int Find(const wxStringView& sub) const;
+
     /**
         Same as Find().
 
@@ -0,0 +1,210 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        stringview.h
+// Purpose:     interface of wxStringView
+// Author:      wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    @class wxStringView
+
+    wxStringView is a non-owning reference to a contiguous part of a string.
+
+    It is similar to the standard @c std::string_view, but the data it refers
+    to is always in the same representation as used by wxString internally,
+    i.e. @c wchar_t in the default build and UTF-8 if @c wxUSE_UNICODE_UTF8 is
+    set to 1. This allows creating a view of any wxString without copying its
+    contents and converting the view back to wxString, if necessary, without
+    any conversions.
+
+    Note that all positions and lengths used by this class are expressed in
+    units of @c wxStringCharType and not in characters, so they are the same
+    as wxString positions in the default build but are byte offsets in UTF-8
+    one.
+
+    As the view doesn't own the data it refers to, it must not outlive the
+    object it was created from, e.g.
+    @code
+    wxStringView v = wxString("temporary"); // Wrong: dangling view!
+    @endcode
+
+    wxStringView is implicitly constructible from wxString, but, unlike
+    wxString, not from raw character pointers, to avoid ambiguities between
+    the overloads of the functions taking either wxString or wxStringView.
+    Use the explicit constructor in order to create a view of a literal or a
+    buffer.
+
+    Typical use of this class is for parsing strings without allocating
+    memory, e.g. using wxStringTokenizer::GetNextTokenView():
+    @code
+    wxStringTokenizer tk(line, ",");
+    while ( tk.HasMoreTokens() )
+    {
+        const wxStringView field = tk.GetNextTokenView();
+
+        long n;
+        if ( field.ToLong(&n) )
+            ... use the number ...
+    }
+    @endcode
+
+    @library{wxbase}
+    @category{data}
+
+    @see wxString
+
+    @since 3.3.0
+*/
+class wxStringView
+{
+public:
+    typedef wxStringCharType value_type;
+    typedef size_t size_type;
+    typedef const wxStringCharType* const_iterator;
+    typedef const_iterator iterator;
+
+    /// Value returned by the search functions if nothing was found.
+    static const size_t npos;
+
+    /// Default constructor creates an empty view.
+    wxStringView();
+
+    /// Creates a view of the given number of characters starting at @a data.
+    wxStringView(const wxStringCharType* data, size_t len);
+
+    /// Creates a view of NUL-terminated string @a data.
+    explicit wxStringView(const wxStringCharType* data);
+
+    /// Creates a view of the buffer contents.
+    explicit wxStringView(const wxScopedCharTypeBuffer<wxStringCharType>& buf);
+
+    /// Creates a view of the standard string contents.
+    explicit wxStringView(const std::basic_string<wxStringCharType>& str);
+
+    /// Creates a view of the contents of the given wxString.
+    wxStringView(const wxString& str);
+
+    /**
+        Creates a view from the standard one.
+
+        @note Requires the application to be compiled with C++17
+    */
+    explicit wxStringView(std::basic_string_view<wxStringCharType> view);
+
+    /**
+        Converts to the standard string view.
+
+        @note Requires the application to be compiled with C++17
+    */
+    operator std::basic_string_view<wxStringCharType>() const;
+
+    /// Returns the pointer to the start of the data, not NUL-terminated.
+    const wxStringCharType* data() const;
+
+    /// Returns the length of the view.
+    size_t length() const;
+
+    /// Synonym for length().
+    size_t size() const;
+
+    /// Returns @true if the view is empty.
+    bool empty() const;
+
+    /// Returns the iterator to the start of the view.
+    const_iterator begin() const;
+
+    /// Returns the iterator to the end of the view.
+    const_iterator end() const;
+
+    /// Returns the code unit at the given position, which must be valid.
+    wxStringCharType operator[](size_t n) const;
+
+    /// Returns a new string with the same contents as this view.
+    wxString ToString() const;
+
+    /**
+        Returns the view of a part of this one.
+
+        @a n can be ::npos or, more generally, exceed the remaining length in
+        which case the view extends up to the end of this one.
+    */
+    wxStringView substr(size_t pos, size_t n = npos) const;
+
+    /// Moves the start of the view forward by @a n units.
+    void remove_prefix(size_t n);
+
+    /// Moves the end of the view backward by @a n units.
+    void remove_suffix(size_t n);
+
+    /**
+        Compares this view with another one.
+
+        Returns a negative value, 0 or a positive value if this view is less
+        than, equal to or greater than the other one.
+    */
+    int compare(const wxStringView& other) const;
+
+    /**
+        Test whether the view is equal to another one.
+
+        The test is case-sensitive if @a caseSensitive is @true (default) or
+        not if it is @false.
+    */
+    bool IsSameAs(const wxStringView& other, bool caseSensitive = true) const;
+
+    /// Returns @true if the view starts with the given prefix.
+    bool StartsWith(const wxStringView& prefix) const;
+
+    /// Returns @true if the view ends with the given suffix.
+    bool EndsWith(const wxStringView& suffix) const;
+
+    /// Returns the position of the first occurrence of @a ch or ::npos.
+    size_t find(wxStringCharType ch, size_t pos = 0) const;
+
+    /// Returns the position of the first occurrence of @a sub or ::npos.
+    size_t find(const wxStringView& sub, size_t pos = 0) const;
+
+    /// Returns the position of the last occurrence of @a ch or ::npos.
+    size_t rfind(wxStringCharType ch, size_t pos = npos) const;
+
+    /// Returns the position of the first of the given @a chars or ::npos.
+    size_t find_first_of(const wxStringView& chars, size_t pos = 0) const;
+
+    /// Returns the position of the first unit not in @a chars or ::npos.
+    size_t find_first_not_of(const wxStringView& chars, size_t pos = 0) const;
+
+    /**
+        Converts the view contents to a signed integer.
+
+        This function works in the same way as wxString::ToLong().
+    */
+    bool ToLong(long *val, int base = 10) const;
+
+    /**
+        Converts the view contents to an unsigned integer.
+
+        This function works in the same way as wxString::ToULong().
+    */
+    bool ToULong(unsigned long *val, int base = 10) const;
+
+    /**
+        Converts the view contents to a floating point number.
+
+        This function works in the same way as wxString::ToDouble().
+    */
+    bool ToDouble(double *val) const;
+};
+
+///@{
+/// Comparison operators for wxStringView.
+bool operator==(const wxStringView& v1, const wxStringView& v2);
+bool operator!=(const wxStringView& v1, const wxStringView& v2);
+bool operator<(const wxStringView& v1, const wxStringView& v2);
+bool operator>(const wxStringView& v1, const wxStringView& v2);
+bool operator<=(const wxStringView& v1, const wxStringView& v2);
+bool operator>=(const wxStringView& v1, const wxStringView& v2);
+bool operator==(const wxStringView& v, const wxStringCharType* s);
+bool operator==(const wxStringCharType* s, const wxStringView& v);
+bool operator!=(const wxStringView& v, const wxStringCharType* s);
+bool operator!=(const wxStringCharType* s, const wxStringView& v);
+///@}
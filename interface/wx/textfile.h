@@ -34,7 +34,8 @@ enum wxTextFileType
     not work in this way with large files (as an estimation, anything over 1 Megabyte
     is surely too big for this class). On the other hand, it is not a serious
     limitation for small files like configuration files or program sources
-    which are well handled by wxTextFile.
+    which are well handled by wxTextFile. Use wxTextFileReader to process
+    big files line by line without loading them into memory.
 
     The typical things you may do with wxTextFile in order are:
 
@@ -298,3 +299,112 @@ public:
     wxString& operator[](size_t n) const;
 };
 
+
+/**
+    @class wxTextFileReader
+
+    wxTextFileReader allows reading the lines of a text file one by one.
+
+    Unlike wxTextFile, this class doesn't load the entire file into memory but
+    reads it in chunks of fixed size, decoding each of them using the provided
+    conversion object, and returns the lines as views into the decoded data,
+    so that even very big files can be processed using a small and constant
+    amount of memory. The line terminators are recognized in the same way as
+    by wxTextFile, i.e. all of Unix, DOS and Mac line endings are supported
+    and can be mixed in the same file.
+
+    Example of using this class:
+    @code
+    wxFile file("huge.log");
+    if ( file.IsOpened() )
+    {
+        wxTextFileReader reader(file);
+
+        wxStringView line;
+        while ( reader.GetNextLine(&line) )
+        {
+            if ( line.StartsWith(wxStringView(wxS("ERROR:"))) )
+                ... process the line, use line.ToString() if it needs to be stored ...
+        }
+
+        if ( reader.Error() )
+            ... handle the error ...
+    }
+    @endcode
+
+    @library{wxbase}
+    @category{file}
+
+    @see wxTextFile, wxStringView
+
+    @since 3.3.0
+*/
+class wxTextFileReader
+{
+public:
+    /**
+        Constructor associates the reader with the given file.
+
+        The file must be opened for reading and must remain opened while this
+        object is used. Reading starts at the current position in the file.
+
+        The conversion object is copied, so it doesn't need to outlive this
+        object.
+    */
+    explicit wxTextFileReader(wxFile& file, const wxMBConv& conv = wxConvAuto());
+
+    /**
+        Returns the next line of the file.
+
+        The line is returned without the line terminator, but its kind is
+        returned in @a type if it is non-null. The last line of the file is
+        only returned if it is non-empty and has ::wxTextFileType_None type if
+        the file doesn't end with a line terminator.
+
+        Notice that the returned view is only valid until the next call to
+        this function.
+
+        @return @true if a line was returned or @false if there are no more
+            lines in the file or an error occurred, use Error() to distinguish
+            between these cases.
+    */
+    bool GetNextLine(wxStringView* line, wxTextFileType* type = nullptr);
+
+    /**
+        Returns @true if GetNextLine() returned @false because reading or
+        decoding the file failed and not because its end was reached.
+    */
+    bool Error() const;
+
+    /**
+        Returns @true if the encoding changed after some lines were returned.
+
+        When using the default wxConvAuto conversion with a file without BOM,
+        the file is decoded as UTF-8 until an invalid UTF-8 sequence is found
+        in it, after which wxConvAuto switches to its fallback encoding (see
+        wxConvAuto::SetFallbackEncoding()). As the file is decoded in chunks,
+        this may happen only after some non-ASCII lines had been already
+        returned decoded as UTF-8 and this function returns @true if this
+        happened. In this case, Rewind() can be called to read the file again
+        from the beginning using the fallback encoding for all of it, as
+        wxTextFile does.
+
+        @since 3.3.0
+    */
+    bool EncodingChanged() const;
+
+    /**
+        Restarts reading from the position at which the file was when this
+        object was created.
+
+        The encoding currently used by the conversion object is preserved, so
+        calling this function after EncodingChanged() returned @true reads
+        the entire file using the fallback encoding.
+
+        @return @true if successful or @false if seeking in the file failed,
+            in which case Error() returns @true as well.
+
+        @since 3.3.0
+    */
+    bool Rewind();
+};
@@ -0,0 +1,304 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/threadpool.h
+// Purpose:     interface of wxThreadPool, wxTaskGroup and wxFuture<T>
+// Author:      wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    Possible states of a task executed by wxThreadPool.
+
+    @see wxFuture::GetStatus()
+
+    @since 3.3.0
+    @category{threading}
+ */
+enum wxTaskStatus
+{
+    /// The task is waiting in the queue.
+    wxTASK_PENDING,
+
+    /// The task is being executed.
+    wxTASK_RUNNING,
+
+    /// The task has finished executing.
+    wxTASK_DONE,
+
+    /// The task was cancelled before it could start executing.
+    wxTASK_CANCELLED
+};
+
+/**
+    Event sent when a task finishes if wxFuture::NotifyOnCompletion() was
+    called.
+
+    The event is a wxThreadEvent with the ID specified when calling
+    NotifyOnCompletion() and wxThreadEvent::GetInt() returning the task status,
+    i.e. either ::wxTASK_DONE or ::wxTASK_CANCELLED.
+
+    @since 3.3.0
+ */
+wxEventType wxEVT_TASK_COMPLETED;
+
+/**
+    Represents the result of a task submitted to wxThreadPool.
+
+    Objects of this class are returned by wxThreadPool::Submit() and
+    wxTaskGroup::Run() and can be used to wait for the task to finish and
+    retrieve the value returned by it, or to cancel it if it hasn't started
+    running yet.
+
+    wxFuture objects can be freely copied, all the copies refer to the same
+    task. Destroying all of them doesn't cancel the task.
+
+    @tparam T
+        The type of the value returned by the task function, may be @c void.
+
+    @since 3.3.0
+
+    @library{wxbase}
+    @category{threading}
+
+    @see wxThreadPool
+*/
+template <typename T>
+class wxFuture<T>
+{
+public:
+    /**
+        Default constructor creates an invalid object.
+
+        Only IsOk() can be called on such objects.
+     */
+    wxFuture();
+
+    /**
+        Returns @true if this object is associated with a task.
+     */
+    bool IsOk() const;
+
+    /**
+        Returns the current task status.
+     */
+    wxTaskStatus GetStatus() const;
+
+    /**
+        Returns @true if the task has either finished or was cancelled.
+     */
+    bool IsFinished() const;
+
+    /**
+        Prevents the task from running if it hasn't started yet.
+
+        Note that a task which is already running can't be cancelled, if it
+        needs to be possible to stop it, it can be created in a wxTaskGroup
+        and check for wxTaskGroup::IsCancelled() periodically.
+
+        @return @true if the task is cancelled, @false if it's too late to do
+            it because the task is either running or already finished.
+     */
+    bool Cancel();
+
+    /**
+        Blocks until the task finishes.
+
+        If this function is called from one of the pool threads, it executes
+        the other pending tasks while waiting, so it is safe to wait for the
+        tasks submitted from inside another task.
+
+        @return @true if the task was executed, @false if it was cancelled.
+     */
+    bool Wait();
+
+    /**
+        Waits for the task completion and returns its result.
+
+        If the task function threw an exception, it is caught by the pool
+        thread executing it, the task status is still set to ::wxTASK_DONE and
+        the exception is rethrown by this function.
+
+        This function must not be called if the task was cancelled.
+     */
+    T Get();
+
+    /**
+        Requests sending wxEVT_TASK_COMPLETED to the given handler when the
+        task finishes.
+
+        The event is queued using wxEvtHandler::QueueEvent() and so is
+        processed in the main thread. If the task has already finished when
+        this function is called, the event is queued immediately.
+
+        The handler must remain alive until the event is processed.
+
+        @param handler The handler to send the event to, must be non-null.
+        @param id The ID of the event.
+     */
+    void NotifyOnCompletion(wxEvtHandler* handler, int id = wxID_ANY);
+};
+
+/**
+    Thread pool executing tasks using a fixed number of worker threads.
+
+    The tasks are arbitrary callable objects, typically lambdas, submitted
+    using Submit() which returns a wxFuture which can be used to get the task
+    result. For example:
+
+    @code
+        wxFuture<long> result = wxThreadPool::GetDefault().Submit([]()
+            {
+                return ComputeSomethingExpensive();
+            });
+
+        ... do something else in the meanwhile ...
+
+        long value = result.Get();
+    @endcode
+
+    Each of the worker threads has its own queue of tasks, to which the tasks
+    submitted from this thread are added. Idle workers steal the tasks from
+    the queues of the other ones, so that the tasks recursively creating more
+    tasks are distributed between all threads efficiently. Tasks submitted
+    from the threads not belonging to the pool are executed in FIFO order.
+
+    Creating a task is much cheaper than creating a new wxThread, so it is
+    fine to use the pool for relatively small units of work.
+
+    Use wxTaskGroup to wait for or cancel several related tasks at once.
+
+    @since 3.3.0
+
+    @library{wxbase}
+    @category{threading}
+
+    @see wxTaskGroup, wxFuture, wxThread
+*/
+class wxThreadPool
+{
+public:
+    /**
+        Creates the pool with the given number of worker threads.
+
+        @param numThreads The number of threads to use, if it is 0, the
+            number of CPUs returned by wxThread::GetCPUCount() is used.
+     */
+    explicit wxThreadPool(int numThreads = 0);
+
+    /**
+        Destroys the pool.
+
+        The destructor waits until all the pending tasks are executed.
+     */
+    ~wxThreadPool();
+
+    /**
+        Returns the global thread pool, creating it on first use.
+
+        This pool is destroyed when the library is shut down.
+     */
+    static wxThreadPool& GetDefault();
+
+    /**
+        Sets the number of threads to use for the default pool.
+
+        This function must be called before the first call to GetDefault().
+     */
+    static void SetDefaultThreadCount(int numThreads);
+
+    /**
+        Returns the number of worker threads.
+
+        This may be less than the number passed to the constructor if some
+        threads couldn't be created. If no threads could be created at all,
+        the tasks are executed synchronously when they are submitted.
+     */
+    int GetThreadCount() const;
+
+    /**
+        Schedules the given function for execution by one of the pool threads.
+
+        @param func Any callable object taking no arguments.
+        @return The object that can be used to wait for the task completion
+            and retrieve its result.
+     */
+    template <typename F>
+    wxFuture<R> Submit(F func);
+
+    /**
+        Returns @true if called from one of the threads of this pool.
+     */
+    bool IsWorkerThread() const;
+};
+
+/**
+    Group of related tasks executed by wxThreadPool.
+
+    This class allows waiting until all tasks belonging to the group finish
+    and to cancel all of them at once. Tasks running as part of a group may
+    add more tasks to the same group, e.g. to recursively split the work into
+    smaller parts.
+
+    Example:
+    @code
+        wxTaskGroup group;
+        for ( auto& item : items )
+            group.Run([&item]() { item.Process(); });
+
+        group.Wait();
+    @endcode
+
+    @since 3.3.0
+
+    @library{wxbase}
+    @category{threading}
+
+    @see wxThreadPool
+*/
+class wxTaskGroup
+{
+public:
+    /**
+        Creates a new group using the given pool.
+     */
+    explicit wxTaskGroup(wxThreadPool& pool = wxThreadPool::GetDefault());
+
+    /**
+        Destructor waits until all tasks of the group finish.
+     */
+    ~wxTaskGroup();
+
+    /**
+        Returns the pool used by this group.
+     */
+    wxThreadPool& GetPool() const;
+
+    /**
+        Schedules the given function for execution as part of this group.
+
+        This is similar to wxThreadPool::Submit().
+     */
+    template <typename F>
+    wxFuture<R> Run(F func);
+
+    /**
+        Blocks until all tasks of this group finish.
+
+        As with wxFuture::Wait(), this function executes other tasks while
+        waiting if it is called from a pool thread.
+     */
+    void Wait();
+
+    /**
+        Cancels all the tasks of this group.
+
+        The tasks which haven't started executing yet won't be executed at
+        all, while the already running tasks may check IsCancelled() to stop
+        as soon as possible.
+     */
+    void Cancel();
+
+    /**
+        Returns @true if Cancel() had been called.
+     */
+    bool IsCancelled() const;
+};
@@ -134,6 +134,19 @@ public:
     */
     wxString GetNextToken();
 
+    /**
+        Returns the view of the next token or an empty view if the end of
+        string was reached.
+
+        This function behaves exactly like GetNextToken() but avoids
+        allocating a new string for each token. The returned view refers to
+        the string stored inside the tokenizer and so remains valid only until
+        the tokenizer is destroyed or SetString() or Reinit() is called.
+
+        @since 3.3.0
+    */
+    wxStringView GetNextTokenView();
+
     /**
         Returns the current position (i.e.\ one index after the last returned
         token or 0 if GetNextToken() has never been called) in the original
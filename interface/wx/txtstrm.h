@@ -159,6 +159,13 @@ public:
     /**
         Reads a line from the input stream and returns it (without the end of
         line character).
+
+        When using an encoding with single byte code units, such as UTF-8 or
+        any of the legacy 8 bit encodings, the line is read from the stream
+        and decoded as a whole and not character by character. For seekable
+        streams, more data than needed may be read from the stream in this
+        case, with the extra data put back into it using
+        wxInputStream::Ungetch().
     */
     wxString ReadLine();
 
@@ -409,9 +409,56 @@ public:
         With this storage method the data is only available during the
         @c wxEVT_WEBREQUEST_DATA event calls as soon as it's received from the
         server.
+
+        If the data needs to be processed as fast as it arrives, e.g. to
+        compute its hash, or if the consumer may be slower than the network,
+        use SetDataConsumer() instead.
     */
     void SetStorage(Storage storage);
 
+    /**
+        Sets the object receiving the response data as soon as it arrives.
+
+        The data is passed to wxWebResponseConsumer::OnData() directly from
+        the network buffers, without being copied or queued, and is not stored
+        anywhere, i.e. using a consumer implies @c Storage_None and no
+        @c wxEVT_WEBREQUEST_DATA events are generated.
+
+        The consumer may return @false from OnData() to pause the transfer if
+        it can't accept more data right now, e.g. because it hands the data to
+        a worker thread and its queue is full. The transfer remains paused,
+        without reading any more data from the network, until ResumeTransfer()
+        is called, which allows to process arbitrarily large responses using a
+        bounded amount of memory.
+
+        This function must be called before Start().
+
+        @param consumer The consumer, which must remain valid until the
+            request terminates, or @NULL to stop using it.
+        @return @true if the backend supports consumers, @false otherwise.
+
+        @note This is only implemented in the CURL backend.
+
+        @since 3.3.0
+    */
+    bool SetDataConsumer(wxWebResponseConsumer* consumer);
+
+    /**
+        Resumes the transfer paused by the data consumer.
+
+        Unlike most of the other functions of this class, this function may
+        be called from any thread. The transfer is resumed asynchronously,
+        from the main thread, and the data refused by the consumer is passed
+        to it again at this time.
+
+        Calling this function when the transfer is not paused does nothing.
+
+        @see SetDataConsumer()
+
+        @since 3.3.0
+    */
+    void ResumeTransfer();
+
     /**
         Disable SSL certificate verification.
 
@@ -543,6 +590,57 @@ public:
     const wxSecretValue& GetPassword() const;
 };
 
+/**
+    Interface for objects receiving the response data of wxWebRequest.
+
+    Derive from this class and pass an object of the derived class to
+    wxWebRequest::SetDataConsumer() to process the data as it arrives.
+
+    Example of computing a checksum of a large download:
+    @code
+        class ChecksumConsumer : public wxWebResponseConsumer
+        {
+        public:
+            bool OnData(const void* data, size_t size) override
+            {
+                m_checksum.Update(data, size);
+                return true;
+            }
+
+            ...
+        };
+    @endcode
+
+    @since 3.3.0
+
+    @library{wxnet}
+    @category{net}
+
+    @see wxWebRequest
+*/
+class wxWebResponseConsumer
+{
+public:
+    /// Trivial but virtual destructor.
+    virtual ~wxWebResponseConsumer();
+
+    /**
+        Called with the next chunk of the response data.
+
+        This function is called in the main thread and should return quickly,
+        as the data is not read from the network while it executes.
+
+        The data pointer is only valid until this function returns.
+
+        @param data Pointer to the data, never @NULL.
+        @param size Size of the data in bytes.
+        @return @true if the data was consumed or @false to pause the
+            transfer, in which case the same data will be passed to this
+            function again after wxWebRequest::ResumeTransfer() is called.
+     */
+    virtual bool OnData(const void* data, size_t size) = 0;
+};
+
 /**
     A wxWebResponse allows access to the response sent by the server.
 
@@ -556,6 +654,29 @@ public:
 class wxWebResponse
 {
 public:
+    /**
+        Phases of the request whose timing is returned by GetTiming().
+
+        @since 3.3.0
+    */
+    enum Timing
+    {
+        /// Resolving the host name is done.
+        Timing_NameLookup,
+
+        /// The connection to the server or proxy is established.
+        Timing_Connect,
+
+        /// The TLS handshake is done, this is 0 for plain HTTP requests.
+        Timing_TLSHandshake,
+
+        /// The first byte of the response is received.
+        Timing_FirstByte,
+
+        /// The request is complete.
+        Timing_Total
+    };
+
     /**
         Default constructor creates an invalid object.
 
@@ -641,6 +762,27 @@ public:
      */
     wxString GetDataFile() const;
 
+    /**
+        Returns the time taken by the given phase of the request.
+
+        The time is given in microseconds counted from the start of the
+        request until the end of the corresponding phase, so that e.g. the
+        time of the TLS handshake itself is the difference between the values
+        returned for @c Timing_TLSHandshake and @c Timing_Connect. Note that
+        all phases before @c Timing_FirstByte take 0 time if an existing
+        connection was reused for this request.
+
+        This function should be called after the request completes, e.g. from
+        wxEVT_WEBREQUEST_STATE handler.
+
+        @return The time in microseconds or -1 if not available.
+
+        @note This is only implemented in the CURL backend.
+
+        @since 3.3.0
+     */
+    wxLongLong GetTiming(Timing timing) const;
+
     /**
         Returns all response data as a string.
 
@@ -665,7 +807,10 @@ public:
 
     Every wxWebRequest sharing the same session object will use the same
     cookies. Additionally, an underlying network connection might be kept
-    alive to achieve faster additional responses.
+    alive to achieve faster additional responses, see SetMaxConnections() and
+    the related functions for controlling this. When using the CURL backend,
+    the results of the host name lookups and TLS sessions are also shared by
+    all sessions, which allows to make new connections faster too.
 
     @since 3.1.5
 
@@ -820,6 +965,84 @@ public:
         @since 3.3.0
      */
     bool EnablePersistentStorage(bool enable);
+
+    /**
+        Sets the maximal number of simultaneous connections to the same host.
+
+        The requests exceeding this limit are queued until one of the existing
+        connections becomes available, which is useful for applications making
+        many requests to the same server, as it allows to reuse the already
+        established connections instead of opening new ones.
+
+        @param maxConnections The maximal number of connections or 0 for no
+            limit, which is the default.
+        @return @true if the backend supports this setting, @false otherwise.
+
+        @note This is only implemented in the CURL backend.
+
+        @since 3.3.0
+     */
+    bool SetMaxConnectionsPerHost(int maxConnections);
+
+    /**
+        Sets the maximal number of simultaneous connections for this session.
+
+        This is similar to SetMaxConnectionsPerHost() but limits the total
+        number of connections to all hosts. It also determines the number of
+        idle connections kept open for reuse by the later requests.
+
+        @param maxConnections The maximal number of connections or 0 for no
+            limit, which is the default.
+        @return @true if the backend supports this setting, @false otherwise.
+
+        @note This is only implemented in the CURL backend.
+
+        @since 3.3.0
+     */
+    bool SetMaxConnections(int maxConnections);
+
+    /**
+        Allows to disable reusing the connections between the requests.
+
+        By default the connections are kept open after the request completes
+        and are reused by the subsequent requests to the same host. Calling
+        this function with @false argument ensures that each request uses a
+        new connection which is closed when it completes.
+
+        This setting only affects the requests created after calling it.
+
+        @return @true if the backend supports this setting, @false otherwise.
+
+        @note This is only implemented in the CURL backend.
+
+        @since 3.3.0
+     */
+    bool EnableConnectionReuse(bool enable = true);
+
+    /**
+        Allows to enable or disable multiplexing several requests over the
+        same HTTP/2 connection.
+
+        When multiplexing is enabled, HTTP/2 is used for HTTPS requests if the
+        server supports it and the requests to the same host are sent over a
+        single connection instead of opening a new one for each of them. If it
+        is disabled, HTTP/1.1 is always used.
+
+        If this function is not called, the backend default is used, which is
+        to use HTTP/2 and multiplexing whenever possible for recent libcurl
+        versions.
+
+        This setting only affects the requests created after calling it.
+
+        @return @true if the backend supports this setting, @false otherwise,
+            e.g. if libcurl was built without HTTP/2 support.
+
+        @note This is only implemented in the CURL backend. Note that HTTP/1.1
+            pipelining is not supported as it was removed from libcurl.
+
+        @since 3.3.0
+     */
+    bool EnableMultiplexing(bool enable = true);
 };
 
 /**
@@ -86,6 +86,10 @@ public:
                         const void *data,
                         size_t size,
                         wxIPCFormat format) override;
+    virtual const void *OnRequest(const wxString& topic,
+                                  const wxString& item,
+                                  size_t *size,
+                                  wxIPCFormat format) override;
     virtual bool OnStartAdvise(const wxString& topic, const wxString& item) override;
     virtual bool OnStopAdvise(const wxString& topic, const wxString& item) override;
 
@@ -99,6 +103,9 @@ private:
     // the item which can be manipulated by the client via Poke() calls
     wxString m_item;
 
+    // the buffer returned from OnRequest(), must persist after it returns
+    wxScopedCharBuffer m_requestData;
+
     // should we notify the client about changes to m_item?
     bool m_advise;
 };
@@ -379,6 +386,26 @@ bool BenchConnection::OnPoke(const wxString& topic,
     return true;
 }
 
+const void *BenchConnection::OnRequest(const wxString& topic,
+                                       const wxString& item,
+                                       size_t *size,
+                                       wxIPCFormat format)
+{
+    if ( !IsSupportedTopicAndItem("OnRequest", topic, item) )
+        return nullptr;
+
+    if ( format != wxIPC_UTF8TEXT )
+    {
+        wxLogMessage("Unexpected format %d in OnRequest().", format);
+        return nullptr;
+    }
+
+    m_requestData = m_item.utf8_str();
+    *size = m_requestData.length() + 1; // include the trailing NUL
+
+    return m_requestData.data();
+}
+
 bool BenchConnection::OnStartAdvise(const wxString& topic, const wxString& item)
 {
     if ( !IsSupportedTopicAndItem("OnStartAdvise", topic, item) )
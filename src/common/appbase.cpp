@@ -466,10 +466,62 @@ void wxAppConsoleBase::DelayPendingEventHandler(wxEvtHandler* toDelay)
     wxLEAVE_CRIT_SECT(m_handlersWithPendingEventsLocker);
 }
 
+void wxAppConsoleBase::AddNewPendingEventHandler(wxEvtHandler* handler)
+{
+    // don't add the handler twice, this would corrupt the list
+    if ( handler->m_isInNewPendingHandlers.exchange(true) )
+        return;
+
+    wxEvtHandler*
+        head = m_newHandlersWithPendingEvents.load(std::memory_order_relaxed);
+    do
+    {
+        handler->m_nextWithNewPendingEvents = head;
+    }
+    while ( !m_newHandlersWithPendingEvents.compare_exchange_weak(head, handler) );
+}
+
+void wxAppConsoleBase::MoveNewPendingEventHandlers()
+{
+    wxEvtHandler* handler = m_newHandlersWithPendingEvents.load();
+    if ( !handler )
+        return;
+
+    handler = m_newHandlersWithPendingEvents.exchange(nullptr);
+
+    // the handlers are in LIFO order, reverse them to process the handlers in
+    // the order in which the events were queued for them
+    wxEvtHandler* first = nullptr;
+    while ( handler )
+    {
+        wxEvtHandler* const next = handler->m_nextWithNewPendingEvents;
+        handler->m_nextWithNewPendingEvents = first;
+        first = handler;
+        handler = next;
+    }
+
+    for ( handler = first; handler; )
+    {
+        // the handler may be added to the list of the new handlers again as
+        // soon as we reset its flag, so get the next one before doing it
+        wxEvtHandler* const next = handler->m_nextWithNewPendingEvents;
+        handler->m_nextWithNewPendingEvents = nullptr;
+        handler->m_isInNewPendingHandlers = false;
+
+        if ( m_handlersWithPendingEvents.Index(handler) == wxNOT_FOUND )
+            m_handlersWithPendingEvents.Add(handler);
+
+        handler = next;
+    }
+}
+
 void wxAppConsoleBase::RemovePendingEventHandler(wxEvtHandler* toRemove)
 {
     wxENTER_CRIT_SECT(m_handlersWithPendingEventsLocker);
 
+    // the handler must not remain in the list of the new handlers either
+    MoveNewPendingEventHandlers();
+
     if (m_handlersWithPendingEvents.Index(toRemove) != wxNOT_FOUND)
     {
         m_handlersWithPendingEvents.Remove(toRemove);
@@ -505,6 +557,10 @@ void wxAppConsoleBase::AppendPendingEventHandler(wxEvtHandler* toAppend)
 
 bool wxAppConsoleBase::HasPendingEvents() const
 {
+    // avoid locking in the common case of new events having been queued
+    if ( m_newHandlersWithPendingEvents.load() )
+        return true;
+
     wxENTER_CRIT_SECT(const_cast<wxAppConsoleBase*>(this)->m_handlersWithPendingEventsLocker);
 
     bool has = !m_handlersWithPendingEvents.IsEmpty();
@@ -535,8 +591,14 @@ void wxAppConsoleBase::ProcessPendingEvents()
 
         // iterate until the list becomes empty: the handlers remove themselves
         // from it when they don't have any more pending events
-        while (!m_handlersWithPendingEvents.IsEmpty())
+        for ( ;; )
         {
+            // take into account the handlers to which new events were queued
+            MoveNewPendingEventHandlers();
+
+            if ( m_handlersWithPendingEvents.IsEmpty() )
+                break;
+
             // NOTE: we always call ProcessPendingEvents() on the first event handler
             //       with pending events because handlers auto-remove themselves
             //       from this list (see RemovePendingEventHandler) if they have no
@@ -575,6 +637,8 @@ void wxAppConsoleBase::DeletePendingEvents()
     wxCHECK_RET( m_handlersWithPendingDelayedEvents.IsEmpty(),
                  "this helper list should be empty" );
 
+    MoveNewPendingEventHandlers();
+
     for (unsigned int i=0; i<m_handlersWithPendingEvents.GetCount(); i++)
         m_handlersWithPendingEvents[i]->DeletePendingEvents();
 
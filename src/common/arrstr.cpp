@@ -16,6 +16,7 @@
 
 
 #include "wx/arrstr.h"
+#include "wx/hashmap.h"
 #include "wx/scopedarray.h"
 #include "wx/wxcrt.h"
 
@@ -43,6 +44,191 @@ wxArrayString::wxArrayString(size_t sz, const wxString* a)
     assign(a, a + sz);
 }
 
+// ----------------------------------------------------------------------------
+// sorting strings by their contents
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Element sorted by SortStrings(): the key data in wxString internal
+// representation and the string which will be put in its place.
+struct StringSortKey
+{
+    const wxStringCharType* data;
+    size_t len;
+    wxString* str;
+};
+
+// Return the code unit at the given position or -1 if the key is shorter than
+// this, which ensures that the prefixes sort before the longer strings.
+inline wxInt64 GetSortUnit(const StringSortKey& key, size_t depth)
+{
+    if ( depth >= key.len )
+        return -1;
+
+#if wxUSE_UNICODE_UTF8
+    // UTF-8 bytes compared as unsigned values give the code points order.
+    return static_cast<unsigned char>(key.data[depth]);
+#else
+    return key.data[depth];
+#endif
+}
+
+// Compare the keys having the same first "depth" code units.
+inline bool IsKeyLess(const StringSortKey& k1, const StringSortKey& k2,
+                      size_t depth)
+{
+    return wxStringView(k1.data + depth, k1.len - depth) <
+            wxStringView(k2.data + depth, k2.len - depth);
+}
+
+// Multikey quicksort (Bentley and Sedgewick): this is a radix sort examining
+// each code unit of the common prefix only once, unlike std::sort() which
+// compares the entire prefix every time. It partitions the keys into those
+// with the code unit at the current position less than, equal to and greater
+// than that of the pivot and, contrary to the classic MSD radix sort, doesn't
+// need 2^16 or more buckets for the wide characters.
+void MultiKeyQuickSort(StringSortKey* keys, size_t count)
+{
+    struct Range
+    {
+        StringSortKey* first;
+        size_t count;
+        size_t depth;
+    };
+
+    // Use an explicit stack instead of recursion as the depth can be as big
+    // as the length of the longest common prefix.
+    std::vector<Range> ranges;
+    ranges.push_back({keys, count, 0});
+
+    while ( !ranges.empty() )
+    {
+        const Range r = ranges.back();
+        ranges.pop_back();
+
+        StringSortKey* const first = r.first;
+        const size_t depth = r.depth;
+
+        if ( r.count < 16 )
+        {
+            // Insertion sort is faster for the small ranges.
+            for ( size_t i = 1; i < r.count; i++ )
+            {
+                for ( size_t j = i;
+                      j > 0 && IsKeyLess(first[j], first[j - 1], depth);
+                      j-- )
+                {
+                    std::swap(first[j], first[j - 1]);
+                }
+            }
+
+            continue;
+        }
+
+        // Use the median of 3 as pivot.
+        const wxInt64 a = GetSortUnit(first[0], depth),
+                      b = GetSortUnit(first[r.count / 2], depth),
+                      c = GetSortUnit(first[r.count - 1], depth);
+        const wxInt64 pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+
+        // Partition the range into [0, lt), [lt, gt) and [gt, count) parts.
+        size_t lt = 0,
+               gt = r.count;
+        for ( size_t i = 0; i < gt; )
+        {
+            const wxInt64 unit = GetSortUnit(first[i], depth);
+            if ( unit < pivot )
+                std::swap(first[lt++], first[i++]);
+            else if ( unit > pivot )
+                std::swap(first[i], first[--gt]);
+            else
+                i++;
+        }
+
+        if ( lt > 1 )
+            ranges.push_back({first, lt, depth});
+
+        if ( r.count - gt > 1 )
+            ranges.push_back({first + gt, r.count - gt, depth});
+
+        // If the pivot is -1, all the strings in the middle part are equal.
+        if ( pivot != -1 && gt - lt > 1 )
+            ranges.push_back({first + lt, gt - lt, depth + 1});
+    }
+}
+
+// Sort the strings in the same order as wxStringSortAscending() or, if
+// caseSensitive is false, wxDictionaryStringSortAscending() would, optionally
+// reversing it.
+void
+SortStrings(wxString* strings, size_t count, bool reverseOrder, bool caseSensitive)
+{
+    if ( count < 2 )
+        return;
+
+    // When ignoring case, sort by lower case copies of the strings, which is
+    // equivalent to using CmpNoCase().
+    std::vector<wxString> lower;
+    if ( !caseSensitive )
+    {
+        lower.reserve(count);
+        for ( size_t n = 0; n < count; n++ )
+            lower.push_back(strings[n].Lower());
+    }
+
+    std::vector<StringSortKey> keys(count);
+    for ( size_t n = 0; n < count; n++ )
+    {
+        const wxStringView key(caseSensitive ? strings[n] : lower[n]);
+
+        keys[n].data = key.data();
+        keys[n].len = key.length();
+        keys[n].str = &strings[n];
+    }
+
+    MultiKeyQuickSort(&keys[0], count);
+
+    if ( !caseSensitive )
+    {
+        // Sort the strings differing only in case using case-sensitive
+        // comparison to get a well-defined order.
+        for ( size_t n = 0; n < count; )
+        {
+            const wxStringView key(keys[n].data, keys[n].len);
+
+            size_t end = n + 1;
+            while ( end < count &&
+                        wxStringView(keys[end].data, keys[end].len) == key )
+                end++;
+
+            if ( end - n > 1 )
+            {
+                std::sort(&keys[n], &keys[n] + (end - n),
+                          [](const StringSortKey& k1, const StringSortKey& k2)
+                          {
+                              return k1.str->Cmp(*k2.str) < 0;
+                          }
+                         );
+            }
+
+            n = end;
+        }
+    }
+
+    // Finally put the strings themselves in order.
+    std::vector<wxString> sorted;
+    sorted.reserve(count);
+    for ( const auto& key : keys )
+        sorted.push_back(std::move(*key.str));
+
+    for ( size_t n = 0; n < count; n++ )
+        strings[n] = std::move(sorted[reverseOrder ? count - n - 1 : n]);
+}
+
+} // anonymous namespace
+
 #if wxUSE_STD_CONTAINERS
 
 #include "wx/arrstr.h"
@@ -82,14 +268,14 @@ void wxArrayString::Sort(CompareFunction function)
 
 void wxArrayString::Sort(bool reverseOrder)
 {
-    if (reverseOrder)
-    {
-        std::sort(begin(), end(), std::greater<wxString>());
-    }
-    else
-    {
-        std::sort(begin(), end());
-    }
+    if ( !empty() )
+        SortStrings(&(*this)[0], size(), reverseOrder, true);
+}
+
+void wxArrayString::SortNoCase(bool reverseOrder)
+{
+    if ( !empty() )
+        SortStrings(&(*this)[0], size(), reverseOrder, false);
 }
 
 int wxSortedArrayString::Index(const wxString& str,
@@ -114,6 +300,34 @@ int wxSortedArrayString::Index(const wxString& str,
     return it - begin();
 }
 
+void wxSortedArrayString::DoMerge(const wxArrayString& strings,
+                                  bool defaultCompare)
+{
+    if ( strings.empty() )
+        return;
+
+    // Append all the new strings, sort them and merge with the existing ones.
+    const size_t countOld = size();
+    const size_t countNew = strings.size();
+
+    // Note that we can't use our push_back() as it inserts in sorted order.
+    insert(end(), strings.begin(), strings.end());
+
+    SCMPFUNC function = GetCompareFunction();
+    const auto pred = [function](const wxString& s1, const wxString& s2)
+                      {
+                          return function(s1, s2) < 0;
+                      };
+
+    const iterator middle = begin() + countOld;
+    if ( defaultCompare )
+        SortStrings(&(*this)[countOld], countNew, false, true);
+    else
+        std::stable_sort(middle, end(), pred);
+
+    std::inplace_merge(begin(), middle, end(), pred);
+}
+
 #else // !wxUSE_STD_CONTAINERS
 
 #ifndef   ARRAY_DEFAULT_INITIAL_SIZE    // also defined in dynarray.h
@@ -159,6 +373,13 @@ std::vector<wxString> wxArrayString::AsVector() const
 
 void wxArrayString::Copy(const wxArrayString& src)
 {
+  if ( m_autoSort )
+  {
+    // don't insert the strings one by one, this is too slow for big arrays
+    DoMerge(src);
+    return;
+  }
+
   if ( src.m_nCount > ARRAY_DEFAULT_INITIAL_SIZE )
     Alloc(src.m_nCount);
 
@@ -495,10 +716,44 @@ void wxArrayString::Sort(CompareFunction2 compareFunction)
 
 void wxArrayString::Sort(bool reverseOrder)
 {
-    if ( reverseOrder )
-        std::sort(m_pItems, m_pItems + m_nCount, std::greater<wxString>());
-    else // normal sort
-        std::sort(m_pItems, m_pItems + m_nCount);
+    SortStrings(m_pItems, m_nCount, reverseOrder, true);
+}
+
+void wxArrayString::SortNoCase(bool reverseOrder)
+{
+    wxCHECK_RET( !m_autoSort, wxT("can't use this method with sorted arrays") );
+
+    SortStrings(m_pItems, m_nCount, reverseOrder, false);
+}
+
+void wxArrayString::DoMerge(const wxArrayString& src)
+{
+    wxASSERT_MSG( m_autoSort, wxT("should be only used with sorted arrays") );
+
+    const size_t countOld = m_nCount;
+    const size_t countNew = src.m_nCount;
+    if ( !countNew )
+        return;
+
+    // Note that this works even if src is this array itself.
+    Alloc(countOld + countNew);
+    for ( size_t n = 0; n < countNew; n++ )
+        m_pItems[countOld + n] = src[n];
+    m_nCount += countNew;
+
+    wxString* const middle = m_pItems + countOld;
+    wxString* const end = m_pItems + m_nCount;
+    if ( m_compareFunction )
+    {
+        const wxSortPredicateAdaptor pred(m_compareFunction);
+        std::stable_sort(middle, end, pred);
+        std::inplace_merge(m_pItems, middle, end, pred);
+    }
+    else
+    {
+        SortStrings(middle, countNew, false, true);
+        std::inplace_merge(m_pItems, middle, end);
+    }
 }
 
 bool wxArrayString::operator==(const wxArrayString& a) const
@@ -517,6 +772,83 @@ bool wxArrayString::operator==(const wxArrayString& a) const
 
 #endif // !wxUSE_STD_CONTAINERS
 
+// ===========================================================================
+// wxArrayStringIndex
+// ===========================================================================
+
+size_t wxArrayStringIndex::GetHash(const wxString& str) const
+{
+    if ( !m_caseSensitive )
+        return wxStringHashNoCase::stringHash(str);
+
+    // Use FNV-1a hash of the code units, just as wxStringHashNoCase does for
+    // the case-folded characters.
+    size_t hash = 2166136261u;
+    for ( const wxStringCharType ch : wxStringView(str) )
+    {
+        hash ^= static_cast<wxUint32>(ch);
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+void wxArrayStringIndex::Rebuild()
+{
+    m_count = m_array.size();
+
+    // Keep the table at most half full.
+    size_t size = 16;
+    while ( size < 2*m_count )
+        size *= 2;
+
+    const Slot empty = { 0, wxNOT_FOUND };
+    m_slots.assign(size, empty);
+
+    const size_t mask = size - 1;
+    for ( size_t n = 0; n < m_count; n++ )
+    {
+        const wxString& str = m_array[n];
+        const size_t hash = GetHash(str);
+
+        for ( size_t i = hash & mask; ; i = (i + 1) & mask )
+        {
+            Slot& slot = m_slots[i];
+            if ( slot.index == wxNOT_FOUND )
+            {
+                slot.hash = hash;
+                slot.index = static_cast<int>(n);
+                break;
+            }
+
+            // Only the first occurrence of the string is found by Index().
+            if ( slot.hash == hash &&
+                    m_array[slot.index].IsSameAs(str, m_caseSensitive) )
+                break;
+        }
+    }
+}
+
+int wxArrayStringIndex::Index(const wxString& str) const
+{
+    wxCHECK_MSG( m_array.size() == m_count, wxNOT_FOUND,
+                 "Rebuild() must be called after modifying the array" );
+
+    const size_t mask = m_slots.size() - 1;
+    const size_t hash = GetHash(str);
+
+    for ( size_t i = hash & mask; ; i = (i + 1) & mask )
+    {
+        const Slot& slot = m_slots[i];
+        if ( slot.index == wxNOT_FOUND )
+            return wxNOT_FOUND;
+
+        if ( slot.hash == hash &&
+                m_array[slot.index].IsSameAs(str, m_caseSensitive) )
+            return slot.index;
+    }
+}
+
 // ===========================================================================
 // wxJoin and wxSplit
 // ===========================================================================
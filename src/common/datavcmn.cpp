@@ -30,6 +30,8 @@
 #include "wx/renderer.h"
 #include "wx/uilocale.h"
 
+#include <algorithm>
+
 #if wxUSE_ACCESSIBILITY
     #include "wx/access.h"
 #endif // wxUSE_ACCESSIBILITY
@@ -674,6 +676,357 @@ unsigned int wxDataViewVirtualListModel::GetChildren( const wxDataViewItem &WXUN
 
 #endif  // __WXMAC__
 
+// ---------------------------------------------------------
+// wxDataViewFilterListModel
+// ---------------------------------------------------------
+
+// Notifier connected to the source model and updating the filter model when
+// the source changes.
+class wxDataViewFilterListModel::SourceNotifier : public wxDataViewModelNotifier
+{
+public:
+    explicit SourceNotifier(wxDataViewFilterListModel* model)
+        : m_model(model)
+    {
+    }
+
+    // When rows are added to or deleted from the source model, the indices of
+    // the shown rows after them must be updated, but the filter only needs to
+    // be evaluated for the new rows. This is only possible if we can find the
+    // indices of the rows in the source model, which is not the case for the
+    // deleted items of wxDataViewIndexListModel, so fall back to recomputing
+    // everything if we can't.
+    virtual bool ItemAdded(const wxDataViewItem& parent,
+                           const wxDataViewItem& item) override
+    {
+        return ItemsAdded(parent, wxDataViewItemArray(1, item));
+    }
+
+    virtual bool ItemDeleted(const wxDataViewItem& parent,
+                             const wxDataViewItem& item) override
+    {
+        return ItemsDeleted(parent, wxDataViewItemArray(1, item));
+    }
+
+    virtual bool ItemsAdded(const wxDataViewItem& WXUNUSED(parent),
+                            const wxDataViewItemArray& items) override
+    {
+        wxVector<unsigned int> rows;
+        if ( GetSourceRows(items, m_model->m_source->GetCount(), rows) )
+            m_model->OnSourceRowsAdded(rows);
+        else
+            m_model->Refilter();
+        return true;
+    }
+
+    virtual bool ItemsDeleted(const wxDataViewItem& WXUNUSED(parent),
+                              const wxDataViewItemArray& items) override
+    {
+        wxVector<unsigned int> rows;
+        if ( GetSourceRows(items, m_model->m_source->GetCount() + items.size(),
+                           rows) )
+            m_model->OnSourceRowsDeleted(rows);
+        else
+            m_model->Refilter();
+        return true;
+    }
+
+    virtual bool ItemChanged(const wxDataViewItem& item) override
+    {
+        m_model->OnSourceRowChanged(m_model->m_source->GetRow(item), -1);
+        return true;
+    }
+
+    virtual bool ValueChanged(const wxDataViewItem& item,
+                              unsigned int col) override
+    {
+        m_model->OnSourceRowChanged(m_model->m_source->GetRow(item), col);
+        return true;
+    }
+
+    virtual bool Cleared() override
+    {
+        m_model->Refilter();
+        return true;
+    }
+
+    virtual void Resort() override
+    {
+        m_model->Resort();
+    }
+
+private:
+    // Fill the provided vector with the sorted source rows of the given items
+    // and return true or return false if any of them is invalid, i.e. not less
+    // than the given count.
+    bool GetSourceRows(const wxDataViewItemArray& items,
+                       unsigned int count,
+                       wxVector<unsigned int>& rows) const
+    {
+        rows.reserve(items.size());
+        for ( const auto& item : items )
+        {
+            const unsigned int row = m_model->m_source->GetRow(item);
+            if ( row >= count )
+                return false;
+
+            rows.push_back(row);
+        }
+
+        std::sort(rows.begin(), rows.end());
+
+        return true;
+    }
+
+    wxDataViewFilterListModel* const m_model;
+
+    wxDECLARE_NO_COPY_CLASS(SourceNotifier);
+};
+
+wxDataViewFilterListModel::wxDataViewFilterListModel(wxDataViewListModel* source)
+    : wxDataViewVirtualListModel(source ? source->GetCount() : 0),
+      m_source(source)
+{
+    wxASSERT_MSG( m_source, "source model must be specified" );
+
+    m_source->IncRef();
+
+    m_rows.reserve(m_source->GetCount());
+    for ( unsigned int n = 0; n < m_source->GetCount(); n++ )
+        m_rows.push_back(n);
+
+    m_notifier = new SourceNotifier(this);
+    m_source->AddNotifier(m_notifier);
+}
+
+wxDataViewFilterListModel::~wxDataViewFilterListModel()
+{
+    // This also deletes the notifier.
+    m_source->RemoveNotifier(m_notifier);
+    m_source->DecRef();
+}
+
+void wxDataViewFilterListModel::SetRows(wxVector<unsigned int>& rows)
+{
+    m_rows.swap(rows);
+
+    Reset(m_rows.size());
+}
+
+void wxDataViewFilterListModel::Refilter()
+{
+    const unsigned int count = m_source->GetCount();
+
+    wxVector<unsigned int> rows;
+    for ( unsigned int n = 0; n < count; n++ )
+    {
+        if ( IsRowShown(n) )
+            rows.push_back(n);
+    }
+
+    SetRows(rows);
+}
+
+void wxDataViewFilterListModel::RefineFilter()
+{
+    wxVector<unsigned int> rows;
+    for ( auto n : m_rows )
+    {
+        if ( IsRowShown(n) )
+            rows.push_back(n);
+    }
+
+    // Avoid resetting the control if nothing has changed, this is common when
+    // refining a filter which already matches only a few rows.
+    if ( rows.size() == m_rows.size() )
+        return;
+
+    SetRows(rows);
+}
+
+void wxDataViewFilterListModel::ResetFilter()
+{
+    const unsigned int count = m_source->GetCount();
+
+    wxVector<unsigned int> rows;
+    rows.reserve(count);
+    for ( unsigned int n = 0; n < count; n++ )
+        rows.push_back(n);
+
+    SetRows(rows);
+}
+
+int wxDataViewFilterListModel::FindRow(unsigned int sourceRow) const
+{
+    const auto it = std::lower_bound(m_rows.begin(), m_rows.end(), sourceRow);
+    if ( it == m_rows.end() || *it != sourceRow )
+        return wxNOT_FOUND;
+
+    return it - m_rows.begin();
+}
+
+void wxDataViewFilterListModel::OnSourceRowChanged(unsigned int sourceRow,
+                                                   int col)
+{
+    const auto it = std::lower_bound(m_rows.begin(), m_rows.end(), sourceRow);
+    const unsigned int row = it - m_rows.begin();
+    const bool wasShown = it != m_rows.end() && *it == sourceRow;
+
+    // The change may have affected whether the row passes the filter or not.
+    if ( IsRowShown(sourceRow) )
+    {
+        if ( !wasShown )
+        {
+            m_rows.insert(it, sourceRow);
+            RowInserted(row);
+        }
+        else if ( col == -1 )
+        {
+            RowChanged(row);
+        }
+        else
+        {
+            RowValueChanged(row, col);
+        }
+    }
+    else if ( wasShown )
+    {
+        m_rows.erase(it);
+        RowDeleted(row);
+    }
+}
+
+void
+wxDataViewFilterListModel::OnSourceRowsAdded(const wxVector<unsigned int>& sourceRows)
+{
+    if ( sourceRows.size() == 1 )
+    {
+        // Shift the indices of the rows after the new one and insert it if
+        // it passes the filter.
+        const unsigned int sourceRow = sourceRows[0];
+        const auto it = std::lower_bound(m_rows.begin(), m_rows.end(), sourceRow);
+        for ( auto i = it; i != m_rows.end(); ++i )
+            ++*i;
+
+        if ( IsRowShown(sourceRow) )
+        {
+            const unsigned int row = it - m_rows.begin();
+            m_rows.insert(it, sourceRow);
+            RowInserted(row);
+        }
+
+        return;
+    }
+
+    // Merge the new rows passing the filter with the existing ones, whose
+    // indices are shifted by the number of the new rows preceding them. As
+    // there is no way to notify about inserting several rows at once, reset
+    // the model after doing it.
+    const size_t numAdded = sourceRows.size();
+
+    wxVector<unsigned int> rows;
+    rows.reserve(m_rows.size() + numAdded);
+
+    size_t n = 0;
+    for ( auto row : m_rows )
+    {
+        for ( ; n < numAdded && sourceRows[n] <= row + n; n++ )
+        {
+            if ( IsRowShown(sourceRows[n]) )
+                rows.push_back(sourceRows[n]);
+        }
+
+        rows.push_back(row + n);
+    }
+
+    for ( ; n < numAdded; n++ )
+    {
+        if ( IsRowShown(sourceRows[n]) )
+            rows.push_back(sourceRows[n]);
+    }
+
+    SetRows(rows);
+}
+
+void
+wxDataViewFilterListModel::OnSourceRowsDeleted(const wxVector<unsigned int>& sourceRows)
+{
+    if ( sourceRows.size() == 1 )
+    {
+        // Remove the row if it was shown and shift the following ones.
+        const unsigned int sourceRow = sourceRows[0];
+        auto it = std::lower_bound(m_rows.begin(), m_rows.end(), sourceRow);
+        const unsigned int row = it - m_rows.begin();
+        const bool wasShown = it != m_rows.end() && *it == sourceRow;
+        if ( wasShown )
+            it = m_rows.erase(it);
+
+        for ( ; it != m_rows.end(); ++it )
+            --*it;
+
+        if ( wasShown )
+            RowDeleted(row);
+
+        return;
+    }
+
+    // Remove all deleted rows and shift the remaining ones by the number of
+    // the deleted rows preceding them in a single pass.
+    const size_t numDeleted = sourceRows.size();
+
+    wxVector<unsigned int> rows;
+    rows.reserve(m_rows.size());
+
+    wxArrayInt deleted;
+
+    size_t n = 0;
+    for ( size_t row = 0; row < m_rows.size(); row++ )
+    {
+        const unsigned int sourceRow = m_rows[row];
+        while ( n < numDeleted && sourceRows[n] < sourceRow )
+            n++;
+
+        if ( n < numDeleted && sourceRows[n] == sourceRow )
+            deleted.push_back(row);
+        else
+            rows.push_back(sourceRow - n);
+    }
+
+    m_rows.swap(rows);
+
+    if ( deleted.size() == 1 )
+        RowDeleted(deleted[0]);
+    else if ( !deleted.empty() )
+        RowsDeleted(deleted);
+}
+
+void wxDataViewFilterListModel::GetValueByRow(wxVariant& variant,
+                                              unsigned int row,
+                                              unsigned int col) const
+{
+    m_source->GetValueByRow(variant, m_rows[row], col);
+}
+
+bool wxDataViewFilterListModel::SetValueByRow(const wxVariant& variant,
+                                              unsigned int row,
+                                              unsigned int col)
+{
+    return m_source->SetValueByRow(variant, m_rows[row], col);
+}
+
+bool wxDataViewFilterListModel::GetAttrByRow(unsigned int row,
+                                             unsigned int col,
+                                             wxDataViewItemAttr& attr) const
+{
+    return m_source->GetAttrByRow(m_rows[row], col, attr);
+}
+
+bool wxDataViewFilterListModel::IsEnabledByRow(unsigned int row,
+                                               unsigned int col) const
+{
+    return m_source->IsEnabledByRow(m_rows[row], col);
+}
+
 //-----------------------------------------------------------------------------
 // wxDataViewIconText
 //-----------------------------------------------------------------------------
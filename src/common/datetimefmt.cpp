@@ -85,33 +85,332 @@ static const int MIN_PER_HOUR = 60;
 namespace
 {
 
-// all the functions below taking non-const wxString::const_iterator p advance
-// it until the end of the match
+// all the functions below taking non-const iterator p advance it until the
+// end of the match
+
+// Return the character code of the given character, these overloads allow
+// the functions below to work with both wxString iterators and char pointers.
+inline wxUint32 GetCharCode(const wxUniChar& ch) { return ch.GetValue(); }
+inline wxUint32 GetCharCode(char ch) { return static_cast<unsigned char>(ch); }
+
+inline bool IsSpaceChar(const wxUniChar& ch) { return wxIsspace(ch) != 0; }
+inline bool IsSpaceChar(char ch)
+{
+    return ch == ' ' || (ch >= '\t' && ch <= '\r');
+}
 
 // Scans all digits (but no more than len) and returns the resulting number.
 // Optionally writes number of digits scanned to numScannedDigits.
+template <typename Iter>
 bool GetNumericToken(size_t len,
-                     wxString::const_iterator& p,
-                     const wxString::const_iterator& end,
+                     Iter& p,
+                     const Iter& end,
                      unsigned long *number,
                      size_t *numScannedDigits = nullptr)
 {
-    size_t n = 1;
-    wxString s;
-    while ( p != end && wxIsdigit(*p) )
+    size_t n = 0;
+    unsigned long value = 0;
+    bool overflow = false;
+    while ( p != end )
     {
-        s += *p++;
+        const wxUint32 digit = GetCharCode(*p) - '0';
+        if ( digit > 9 )
+            break;
+
+        ++p;
 
-        if ( len && ++n > len )
+        if ( value > (ULONG_MAX - digit) / 10 )
+            overflow = true;
+        value = value*10 + digit;
+
+        if ( ++n == len )
             break;
     }
 
     if (numScannedDigits)
     {
-        *numScannedDigits = n - 1;
+        *numScannedDigits = n;
+    }
+
+    if ( !n || overflow )
+        return false;
+
+    *number = value;
+    return true;
+}
+
+// Scans exactly len digits.
+template <typename Iter>
+bool GetFixedNumericToken(size_t len,
+                          Iter& p,
+                          const Iter& end,
+                          unsigned long *number)
+{
+    size_t numScannedDigits;
+    return GetNumericToken(len, p, end, number, &numScannedDigits) &&
+            numScannedDigits == len;
+}
+
+// Checks that the next character is the given one and skips it.
+template <typename Iter>
+bool MatchChar(Iter& p, const Iter& end, wxUint32 ch)
+{
+    if ( p == end || GetCharCode(*p) != ch )
+        return false;
+
+    ++p;
+    return true;
+}
+
+// The fields of date and time found by the parsing functions.
+struct ParsedDateTime
+{
+    int year = 0;
+    wxDateTime::Month mon = wxDateTime::Inv_Month;
+    wxDateTime::wxDateTime_t mday = 0,
+                             hour = 0,
+                             min = 0,
+                             sec = 0,
+                             msec = 0;
+
+    bool haveYear = false,
+         haveMon = false,
+         haveDay = false,
+         haveHour = false,
+         haveMin = false,
+         haveSec = false,
+         haveMsec = false;
+
+    // Parse "%Y-%m-%d" or "%H:%M:%S" using the same rules as ParseFormat().
+    template <typename Iter>
+    bool ParseISODate(Iter& p, const Iter& end);
+
+    template <typename Iter>
+    bool ParseISOTime(Iter& p, const Iter& end);
+
+    // Set the date to the parsed fields, taking the missing ones from dateDef
+    // if it's valid, the date itself if it is or today otherwise, just as
+    // ParseFormat() does. Returns false if the date is invalid.
+    bool SetTo(wxDateTime& dt, const wxDateTime& dateDef) const;
+};
+
+template <typename Iter>
+bool ParsedDateTime::ParseISODate(Iter& p, const Iter& end)
+{
+    unsigned long y, m, d;
+    if ( !GetNumericToken(4, p, end, &y) ||
+            !MatchChar(p, end, '-') ||
+                !GetNumericToken(2, p, end, &m) || !m || m > 12 ||
+                    !MatchChar(p, end, '-') ||
+                        !GetNumericToken(2, p, end, &d) || !d || d > 31 )
+    {
+        return false;
+    }
+
+    year = static_cast<int>(y);
+    mon = static_cast<wxDateTime::Month>(m - 1);
+    mday = static_cast<wxDateTime::wxDateTime_t>(d);
+    haveYear = haveMon = haveDay = true;
+
+    return true;
+}
+
+template <typename Iter>
+bool ParsedDateTime::ParseISOTime(Iter& p, const Iter& end)
+{
+    unsigned long h, m, s;
+    if ( !GetNumericToken(2, p, end, &h) || h > 23 ||
+            !MatchChar(p, end, ':') ||
+                !GetNumericToken(2, p, end, &m) || m > 59 ||
+                    !MatchChar(p, end, ':') ||
+                        !GetNumericToken(2, p, end, &s) || s > 61 )
+    {
+        return false;
     }
 
-    return !s.empty() && s.ToULong(number);
+    hour = static_cast<wxDateTime::wxDateTime_t>(h);
+    min = static_cast<wxDateTime::wxDateTime_t>(m);
+    sec = static_cast<wxDateTime::wxDateTime_t>(s);
+    haveHour = haveMin = haveSec = true;
+
+    return true;
+}
+
+bool ParsedDateTime::SetTo(wxDateTime& dt, const wxDateTime& dateDef) const
+{
+    wxDateTime::Tm tm;
+    if ( haveYear && haveMon && haveDay && haveHour && haveMin && haveSec )
+    {
+        // Avoid the relatively expensive conversion of the default date to
+        // broken down time if we need only its milliseconds, which don't
+        // depend on the time zone.
+        const wxDateTime& def = dateDef.IsValid() ? dateDef : dt;
+        if ( def.IsValid() )
+        {
+            const long ms = (def.GetValue() % 1000).ToLong();
+            tm.msec = static_cast<wxDateTime::wxDateTime_t>(ms < 0 ? ms + 1000
+                                                                   : ms);
+        }
+        else
+        {
+            tm.msec = 0;
+        }
+    }
+    else if ( dateDef.IsValid() )
+    {
+        tm = dateDef.GetTm();
+    }
+    else if ( dt.IsValid() )
+    {
+        tm = dt.GetTm();
+    }
+    else
+    {
+        tm = wxDateTime::Today().GetTm();
+    }
+
+    if ( haveMon )
+        tm.mon = mon;
+
+    if ( haveYear )
+        tm.year = year;
+
+    if ( haveDay )
+    {
+        if ( mday > wxDateTime::GetNumberOfDays(tm.mon, tm.year) )
+            return false;
+
+        tm.mday = mday;
+    }
+
+    if ( haveHour )
+        tm.hour = hour;
+
+    if ( haveMin )
+        tm.min = min;
+
+    if ( haveSec )
+        tm.sec = sec;
+
+    if ( haveMsec )
+        tm.msec = msec;
+
+    dt.Set(tm);
+
+    return true;
+}
+
+// Parse the date in RFC 3339 format and return the number of milliseconds
+// since the Epoch corresponding to it.
+template <typename Iter>
+bool ParseRfc3339At(Iter& p, const Iter& end, wxLongLong* value)
+{
+    unsigned long year, mon, mday, hour, min, sec;
+    if ( !GetFixedNumericToken(4, p, end, &year) ||
+            !MatchChar(p, end, '-') ||
+                !GetFixedNumericToken(2, p, end, &mon) || !mon || mon > 12 ||
+                    !MatchChar(p, end, '-') ||
+                        !GetFixedNumericToken(2, p, end, &mday) || !mday ||
+                            mday > wxDateTime::GetNumberOfDays
+                                   (
+                                    static_cast<wxDateTime::Month>(mon - 1),
+                                    static_cast<int>(year)
+                                   ) )
+    {
+        return false;
+    }
+
+    // RFC 3339 allows using a space or a lower case letter as separator too.
+    if ( !MatchChar(p, end, 'T') && !MatchChar(p, end, 't') &&
+            !MatchChar(p, end, ' ') )
+        return false;
+
+    if ( !GetFixedNumericToken(2, p, end, &hour) || hour > 23 ||
+            !MatchChar(p, end, ':') ||
+                !GetFixedNumericToken(2, p, end, &min) || min > 59 ||
+                    !MatchChar(p, end, ':') ||
+                        !GetFixedNumericToken(2, p, end, &sec) || sec > 60 )
+    {
+        return false;
+    }
+
+    // Fractional seconds may have any number of digits, but we only use the
+    // first 3 of them.
+    unsigned long msec = 0;
+    if ( MatchChar(p, end, '.') )
+    {
+        size_t numDigits;
+        if ( !GetNumericToken(3, p, end, &msec, &numDigits) )
+            return false;
+
+        for ( ; numDigits < 3; numDigits++ )
+            msec *= 10;
+
+        unsigned long rest;
+        GetNumericToken(0, p, end, &rest);
+    }
+
+    long offset;
+    if ( MatchChar(p, end, 'Z') || MatchChar(p, end, 'z') )
+    {
+        offset = 0;
+    }
+    else
+    {
+        const bool minus = MatchChar(p, end, '-');
+        if ( !minus && !MatchChar(p, end, '+') )
+            return false;
+
+        unsigned long offHours, offMinutes;
+        if ( !GetFixedNumericToken(2, p, end, &offHours) || offHours > 23 ||
+                !MatchChar(p, end, ':') ||
+                    !GetFixedNumericToken(2, p, end, &offMinutes) ||
+                        offMinutes > 59 )
+        {
+            return false;
+        }
+
+        offset = 3600*offHours + 60*offMinutes;
+        if ( minus )
+            offset = -offset;
+    }
+
+    // Compute the number of days since the Epoch in the proleptic Gregorian
+    // calendar directly, as the time zone is known there is no need to use
+    // the (much slower) standard library functions.
+    const long y = static_cast<long>(year) - (mon <= 2);
+    const long era = (y >= 0 ? y : y - 399) / 400;
+    const long yoe = y - era*400;
+    const long doy = static_cast<long>(153*(mon > 2 ? mon - 3 : mon + 9) + 2)/5
+                        + static_cast<long>(mday) - 1;
+    const long days = era*146097 + yoe*365 + yoe/4 - yoe/100 + doy - 719468;
+
+    const long secs = static_cast<long>(3600*hour + 60*min + sec) - offset;
+
+    *value = wxLongLong(days)*86400 + secs;
+    *value *= 1000;
+    *value += static_cast<long>(msec);
+
+    return true;
+}
+
+// Append the number padded with zeroes to the given width.
+inline void AppendNumber(wxString& s, unsigned value, int width)
+{
+    char buf[16];
+    int n = 0;
+    do
+    {
+        buf[n++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    while ( value );
+
+    while ( n < width )
+        buf[n++] = '0';
+
+    while ( n )
+        s += buf[--n];
 }
 
 // scans all alphabetic characters and returns the resulting string
@@ -743,6 +1042,362 @@ wxString wxDateTime::Format(const wxString& formatp, const TimeZone& tz) const
     return res;
 }
 
+// ----------------------------------------------------------------------------
+// ISO 8601 formatting
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// These functions use the same representation as strftime() does for the
+// years with 4 digits, other years must be formatted using Format().
+inline bool CanFormatISO(const wxDateTime::Tm& tm)
+{
+    return tm.year >= 1000 && tm.year <= 9999;
+}
+
+void AppendISODate(wxString& s, const wxDateTime::Tm& tm)
+{
+    AppendNumber(s, tm.year, 4);
+    s += '-';
+    AppendNumber(s, tm.mon + 1, 2);
+    s += '-';
+    AppendNumber(s, tm.mday, 2);
+}
+
+void AppendISOTime(wxString& s, const wxDateTime::Tm& tm)
+{
+    AppendNumber(s, tm.hour, 2);
+    s += ':';
+    AppendNumber(s, tm.min, 2);
+    s += ':';
+    AppendNumber(s, tm.sec, 2);
+}
+
+} // anonymous namespace
+
+wxString wxDateTime::FormatISODate() const
+{
+    const Tm tm = GetTm();
+    if ( !CanFormatISO(tm) )
+        return Format(wxS("%Y-%m-%d"));
+
+    wxString s;
+    s.reserve(10);
+    AppendISODate(s, tm);
+
+    return s;
+}
+
+wxString wxDateTime::FormatISOTime() const
+{
+    wxString s;
+    s.reserve(8);
+    AppendISOTime(s, GetTm());
+
+    return s;
+}
+
+wxString wxDateTime::FormatISOCombined(char sep) const
+{
+    const Tm tm = GetTm();
+    if ( !CanFormatISO(tm) )
+        return FormatISODate() + sep + FormatISOTime();
+
+    wxString s;
+    s.reserve(19);
+    AppendISODate(s, tm);
+    s += sep;
+    AppendISOTime(s, tm);
+
+    return s;
+}
+
+// ============================================================================
+// wxDateTimeFormat
+// ============================================================================
+
+wxDateTimeFormat::wxDateTimeFormat(const wxString& format)
+    : m_format(format),
+      m_isASCII(true)
+{
+    const auto addSpec = [this](char spec)
+    {
+        const Field field = { spec, wxUniChar() };
+        m_fields.push_back(field);
+    };
+
+    const auto addLiteral = [this](const wxUniChar& ch)
+    {
+        const Field field = { 0, ch };
+        m_fields.push_back(field);
+    };
+
+    for ( wxString::const_iterator p = format.begin(); p != format.end(); ++p )
+    {
+        const wxUniChar ch = *p;
+        if ( ch != '%' )
+        {
+            if ( wxIsspace(ch) )
+            {
+                const Field field = { ' ', ch };
+                m_fields.push_back(field);
+            }
+            else
+            {
+                if ( !ch.IsAscii() )
+                    m_isASCII = false;
+
+                addLiteral(ch);
+            }
+
+            continue;
+        }
+
+        if ( ++p == format.end() )
+        {
+            m_fields.clear();
+            return;
+        }
+
+        const wxUniChar spec = *p;
+        switch ( spec.GetValue() )
+        {
+            case 'Y':
+            case 'y':
+            case 'm':
+            case 'd':
+            case 'H':
+            case 'M':
+            case 'S':
+            case 'l':
+                addSpec(static_cast<char>(spec.GetValue()));
+                break;
+
+            case 'F':
+                addSpec('Y');
+                addLiteral('-');
+                addSpec('m');
+                addLiteral('-');
+                addSpec('d');
+                break;
+
+            case 'T':
+                addSpec('H');
+                addLiteral(':');
+                addSpec('M');
+                addLiteral(':');
+                addSpec('S');
+                break;
+
+            case '%':
+                addLiteral('%');
+                break;
+
+            default:
+                // Not supported, fall back to the wxDateTime functions.
+                m_fields.clear();
+                return;
+        }
+    }
+}
+
+wxString
+wxDateTimeFormat::Format(const wxDateTime& dt,
+                         const wxDateTime::TimeZone& tz) const
+{
+    if ( m_fields.empty() )
+        return dt.Format(m_format, tz);
+
+    const wxDateTime::Tm tm = dt.GetTm(tz);
+    if ( !CanFormatISO(tm) )
+        return dt.Format(m_format, tz);
+
+    wxString s;
+    s.reserve(2*m_fields.size());
+
+    for ( const Field& field : m_fields )
+    {
+        switch ( field.spec )
+        {
+            case 0:
+            case ' ':
+                s += field.ch;
+                break;
+
+            case 'Y':
+                AppendNumber(s, tm.year, 4);
+                break;
+
+            case 'y':
+                AppendNumber(s, tm.year % 100, 2);
+                break;
+
+            case 'm':
+                AppendNumber(s, tm.mon + 1, 2);
+                break;
+
+            case 'd':
+                AppendNumber(s, tm.mday, 2);
+                break;
+
+            case 'H':
+                AppendNumber(s, tm.hour, 2);
+                break;
+
+            case 'M':
+                AppendNumber(s, tm.min, 2);
+                break;
+
+            case 'S':
+                AppendNumber(s, tm.sec, 2);
+                break;
+
+            case 'l':
+                AppendNumber(s, tm.msec, 3);
+                break;
+        }
+    }
+
+    return s;
+}
+
+template <typename Iter>
+bool
+wxDateTimeFormat::DoParse(wxDateTime& dt,
+                          Iter& p,
+                          const Iter& end,
+                          const wxDateTime& dateDef) const
+{
+    // The checks here must be the same as in wxDateTime::ParseFormat().
+    ParsedDateTime parsed;
+    unsigned long num;
+    for ( const Field& field : m_fields )
+    {
+        switch ( field.spec )
+        {
+            case 0:
+                if ( !MatchChar(p, end, field.ch.GetValue()) )
+                    return false;
+                break;
+
+            case ' ':
+                while ( p != end && IsSpaceChar(*p) )
+                    ++p;
+                break;
+
+            case 'Y':
+                if ( !GetNumericToken(4, p, end, &num) )
+                    return false;
+
+                parsed.haveYear = true;
+                parsed.year = static_cast<int>(num);
+                break;
+
+            case 'y':
+                if ( !GetNumericToken(2, p, end, &num) || num > 99 )
+                    return false;
+
+                parsed.haveYear = true;
+                parsed.year = (num > 30 ? 1900 : 2000) + static_cast<int>(num);
+                break;
+
+            case 'm':
+                if ( !GetNumericToken(2, p, end, &num) || !num || num > 12 )
+                    return false;
+
+                parsed.haveMon = true;
+                parsed.mon = static_cast<wxDateTime::Month>(num - 1);
+                break;
+
+            case 'd':
+                if ( !GetNumericToken(2, p, end, &num) || !num || num > 31 )
+                    return false;
+
+                parsed.haveDay = true;
+                parsed.mday = static_cast<wxDateTime::wxDateTime_t>(num);
+                break;
+
+            case 'H':
+                if ( !GetNumericToken(2, p, end, &num) || num > 23 )
+                    return false;
+
+                parsed.haveHour = true;
+                parsed.hour = static_cast<wxDateTime::wxDateTime_t>(num);
+                break;
+
+            case 'M':
+                if ( !GetNumericToken(2, p, end, &num) || num > 59 )
+                    return false;
+
+                parsed.haveMin = true;
+                parsed.min = static_cast<wxDateTime::wxDateTime_t>(num);
+                break;
+
+            case 'S':
+                if ( !GetNumericToken(2, p, end, &num) || num > 61 )
+                    return false;
+
+                parsed.haveSec = true;
+                parsed.sec = static_cast<wxDateTime::wxDateTime_t>(num);
+                break;
+
+            case 'l':
+                if ( !GetNumericToken(3, p, end, &num) )
+                    return false;
+
+                parsed.haveMsec = true;
+                parsed.msec = static_cast<wxDateTime::wxDateTime_t>(num);
+                break;
+        }
+    }
+
+    return parsed.SetTo(dt, dateDef);
+}
+
+bool
+wxDateTimeFormat::Parse(wxDateTime& dt,
+                        const wxString& date,
+                        const wxDateTime& dateDef,
+                        wxString::const_iterator *end) const
+{
+    if ( m_fields.empty() )
+        return dt.ParseFormat(date, m_format, dateDef, end);
+
+    wxCHECK_MSG( end, false, "end iterator pointer must be specified" );
+
+    wxString::const_iterator p = date.begin();
+    if ( !DoParse(dt, p, date.end(), dateDef) )
+        return false;
+
+    *end = p;
+
+    return true;
+}
+
+const char*
+wxDateTimeFormat::Parse(wxDateTime& dt,
+                        const char* date,
+                        const char* end,
+                        const wxDateTime& dateDef) const
+{
+    if ( m_fields.empty() || !m_isASCII )
+    {
+        const wxString dateStr(date, end - date);
+
+        wxString::const_iterator endParse;
+        if ( !dt.ParseFormat(dateStr, m_format, dateDef, &endParse) )
+            return nullptr;
+
+        return date + dateStr.IterOffsetInMBStr(endParse);
+    }
+
+    if ( !DoParse(dt, date, end, dateDef) )
+        return nullptr;
+
+    return date;
+}
+
 bool
 wxDateTime::ParseRFC822TimeZone(wxString::const_iterator *iterator,
                                 const wxString::const_iterator &pEnd)
@@ -1035,6 +1690,95 @@ const wchar_t* wxDateTime::ParseRfc822Date(const wchar_t* date)
     return date + (end - dateStr.begin());
 }
 
+// ----------------------------------------------------------------------------
+// ISO 8601 and RFC 3339 parsing
+// ----------------------------------------------------------------------------
+
+bool wxDateTime::ParseISODate(const wxString& date)
+{
+    wxString::const_iterator p = date.begin();
+    const wxString::const_iterator end = date.end();
+
+    ParsedDateTime parsed;
+    return parsed.ParseISODate(p, end) && p == end &&
+            parsed.SetTo(*this, wxDefaultDateTime);
+}
+
+bool wxDateTime::ParseISOTime(const wxString& time)
+{
+    wxString::const_iterator p = time.begin();
+    const wxString::const_iterator end = time.end();
+
+    ParsedDateTime parsed;
+    return parsed.ParseISOTime(p, end) && p == end &&
+            parsed.SetTo(*this, wxDefaultDateTime);
+}
+
+bool wxDateTime::ParseISOCombined(const wxString& datetime, char sep)
+{
+    wxString::const_iterator p = datetime.begin();
+    const wxString::const_iterator end = datetime.end();
+
+    ParsedDateTime parsed;
+    return parsed.ParseISODate(p, end) &&
+            MatchChar(p, end, static_cast<unsigned char>(sep)) &&
+                parsed.ParseISOTime(p, end) && p == end &&
+                    parsed.SetTo(*this, wxDefaultDateTime);
+}
+
+bool wxDateTime::ParseISODate(const char* date, const char* end)
+{
+    ParsedDateTime parsed;
+    return parsed.ParseISODate(date, end) && date == end &&
+            parsed.SetTo(*this, wxDefaultDateTime);
+}
+
+bool wxDateTime::ParseISOTime(const char* time, const char* end)
+{
+    ParsedDateTime parsed;
+    return parsed.ParseISOTime(time, end) && time == end &&
+            parsed.SetTo(*this, wxDefaultDateTime);
+}
+
+bool
+wxDateTime::ParseISOCombined(const char* datetime, const char* end, char sep)
+{
+    ParsedDateTime parsed;
+    return parsed.ParseISODate(datetime, end) &&
+            MatchChar(datetime, end, static_cast<unsigned char>(sep)) &&
+                parsed.ParseISOTime(datetime, end) && datetime == end &&
+                    parsed.SetTo(*this, wxDefaultDateTime);
+}
+
+bool
+wxDateTime::ParseRfc3339Date(const wxString& date,
+                             wxString::const_iterator *end)
+{
+    wxCHECK_MSG( end, false, "end iterator pointer must be specified" );
+
+    wxString::const_iterator p = date.begin();
+
+    wxLongLong value;
+    if ( !ParseRfc3339At(p, date.end(), &value) )
+        return false;
+
+    m_time = value;
+    *end = p;
+
+    return true;
+}
+
+const char* wxDateTime::ParseRfc3339Date(const char* date, const char* end)
+{
+    wxLongLong value;
+    if ( !ParseRfc3339At(date, end, &value) )
+        return nullptr;
+
+    m_time = value;
+
+    return date;
+}
+
 bool
 wxDateTime::ParseFormat(const wxString& date,
                         const wxString& format,
@@ -1236,15 +1980,15 @@ wxDateTime::ParseFormat(const wxString& date,
 
             case wxT('F'):       // ISO 8601 date
                 {
-                    wxDateTime dt = ParseFormatAt(input, end, wxS("%Y-%m-%d"));
-                    if ( !dt.IsValid() )
+                    ParsedDateTime parsed;
+                    if ( !parsed.ParseISODate(input, end) ||
+                            parsed.mday > GetNumberOfDays(parsed.mon,
+                                                          parsed.year) )
                         return false;
 
-                    const Tm tm = dt.GetTm();
-
-                    year = tm.year;
-                    mon = tm.mon;
-                    mday = tm.mday;
+                    year = parsed.year;
+                    mon = parsed.mon;
+                    mday = parsed.mday;
 
                     haveDay = haveMon = haveYear = true;
                 }
@@ -1390,19 +2134,17 @@ wxDateTime::ParseFormat(const wxString& date,
 
             case wxT('T'):       // time as %H:%M:%S
                 {
-                    const wxDateTime
-                        dt = ParseFormatAt(input, end, wxS("%H:%M:%S"));
-                    if ( !dt.IsValid() )
+                    ParsedDateTime parsed;
+                    if ( !parsed.ParseISOTime(input, end) )
                         return false;
 
                     haveHour =
                     haveMin =
                     haveSec = true;
 
-                    const Tm tm = dt.GetTm();
-                    hour = tm.hour;
-                    min = tm.min;
-                    sec = tm.sec;
+                    hour = parsed.hour;
+                    min = parsed.min;
+                    sec = parsed.sec;
                 }
                 break;
 
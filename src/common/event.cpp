@@ -44,7 +44,12 @@
 #include "wx/thread.h"
 
 #if wxUSE_BASE
+    #include "wx/time.h"
+    #include "wx/timer.h"
+
     #include <memory>
+    #include <unordered_map>
+    #include <vector>
 #endif // wxUSE_BASE
 
 #if wxUSE_GUI
@@ -360,6 +365,7 @@ wxEvent::wxEvent(int theId, wxEventType commandType)
     m_skipped = false;
     m_callbackUserData = nullptr;
     m_handlerToProcessOnlyIn = nullptr;
+    m_nextPending = nullptr;
     m_isCommandEvent = false;
     m_propagationLevel = wxEVENT_PROPAGATE_NONE;
     m_propagatedFrom = nullptr;
@@ -375,6 +381,7 @@ wxEvent::wxEvent(const wxEvent& src)
     , m_id(src.m_id)
     , m_callbackUserData(src.m_callbackUserData)
     , m_handlerToProcessOnlyIn(nullptr)
+    , m_nextPending(nullptr)
     , m_propagationLevel(src.m_propagationLevel)
     , m_propagatedFrom(nullptr)
     , m_skipped(src.m_skipped)
@@ -1159,6 +1166,334 @@ void wxEventHashTable::GrowEventTypeTable()
     delete[] oldEventTypeTable;
 }
 
+// ----------------------------------------------------------------------------
+// wxDynamicEventIndex: dynamic event table entries grouped by event type
+// ----------------------------------------------------------------------------
+
+// The index is only created when the number of dynamic event table entries
+// reaches this value, as linear search is as fast as using the index for
+// fewer entries.
+static const size_t wxDYNAMIC_EVENTS_INDEX_THRESHOLD = 16;
+
+class wxDynamicEventIndex
+{
+public:
+    typedef wxVector<wxDynamicEventTableEntry*> Entries;
+
+    wxDynamicEventIndex() = default;
+
+    // Return the entries for the given type, in the order in which they were
+    // bound, or null if there are none.
+    //
+    // Notice that the returned pointer remains valid even if more entries are
+    // added to the index, as std::unordered_map never moves its elements.
+    Entries* Find(wxEventType eventType)
+    {
+        const auto it = m_entries.find(eventType);
+        return it == m_entries.end() ? nullptr : &it->second;
+    }
+
+    void Add(wxDynamicEventTableEntry* entry)
+    {
+        m_entries[entry->m_eventType].push_back(entry);
+    }
+
+    // Mark the entry as removed by replacing it with null, as we can't remove
+    // it from the vector if it's currently being iterated over.
+    void Remove(wxDynamicEventTableEntry* entry)
+    {
+        Entries* const entries = Find(entry->m_eventType);
+        wxCHECK_RET( entries, "removing entry not in the index?" );
+
+        for ( size_t n = entries->size(); n; n-- )
+        {
+            if ( (*entries)[n - 1] == entry )
+            {
+                (*entries)[n - 1] = nullptr;
+                m_needsPruning = true;
+                return;
+            }
+        }
+
+        wxFAIL_MSG( "removing entry not in the index?" );
+    }
+
+    bool NeedsPruning() const { return m_needsPruning; }
+
+    // Really remove the entries previously marked as removed.
+    void Prune()
+    {
+        // Notice that we don't erase the empty vectors, to keep the pointers
+        // returned by Find() valid.
+        for ( auto& kv : m_entries )
+        {
+            Entries& entries = kv.second;
+
+            size_t nNew = 0;
+            for ( size_t n = 0; n != entries.size(); n++ )
+            {
+                if ( entries[n] )
+                    entries[nNew++] = entries[n];
+            }
+
+            entries.resize(nNew);
+        }
+
+        m_needsPruning = false;
+    }
+
+private:
+    std::unordered_map<wxEventType, Entries> m_entries;
+
+    // True if Remove() was called since the last call to Prune().
+    bool m_needsPruning = false;
+
+    wxDECLARE_NO_COPY_CLASS(wxDynamicEventIndex);
+};
+
+// ----------------------------------------------------------------------------
+// wxEventCoalescer: implementation of wxEvtHandler::QueueCoalescedEvent()
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Information about the coalesced events with the given type and id.
+struct wxCoalescedEventSlot
+{
+    wxCoalescedEventSlot(wxEventType eventType_, int id_)
+        : eventType(eventType_),
+          id(id_)
+    {
+    }
+
+    const wxEventType eventType;
+    const int id;
+
+    // The latest queued event: if it's non-null, its processing has already
+    // been scheduled, either by queuing wxCoalescedEventCall or by starting
+    // the timer.
+    wxEvent* event = nullptr;
+
+    // The minimal interval between processing the events in milliseconds and
+    // the time when the last event was processed.
+    int minInterval = 0;
+    wxMilliClock_t lastProcessed = 0;
+
+#if wxUSE_TIMER
+    // The timer used to process the event when the interval expires, only
+    // created if needed and only used from the main thread.
+    std::unique_ptr<wxTimer> timer;
+#endif // wxUSE_TIMER
+};
+
+} // anonymous namespace
+
+class wxEventCoalescer
+{
+public:
+    explicit wxEventCoalescer(wxEvtHandler& handler)
+        : m_handler(handler)
+    {
+    }
+
+    ~wxEventCoalescer()
+    {
+        DeletePendingEvents();
+    }
+
+    void Queue(wxEvent* event);
+    void SetMinInterval(wxEventType eventType, int id, int milliseconds);
+
+    // Process the latest event of the given slot, called from the main thread.
+    void Process(wxCoalescedEventSlot& slot);
+
+    void DeletePendingEvents();
+
+private:
+    // Find or create the slot for the given key, must be called with m_cs held.
+    wxCoalescedEventSlot& GetSlot(wxEventType eventType, int id);
+
+    wxEvtHandler& m_handler;
+
+    wxCriticalSection m_cs;
+
+    // The slots are never removed and their addresses must not change, as
+    // they're referenced by the pending wxCoalescedEventCall objects.
+    std::vector<std::unique_ptr<wxCoalescedEventSlot>> m_slots;
+
+    wxDECLARE_NO_COPY_CLASS(wxEventCoalescer);
+};
+
+namespace
+{
+
+// The event queued to the handler to process the latest coalesced event.
+class wxCoalescedEventCall : public wxAsyncMethodCallEvent
+{
+public:
+    wxCoalescedEventCall(wxEvtHandler* handler,
+                         wxEventCoalescer& coalescer,
+                         wxCoalescedEventSlot& slot,
+                         wxEventCategory category)
+        : wxAsyncMethodCallEvent(handler),
+          m_coalescer(coalescer),
+          m_slot(slot),
+          m_category(category)
+    {
+    }
+
+    virtual wxEvent *Clone() const override
+    {
+        return new wxCoalescedEventCall(*this);
+    }
+
+    // Use the category of the real event to allow YieldFor() to handle it
+    // correctly.
+    virtual wxEventCategory GetEventCategory() const override
+    {
+        return m_category;
+    }
+
+    virtual void Execute() override
+    {
+        m_coalescer.Process(m_slot);
+    }
+
+private:
+    wxEventCoalescer& m_coalescer;
+    wxCoalescedEventSlot& m_slot;
+    const wxEventCategory m_category;
+};
+
+#if wxUSE_TIMER
+
+class wxCoalescedEventTimer : public wxTimer
+{
+public:
+    wxCoalescedEventTimer(wxEventCoalescer& coalescer,
+                          wxCoalescedEventSlot& slot)
+        : m_coalescer(coalescer),
+          m_slot(slot)
+    {
+    }
+
+    virtual void Notify() override
+    {
+        m_coalescer.Process(m_slot);
+    }
+
+private:
+    wxEventCoalescer& m_coalescer;
+    wxCoalescedEventSlot& m_slot;
+
+    wxDECLARE_NO_COPY_CLASS(wxCoalescedEventTimer);
+};
+
+#endif // wxUSE_TIMER
+
+} // anonymous namespace
+
+wxCoalescedEventSlot& wxEventCoalescer::GetSlot(wxEventType eventType, int id)
+{
+    for ( const auto& slot : m_slots )
+    {
+        if ( slot->eventType == eventType && slot->id == id )
+            return *slot;
+    }
+
+    m_slots.emplace_back(new wxCoalescedEventSlot(eventType, id));
+    return *m_slots.back();
+}
+
+void wxEventCoalescer::Queue(wxEvent* event)
+{
+    wxCoalescedEventSlot* slot;
+    wxEventCategory category;
+    {
+        wxCriticalSectionLocker lock(m_cs);
+
+        slot = &GetSlot(event->GetEventType(), event->GetId());
+
+        // Notice that we can't use the event after leaving the critical
+        // section as it could be already replaced and deleted by then.
+        category = event->GetEventCategory();
+
+        const bool scheduled = slot->event != nullptr;
+
+        delete slot->event;
+        slot->event = event;
+
+        // Nothing else to do if the previous event hadn't been processed yet,
+        // the new one will be processed instead of it.
+        if ( scheduled )
+            return;
+    }
+
+    m_handler.QueueEvent(new wxCoalescedEventCall(&m_handler, *this, *slot,
+                                                  category));
+}
+
+void wxEventCoalescer::SetMinInterval(wxEventType eventType,
+                                      int id,
+                                      int milliseconds)
+{
+    wxCriticalSectionLocker lock(m_cs);
+
+    GetSlot(eventType, id).minInterval = milliseconds;
+}
+
+void wxEventCoalescer::Process(wxCoalescedEventSlot& slot)
+{
+    wxEvent* event;
+    {
+        wxCriticalSectionLocker lock(m_cs);
+
+        // This can happen if the pending events were deleted.
+        if ( !slot.event )
+            return;
+
+        if ( slot.minInterval > 0 )
+        {
+            // Use UTC time, as wxStopWatch does, as local time may jump
+            // backwards or forwards when DST starts or ends.
+            const wxMilliClock_t now = wxGetUTCTimeMillis();
+
+#if wxUSE_TIMER
+            const wxMilliClock_t next = slot.lastProcessed + slot.minInterval;
+            if ( now < next )
+            {
+                // It's too early to process this event, do it later.
+                if ( !slot.timer )
+                    slot.timer.reset(new wxCoalescedEventTimer(*this, slot));
+
+                slot.timer->StartOnce(wxMilliClockToLong(next - now));
+                return;
+            }
+#endif // wxUSE_TIMER
+
+            slot.lastProcessed = now;
+        }
+
+        event = slot.event;
+        slot.event = nullptr;
+    }
+
+    std::unique_ptr<wxEvent> eventPtr(event);
+
+    // Note that the handler, and this object with it, could be destroyed by
+    // the event handler, so don't do anything after calling it.
+    m_handler.SafelyProcessEvent(*event);
+}
+
+void wxEventCoalescer::DeletePendingEvents()
+{
+    wxCriticalSectionLocker lock(m_cs);
+
+    for ( const auto& slot : m_slots )
+        wxDELETE(slot->event);
+}
+
 // ----------------------------------------------------------------------------
 // wxEvtHandler
 // ----------------------------------------------------------------------------
@@ -1169,7 +1504,13 @@ wxEvtHandler::wxEvtHandler()
     m_previousHandler = nullptr;
     m_enabled = true;
     m_dynamicEvents = nullptr;
-    m_pendingEvents = nullptr;
+    m_dynamicEventsIndex = nullptr;
+    m_newPendingEvents = nullptr;
+    m_pendingEventsFirst =
+    m_pendingEventsLast = nullptr;
+    m_nextWithNewPendingEvents = nullptr;
+    m_isInNewPendingHandlers = false;
+    m_coalescer = nullptr;
 
     // no client data (yet)
     m_clientData = nullptr;
@@ -1205,6 +1546,7 @@ wxEvtHandler::~wxEvtHandler()
             delete entry;
         }
         delete m_dynamicEvents;
+        delete m_dynamicEventsIndex;
     }
 
     // Remove us from the list of the pending events if necessary.
@@ -1213,6 +1555,8 @@ wxEvtHandler::~wxEvtHandler()
 
     DeletePendingEvents();
 
+    delete m_coalescer.load();
+
     // we only delete object data, not untyped
     if ( m_clientDataType == wxClientData_Object )
         delete m_clientObject;
@@ -1308,37 +1652,125 @@ void wxEvtHandler::QueueEvent(wxEvent *event)
         return;
     }
 
-    // 1) Add this event to our list of pending events
-    wxENTER_CRIT_SECT( m_pendingEventsLock );
-
-    if ( !m_pendingEvents )
-        m_pendingEvents = new wxList;
-
-    m_pendingEvents->Append(event);
+    // 1) Add this event to our list of new pending events: this doesn't
+    //    require any locking, so that many threads can queue events to the
+    //    same handler without contention.
+    wxEvent* head = m_newPendingEvents.load(std::memory_order_relaxed);
+    do
+    {
+        event->m_nextPending = head;
+    }
+    while ( !m_newPendingEvents.compare_exchange_weak(head, event,
+                                                      std::memory_order_release,
+                                                      std::memory_order_relaxed) );
+
+    // If there already were new events, the thread which queued the first of
+    // them has already done (or is going to do) the rest, so there is nothing
+    // more to do: this ensures we only wake up the event loop once for all
+    // the events queued before it gets to process them.
+    if ( head )
+        return;
 
     // 2) Add this event handler to list of event handlers that
     //    have pending events.
-
-    wxTheApp->AppendPendingEventHandler(this);
-
-    // only release m_pendingEventsLock now because otherwise there is a race
-    // condition as described in the ticket #9093: we could process the event
-    // just added to m_pendingEvents in our ProcessPendingEvents() below before
-    // we had time to append this pointer to wxHandlersWithPendingEvents list; thus
-    // breaking the invariant that a handler should be in the list iff it has
-    // any pending events to process
-    wxLEAVE_CRIT_SECT( m_pendingEventsLock );
+    //
+    // Notice that, unlike the events, the handler may be added to this list
+    // even if it's already there or if it has no events left by the time it
+    // is processed: ProcessPendingEvents() deals with both situations.
+    wxTheApp->AddNewPendingEventHandler(this);
 
     // 3) Inform the system that new pending events are somewhere,
     //    and that these should be processed in idle time.
     wxWakeUpIdle();
 }
 
+void wxEvtHandler::QueueCoalescedEvent(wxEvent *event)
+{
+    wxCHECK_RET( event, "null event can't be posted" );
+
+    if ( !wxTheApp )
+    {
+        // let QueueEvent() deal with it
+        QueueEvent(event);
+        return;
+    }
+
+    GetCoalescer().Queue(event);
+}
+
+void wxEvtHandler::SetCoalescedEventMinInterval(wxEventType eventType,
+                                                int winid,
+                                                int milliseconds)
+{
+    wxCHECK_RET( milliseconds >= 0, "invalid interval" );
+
+    GetCoalescer().SetMinInterval(eventType, winid, milliseconds);
+}
+
+wxEventCoalescer& wxEvtHandler::GetCoalescer()
+{
+    wxEventCoalescer* coalescer = m_coalescer.load();
+    if ( !coalescer )
+    {
+        // Another thread could be creating it simultaneously, so be careful
+        // to only use a single object.
+        std::unique_ptr<wxEventCoalescer> created(new wxEventCoalescer(*this));
+        if ( m_coalescer.compare_exchange_strong(coalescer, created.get()) )
+            coalescer = created.release();
+    }
+
+    return *coalescer;
+}
+
+void wxEvtHandler::TakeNewPendingEvents()
+{
+    wxEvent* event = m_newPendingEvents.exchange(nullptr,
+                                                 std::memory_order_acquire);
+    if ( !event )
+        return;
+
+    // The new events are in LIFO order, reverse them before appending.
+    wxEvent* const last = event;
+    wxEvent* first = nullptr;
+    while ( event )
+    {
+        wxEvent* const next = event->m_nextPending;
+        event->m_nextPending = first;
+        first = event;
+        event = next;
+    }
+
+    if ( m_pendingEventsLast )
+        m_pendingEventsLast->m_nextPending = first;
+    else
+        m_pendingEventsFirst = first;
+
+    m_pendingEventsLast = last;
+}
+
 void wxEvtHandler::DeletePendingEvents()
 {
-    if (m_pendingEvents)
-        m_pendingEvents->DeleteContents(true);
-    wxDELETE(m_pendingEvents);
+    wxENTER_CRIT_SECT( m_pendingEventsLock );
+
+    TakeNewPendingEvents();
+
+    wxEvent* event = m_pendingEventsFirst;
+    while ( event )
+    {
+        wxEvent* const next = event->m_nextPending;
+        delete event;
+        event = next;
+    }
+
+    m_pendingEventsFirst =
+    m_pendingEventsLast = nullptr;
+
+    wxLEAVE_CRIT_SECT( m_pendingEventsLock );
+
+    // the coalesced events wouldn't be processed any more either, as the
+    // events used for processing them were just deleted
+    if ( wxEventCoalescer* const coalescer = m_coalescer.load() )
+        coalescer->DeletePendingEvents();
 }
 
 void wxEvtHandler::ProcessPendingEvents()
@@ -1357,25 +1789,22 @@ void wxEvtHandler::ProcessPendingEvents()
 
     wxENTER_CRIT_SECT( m_pendingEventsLock );
 
-    // this method is only called by wxApp if this handler does have
-    // pending events
-    wxCHECK_RET( m_pendingEvents && !m_pendingEvents->IsEmpty(),
-                 "should have pending events if called" );
-
-    wxList::compatibility_iterator node = m_pendingEvents->GetFirst();
-    wxEvent* pEvent = static_cast<wxEvent *>(node->GetData());
+    TakeNewPendingEvents();
 
     // find the first event which can be processed now:
+    wxEvent* prev = nullptr;
+    wxEvent* pEvent = m_pendingEventsFirst;
+
     wxEventLoopBase* evtLoop = wxEventLoopBase::GetActive();
-    if (evtLoop && evtLoop->IsYielding())
+    if (pEvent && evtLoop && evtLoop->IsYielding())
     {
-        while (node && pEvent && !evtLoop->IsEventAllowedInsideYield(pEvent->GetEventCategory()))
+        while (pEvent && !evtLoop->IsEventAllowedInsideYield(pEvent->GetEventCategory()))
         {
-            node = node->GetNext();
-            pEvent = node ? static_cast<wxEvent *>(node->GetData()) : nullptr;
+            prev = pEvent;
+            pEvent = pEvent->m_nextPending;
         }
 
-        if (!node)
+        if (!pEvent)
         {
             // all our events are NOT processable now... signal this:
             wxTheApp->DelayPendingEventHandler(this);
@@ -1394,17 +1823,42 @@ void wxEvtHandler::ProcessPendingEvents()
     // it's important we remove event from list before processing it, else a
     // nested event loop, for example from a modal dialog, might process the
     // same event again.
-    m_pendingEvents->Erase(node);
+    if ( pEvent )
+    {
+        wxEvent* const next = pEvent->m_nextPending;
+        if ( prev )
+            prev->m_nextPending = next;
+        else
+            m_pendingEventsFirst = next;
 
-    if ( m_pendingEvents->IsEmpty() )
+        if ( m_pendingEventsLast == pEvent )
+            m_pendingEventsLast = prev;
+
+        pEvent->m_nextPending = nullptr;
+    }
+
+    if ( !m_pendingEventsFirst )
     {
         // if there are no more pending events left, we don't need to
         // stay in this list
         wxTheApp->RemovePendingEventHandler(this);
+
+        // but new events could have been queued since we took them above
+        // and, if this handler was still in the list of handlers with new
+        // pending events at that time, it wasn't added to it again, but
+        // could have been just moved to the list we removed it from, so
+        // check for this to avoid losing these events
+        if ( m_newPendingEvents.load() )
+            wxTheApp->AppendPendingEventHandler(this);
     }
 
     wxLEAVE_CRIT_SECT( m_pendingEventsLock );
 
+    // the handler could have been in the list without any pending events (see
+    // QueueEvent()), in which case there is nothing else to do
+    if ( !event )
+        return;
+
     // We must not let exceptions escape from here, there is no outer exception
     // handler to catch them and so letting them do it would just terminate the
     // program.
@@ -1781,6 +2235,8 @@ void wxEvtHandler::DoBind(int id,
     // than inserting the element at the front.
     m_dynamicEvents->push_back(entry);
 
+    AddToDynamicEventsIndex(entry);
+
     // Make sure we get to know when a sink is destroyed
     wxEvtHandler *eventSink = func->GetEvtHandler();
     if ( eventSink && eventSink != this )
@@ -1835,6 +2291,8 @@ wxEvtHandler::DoUnbind(int id,
             // this implementation detail.
             (*m_dynamicEvents)[cookie] = nullptr;
 
+            RemoveFromDynamicEventsIndex(entry);
+
             delete entry;
             return true;
         }
@@ -1870,22 +2328,78 @@ wxEvtHandler::GetNextDynamicEntry(size_t& cookie) const
     return nullptr;
 }
 
+void wxEvtHandler::AddToDynamicEventsIndex(wxDynamicEventTableEntry* entry)
+{
+    if ( m_dynamicEventsIndex )
+    {
+        m_dynamicEventsIndex->Add(entry);
+    }
+    else if ( m_dynamicEvents->size() >= wxDYNAMIC_EVENTS_INDEX_THRESHOLD )
+    {
+        // Create the index containing all the existing entries, including the
+        // just added one.
+        m_dynamicEventsIndex = new wxDynamicEventIndex;
+
+        for ( wxDynamicEventTableEntry* const e : *m_dynamicEvents )
+        {
+            if ( e )
+                m_dynamicEventsIndex->Add(e);
+        }
+    }
+}
+
+void
+wxEvtHandler::RemoveFromDynamicEventsIndex(wxDynamicEventTableEntry* entry)
+{
+    if ( m_dynamicEventsIndex )
+        m_dynamicEventsIndex->Remove(entry);
+}
+
+void wxEvtHandler::PruneDynamicEvents()
+{
+    DynamicEvents& dynamicEvents = *m_dynamicEvents;
+
+    size_t nNew = 0;
+    for ( size_t n = 0; n != dynamicEvents.size(); n++ )
+    {
+        if ( dynamicEvents[n] )
+            dynamicEvents[nNew++] = dynamicEvents[n];
+    }
+
+    dynamicEvents.resize(nNew);
+
+    if ( m_dynamicEventsIndex )
+        m_dynamicEventsIndex->Prune();
+}
+
 bool wxEvtHandler::SearchDynamicEventTable( wxEvent& event )
 {
     wxCHECK_MSG( m_dynamicEvents, false,
                  wxT("caller should check that we have dynamic events") );
 
-    DynamicEvents& dynamicEvents = *m_dynamicEvents;
+    // If we have the index, we only need to check the entries for the type of
+    // this event, which are in the same order as in m_dynamicEvents, otherwise
+    // check all of them.
+    DynamicEvents* entries = m_dynamicEvents;
 
     bool needToPruneDeleted = false;
 
+    if ( m_dynamicEventsIndex )
+    {
+        entries = m_dynamicEventsIndex->Find(event.GetEventType());
+
+        // We may not see the entries removed from the other types vectors, so
+        // we need to check for them separately.
+        needToPruneDeleted = m_dynamicEventsIndex->NeedsPruning();
+    }
+
     // We can't use Get{First,Next}DynamicEntry() here as they hide the deleted
     // but not yet pruned entries from the caller, but here we do want to know
     // about them, so iterate directly. Remember to do it in the reverse order
     // to honour the order of handlers connection.
-    for ( size_t n = dynamicEvents.size(); n; n-- )
+    for ( size_t n = entries ? entries->size() : 0; n; n-- )
     {
-        wxDynamicEventTableEntry* const entry = dynamicEvents[n - 1];
+        wxDynamicEventTableEntry* const entry = (*entries)[n - 1];
 
         if ( !entry )
         {
@@ -1922,17 +2436,7 @@ bool wxEvtHandler::SearchDynamicEventTable( wxEvent& event )
     }
 
     if ( needToPruneDeleted )
-    {
-        size_t nNew = 0;
-        for ( size_t n = 0; n != dynamicEvents.size(); n++ )
-        {
-            if ( dynamicEvents[n] )
-                dynamicEvents[nNew++] = dynamicEvents[n];
-        }
-
-        wxASSERT( nNew != dynamicEvents.size() );
-        dynamicEvents.resize(nNew);
-    }
+        PruneDynamicEvents();
 
     return false;
 }
@@ -2007,6 +2511,8 @@ void wxEvtHandler::OnSinkDestroyed( wxEvtHandler *sink )
     {
         if ( entry->m_fn->GetEvtHandler() == sink )
         {
+            RemoveFromDynamicEventsIndex(entry);
+
             delete entry->m_callbackUserData;
             delete entry;
 
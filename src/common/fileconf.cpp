@@ -667,9 +667,14 @@ void wxFileConfig::Parse(const wxTextBuffer& buffer, bool bLocal)
 
   for ( size_t n = 0; n < nLineCount; n++ )
   {
-    wxString strLine = buffer[n];
+    const wxString& strLine = buffer[n];
+#if wxUSE_UNICODE_UTF8
     // FIXME-UTF8: rewrite using iterators
     wxWCharBuffer buf(strLine.c_str());
+#else
+    // use the string data directly instead of copying every line
+    const wxChar* const buf = strLine.wx_str();
+#endif
     const wxChar *pStart;
     const wxChar *pEnd;
 
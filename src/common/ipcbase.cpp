@@ -24,6 +24,7 @@ wxConnectionBase::wxConnectionBase(void *buffer, size_t bytes)
     : m_buffer((char *)buffer),
       m_buffersize(bytes),
       m_deletebufferwhendone(false),
+      m_lastRequestId(0),
       m_connected(true)
 {
   if ( buffer == nullptr )
@@ -37,6 +38,7 @@ wxConnectionBase::wxConnectionBase()
     : m_buffer(nullptr),
       m_buffersize(0),
       m_deletebufferwhendone(true),
+      m_lastRequestId(0),
       m_connected(true)
 {
 }
@@ -46,6 +48,7 @@ wxConnectionBase::wxConnectionBase(const wxConnectionBase& copy)
       m_buffer(copy.m_buffer),
       m_buffersize(copy.m_buffersize),
       m_deletebufferwhendone(false),
+      m_lastRequestId(0),
       m_connected(copy.m_connected)
 
 {
@@ -60,6 +63,29 @@ wxConnectionBase::~wxConnectionBase()
     delete [] m_buffer;
 }
 
+int wxConnectionBase::RequestAsync(const wxString& item, wxIPCFormat format)
+{
+  // default implementation for the classes not supporting asynchronous
+  // requests: just perform a synchronous one and report its result
+  // immediately
+  const int requestId = GetNextRequestId();
+
+  size_t size = 0;
+  const void * const data = Request(item, &size, format);
+  OnRequestReply(requestId, data, data ? size : 0, format);
+
+  return requestId;
+}
+
+int wxConnectionBase::GetNextRequestId()
+{
+  // 0 is used to indicate an error, so never return it
+  if ( ++m_lastRequestId <= 0 )
+    m_lastRequestId = 1;
+
+  return m_lastRequestId;
+}
+
 /* static */
 wxString wxConnectionBase::GetTextFromData(const void* data,
                                            size_t size,
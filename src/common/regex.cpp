@@ -31,6 +31,12 @@
     #include "wx/crt.h"
 #endif //WX_PRECOMP
 
+#include "wx/thread.h"
+
+#include <list>
+#include <memory>
+#include <unordered_map>
+
 // At least FreeBSD requires this.
 #if defined(__UNIX__)
 #   include <sys/types.h>
@@ -89,6 +95,7 @@ namespace
 #define REG_NOTEOL    0x0008    // Same as PCRE2_NOTEOL.
 #define REG_NOSUB     0x0020    // Don't return matches.
 #define REG_NOTEMPTY  0x0100    // Same as PCRE2_NOTEMPTY.
+#define REG_JIT       0x0200    // Use pcre2_jit_compile(), if possible.
 
 enum
 {
@@ -100,15 +107,21 @@ enum
 
 typedef size_t regoff_t;
 
+// Compiled pattern may be shared by several regex_t objects, see wxRegExCache.
+typedef std::shared_ptr<pcre2_code> wxRegCodePtr;
+
 struct regex_t
 {
     // This is the only "public" field -- not that it really matters anyhow for
     // this private struct.
     size_t re_nsub;
 
-    pcre2_code* code;
+    wxRegCodePtr code;
     pcre2_match_data* match_data;
 
+    // True if the code was successfully compiled by the JIT compiler.
+    bool jit;
+
     int errorcode;
     regoff_t erroroffset;
 };
@@ -119,6 +132,66 @@ struct regmatch_t
     regoff_t rm_eo;
 };
 
+// Match context using a bigger JIT stack than the default one, which is only
+// 32KiB and is not enough for some patterns. As the JIT stack can't be used by
+// more than one thread at once, each thread has its own one.
+class wxRegExJITContext
+{
+public:
+    wxRegExJITContext()
+    {
+        m_context = nullptr;
+        m_stack = nullptr;
+    }
+
+    ~wxRegExJITContext()
+    {
+        if ( m_stack )
+            pcre2_jit_stack_free(m_stack);
+        if ( m_context )
+            pcre2_match_context_free(m_context);
+    }
+
+    // Return nullptr if creating the context failed, this is still fine to
+    // pass to pcre2_match() and just means that the default stack is used.
+    pcre2_match_context* Get()
+    {
+        if ( !m_context )
+        {
+            m_context = pcre2_match_context_create(nullptr);
+            if ( !m_context )
+                return nullptr;
+
+            m_stack = pcre2_jit_stack_create(32*1024, 1024*1024, nullptr);
+            if ( m_stack )
+                pcre2_jit_stack_assign(m_context, nullptr, m_stack);
+        }
+
+        return m_context;
+    }
+
+private:
+    pcre2_match_context* m_context;
+    pcre2_jit_stack* m_stack;
+
+    wxDECLARE_NO_COPY_CLASS(wxRegExJITContext);
+};
+
+pcre2_match_context* wxGetRegExJITContext()
+{
+    thread_local wxRegExJITContext s_context;
+
+    return s_context.Get();
+}
+
+// Use the given, possibly shared, compiled code for this regex.
+void wx_regattach(regex_t* preg, const wxRegCodePtr& code, bool jit)
+{
+    preg->code = code;
+    preg->jit = jit;
+    preg->match_data = pcre2_match_data_create_from_pattern(code.get(), nullptr);
+}
+
 int wx_regcomp(regex_t* preg, const wxRegChar* pattern, int cflags)
 {
     // PCRE2_UTF is required in order to handle non-ASCII characters when using
@@ -141,17 +214,17 @@ int wx_regcomp(regex_t* preg, const wxRegChar* pattern, int cflags)
     else
         options |= PCRE2_DOTALL;
 
-    preg->code = pcre2_compile
-                 (
-                    (PCRE2_SPTR)pattern,
-                    PCRE2_ZERO_TERMINATED,
-                    options,
-                    &preg->errorcode,
-                    &preg->erroroffset,
-                    nullptr                    // use default context
-                 );
-
-    if ( !preg->code )
+    pcre2_code* const code = pcre2_compile
+                             (
+                                (PCRE2_SPTR)pattern,
+                                PCRE2_ZERO_TERMINATED,
+                                options,
+                                &preg->errorcode,
+                                &preg->erroroffset,
+                                nullptr                    // use default context
+                             );
+
+    if ( !code )
     {
         // Don't bother translating PCRE error to the most appropriate POSIX
         // error code, there is no way to do it losslessly and the main thing
@@ -159,7 +232,13 @@ int wx_regcomp(regex_t* preg, const wxRegChar* pattern, int cflags)
         return REG_BADPAT;
     }
 
-    preg->match_data = pcre2_match_data_create_from_pattern(preg->code, nullptr);
+    // JIT compilation fails if JIT support is not available in PCRE or on
+    // this platform, but the interpreter can still be used in this case.
+    bool jit = false;
+    if ( cflags & REG_JIT )
+        jit = pcre2_jit_compile(code, PCRE2_JIT_COMPLETE) == 0;
+
+    wx_regattach(preg, wxRegCodePtr(code, pcre2_code_free), jit);
 
     return REG_NOERROR;
 }
@@ -177,15 +256,22 @@ wx_regexec(const regex_t* preg, const wxRegChar* string, size_t len,
     if ( eflags & REG_NOTEMPTY )
         options |= PCRE2_NOTEMPTY;
 
+#ifdef WXREGEX_CONVERT_TO_MB
+    // We only get UTF-8 strings coming from wxString here and they are always
+    // valid, so don't waste time on checking the entire subject again during
+    // each call, which is especially costly when matching in a loop.
+    options |= PCRE2_NO_UTF_CHECK;
+#endif
+
     const int rc = pcre2_match
                    (
-                        preg->code,
+                        preg->code.get(),
                         (PCRE2_SPTR)string,
                         len,
                         0,                      // start offset
                         options,
                         preg->match_data,
-                        nullptr                    // use default context
+                        preg->jit ? wxGetRegExJITContext() : nullptr
                    );
 
     if ( rc == PCRE2_ERROR_NOMATCH )
@@ -245,7 +331,8 @@ wx_regerror(int errcode, const regex_t* preg, wxRegErrorChar* errbuf, size_t err
 void wx_regfree(regex_t* preg)
 {
     pcre2_match_data_free(preg->match_data);
-    pcre2_code_free(preg->code);
+    preg->match_data = nullptr;
+    preg->code.reset();
 }
 
 } // anonymous namespace
@@ -283,6 +370,108 @@ private:
     regmatch_t *m_matches;
 };
 
+// process-wide LRU cache of the recently compiled patterns, allowing to avoid
+// recompiling the same pattern again when wxRegEx objects are created on the
+// fly instead of being reused
+class wxRegExCache
+{
+public:
+    // the data shared by all wxRegEx objects using the same pattern
+    struct Entry
+    {
+        wxRegCodePtr code;
+        bool jit;
+        size_t nMatches;
+    };
+
+    static wxRegExCache& Get()
+    {
+        static wxRegExCache s_cache;
+
+        return s_cache;
+    }
+
+    void SetMaxSize(size_t maxSize)
+    {
+        wxCRIT_SECT_LOCKER(lock, m_cs);
+
+        m_maxSize = maxSize;
+        Trim();
+    }
+
+    // return true and fill in the entry if the pattern is in the cache
+    bool Find(const wxString& expr, int flags, Entry& entry)
+    {
+        wxCRIT_SECT_LOCKER(lock, m_cs);
+
+        const Index::const_iterator it = m_index.find(Key(expr, flags));
+        if ( it == m_index.end() )
+            return false;
+
+        // move the entry to the front as it's now the most recently used one
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+
+        entry = it->second->second;
+
+        return true;
+    }
+
+    void Add(const wxString& expr, int flags, const Entry& entry)
+    {
+        wxCRIT_SECT_LOCKER(lock, m_cs);
+
+        if ( !m_maxSize )
+            return;
+
+        const Key key(expr, flags);
+        if ( m_index.count(key) )
+            return;
+
+        m_entries.push_front(std::make_pair(key, entry));
+        m_index[key] = m_entries.begin();
+
+        Trim();
+    }
+
+private:
+    wxRegExCache() : m_maxSize(32) { }
+
+    // remove the least recently used entries exceeding the maximal size
+    void Trim()
+    {
+        while ( m_entries.size() > m_maxSize )
+        {
+            m_index.erase(m_entries.back().first);
+            m_entries.pop_back();
+        }
+    }
+
+    typedef std::pair<wxString, int> Key;
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const
+        {
+            return std::hash<wxString>()(key.first) ^ key.second;
+        }
+    };
+
+    typedef std::list< std::pair<Key, Entry> > Entries;
+    typedef std::unordered_map<Key, Entries::iterator, KeyHash> Index;
+
+    // the entries, most recently used first
+    Entries m_entries;
+
+    // index of m_entries by pattern and flags
+    Index m_index;
+
+    size_t m_maxSize;
+
+    wxCRIT_SECT_DECLARE_MEMBER(m_cs);
+
+    wxDECLARE_NO_COPY_CLASS(wxRegExCache);
+};
+
 // the real implementation of wxRegEx
 class wxRegExImpl
 {
@@ -951,9 +1140,25 @@ bool wxRegExImpl::Compile(wxString expr, int flags)
 {
     Reinit();
 
-    wxASSERT_MSG( !(flags & ~(wxRE_ADVANCED | wxRE_BASIC | wxRE_ICASE | wxRE_NOSUB | wxRE_NEWLINE)),
+    wxASSERT_MSG( !(flags & ~(wxRE_ADVANCED | wxRE_BASIC | wxRE_ICASE | wxRE_NOSUB | wxRE_NEWLINE | wxRE_JIT)),
                   wxT("unrecognized flags in wxRegEx::Compile") );
 
+    // reuse the already compiled pattern if we have it
+    wxRegExCache& cache = wxRegExCache::Get();
+    wxRegExCache::Entry entry;
+    if ( cache.Find(expr, flags, entry) )
+    {
+        wx_regattach(&m_RegEx, entry.code, entry.jit);
+        m_nMatches = entry.nMatches;
+        m_isCompiled = true;
+
+        return true;
+    }
+
+    // remember the original pattern and flags for adding them to the cache
+    const wxString exprOrig = expr;
+    const int flagsOrig = flags;
+
     // Deal with the directors and embedded options first (this can modify
     // flags).
     expr = ConvertMetasyntax(expr, flags);
@@ -979,6 +1184,8 @@ bool wxRegExImpl::Compile(wxString expr, int flags)
         flagsRE |= REG_NOSUB;
     if ( flags & wxRE_NEWLINE )
         flagsRE |= REG_NEWLINE;
+    if ( flags & wxRE_JIT )
+        flagsRE |= REG_JIT;
 
 #ifndef WXREGEX_CONVERT_TO_MB
     const wxChar *exprstr = expr.c_str();
@@ -1041,6 +1248,11 @@ bool wxRegExImpl::Compile(wxString expr, int flags)
         }
 
         m_isCompiled = true;
+
+        entry.code = m_RegEx.code;
+        entry.jit = m_RegEx.jit;
+        entry.nMatches = m_nMatches;
+        cache.Add(exprOrig, flagsOrig, entry);
     }
 
     return IsValid();
@@ -1281,18 +1493,30 @@ bool wxRegEx::Compile(const wxString& expr, int flags)
 }
 
 bool wxRegEx::Matches(const wxString& str, int flags) const
+{
+    return Matches(wxStringView(str), flags);
+}
+
+bool wxRegEx::Matches(const wxStringView& text, int flags) const
+{
+    wxCHECK_MSG( IsValid(), false, wxT("must successfully Compile() first") );
+
+    // PCRE uses the same representation as wxString internally, so no copy
+    // is needed even in UTF-8 build.
+    return m_impl->Matches(text.empty() ? wxS("") : text.data(),
+                           flags, text.length());
+}
+
+bool wxRegEx::Matches(const wxChar *text, int flags, size_t len) const
 {
     wxCHECK_MSG( IsValid(), false, wxT("must successfully Compile() first") );
 
 #ifndef WXREGEX_CONVERT_TO_MB
-    const wxChar* const textstr = str.c_str();
-    const size_t textlen = str.length();
+    // PCRE uses the same representation as wxChar, so no copy is needed.
+    return m_impl->Matches(text, flags, len);
 #else
-    const wxScopedCharBuffer textstr = str.utf8_str();
-    const size_t textlen = textstr.length();
+    return Matches(wxString(text, len), flags);
 #endif
-
-    return m_impl->Matches(textstr, flags, textlen);
 }
 
 bool wxRegEx::GetMatch(size_t *start, size_t *len, size_t index) const
@@ -1356,6 +1580,12 @@ wxString wxRegEx::QuoteMeta(const wxString& str)
     return strEscaped;
 }
 
+/* static */
+void wxRegEx::SetCacheSize(size_t size)
+{
+    wxRegExCache::Get().SetMaxSize(size);
+}
+
 /* static */
 wxVersionInfo wxRegEx::GetLibraryVersionInfo()
 {
@@ -42,6 +42,8 @@
 
 #include "wx/socket.h"
 
+#include <vector>
+
 // --------------------------------------------------------------------------
 // macros and constants
 // --------------------------------------------------------------------------
@@ -64,9 +66,25 @@ enum IPCCode
     IPC_FAIL            = 9,
     IPC_CONNECT         = 10,
     IPC_DISCONNECT      = 11,
+    IPC_REQUEST_ASYNC   = 12,
+    IPC_REQUEST_ASYNC_REPLY = 13,
+    IPC_REQUEST_ASYNC_FAIL  = 14,
     IPC_MAX
 };
 
+// The maximal number of messages processed in a single socket event handler
+// call: this avoids blocking the event loop for too long if the peer keeps
+// sending us more messages.
+const int MAX_MESSAGES_PER_EVENT = 256;
+
+// Size of the output buffer: it is big enough to contain many messages when
+// batching them.
+const size_t OUTPUT_BUFFER_SIZE = 64*1024;
+
+// Size of the input buffer: we read as much data as is available, up to this
+// size, at once.
+const size_t INPUT_BUFFER_SIZE = 64*1024;
+
 } // anonymous namespace
 
 // headers needed for umask()
@@ -75,10 +93,29 @@ enum IPCCode
     #include <sys/stat.h>
 #endif // __UNIX_LIKE__
 
+// headers needed for TCP_NODELAY
+#ifdef __WINDOWS__
+    #include "wx/msw/wrapwin.h"
+#else
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+#endif
+
 // ----------------------------------------------------------------------------
 // private functions
 // ----------------------------------------------------------------------------
 
+// disable Nagle algorithm for TCP sockets as IPC messages are typically small
+// and sending them with a delay results in huge latencies, especially when
+// several messages are sent without waiting for the replies
+//
+// notice that this harmlessly fails for Unix domain sockets
+static void DisableNagle(wxSocketBase& sock)
+{
+    int on = 1;
+    sock.SetOption(IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+}
+
 // get the address object for the given server name, the caller must delete it
 static wxSockAddress *
 GetAddressFromName(const wxString& serverName,
@@ -120,8 +157,17 @@ public:
     void Client_OnRequest(wxSocketEvent& event);
     void Server_OnRequest(wxSocketEvent& event);
 
+    // handle a single message with the given code whose remaining contents
+    // is read from the connection streams, return false if the connection
+    // was closed and possibly destroyed
+    static bool HandleMessage(wxTCPConnection *connection, int msg);
+
+    // generate an input event for the data already read from the socket but
+    // not handled yet, as we wouldn't get any socket events for it
+    static void QueueBufferedInput(wxTCPConnection *connection);
+
 private:
-    void HandleDisconnect(wxTCPConnection *connection);
+    static void HandleDisconnect(wxTCPConnection *connection);
 
     wxDECLARE_EVENT_TABLE();
     wxDECLARE_NO_COPY_CLASS(wxTCPEventHandler);
@@ -172,6 +218,80 @@ wxTCPEventHandler *wxTCPEventHandlerModule::ms_handler = nullptr;
 
 #define USE_BUFFER
 
+// input stream reading the data from the socket in big chunks: it reads all
+// the data available from the socket, but at least one byte, into its buffer,
+// unlike wxSocketInputStream which would wait until the entire buffer is
+// filled, and so avoids reading each part of an IPC message separately
+//
+// note that we can't use wxBufferedInputStream for this because it reduces
+// its buffer size to the size of the last read
+class wxIPCSocketInputStream : public wxInputStream
+{
+public:
+    wxIPCSocketInputStream(wxSocketBase& sock, size_t size)
+        : m_sock(sock),
+          m_buf(size)
+    {
+        m_pos =
+        m_end = 0;
+    }
+
+    // return true if we have any data which was already read from the socket
+    bool HasBufferedData() const { return m_pos != m_end; }
+
+protected:
+    virtual size_t OnSysRead(void *buffer, size_t size) override
+    {
+        if ( !HasBufferedData() )
+        {
+            // there is no need to use the buffer for big reads
+            if ( size >= m_buf.size() )
+                return ReadAvailable(buffer, size);
+
+            m_pos = 0;
+            m_end = ReadAvailable(&m_buf[0], m_buf.size());
+        }
+
+        const size_t count = wxMin(size, m_end - m_pos);
+        memcpy(buffer, &m_buf[m_pos], count);
+        m_pos += count;
+
+        return count;
+    }
+
+private:
+    // read everything available from the socket, but at least one byte
+    size_t ReadAvailable(void *buffer, size_t size)
+    {
+        char * const p = static_cast<char *>(buffer);
+
+        // wait until at least one byte is available ...
+        size_t ret = m_sock.Read(p, 1).LastReadCount();
+        if ( ret == 1 && size > 1 )
+        {
+            // ... and then read everything else without blocking
+            const wxSocketFlags flags = m_sock.GetFlags();
+            m_sock.SetFlags(wxSOCKET_NOWAIT);
+            ret += m_sock.Read(p + 1, size - 1).LastReadCount();
+            m_sock.SetFlags(flags);
+        }
+
+        m_lasterror = ret ? wxSTREAM_NO_ERROR
+                          : m_sock.IsClosed() ? wxSTREAM_EOF
+                                              : wxSTREAM_READ_ERROR;
+        return ret;
+    }
+
+    wxSocketBase& m_sock;
+
+    // the buffer and the positions of the data which wasn't consumed yet in it
+    std::vector<char> m_buf;
+    size_t m_pos,
+           m_end;
+
+    wxDECLARE_NO_COPY_CLASS(wxIPCSocketInputStream);
+};
+
 // this class contains the various (related) streams used by wxTCPConnection
 // and also provides a way to read from the socket stream directly
 //
@@ -181,18 +301,20 @@ class wxIPCSocketStreams
 public:
     // ctor initializes all the streams on top of the given socket
     //
-    // note that we use a bigger than default buffer size which matches the
-    // typical Ethernet MTU (minus TCP header overhead)
+    // note that we use a bigger than default buffer size to be able to send
+    // many batched messages at once
     wxIPCSocketStreams(wxSocketBase& sock)
         : m_socketStream(sock),
+          m_socketIn(sock, INPUT_BUFFER_SIZE),
 #ifdef USE_BUFFER
-          m_bufferedOut(m_socketStream, 1448),
+          m_bufferedOut(m_socketStream, OUTPUT_BUFFER_SIZE),
 #else
           m_bufferedOut(m_socketStream),
 #endif
-          m_dataIn(m_socketStream),
+          m_dataIn(m_socketIn),
           m_dataOut(m_bufferedOut)
     {
+        m_batchDepth = 0;
     }
 
     // expose the IO methods needed by IPC code (notice that writing is only
@@ -206,23 +328,63 @@ public:
 #endif
     }
 
+    // flush output unless we're batching: this is called when a message is
+    // complete and also before reading as the peer may be waiting for it
+    void FlushIfNotBatching()
+    {
+        if ( !m_batchDepth )
+            Flush();
+    }
+
+    // batches can be nested, the output is only flushed when the outermost
+    // one ends
+    void BeginBatch()
+    {
+        m_batchDepth++;
+    }
+
+    bool EndBatch()
+    {
+        wxCHECK_MSG( m_batchDepth, false, "no batch in progress" );
+
+        if ( !--m_batchDepth )
+            Flush();
+
+        return m_bufferedOut.IsOk();
+    }
+
+    // return true if some data was already read from the socket but not
+    // consumed yet: no socket events are generated for it
+    bool HasBufferedInput() const { return m_socketIn.HasBufferedData(); }
+
+    // return true if there is more input available, without blocking nor
+    // dispatching any events, unlike wxSocketBase::IsData()
+    bool HasInput(wxSocketBase& sock) const
+    {
+        if ( HasBufferedInput() )
+            return true;
+
+        char ch;
+        return sock.Peek(&ch, 1).LastCount() == 1;
+    }
+
     // simple wrappers around the functions with the same name in
     // wxDataInputStream
     wxUint8 Read8()
     {
-        Flush();
+        FlushIfNotBatching();
         return m_dataIn.Read8();
     }
 
     wxUint32 Read32()
     {
-        Flush();
+        FlushIfNotBatching();
         return m_dataIn.Read32();
     }
 
     wxString ReadString()
     {
-        Flush();
+        FlushIfNotBatching();
         return m_dataIn.ReadString();
     }
 
@@ -231,7 +393,7 @@ public:
     // connection parameter is needed to call its GetBufferAtLeast() method
     void *ReadData(wxConnectionBase *conn, size_t *size)
     {
-        Flush();
+        FlushIfNotBatching();
 
         wxCHECK_MSG( conn, nullptr, "null connection parameter" );
         wxCHECK_MSG( size, nullptr, "null size parameter" );
@@ -241,7 +403,7 @@ public:
         void * const data = conn->GetBufferAtLeast(*size);
         wxCHECK_MSG( data, nullptr, "IPC buffer allocation failed" );
 
-        m_socketStream.Read(data, *size);
+        m_socketIn.Read(data, *size);
 
         return data;
     }
@@ -266,6 +428,9 @@ private:
     // this is the low-level underlying stream using the connection socket
     wxSocketStream m_socketStream;
 
+    // and this one is used for reading from it
+    wxIPCSocketInputStream m_socketIn;
+
     // the buffered stream is used to avoid writing all pieces of an IPC
     // request to the socket one by one but to instead do it all at once when
     // we're done with it
@@ -280,6 +445,9 @@ private:
     wxDataInputStream  m_dataIn;
     wxDataOutputStream m_dataOut;
 
+    // the number of nested BeginBatch() calls
+    int m_batchDepth;
+
     wxDECLARE_NO_COPY_CLASS(wxIPCSocketStreams);
 };
 
@@ -302,8 +470,9 @@ public:
         wxASSERT_MSG( streams, "null streams pointer" );
     }
 
-    // dtor calls Flush() really sending the IPC data to the network
-    ~IPCOutput() { m_streams.Flush(); }
+    // dtor calls Flush() really sending the IPC data to the network, unless
+    // we're inside a batch
+    ~IPCOutput() { m_streams.FlushIfNotBatching(); }
 
 
     // write a byte
@@ -312,6 +481,12 @@ public:
         m_streams.GetDataOut().Write8(i);
     }
 
+    // write a 32 bit value, e.g. request ID
+    void Write32(wxUint32 i)
+    {
+        m_streams.GetDataOut().Write32(i);
+    }
+
     // write the reply code and a string
     void Write(IPCCode code, const wxString& str)
     {
@@ -340,6 +515,27 @@ private:
     wxDECLARE_NO_COPY_CLASS(IPCOutput);
 };
 
+// return the size of the data returned by OnRequest(), computing it for the
+// text formats if it wasn't given
+size_t GetRequestDataSize(const void *data, size_t size, wxIPCFormat format)
+{
+    if ( size != wxNO_LEN )
+        return size;
+
+    switch ( format )
+    {
+        case wxIPC_TEXT:
+        case wxIPC_UTF8TEXT:
+            return strlen((const char *)data) + 1;  // includes final NUL
+
+        case wxIPC_UNICODETEXT:
+            return (wcslen((const wchar_t *)data) + 1) * sizeof(wchar_t);  // includes final NUL
+
+        default:
+            return 0;
+    }
+}
+
 } // anonymous namespace
 
 // ==========================================================================
@@ -382,6 +578,8 @@ wxConnectionBase *wxTCPClient::MakeConnection(const wxString& host,
 
     if ( ok )
     {
+        DisableNagle(*client);
+
         // Send topic name, and enquire whether this has succeeded
         IPCOutput(streams).Write(IPC_CONNECT, topic);
 
@@ -610,15 +808,37 @@ const void *wxTCPConnection::Request(const wxString& item,
 
     IPCOutput(m_streams).Write(IPC_REQUEST, item, format);
 
-    const int ret = m_streams->Read8();
+    const int ret = ReadReply();
     if ( ret != IPC_REQUEST_REPLY )
+    {
+        wxTCPEventHandler::QueueBufferedInput(this);
         return nullptr;
+    }
 
     // ReadData() needs a non-null size pointer but the client code can call us
     // with null pointer (this makes sense if it knows that it always works
     // with NUL-terminated strings)
     size_t sizeFallback;
-    return m_streams->ReadData(this, size ? size : &sizeFallback);
+    const void * const
+        data = m_streams->ReadData(this, size ? size : &sizeFallback);
+
+    wxTCPEventHandler::QueueBufferedInput(this);
+
+    return data;
+}
+
+int wxTCPConnection::RequestAsync(const wxString& item, wxIPCFormat format)
+{
+    if ( !m_sock->IsConnected() )
+        return 0;
+
+    const int id = GetNextRequestId();
+
+    IPCOutput out(m_streams);
+    out.Write(IPC_REQUEST_ASYNC, item, format);
+    out.Write32(id);
+
+    return id;
 }
 
 bool wxTCPConnection::DoPoke(const wxString& item,
@@ -643,7 +863,9 @@ bool wxTCPConnection::StartAdvise(const wxString& item)
 
     IPCOutput(m_streams).Write(IPC_ADVISE_START, item);
 
-    const int ret = m_streams->Read8();
+    const int ret = ReadReply();
+
+    wxTCPEventHandler::QueueBufferedInput(this);
 
     return ret == IPC_ADVISE_START;
 }
@@ -655,7 +877,9 @@ bool wxTCPConnection::StopAdvise (const wxString& item)
 
     IPCOutput(m_streams).Write(IPC_ADVISE_STOP, item);
 
-    const int ret = m_streams->Read8();
+    const int ret = ReadReply();
+
+    wxTCPEventHandler::QueueBufferedInput(this);
 
     return ret == IPC_ADVISE_STOP;
 }
@@ -676,6 +900,54 @@ bool wxTCPConnection::DoAdvise(const wxString& item,
     return true;
 }
 
+void wxTCPConnection::BeginBatch()
+{
+    wxCHECK_RET( m_streams, "not connected" );
+
+    m_streams->BeginBatch();
+}
+
+bool wxTCPConnection::EndBatch()
+{
+    wxCHECK_MSG( m_streams, false, "not connected" );
+
+    return m_streams->EndBatch();
+}
+
+int wxTCPConnection::ReadReply()
+{
+    // send the request even if we're inside a batch as we can't get a reply
+    // to it otherwise
+    m_streams->Flush();
+
+    for ( ;; )
+    {
+        const int msg = m_streams->Read8();
+        if ( m_sock->Error() )
+            return IPC_FAIL;
+
+        switch ( msg )
+        {
+            case IPC_REQUEST_REPLY:
+            case IPC_ADVISE_START:
+            case IPC_ADVISE_STOP:
+            case IPC_FAIL:
+                return msg;
+
+            case IPC_DISCONNECT:
+                // don't handle it here as this would destroy this object, it
+                // will be done when wxSOCKET_LOST is received later
+                return msg;
+        }
+
+        // this is an unrelated message sent by the peer before the reply
+        // (e.g. an advise or a reply to an asynchronous request), handle it
+        // as we would have done it if it had been received later
+        if ( !wxTCPEventHandler::HandleMessage(this, msg) )
+            return IPC_DISCONNECT;
+    }
+}
+
 // --------------------------------------------------------------------------
 // wxTCPEventHandler (private class)
 // --------------------------------------------------------------------------
@@ -720,7 +992,49 @@ void wxTCPEventHandler::Client_OnRequest(wxSocketEvent &event)
         return;
     }
 
-    // Receive message number.
+    // We may have already read the data corresponding to this event when
+    // handling the previous one, don't block waiting for more in this case.
+    wxIPCSocketStreams * const streams = connection->m_streams;
+    if ( !streams->HasInput(*sock) )
+        return;
+
+    // Handle all the messages already received at once, batching the replies
+    // to them together.
+    streams->BeginBatch();
+
+    for ( int n = 0; n < MAX_MESSAGES_PER_EVENT; n++ )
+    {
+        if ( !HandleMessage(connection, streams->Read8()) )
+        {
+            // the connection may have been already deleted, don't use it
+            return;
+        }
+
+        if ( !streams->HasInput(*sock) )
+            break;
+    }
+
+    streams->EndBatch();
+
+    // If we stopped because of the messages limit, continue later.
+    QueueBufferedInput(connection);
+}
+
+void wxTCPEventHandler::QueueBufferedInput(wxTCPConnection *connection)
+{
+    if ( !connection->m_streams->HasBufferedInput() )
+        return;
+
+    wxSocketEvent event(_CLIENT_ONREQUEST_ID);
+    event.m_event = wxSOCKET_INPUT;
+    event.m_clientData = connection;
+    event.SetEventObject(connection->m_sock);
+
+    wxTCPEventHandlerModule::GetHandler().AddPendingEvent(event);
+}
+
+bool wxTCPEventHandler::HandleMessage(wxTCPConnection *connection, int msg)
+{
     wxIPCSocketStreams * const streams = connection->m_streams;
 
     const wxString topic = connection->m_topic;
@@ -728,7 +1042,6 @@ void wxTCPEventHandler::Client_OnRequest(wxSocketEvent &event)
 
     bool error = false;
 
-    const int msg = streams->Read8();
     switch ( msg )
     {
         case IPC_EXECUTE:
@@ -815,34 +1128,71 @@ void wxTCPEventHandler::Client_OnRequest(wxSocketEvent &event)
 
                 IPCOutput out(streams);
                 out.Write8(IPC_REQUEST_REPLY);
+                out.WriteData(user_data,
+                              GetRequestDataSize(user_data, user_size, format));
+            }
+            break;
+
+        case IPC_REQUEST_ASYNC:
+            {
+                item = streams->ReadString();
+
+                wxIPCFormat format = (wxIPCFormat)streams->Read8();
+                const wxUint32 id = streams->Read32();
 
-                if ( user_size == wxNO_LEN )
+                size_t user_size = wxNO_LEN;
+                const void *user_data = connection->OnRequest(topic,
+                                                              item,
+                                                              &user_size,
+                                                              format);
+
+                IPCOutput out(streams);
+                if ( !user_data )
                 {
-                    switch ( format )
-                    {
-                        case wxIPC_TEXT:
-                        case wxIPC_UTF8TEXT:
-                            user_size = strlen((const char *)user_data) + 1;  // includes final NUL
-                            break;
-                        case wxIPC_UNICODETEXT:
-                            user_size = (wcslen((const wchar_t *)user_data) + 1) * sizeof(wchar_t);  // includes final NUL
-                            break;
-                        default:
-                            user_size = 0;
-                    }
+                    out.Write8(IPC_REQUEST_ASYNC_FAIL);
+                    out.Write32(id);
+                    break;
                 }
 
-                out.WriteData(user_data, user_size);
+                out.Write8(IPC_REQUEST_ASYNC_REPLY);
+                out.Write32(id);
+                out.Write8(format);
+                out.WriteData(user_data,
+                              GetRequestDataSize(user_data, user_size, format));
+            }
+            break;
+
+        case IPC_REQUEST_ASYNC_REPLY:
+            {
+                const wxUint32 id = streams->Read32();
+
+                wxIPCFormat format;
+                size_t size wxDUMMY_INITIALIZE(0);
+                void * const
+                    data = streams->ReadFormatData(connection, &format, &size);
+
+                if ( data )
+                    connection->OnRequestReply(id, data, size, format);
+                else
+                    error = true;
             }
             break;
 
+        case IPC_REQUEST_ASYNC_FAIL:
+            connection->OnRequestReply(streams->Read32(), nullptr, 0,
+                                       wxIPC_INVALID);
+            break;
+
         case IPC_DISCONNECT:
             HandleDisconnect(connection);
-            break;
+            return false;
 
         case IPC_FAIL:
+            // this is what the peers using older wxWidgets versions send in
+            // reply to IPC_REQUEST_ASYNC which they don't understand, don't
+            // reply to it with another IPC_FAIL, as it would make them send
+            // another one back to us and so on forever
             wxLogDebug("Unexpected IPC_FAIL received");
-            error = true;
             break;
 
         default:
@@ -853,6 +1203,8 @@ void wxTCPEventHandler::Client_OnRequest(wxSocketEvent &event)
 
     if ( error )
         IPCOutput(streams).Write8(IPC_FAIL);
+
+    return true;
 }
 
 void wxTCPEventHandler::Server_OnRequest(wxSocketEvent &event)
@@ -879,6 +1231,8 @@ void wxTCPEventHandler::Server_OnRequest(wxSocketEvent &event)
         return;
     }
 
+    DisableNagle(*sock);
+
     wxIPCSocketStreams *streams = new wxIPCSocketStreams(*sock);
 
     {
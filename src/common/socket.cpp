@@ -41,12 +41,21 @@
 #include "wx/thread.h"
 #include "wx/evtloop.h"
 #include "wx/link.h"
+#include "wx/file.h"
 
 #include "wx/private/fd.h"
 #include "wx/private/socket.h"
 
+#include <memory>
+
 #ifdef __UNIX__
     #include <errno.h>
+    #include <sys/uio.h>
+#endif
+
+#ifdef wxHAS_SOCKET_SENDFILE
+    #include <sys/sendfile.h>
+    #include <signal.h>
 #endif
 
 // we use MSG_NOSIGNAL to avoid getting SIGPIPE when sending data to a remote
@@ -113,6 +122,16 @@ wxDEFINE_EVENT(wxEVT_SOCKET, wxSocketEvent);
 // discard buffer
 #define MAX_DISCARD_SIZE (10 * 1024)
 
+// maximal number of buffers passed to a single readv() or writev() call
+#define MAX_IOV_COUNT 64
+
+// the buffer used for writing files when they can't be sent directly
+#define WRITE_FILE_BUFFER_SIZE (64 * 1024)
+
+// pushback buffers bigger than this are freed as soon as they become empty
+// instead of being kept for reuse
+#define MAX_PUSHBACK_KEEP_SIZE (64 * 1024)
+
 #define wxTRACE_Socket wxT("wxSocket")
 
 // --------------------------------------------------------------------------
@@ -645,6 +664,14 @@ const wxSockAddressImpl& wxSocketImpl::GetLocal()
     #define DO_WHILE_EINTR( rc, syscall ) rc = (syscall)
 #endif
 
+void wxSocketImpl::OnStreamClosed()
+{
+    m_establishing = false;
+    NotifyOnStateChange(wxSOCKET_LOST);
+
+    Shutdown();
+}
+
 int wxSocketImpl::RecvStream(void *buffer, int size)
 {
     int ret;
@@ -655,10 +682,7 @@ int wxSocketImpl::RecvStream(void *buffer, int size)
         // receiving 0 bytes for a TCP socket indicates that the connection was
         // closed by peer so shut down our end as well (for UDP sockets empty
         // datagrams are also possible)
-        m_establishing = false;
-        NotifyOnStateChange(wxSOCKET_LOST);
-
-        Shutdown();
+        OnStreamClosed();
 
         // do not return an error in this case however
     }
@@ -754,6 +778,183 @@ int wxSocketImpl::Write(const void *buffer, int size)
     return ret;
 }
 
+#ifdef __UNIX__
+
+namespace
+{
+
+// Fill the given array, which must have MAX_IOV_COUNT elements, with the
+// buffers from vec, skipping the given number of bytes in the first one, and
+// return the number of the elements used.
+int FillIOVec(iovec *iov, const wxSocketIOVec *vec, int count, wxUint32 offset)
+{
+    if ( count > MAX_IOV_COUNT )
+        count = MAX_IOV_COUNT;
+
+    for ( int n = 0; n < count; n++ )
+    {
+        iov[n].iov_base = static_cast<char *>(vec[n].data) + offset;
+        iov[n].iov_len = vec[n].size - offset;
+
+        offset = 0;
+    }
+
+    return count;
+}
+
+} // anonymous namespace
+
+#endif // __UNIX__
+
+int wxSocketImpl::ReadV(const wxSocketIOVec *vec, int count, wxUint32 offset)
+{
+    if ( m_fd == INVALID_SOCKET || m_server || !m_stream )
+    {
+        m_error = wxSOCKET_INVSOCK;
+        return -1;
+    }
+
+#ifdef __UNIX__
+    iovec iov[MAX_IOV_COUNT];
+    const int iovcnt = FillIOVec(iov, vec, count, offset);
+
+    int ret;
+    DO_WHILE_EINTR( ret, readv(m_fd, iov, iovcnt) );
+
+    if ( !ret )
+        OnStreamClosed();
+#else // !__UNIX__
+    // Just read into the first buffer, the caller will call us again for the
+    // subsequent ones if necessary.
+    wxUnusedVar(count);
+
+    int ret = RecvStream(static_cast<char *>(vec->data) + offset,
+                         vec->size - offset);
+#endif // __UNIX__/!__UNIX__
+
+    m_error = ret == SOCKET_ERROR ? GetLastError() : wxSOCKET_NOERROR;
+
+    return ret;
+}
+
+int wxSocketImpl::WriteV(const wxSocketIOVec *vec, int count, wxUint32 offset)
+{
+    if ( m_fd == INVALID_SOCKET || m_server || !m_stream )
+    {
+        m_error = wxSOCKET_INVSOCK;
+        return -1;
+    }
+
+#ifdef __UNIX__
+#ifdef wxNEEDS_IGNORE_SIGPIPE
+    IgnoreSignal ignore(SIGPIPE);
+#endif
+
+    iovec iov[MAX_IOV_COUNT];
+
+    // Use sendmsg() rather than writev() to be able to pass it the same flags
+    // as we use with send() in SendStream().
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = FillIOVec(iov, vec, count, offset);
+
+    int ret;
+    DO_WHILE_EINTR( ret, sendmsg(m_fd, &msg, wxSOCKET_MSG_NOSIGNAL) );
+#else // !__UNIX__
+    wxUnusedVar(count);
+
+    int ret = SendStream(static_cast<const char *>(vec->data) + offset,
+                         vec->size - offset);
+#endif // __UNIX__/!__UNIX__
+
+    m_error = ret == SOCKET_ERROR ? GetLastError() : wxSOCKET_NOERROR;
+
+    return ret;
+}
+
+#ifdef wxHAS_SOCKET_SENDFILE
+
+namespace
+{
+
+// Unlike send(), sendfile() has no way to avoid generating SIGPIPE if the peer
+// has closed the connection, so this class blocks it for the current thread
+// during its lifetime and discards the signal if it was generated.
+class SigPipeBlocker
+{
+public:
+    SigPipeBlocker()
+    {
+        sigemptyset(&m_sigpipe);
+        sigaddset(&m_sigpipe, SIGPIPE);
+
+        // If SIGPIPE is already pending, it must be blocked, and we can't
+        // distinguish it from the one we could generate, so don't do anything.
+        sigset_t pending;
+        m_blocked = sigpending(&pending) == 0 &&
+                        !sigismember(&pending, SIGPIPE) &&
+                            pthread_sigmask(SIG_BLOCK, &m_sigpipe, &m_old) == 0;
+    }
+
+    ~SigPipeBlocker()
+    {
+        if ( !m_blocked )
+            return;
+
+        sigset_t pending;
+        if ( sigpending(&pending) == 0 && sigismember(&pending, SIGPIPE) )
+        {
+            const timespec noWait = { 0, 0 };
+            sigtimedwait(&m_sigpipe, nullptr, &noWait);
+        }
+
+        pthread_sigmask(SIG_SETMASK, &m_old, nullptr);
+    }
+
+private:
+    sigset_t m_sigpipe,
+             m_old;
+    bool m_blocked;
+
+    wxDECLARE_NO_COPY_CLASS(SigPipeBlocker);
+};
+
+} // anonymous namespace
+
+int wxSocketImpl::SendFile(int fd, wxFileOffset *offset, wxUint32 size)
+{
+    if ( m_fd == INVALID_SOCKET || m_server || !m_stream )
+    {
+        m_error = wxSOCKET_INVSOCK;
+        return -1;
+    }
+
+    SigPipeBlocker noSigPipe;
+
+    off_t off = *offset;
+
+    int ret;
+    DO_WHILE_EINTR( ret, sendfile(m_fd, fd, &off, size) );
+
+    if ( ret == SOCKET_ERROR )
+    {
+        // These errors indicate that this file (or socket) can't be used with
+        // sendfile() at all, e.g. because it's a pipe.
+        m_error = errno == EINVAL || errno == ENOSYS ? wxSOCKET_INVOP
+                                                     : GetLastError();
+    }
+    else
+    {
+        *offset = off;
+        m_error = wxSOCKET_NOERROR;
+    }
+
+    return ret;
+}
+
+#endif // wxHAS_SOCKET_SENDFILE
+
 // ==========================================================================
 // wxSocketBase
 // ==========================================================================
@@ -945,6 +1146,26 @@ int wxSocketBase::GetBlockingFlagIfNeeded()
 // Basic IO calls
 // --------------------------------------------------------------------------
 
+namespace
+{
+
+// Advance the current position in the given buffers, represented by the index
+// of the current buffer and the offset in it, by the given number of bytes,
+// skipping any empty buffers following it.
+void
+AdvanceIOVec(const wxSocketIOVec *vec, int count,
+             int& n, wxUint32& offset, wxUint32 nbytes)
+{
+    offset += nbytes;
+    while ( n < count && offset >= vec[n].size )
+    {
+        offset -= vec[n].size;
+        n++;
+    }
+}
+
+} // anonymous namespace
+
 // The following IO operations update m_lcount:
 // {Read, Write, ReadMsg, WriteMsg, Peek, Unread, Discard}
 bool wxSocketBase::Close()
@@ -1061,6 +1282,89 @@ wxUint32 wxSocketBase::DoRead(void* buffer_, wxUint32 nbytes)
     return total;
 }
 
+wxSocketBase& wxSocketBase::ReadV(const wxSocketIOVec *vec, int count)
+{
+    wxSocketReadGuard read(this);
+
+    m_lcount_read = DoReadV(vec, count);
+    m_lcount = m_lcount_read;
+
+    return *this;
+}
+
+// This is the same as DoRead() but reads into several buffers.
+wxUint32 wxSocketBase::DoReadV(const wxSocketIOVec *vec, int count)
+{
+    wxCHECK_MSG( m_impl, 0, "socket must be valid" );
+    wxCHECK_MSG( vec || !count, 0, "null buffers" );
+    wxCHECK_MSG( m_impl->m_stream, 0, "only stream sockets are supported" );
+
+    // the index of the buffer being filled and the offset in it
+    int n = 0;
+    wxUint32 offset = 0;
+    AdvanceIOVec(vec, count, n, offset, 0);
+
+    // Use the push back buffer first, as DoRead() does.
+    wxUint32 total = 0;
+    while ( n < count )
+    {
+        const wxUint32 ret = GetPushback(static_cast<char *>(vec[n].data) + offset,
+                                         vec[n].size - offset, false);
+        if ( !ret )
+            break;
+
+        total += ret;
+        AdvanceIOVec(vec, count, n, offset, ret);
+    }
+
+    while ( n < count )
+    {
+        const int ret = m_connected ? m_impl->ReadV(vec + n, count - n, offset)
+                                    : 0;
+        if ( ret == -1 )
+        {
+            if ( m_impl->GetLastError() == wxSOCKET_WOULDBLOCK )
+            {
+                if ( m_flags & wxSOCKET_NOWAIT_READ )
+                {
+                    SetError(wxSOCKET_NOERROR);
+                    break;
+                }
+
+                if ( !DoWaitWithTimeout(wxSOCKET_INPUT_FLAG) )
+                {
+                    SetError(wxSOCKET_TIMEDOUT);
+                    break;
+                }
+
+                continue;
+            }
+            else // "real" error
+            {
+                SetError(wxSOCKET_IOERR);
+                break;
+            }
+        }
+        else if ( ret == 0 )
+        {
+            m_closed = true;
+
+            if ( (m_flags & wxSOCKET_WAITALL_READ) || !total )
+                SetError(wxSOCKET_IOERR);
+            break;
+        }
+
+        total += ret;
+
+        if ( !(m_flags & wxSOCKET_WAITALL_READ) )
+            break;
+
+        AdvanceIOVec(vec, count, n, offset, ret);
+    }
+
+    return total;
+}
+
 wxSocketBase& wxSocketBase::ReadMsg(void* buffer, wxUint32 nbytes)
 {
     struct
@@ -1250,13 +1554,78 @@ wxUint32 wxSocketBase::DoWrite(const void *buffer_, wxUint32 nbytes)
     return total;
 }
 
+wxSocketBase& wxSocketBase::WriteV(const wxSocketIOVec *vec, int count)
+{
+    wxSocketWriteGuard write(this);
+
+    m_lcount_write = DoWriteV(vec, count);
+    m_lcount = m_lcount_write;
+
+    return *this;
+}
+
+// This is the same as DoWrite() but writes from several buffers.
+wxUint32 wxSocketBase::DoWriteV(const wxSocketIOVec *vec, int count)
+{
+    wxCHECK_MSG( m_impl, 0, "socket must be valid" );
+    wxCHECK_MSG( vec || !count, 0, "null buffers" );
+    wxCHECK_MSG( m_impl->m_stream, 0, "only stream sockets are supported" );
+
+    int n = 0;
+    wxUint32 offset = 0;
+    AdvanceIOVec(vec, count, n, offset, 0);
+
+    wxUint32 total = 0;
+    while ( n < count )
+    {
+        if ( !m_connected )
+        {
+            if ( (m_flags & wxSOCKET_WAITALL_WRITE) || !total )
+                SetError(wxSOCKET_IOERR);
+            break;
+        }
+
+        const int ret = m_impl->WriteV(vec + n, count - n, offset);
+        if ( ret == -1 )
+        {
+            if ( m_impl->GetLastError() == wxSOCKET_WOULDBLOCK )
+            {
+                if ( m_flags & wxSOCKET_NOWAIT_WRITE )
+                    break;
+
+                if ( !DoWaitWithTimeout(wxSOCKET_OUTPUT_FLAG) )
+                {
+                    SetError(wxSOCKET_TIMEDOUT);
+                    break;
+                }
+
+                continue;
+            }
+            else // "real" error
+            {
+                SetError(wxSOCKET_IOERR);
+                break;
+            }
+        }
+
+        total += ret;
+
+        if ( !(m_flags & wxSOCKET_WAITALL_WRITE) )
+            break;
+
+        AdvanceIOVec(vec, count, n, offset, ret);
+    }
+
+    return total;
+}
+
 wxSocketBase& wxSocketBase::WriteMsg(const void *buffer, wxUint32 nbytes)
 {
     struct
     {
         unsigned char sig[4];
         unsigned char len[4];
-    } msg;
+    } msg, trailer;
 
     wxSocketWriteGuard write(this);
 
@@ -1272,23 +1641,44 @@ wxSocketBase& wxSocketBase::WriteMsg(const void *buffer, wxUint32 nbytes)
     msg.len[2] = (unsigned char) ((nbytes >> 16) & 0xff);
     msg.len[3] = (unsigned char) ((nbytes >> 24) & 0xff);
 
+    trailer.sig[0] = (unsigned char) 0xed;
+    trailer.sig[1] = (unsigned char) 0xfe;
+    trailer.sig[2] = (unsigned char) 0xad;
+    trailer.sig[3] = (unsigned char) 0xde;
+    trailer.len[0] =
+    trailer.len[1] =
+    trailer.len[2] =
+    trailer.len[3] = (char) 0;
+
     bool ok = false;
-    if ( DoWrite(&msg, sizeof(msg)) == sizeof(msg) )
+    if ( m_impl && m_impl->m_stream )
+    {
+        // Write everything at once instead of using 3 separate system calls,
+        // which could also result in sending 3 separate packets.
+        const wxSocketIOVec vec[] =
+        {
+            { &msg, sizeof(msg) },
+            { const_cast<void *>(buffer), nbytes },
+            { &trailer, sizeof(trailer) },
+        };
+
+        const wxUint32 total = DoWriteV(vec, WXSIZEOF(vec));
+
+        // As below, only the message data itself is counted.
+        m_lcount_write = total > sizeof(msg) ? total - sizeof(msg) : 0;
+        if ( m_lcount_write > nbytes )
+            m_lcount_write = nbytes;
+        m_lcount = m_lcount_write;
+
+        ok = total == sizeof(msg) + nbytes + sizeof(trailer);
+    }
+    else if ( DoWrite(&msg, sizeof(msg)) == sizeof(msg) )
     {
         m_lcount_write = DoWrite(buffer, nbytes);
         m_lcount = m_lcount_write;
         if ( m_lcount_write == nbytes )
         {
-            msg.sig[0] = (unsigned char) 0xed;
-            msg.sig[1] = (unsigned char) 0xfe;
-            msg.sig[2] = (unsigned char) 0xad;
-            msg.sig[3] = (unsigned char) 0xde;
-            msg.len[0] =
-            msg.len[1] =
-            msg.len[2] =
-            msg.len[3] = (char) 0;
-
-            if ( DoWrite(&msg, sizeof(msg)) == sizeof(msg))
+            if ( DoWrite(&trailer, sizeof(trailer)) == sizeof(trailer))
                 ok = true;
         }
     }
@@ -1299,6 +1689,127 @@ wxSocketBase& wxSocketBase::WriteMsg(const void *buffer, wxUint32 nbytes)
     return *this;
 }
 
+#if wxUSE_FILE
+
+wxSocketBase& wxSocketBase::WriteFile(wxFile& file, wxUint32 nbytes)
+{
+    wxSocketWriteGuard write(this);
+
+    m_lcount_write = DoWriteFile(file, nbytes);
+    m_lcount = m_lcount_write;
+
+    return *this;
+}
+
+wxUint32 wxSocketBase::DoWriteFile(wxFile& file, wxUint32 nbytes)
+{
+    wxCHECK_MSG( m_impl, 0, "socket must be valid" );
+    wxCHECK_MSG( file.IsOpened(), 0, "file must be opened" );
+
+    wxUint32 total = 0;
+
+#ifdef wxHAS_SOCKET_SENDFILE
+    // Send the file data directly from the kernel if possible, this loop is
+    // the same as in DoWrite().
+    bool useSendFile = m_impl->m_stream;
+    if ( useSendFile )
+    {
+        wxFileOffset offset = file.Tell();
+
+        while ( nbytes )
+        {
+            if ( !m_connected )
+            {
+                if ( (m_flags & wxSOCKET_WAITALL_WRITE) || !total )
+                    SetError(wxSOCKET_IOERR);
+                break;
+            }
+
+            const int ret = m_impl->SendFile(file.fd(), &offset, nbytes);
+            if ( ret == -1 )
+            {
+                if ( m_impl->GetError() == wxSOCKET_INVOP && !total )
+                {
+                    // This file can't be sent directly, fall back on copying.
+                    useSendFile = false;
+                    break;
+                }
+
+                if ( m_impl->GetLastError() == wxSOCKET_WOULDBLOCK )
+                {
+                    if ( m_flags & wxSOCKET_NOWAIT_WRITE )
+                        break;
+
+                    if ( !DoWaitWithTimeout(wxSOCKET_OUTPUT_FLAG) )
+                    {
+                        SetError(wxSOCKET_TIMEDOUT);
+                        break;
+                    }
+
+                    continue;
+                }
+                else // "real" error
+                {
+                    SetError(wxSOCKET_IOERR);
+                    break;
+                }
+            }
+            else if ( ret == 0 )
+            {
+                // end of file
+                break;
+            }
+
+            total += ret;
+
+            if ( !(m_flags & wxSOCKET_WAITALL_WRITE) )
+                break;
+
+            nbytes -= ret;
+        }
+
+        // sendfile() doesn't update the file position, do it ourselves.
+        if ( useSendFile )
+        {
+            file.Seek(offset);
+            return total;
+        }
+    }
+#endif // wxHAS_SOCKET_SENDFILE
+
+    std::unique_ptr<char[]>
+        buffer(new char[wxMin(nbytes, WRITE_FILE_BUFFER_SIZE)]);
+
+    while ( nbytes )
+    {
+        const ssize_t nRead = file.Read(buffer.get(),
+                                        wxMin(nbytes, WRITE_FILE_BUFFER_SIZE));
+        if ( nRead == wxInvalidOffset )
+        {
+            SetError(wxSOCKET_IOERR);
+            break;
+        }
+
+        if ( !nRead )
+            break;
+
+        const wxUint32 nWritten = DoWrite(buffer.get(), nRead);
+        total += nWritten;
+        nbytes -= nWritten;
+
+        if ( nWritten < static_cast<wxUint32>(nRead) )
+        {
+            // Don't skip over the part of the file which wasn't written.
+            file.Seek(static_cast<wxFileOffset>(nWritten) - nRead, wxFromCurrent);
+            break;
+        }
+    }
+
+    return total;
+}
+
+#endif // wxUSE_FILE
+
 wxSocketBase& wxSocketBase::Unread(const void *buffer, wxUint32 nbytes)
 {
     if (nbytes != 0)
@@ -1591,7 +2102,7 @@ bool wxSocketBase::Wait(long seconds, long milliseconds)
 bool wxSocketBase::WaitForRead(long seconds, long milliseconds)
 {
     // Check pushback buffer before entering DoWait
-    if ( m_unread )
+    if ( m_unrd_cur < m_unrd_size )
         return true;
 
     // Check if the socket is not already ready for input, if it is, there is
@@ -1819,29 +2330,33 @@ void wxSocketBase::Pushback(const void *buffer, wxUint32 size)
 {
     if (!size) return;
 
-    if (m_unread == nullptr)
-        m_unread = malloc(size);
-    else
+    // The existing data is at the end of the buffer, so we only need to
+    // reallocate it if there is not enough space before it.
+    if (m_unrd_cur < size)
     {
-        void *tmp;
+        const wxUint32 used = m_unrd_size - m_unrd_cur;
+        const wxUint32 newSize = wxMax(2*m_unrd_size, used + size);
 
-        tmp = malloc(m_unrd_size + size);
-        memcpy((char *)tmp + size, m_unread, m_unrd_size);
+        char * const tmp = (char *)malloc(newSize);
+        if (used)
+            memcpy(tmp + newSize - used, (char *)m_unread + m_unrd_cur, used);
         free(m_unread);
 
         m_unread = tmp;
+        m_unrd_size = newSize;
+        m_unrd_cur = newSize - used;
     }
 
-    m_unrd_size += size;
+    m_unrd_cur -= size;
 
-    memcpy(m_unread, buffer, size);
+    memcpy((char *)m_unread + m_unrd_cur, buffer, size);
 }
 
 wxUint32 wxSocketBase::GetPushback(void *buffer, wxUint32 size, bool peek)
 {
     wxCHECK_MSG( buffer, 0, "null buffer" );
 
-    if (!m_unrd_size)
+    if (m_unrd_cur == m_unrd_size)
         return 0;
 
     if (size > (m_unrd_size-m_unrd_cur))
@@ -1852,7 +2367,10 @@ wxUint32 wxSocketBase::GetPushback(void *buffer, wxUint32 size, bool peek)
     if (!peek)
     {
         m_unrd_cur += size;
-        if (m_unrd_size == m_unrd_cur)
+
+        // Keep the empty buffer for reuse by the next Peek() or Unread(),
+        // unless it's too big.
+        if (m_unrd_size == m_unrd_cur && m_unrd_size > MAX_PUSHBACK_KEEP_SIZE)
         {
             free(m_unread);
             m_unread = nullptr;
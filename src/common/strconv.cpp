@@ -49,6 +49,17 @@
 
 #include <unordered_map>
 
+// SIMD instructions used for the UTF-8 conversions of ASCII text: only use
+// them when they are always available for the target architecture, so that
+// no run-time checks are needed.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define wxHAS_UTF8_SSE2
+    #include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define wxHAS_UTF8_NEON
+    #include <arm_neon.h>
+#endif
+
 #define TRACE_STRCONV wxT("strconv")
 
 // WC_UTF16 is defined only if sizeof(wchar_t) == 2, otherwise it's supposed to
@@ -952,6 +963,189 @@ extern const unsigned char tableUtf8Lengths[256] = {
                    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0   // F5..FF
 };
 
+// Text is very often mostly, if not entirely, ASCII, so the UTF-8 conversion
+// functions below convert the runs of ASCII characters using the functions
+// here, processing 16 characters at once if possible, and only decode or
+// encode the other characters one by one.
+
+// Convert at most len ASCII characters from src to dst, which may be null if
+// the characters only need to be counted. Returns the number of characters
+// converted, which is less than len if a non-ASCII character was found.
+static size_t
+wxConvertASCIIToWChar(const char *src, size_t len, wchar_t *dst)
+{
+    size_t n = 0;
+
+#if defined(wxHAS_UTF8_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for ( ; len - n >= 16; n += 16 )
+    {
+        const __m128i
+            bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + n));
+        if ( _mm_movemask_epi8(bytes) )
+            break;
+
+        if ( dst )
+        {
+            const __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+            const __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+
+            __m128i* const out = reinterpret_cast<__m128i*>(dst + n);
+#ifdef WC_UTF16
+            _mm_storeu_si128(out, lo);
+            _mm_storeu_si128(out + 1, hi);
+#else // !WC_UTF16
+            _mm_storeu_si128(out, _mm_unpacklo_epi16(lo, zero));
+            _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(lo, zero));
+            _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(hi, zero));
+            _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(hi, zero));
+#endif // WC_UTF16/!WC_UTF16
+        }
+    }
+#elif defined(wxHAS_UTF8_NEON)
+    for ( ; len - n >= 16; n += 16 )
+    {
+        const uint8x16_t
+            bytes = vld1q_u8(reinterpret_cast<const uint8_t*>(src + n));
+        if ( vmaxvq_u8(bytes) >= 0x80 )
+            break;
+
+        if ( dst )
+        {
+            const uint16x8_t lo = vmovl_u8(vget_low_u8(bytes));
+            const uint16x8_t hi = vmovl_u8(vget_high_u8(bytes));
+
+#ifdef WC_UTF16
+            uint16_t* const out = reinterpret_cast<uint16_t*>(dst + n);
+            vst1q_u16(out, lo);
+            vst1q_u16(out + 8, hi);
+#else // !WC_UTF16
+            uint32_t* const out = reinterpret_cast<uint32_t*>(dst + n);
+            vst1q_u32(out, vmovl_u16(vget_low_u16(lo)));
+            vst1q_u32(out + 4, vmovl_u16(vget_high_u16(lo)));
+            vst1q_u32(out + 8, vmovl_u16(vget_low_u16(hi)));
+            vst1q_u32(out + 12, vmovl_u16(vget_high_u16(hi)));
+#endif // WC_UTF16/!WC_UTF16
+        }
+    }
+#else // no SIMD
+    // Check 8 bytes at once, even if we still have to copy them one by one.
+    for ( ; len - n >= 8; n += 8 )
+    {
+        wxUint64 word;
+        memcpy(&word, src + n, sizeof(word));
+        if ( word & wxULL(0x8080808080808080) )
+            break;
+
+        if ( dst )
+        {
+            for ( size_t i = n; i < n + 8; i++ )
+                dst[i] = static_cast<unsigned char>(src[i]);
+        }
+    }
+#endif // SIMD
+
+    // Handle the remaining characters, if any, one by one.
+    for ( ; n < len; n++ )
+    {
+        const unsigned char c = src[n];
+        if ( c >= 0x80 )
+            break;
+
+        if ( dst )
+            dst[n] = c;
+    }
+
+    return n;
+}
+
+// Convert at most len ASCII characters from src to dst, which may be null.
+// Returns the number of characters converted, just as the function above.
+static size_t
+wxConvertASCIIFromWChar(const wchar_t *src, size_t len, char *dst)
+{
+    size_t n = 0;
+
+#if defined(wxHAS_UTF8_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for ( ; len - n >= 16; n += 16 )
+    {
+        const __m128i* const in = reinterpret_cast<const __m128i*>(src + n);
+
+#ifdef WC_UTF16
+        const __m128i w0 = _mm_loadu_si128(in);
+        const __m128i w1 = _mm_loadu_si128(in + 1);
+
+        const __m128i high = _mm_and_si128(_mm_or_si128(w0, w1),
+                                           _mm_set1_epi16(~0x7F));
+        if ( _mm_movemask_epi8(_mm_cmpeq_epi16(high, zero)) != 0xFFFF )
+            break;
+
+        const __m128i bytes = _mm_packus_epi16(w0, w1);
+#else // !WC_UTF16
+        const __m128i w0 = _mm_loadu_si128(in);
+        const __m128i w1 = _mm_loadu_si128(in + 1);
+        const __m128i w2 = _mm_loadu_si128(in + 2);
+        const __m128i w3 = _mm_loadu_si128(in + 3);
+
+        const __m128i all = _mm_or_si128(_mm_or_si128(w0, w1),
+                                         _mm_or_si128(w2, w3));
+        const __m128i high = _mm_and_si128(all, _mm_set1_epi32(~0x7F));
+        if ( _mm_movemask_epi8(_mm_cmpeq_epi32(high, zero)) != 0xFFFF )
+            break;
+
+        // All values are less than 0x80, so saturation never happens here.
+        const __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(w0, w1),
+                                               _mm_packs_epi32(w2, w3));
+#endif // WC_UTF16/!WC_UTF16
+
+        if ( dst )
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + n), bytes);
+    }
+#elif defined(wxHAS_UTF8_NEON)
+    for ( ; len - n >= 16; n += 16 )
+    {
+#ifdef WC_UTF16
+        const uint16_t* const in = reinterpret_cast<const uint16_t*>(src + n);
+        const uint16x8_t w0 = vld1q_u16(in);
+        const uint16x8_t w1 = vld1q_u16(in + 8);
+        if ( vmaxvq_u16(vorrq_u16(w0, w1)) >= 0x80 )
+            break;
+#else // !WC_UTF16
+        const uint32_t* const in = reinterpret_cast<const uint32_t*>(src + n);
+        const uint32x4_t d0 = vld1q_u32(in);
+        const uint32x4_t d1 = vld1q_u32(in + 4);
+        const uint32x4_t d2 = vld1q_u32(in + 8);
+        const uint32x4_t d3 = vld1q_u32(in + 12);
+        const uint32x4_t all = vorrq_u32(vorrq_u32(d0, d1), vorrq_u32(d2, d3));
+        if ( vmaxvq_u32(all) >= 0x80 )
+            break;
+
+        const uint16x8_t w0 = vcombine_u16(vmovn_u32(d0), vmovn_u32(d1));
+        const uint16x8_t w1 = vcombine_u16(vmovn_u32(d2), vmovn_u32(d3));
+#endif // WC_UTF16/!WC_UTF16
+
+        if ( dst )
+        {
+            vst1q_u8(reinterpret_cast<uint8_t*>(dst + n),
+                     vcombine_u8(vmovn_u16(w0), vmovn_u16(w1)));
+        }
+    }
+#endif // SIMD
+
+    for ( ; n < len; n++ )
+    {
+        const wxUint32 wc = static_cast<wxUint32>(src[n]);
+        if ( wc >= 0x80 )
+            break;
+
+        if ( dst )
+            dst[n] = static_cast<char>(wc);
+    }
+
+    return n;
+}
+
 size_t
 wxMBConvStrictUTF8::ToWChar(wchar_t *dst, size_t dstLen,
                             const char *src, size_t srcLen) const
@@ -962,7 +1156,7 @@ wxMBConvStrictUTF8::ToWChar(wchar_t *dst, size_t dstLen,
     if ( srcLen == wxNO_LEN )
         srcLen = strlen(src) + 1;
 
-    for ( const char *p = src; ; p++ )
+    for ( const char *p = src; ; )
     {
         if ( (srcLen == wxNO_LEN ? !*p : !srcLen) )
         {
@@ -984,6 +1178,28 @@ wxMBConvStrictUTF8::ToWChar(wchar_t *dst, size_t dstLen,
             return written;
         }
 
+        if ( static_cast<unsigned char>(*p) < 0x80 )
+        {
+            size_t ascii = srcLen;
+            if ( out && dstLen < ascii )
+                ascii = dstLen;
+
+            ascii = wxConvertASCIIToWChar(p, ascii, out);
+            if ( ascii )
+            {
+                p += ascii;
+                srcLen -= ascii;
+                written += ascii;
+                if ( out )
+                {
+                    out += ascii;
+                    dstLen -= ascii;
+                }
+
+                continue;
+            }
+        }
+
         if ( out && !dstLen-- )
             break;
 
@@ -1062,6 +1278,7 @@ wxMBConvStrictUTF8::ToWChar(wchar_t *dst, size_t dstLen,
             out++;
 
         written++;
+        p++;
     }
 
     return wxCONV_FAILED;
@@ -1097,6 +1314,27 @@ wxMBConvStrictUTF8::FromWChar(char *dst, size_t dstLen,
             return written;
         }
 
+        if ( end && static_cast<wxUint32>(*wp) < 0x80 )
+        {
+            size_t ascii = end - wp;
+            if ( out && dstLen < ascii )
+                ascii = dstLen;
+
+            ascii = wxConvertASCIIFromWChar(wp, ascii, out);
+            if ( ascii )
+            {
+                wp += ascii;
+                written += ascii;
+                if ( out )
+                {
+                    out += ascii;
+                    dstLen -= ascii;
+                }
+
+                continue;
+            }
+        }
+
         wxUint32 code;
 #ifdef WC_UTF16
         code = wxDecodeSurrogate(&wp, end);
@@ -1191,6 +1429,27 @@ size_t wxMBConvUTF8::ToWChar(wchar_t *buf, size_t n,
     const bool isNulTerminated = srcLen == wxNO_LEN;
     while ((isNulTerminated ? *psz : srcLen--) && ((!buf) || (len < n)))
     {
+        // Convert the runs of ASCII characters at once, unless we need to
+        // escape backslashes in them.
+        if ( !isNulTerminated &&
+                !(m_options & MAP_INVALID_UTF8_TO_OCTAL) &&
+                    static_cast<unsigned char>(*psz) < 0x80 )
+        {
+            // Note that srcLen had been already decremented above.
+            size_t ascii = srcLen + 1;
+            if ( buf && n - len < ascii )
+                ascii = n - len;
+
+            ascii = wxConvertASCIIToWChar(psz, ascii, buf);
+            psz += ascii;
+            srcLen -= ascii - 1;
+            len += ascii;
+            if ( buf )
+                buf += ascii;
+
+            continue;
+        }
+
         const char *opsz = psz;
         unsigned char cc = *psz++, fc = cc;
         unsigned cnt;
@@ -1364,6 +1623,23 @@ size_t wxMBConvUTF8::FromWChar(char *buf, size_t n,
     const wchar_t* const end = srcLen == wxNO_LEN ? nullptr : psz + srcLen;
     while ((end ? psz < end : *psz) && ((!buf) || (len < n)))
     {
+        if ( end &&
+                !(m_options & MAP_INVALID_UTF8_TO_OCTAL) &&
+                    static_cast<wxUint32>(*psz) < 0x80 )
+        {
+            size_t ascii = end - psz;
+            if ( buf && n - len < ascii )
+                ascii = n - len;
+
+            ascii = wxConvertASCIIFromWChar(psz, ascii, buf);
+            psz += ascii;
+            len += ascii;
+            if ( buf )
+                buf += ascii;
+
+            continue;
+        }
+
         wxUint32 cc;
 
 #ifdef WC_UTF16
@@ -29,6 +29,7 @@
 #include <string.h>
 #include <stdlib.h>
 
+#include "wx/hashmap.h"
 #include "wx/uilocale.h"
 #include "wx/vector.h"
 #include "wx/xlocale.h"
@@ -64,6 +65,7 @@ UntypedBufferData *GetUntypedNullData()
 
 //According to STL _must_ be a -1 size_t
 const size_t wxString::npos = (size_t) -1;
+const size_t wxStringView::npos = (size_t) -1;
 
 // FIXME-UTF8: get rid of this, have only one wxEmptyString
 #if wxUSE_UNICODE_UTF8
@@ -79,6 +81,104 @@ wxString::Cache& wxString::GetCache()
     return s_cache;
 }
 
+struct wxStrCacheMarksDeleter
+{
+    ~wxStrCacheMarksDeleter()
+    {
+        wxString::Cache::Element * const cacheBegin = wxString::GetCacheBegin();
+        for ( unsigned n = 0; n < wxString::Cache::SIZE; n++ )
+        {
+            wxString::Cache::Element& c = cacheBegin[n];
+
+            free(c.marks);
+            c.marks = nullptr;
+            c.numMarks =
+            c.maxMarks = 0;
+        }
+    }
+};
+
+size_t wxString::DoPosToImplUsingMarks(Cache::Element *cache,
+                                       size_t pos,
+                                       size_t from,
+                                       size_t fromImpl) const
+{
+    const size_t step = Cache::MARK_STEP;
+
+    // start from the closest mark preceding the position if it's closer than
+    // the starting point proposed by the caller
+    size_t nMark = pos / step;
+    if ( nMark > cache->numMarks )
+        nMark = cache->numMarks;
+    if ( nMark && nMark*step > from )
+    {
+        wxCACHE_PROFILE_FIELD_INC(markhits);
+
+        from = nMark*step;
+        fromImpl = cache->marks[nMark - 1];
+    }
+
+    // the marks in the ASCII prefix are trivial, add them if necessary to be
+    // able to continue adding the marks after it below
+    while ( (cache->numMarks + 1)*step <= cache->ascii )
+    {
+        if ( !AddCacheMark(cache, (cache->numMarks + 1)*step) )
+            break;
+    }
+
+    wxCACHE_PROFILE_FIELD_ADD(sumofs, pos - from);
+
+    // note that we only add the new marks if there is no gap between the last
+    // existing one and the starting position
+    size_t nextMark = (cache->numMarks + 1)*step;
+
+    wxStringImpl::const_iterator i(m_impl.begin() + fromImpl);
+    for ( size_t n = from; n < pos; )
+    {
+        wxStringOperations::IncIter(i);
+
+        if ( ++n == nextMark )
+        {
+            if ( AddCacheMark(cache, i - m_impl.begin()) )
+                nextMark += step;
+        }
+    }
+
+    cache->pos = pos;
+    cache->impl = i - m_impl.begin();
+
+    wxSTRING_CACHE_ASSERT(
+        (int)cache->impl == (begin() + pos).impl() - m_impl.begin() );
+
+    return cache->impl;
+}
+
+/* static */
+bool wxString::AddCacheMark(Cache::Element *cache, size_t impl)
+{
+    if ( cache->numMarks == cache->maxMarks )
+    {
+        // ensure that the memory allocated here is freed when the thread
+        // exits, notice that this object must be separate from the cache
+        // itself, see the comment before wxString::Cache
+        static wxTHREAD_SPECIFIC_DECL wxStrCacheMarksDeleter s_marksDeleter;
+        wxUnusedVar(s_marksDeleter);
+
+        const size_t maxMarks = cache->maxMarks ? 2*cache->maxMarks : 16;
+        size_t * const
+            marks = (size_t *)realloc(cache->marks, maxMarks*sizeof(size_t));
+        if ( !marks )
+            return false;
+
+        cache->marks = marks;
+        cache->maxMarks = maxMarks;
+    }
+
+    cache->marks[cache->numMarks++] = impl;
+
+    return true;
+}
+
 // gdb seems to be unable to display thread-local variables correctly, at least
 // not my 6.4.98 version under amd64, so provide this debugging helper to do it
 #if wxDEBUG_LEVEL >= 2
@@ -93,13 +193,15 @@ struct wxStrCacheDumper
             const wxString::Cache::Element&
                 c = wxString::GetCacheBegin()[n];
 
-            printf("\t%u%s\t%p: pos=(%lu, %lu), len=%ld\n",
+            printf("\t%u%s\t%p: pos=(%lu, %lu), len=%ld, ascii=%lu, marks=%lu\n",
                    n,
                    n == wxString::LastUsedCacheElement() ? " [*]" : "",
                    c.str,
                    (unsigned long)c.pos,
                    (unsigned long)c.impl,
-                   (long)c.len);
+                   (long)c.len,
+                   (unsigned long)c.ascii,
+                   (unsigned long)c.numMarks);
         }
     }
 };
@@ -110,13 +212,13 @@ void wxDumpStrCache() { wxStrCacheDumper::ShowAll(); }
 
 #ifdef wxPROFILE_STRING_CACHE
 
-wxString::CacheStats wxString::ms_cacheStats;
+wxString::PosToImplCacheStats wxString::ms_cacheStats;
 
 struct wxStrCacheStatsDumper
 {
     ~wxStrCacheStatsDumper()
     {
-        const wxString::CacheStats& stats = wxString::ms_cacheStats;
+        const wxString::PosToImplCacheStats& stats = wxString::ms_cacheStats;
 
         if ( stats.postot )
         {
@@ -127,6 +229,10 @@ struct wxStrCacheStatsDumper
                    stats.poshits,
                    stats.mishits,
                    100.*float(stats.poshits - stats.mishits)/stats.postot);
+            printf("\tFound in ASCII prefix %u or %.2f%%, using marks %u\n",
+                   stats.asciihits,
+                   100.*float(stats.asciihits)/stats.postot,
+                   stats.markhits);
             printf("\tAverage position requested: %.2f\n",
                    float(stats.sumpos) / stats.postot);
             printf("\tAverage offset after cached hint: %.2f\n",
@@ -245,6 +351,16 @@ void wxString::PosLenToImpl(size_t pos, size_t len,
         }
         else // have valid length too
         {
+#if wxUSE_STRING_POS_CACHE
+            // nothing to do if the substring is inside the ASCII prefix
+            const Cache::Element * const cache = FindCacheElement();
+            if ( cache && cache->ascii >= pos && len <= cache->ascii - pos )
+            {
+                *implLen = len;
+                return;
+            }
+#endif // wxUSE_STRING_POS_CACHE
+
             // we need to handle the case of length specifying a substring
             // going beyond the end of the string, just as std::string does
             const const_iterator e(end());
@@ -867,91 +983,246 @@ size_t wxString::find_last_not_of(const char* sz, size_t nStart,
 // other common string functions
 // ===========================================================================
 
-int wxString::CmpNoCase(const wxString& s) const
+namespace
 {
-#if !wxUSE_UNICODE_UTF8
-    // We compare NUL-delimited chunks of the strings inside the loop. We will
-    // do as many iterations as there are embedded NULs in the string, i.e.
-    // usually we will run it just once.
 
-    typedef const wxStringImpl::value_type *pchar_type;
-    const pchar_type thisBegin = m_impl.c_str();
-    const pchar_type thatBegin = s.m_impl.c_str();
+// ----------------------------------------------------------------------------
+// case-insensitive comparison and case conversion helpers
+// ----------------------------------------------------------------------------
+
+// The functions below work with ASCII characters a word at a time: several
+// code units are packed into a 64-bit integer and the same operation is
+// applied to all of them at once, which is portable and much faster than
+// calling towlower() for each of them. The full Unicode case folding is only
+// used for the non-ASCII characters.
+typedef wxUint64 UnitsWord;
 
-    const pchar_type thisEnd = thisBegin + m_impl.length();
-    const pchar_type thatEnd = thatBegin + s.m_impl.length();
+const size_t UNITS_PER_WORD = sizeof(UnitsWord) / sizeof(wxStringCharType);
 
-    pchar_type thisCur = thisBegin;
-    pchar_type thatCur = thatBegin;
+// Word with only the lowest bit of each code unit set.
+const UnitsWord WORD_LOW_BITS =
+    ~UnitsWord(0) / ((UnitsWord(1) << (8*sizeof(wxStringCharType))) - 1);
 
-    int rc;
-    for ( ;; )
+// Word with all the bits which are never set in ASCII code units set.
+const UnitsWord WORD_NON_ASCII =
+    WORD_LOW_BITS *
+        (((UnitsWord(1) << (8*sizeof(wxStringCharType))) - 1) & ~UnitsWord(0x7f));
+
+inline UnitsWord LoadWord(const wxStringCharType* p)
+{
+    UnitsWord w;
+    memcpy(&w, p, sizeof(w));
+    return w;
+}
+
+inline void StoreWord(wxStringCharType* p, UnitsWord w)
+{
+    memcpy(p, &w, sizeof(w));
+}
+
+// Return the mask with 0x20 bit set in all units of the given word, which
+// must contain only ASCII characters, which are between "first" and "last".
+inline UnitsWord GetAsciiRangeMask(UnitsWord w, unsigned first, unsigned last)
+{
+    // The high bit of each unit of "ge" is set if it is >= first and of "gt"
+    // if it is > last: as all units are <= 0x7f, there is no carry into the
+    // next unit.
+    const UnitsWord ge = w + WORD_LOW_BITS*(0x80 - first);
+    const UnitsWord gt = w + WORD_LOW_BITS*(0x80 - last - 1);
+
+    return (ge & ~gt & (WORD_LOW_BITS*0x80)) >> 2;
+}
+
+inline wxUint32 GetUnit(char c) { return static_cast<unsigned char>(c); }
+inline wxUint32 GetUnit(wchar_t c) { return static_cast<wxUint32>(c); }
+
+// ASCII case conversion is the same in all locales and is done by toggling
+// the 0x20 bit of the letters.
+struct AsciiToLower
+{
+    static UnitsWord Word(UnitsWord w)
+        { return w | GetAsciiRangeMask(w, 'A', 'Z'); }
+
+    static wxUint32 Unit(wxUint32 c)
+        { return c - 'A' < 26 ? c + ('a' - 'A') : c; }
+
+    static wxUint32 NonAscii(wxUint32 c)
+        { return static_cast<wxUint32>(wxCRT_TolowerW(static_cast<wint_t>(c))); }
+};
+
+struct AsciiToUpper
+{
+    static UnitsWord Word(UnitsWord w)
+        { return w & ~GetAsciiRangeMask(w, 'a', 'z'); }
+
+    static wxUint32 Unit(wxUint32 c)
+        { return c - 'a' < 26 ? c - ('a' - 'A') : c; }
+
+    static wxUint32 NonAscii(wxUint32 c)
+        { return static_cast<wxUint32>(wxCRT_ToupperW(static_cast<wint_t>(c))); }
+};
+
+// Return the character used for case-insensitive comparison.
+inline wxUint32 FoldCase(wxUint32 c)
+{
+    return c < 0x80 ? AsciiToLower::Unit(c) : AsciiToLower::NonAscii(c);
+}
+
+// Change the case of ASCII characters in the given buffer and return the
+// position of the first non-ASCII code unit or len if there are none.
+template <typename Converter>
+size_t ChangeAsciiCase(wxStringCharType* p, size_t len)
+{
+    size_t n = 0;
+    for ( ; n + UNITS_PER_WORD <= len; n += UNITS_PER_WORD )
     {
-        // Compare until the next NUL, if the strings differ this is the final
-        // result.
-        rc = wxStricmp(thisCur, thatCur);
-        if ( rc )
+        const UnitsWord w = LoadWord(p + n);
+        if ( w & WORD_NON_ASCII )
             break;
 
-        const size_t lenChunk = wxStrlen(thisCur);
-        thisCur += lenChunk;
-        thatCur += lenChunk;
+        const UnitsWord changed = Converter::Word(w);
+        if ( changed != w )
+            StoreWord(p + n, changed);
+    }
 
-        // Skip all the NULs as wxStricmp() doesn't handle them.
-        for ( ; !*thisCur; thisCur++, thatCur++ )
-        {
-            // Check if we exhausted either of the strings.
-            if ( thisCur == thisEnd )
-            {
-                // This one is exhausted, is the other one too?
-                return thatCur == thatEnd ? 0 : -1;
-            }
+    for ( ; n < len; n++ )
+    {
+        const wxUint32 c = GetUnit(p[n]);
+        if ( c >= 0x80 )
+            break;
 
-            if ( thatCur == thatEnd )
-            {
-                // Because of the test above we know that this one is not
-                // exhausted yet so it's greater than the other one that is.
-                return 1;
-            }
+        p[n] = static_cast<wxStringCharType>(Converter::Unit(c));
+    }
 
-            if ( *thatCur )
-            {
-                // Anything non-NUL is greater than NUL.
-                return -1;
-            }
-        }
+    return n;
+}
+
+#if wxUSE_UNICODE_UTF8
+
+inline bool IsUtf8Continuation(char c)
+{
+    return (static_cast<unsigned char>(c) & 0xc0) == 0x80;
+}
+
+// Decode the character at the given position of a valid UTF-8 string and
+// advance the pointer past it.
+inline wxUint32 DecodeUtf8Char(const char*& p)
+{
+    const unsigned char lead = static_cast<unsigned char>(*p++);
+    if ( lead < 0x80 )
+        return lead;
+
+    const size_t len = wxStringOperations::GetUtf8CharLength(lead);
+
+    wxUint32 code = lead & (0x7f >> len);
+    for ( size_t n = 1; n < len; n++ )
+        code = (code << 6) | (static_cast<unsigned char>(*p++) & 0x3f);
+
+    return code;
+}
+
+// Compare the strings ignoring case, one character at a time.
+int DoCmpNoCaseUtf8(const char* p1, const char* end1,
+                    const char* p2, const char* end2)
+{
+    while ( p1 != end1 && p2 != end2 )
+    {
+        const wxUint32 c1 = FoldCase(DecodeUtf8Char(p1)),
+                       c2 = FoldCase(DecodeUtf8Char(p2));
+        if ( c1 != c2 )
+            return c1 < c2 ? -1 : 1;
     }
 
-    return rc;
-#else // wxUSE_UNICODE_UTF8
-    // CRT functions can't be used for case-insensitive comparison of UTF-8
-    // strings so do it in the naive, simple and inefficient way.
+    return p1 != end1 ? 1 : p2 != end2 ? -1 : 0;
+}
 
-    // FIXME-UTF8: use wxUniChar::ToLower/ToUpper once added
-    const_iterator i1 = begin();
-    const_iterator end1 = end();
-    const_iterator i2 = s.begin();
-    const_iterator end2 = s.end();
+#endif // wxUSE_UNICODE_UTF8
+
+// Compare the strings in internal representation ignoring case.
+int DoCmpNoCase(const wxStringCharType* s1, size_t len1,
+                const wxStringCharType* s2, size_t len2)
+{
+    const size_t len = len1 < len2 ? len1 : len2;
 
-    for ( ; i1 != end1 && i2 != end2; ++i1, ++i2 )
+    // Skip the part of the strings which is the same, possibly after folding
+    // the case of ASCII letters, a word at a time.
+    size_t n = 0;
+    for ( ; n + UNITS_PER_WORD <= len; n += UNITS_PER_WORD )
     {
-        wxUniChar lower1 = (wxChar)wxTolower(*i1);
-        wxUniChar lower2 = (wxChar)wxTolower(*i2);
-        if ( lower1 != lower2 )
-            return lower1 < lower2 ? -1 : 1;
+        const UnitsWord w1 = LoadWord(s1 + n),
+                        w2 = LoadWord(s2 + n);
+        if ( w1 == w2 )
+            continue;
+
+        if ( ((w1 | w2) & WORD_NON_ASCII) ||
+                AsciiToLower::Word(w1) != AsciiToLower::Word(w2) )
+            break;
+    }
+
+    // Then find the first different character, if any.
+    for ( ; n < len; n++ )
+    {
+        wxUint32 c1 = GetUnit(s1[n]),
+                 c2 = GetUnit(s2[n]);
+        if ( c1 == c2 )
+            continue;
+
+#if wxUSE_UNICODE_UTF8
+        if ( (c1 | c2) >= 0x80 )
+        {
+            // Compare the rest of the strings, starting from the beginning of
+            // the current character, which is the same for both of them as
+            // the preceding bytes are equal, using full case folding.
+            while ( n > 0 &&
+                        (IsUtf8Continuation(s1[n]) ||
+                            IsUtf8Continuation(s2[n])) )
+                n--;
+
+            return DoCmpNoCaseUtf8(s1 + n, s1 + len1, s2 + n, s2 + len2);
+        }
+#endif // wxUSE_UNICODE_UTF8
+
+        c1 = FoldCase(c1);
+        c2 = FoldCase(c2);
+        if ( c1 != c2 )
+            return c1 < c2 ? -1 : 1;
     }
 
-    size_t len1 = length();
-    size_t len2 = s.length();
+    return len1 < len2 ? -1 : len1 > len2 ? 1 : 0;
+}
+
+} // anonymous namespace
 
-    if ( len1 < len2 )
-        return -1;
-    else if ( len1 > len2 )
-        return 1;
-    return 0;
-#endif // !wxUSE_UNICODE_UTF8/wxUSE_UNICODE_UTF8
+int wxString::CmpNoCase(const wxString& s) const
+{
+    return DoCmpNoCase(m_impl.data(), m_impl.length(),
+                       s.m_impl.data(), s.m_impl.length());
 }
 
+/* static */
+unsigned long wxStringHashNoCase::stringHash(const wxString& str)
+{
+    // Use FNV-1a hash of the case-folded characters, this must be consistent
+    // with CmpNoCase().
+    wxUint32 hash = 2166136261u;
+
+    const wxStringView view(str);
+    const wxStringCharType* p = view.data();
+    const wxStringCharType* const end = view.end();
+    while ( p != end )
+    {
+#if wxUSE_UNICODE_UTF8
+        const wxUint32 c = FoldCase(DecodeUtf8Char(p));
+#else
+        const wxUint32 c = FoldCase(GetUnit(*p++));
+#endif
+
+        hash ^= c;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
 
 wxString wxString::FromAscii(const char *ascii, size_t len)
 {
@@ -1332,18 +1603,51 @@ wxString wxString::Strip(stripType w) const
 
 wxString& wxString::MakeUpper()
 {
-  for ( iterator it = begin(), en = end(); it != en; ++it )
-    *it = (wxChar)wxToupper(*it);
+    DoChangeCase<AsciiToUpper>();
 
-  return *this;
+    return *this;
 }
 
 wxString& wxString::MakeLower()
 {
-  for ( iterator it = begin(), en = end(); it != en; ++it )
-    *it = (wxChar)wxTolower(*it);
+    DoChangeCase<AsciiToLower>();
+
+    return *this;
+}
+
+template <typename Converter>
+void wxString::DoChangeCase()
+{
+    // Note that changing the case of ASCII characters doesn't change the
+    // length of the string, even in UTF-8, so it can be done in place.
+    wxStringCharType* const p = &m_impl[0];
+    const size_t len = m_impl.length();
+
+    size_t n = ChangeAsciiCase<Converter>(p, len);
+    if ( n == len )
+        return;
+
+#if wxUSE_UNICODE_UTF8
+    // Non-ASCII characters may have different length in UTF-8 after changing
+    // their case, so use the slow but general code for the rest.
+    for ( iterator it = iterator(this, m_impl.begin() + n), en = end();
+          it != en;
+          ++it )
+    {
+        *it = static_cast<wxChar>(Converter::NonAscii(wxUniChar(*it).GetValue()));
+    }
+#else // !wxUSE_UNICODE_UTF8
+    for ( ;; )
+    {
+        p[n] = static_cast<wxStringCharType>(Converter::NonAscii(GetUnit(p[n])));
+        if ( ++n == len )
+            break;
 
-  return *this;
+        n += ChangeAsciiCase<Converter>(p + n, len - n);
+        if ( n == len )
+            break;
+    }
+#endif // wxUSE_UNICODE_UTF8/!wxUSE_UNICODE_UTF8
 }
 
 wxString& wxString::MakeCapitalized()
@@ -1560,6 +1864,101 @@ bool wxString::ToULongLong(wxULongLong_t *pVal, int base) const
     return ToNumeric(pVal, wxStrtoull, wx_str(), base);
 }
 
+// ----------------------------------------------------------------------------
+// wxStringView
+// ----------------------------------------------------------------------------
+
+size_t wxStringView::find(const wxStringView& sub, size_t pos) const
+{
+    if ( pos > m_len )
+        return npos;
+
+    const size_t lenSub = sub.m_len;
+    if ( !lenSub )
+        return pos;
+
+    const wxStringCharType first = sub.m_data[0];
+    for ( ; lenSub <= m_len - pos; pos++ )
+    {
+        pos = find(first, pos);
+        if ( pos == npos || lenSub > m_len - pos )
+            break;
+
+        if ( Traits::compare(m_data + pos + 1, sub.m_data + 1, lenSub - 1) == 0 )
+            return pos;
+    }
+
+    return npos;
+}
+
+bool wxStringView::DoIsSameAsNoCase(const wxStringView& other) const
+{
+#if !wxUSE_UNICODE_UTF8
+    // In UTF-8 build the lengths of the strings differing only in case may be
+    // different, but otherwise we can use this shortcut.
+    if ( m_len != other.m_len )
+        return false;
+#endif // !wxUSE_UNICODE_UTF8
+
+    return DoCmpNoCase(m_data, m_len, other.m_data, other.m_len) == 0;
+}
+
+namespace
+{
+
+// Call the given function with the NUL-terminated copy of the view contents,
+// which is stored on the stack for the short strings, as is typically the
+// case for numbers.
+template <typename F>
+bool CallWithNulTerminated(const wxStringView& view, F func)
+{
+    wxStringCharType buf[64];
+    if ( view.length() < WXSIZEOF(buf) )
+    {
+        std::char_traits<wxStringCharType>::copy(buf, view.data(), view.length());
+        buf[view.length()] = 0;
+
+        return func(buf);
+    }
+
+    const wxString str(view);
+    return func(str.wx_str());
+}
+
+} // anonymous namespace
+
+bool wxStringView::ToLong(long *pVal, int base) const
+{
+    return CallWithNulTerminated(*this, [=](const wxStringCharType* s)
+        {
+            return ToNumeric(pVal, wxStrtol, s, base);
+        });
+}
+
+bool wxStringView::ToULong(unsigned long *pVal, int base) const
+{
+    return CallWithNulTerminated(*this, [=](const wxStringCharType* s)
+        {
+            return ToNumeric(pVal, wxStrtoul, s, base);
+        });
+}
+
+bool wxStringView::ToDouble(double *pVal) const
+{
+    return CallWithNulTerminated(*this, [=](const wxStringCharType* s)
+        {
+            return ToNumeric<double>
+                   (
+                    pVal,
+                    [](const wxStringCharType* start, wxStringCharType** endptr, int)
+                    {
+                        return wxStrtod(start, endptr);
+                    },
+                    s
+                   );
+        });
+}
+
 bool wxString::ToDouble(double *pVal) const
 {
     // Use a hack to allow calling wxStrtod() with an unused "base" parameter
@@ -1907,34 +2306,59 @@ wxString wxString::FormatV(const wxString& format, va_list argptr)
     return s;
 }
 
-#if !wxUSE_UTF8_LOCALE_ONLY
-int wxString::DoPrintfWchar(const wxChar *format, ...)
+namespace
 {
-    va_list argptr;
-    va_start(argptr, format);
 
-    int iLen = PrintfV(format, argptr);
+// Call the appropriate vsnprintf() function for the given buffer and format.
+inline int
+DoVsnprintf(wchar_t* buf, size_t size, const wxString& format, va_list argptr)
+{
+    return wxVsnprintf(buf, size, format, argptr);
+}
 
-    va_end(argptr);
+inline int
+DoVsnprintf(char* buf, size_t size, const wxString& format, va_list argptr)
+{
+    return wxVsnprintf(buf, size, format, argptr);
+}
 
-    return iLen;
+#if wxUSE_UNICODE_WCHAR
+inline int
+DoVsnprintf(wchar_t* buf, size_t size, const wchar_t* format, va_list argptr)
+{
+    return wxCRT_VsnprintfW(buf, size, format, argptr);
 }
-#endif // !wxUSE_UTF8_LOCALE_ONLY
+#endif // wxUSE_UNICODE_WCHAR
 
 #if wxUSE_UNICODE_UTF8
-int wxString::DoPrintfUtf8(const char *format, ...)
+inline int
+DoVsnprintf(char* buf, size_t size, const char* format, va_list argptr)
 {
-    va_list argptr;
-    va_start(argptr, format);
+    return wxCRT_VsnprintfA(buf, size, format, argptr);
+}
+#endif // wxUSE_UNICODE_UTF8
 
-    int iLen = PrintfV(wxString::FromUTF8(format), argptr);
+// Store the formatted string in the output string.
+inline void AssignFormatted(wxString& str, const wchar_t* buf, size_t len)
+{
+    str.assign(buf, len);
+}
 
-    va_end(argptr);
+#if wxUSE_UNICODE_UTF8
+inline void AssignFormatted(wxString& str, const char* buf, size_t len)
+{
+    // vsnprintf() may put invalid UTF-8 in the buffer, e.g. when using "%c"
+    // with a non-ASCII character, so check for it, which is done by
+    // FromUTF8(). Notice that the buffer is always NUL-terminated at "len"
+    // here, so use the overload without the length, which is faster.
+    wxASSERT( buf[len] == '\0' );
 
-    return iLen;
+    str = wxString::FromUTF8(buf);
 }
 #endif // wxUSE_UNICODE_UTF8
 
+} // anonymous namespace
+
 /*
     Uses wxVsnprintf and places the result into the this string.
 
@@ -1968,35 +2392,22 @@ int wxString::DoPrintfUtf8(const char *format, ...)
     later result in out of memory error and crashing, so we also have to impose
     some arbitrary limit on it.
 */
-#if wxUSE_UNICODE_UTF8
-template<typename BufferType>
-#else
-// we only need one version in non-UTF8 builds and at least two Windows
-// compilers have problems with this function template, so use just one
-// normal function here
-#endif
+template <typename CharType, typename FormatType>
 static int DoStringPrintfV(wxString& str,
-                           const wxString& format, va_list argptr)
+                           const FormatType& format, va_list argptr)
 {
-    size_t size = 1024;
     PreserveErrno preserveErrno;
 
-    for ( ;; )
-    {
-#if wxUSE_UNICODE_UTF8
-        BufferType tmp(str, size + 1);
-        typename BufferType::CharType *buf = tmp;
-#else
-        wxStringBuffer tmp(str, size + 1);
-        wxChar *buf = tmp;
-#endif
+    // Start with a buffer on the stack, which is big enough for most strings,
+    // to avoid allocating any memory other than for the string itself.
+    CharType bufStack[512];
+    CharType* buf = bufStack;
+    size_t size = WXSIZEOF(bufStack);
 
-        if ( !buf )
-        {
-            // out of memory
-            return -1;
-        }
+    std::unique_ptr<CharType[]> bufHeap;
 
+    for ( ;; )
+    {
         // wxVsnprintf() may modify the original arg pointer, so pass it
         // only a copy
         va_list argptrcopy;
@@ -2004,27 +2415,13 @@ static int DoStringPrintfV(wxString& str,
 
         // Set errno to 0 to make it determinate if wxVsnprintf fails to set it.
         errno = 0;
-        int len = wxVsnprintf(buf, size, format, argptrcopy);
+        int len = DoVsnprintf(buf, size, format, argptrcopy);
         va_end(argptrcopy);
 
-        // some implementations of vsnprintf() don't NUL terminate
-        // the string if there is not enough space for it so
-        // always do it manually
-        // FIXME: This really seems to be the wrong and would be an off-by-one
-        // bug except the code above allocates an extra character.
-        buf[size] = wxT('\0');
-
         // Handle all possible results that we can get depending on the build
         // options.
         if ( len < 0 )
         {
-            // When vswprintf() returns an error, it can leave invalid bytes in
-            // the buffer, e.g. using "%c" with an invalid character results in
-            // U+FFFFFFFF in the buffer, which would trigger an assert when we
-            // try to copy it back to wxString as UTF-8 in "tmp" buffer dtor,
-            // so ensure we don't try to do it.
-            buf[0] = L'\0';
-
             // assume it only returns error if there is not enough space, but
             // as we don't know how much we need, double the current size of
             // the buffer
@@ -2032,6 +2429,7 @@ static int DoStringPrintfV(wxString& str,
             {
                 // If errno was set to one of the two well-known hard errors
                 // then fail immediately to avoid an infinite loop.
+                str.clear();
                 return -1;
             }
 
@@ -2047,7 +2445,10 @@ static int DoStringPrintfV(wxString& str,
             static const size_t MAX_BUFFER_SIZE = 128*1024*1024;
 
             if ( size >= MAX_BUFFER_SIZE )
+            {
+                str.clear();
                 return -1;
+            }
 
             // Note that doubling the size here will never overflow for size
             // less than the limit.
@@ -2061,12 +2462,14 @@ static int DoStringPrintfV(wxString& str,
         }
         else // ok, there was enough space
         {
+            // Note that we stop at the first NUL, if any, for compatibility.
+            AssignFormatted(str, buf, wxStrnlen(buf, len));
             break;
         }
-    }
 
-    // we could have overshot
-    str.Shrink();
+        bufHeap.reset(new CharType[size]);
+        buf = bufHeap.get();
+    }
 
     return str.length();
 }
@@ -2074,20 +2477,55 @@ static int DoStringPrintfV(wxString& str,
 int wxString::PrintfV(const wxString& format, va_list argptr)
 {
 #if wxUSE_UTF8_LOCALE_ONLY
-    return DoStringPrintfV<wxUTF8StringBuffer>(*this, format, argptr);
+    return DoStringPrintfV<char>(*this, format, argptr);
 #else
     #if wxUSE_UNICODE_UTF8
     if ( wxLocaleIsUtf8 )
-        return DoStringPrintfV<wxUTF8StringBuffer>(*this, format, argptr);
+        return DoStringPrintfV<char>(*this, format, argptr);
     else
         // wxChar* version
-        return DoStringPrintfV<wxStringBuffer>(*this, format, argptr);
+        return DoStringPrintfV<wchar_t>(*this, format, argptr);
     #else
-        return DoStringPrintfV(*this, format, argptr);
+        return DoStringPrintfV<wchar_t>(*this, format, argptr);
     #endif // UTF8/WCHAR
 #endif
 }
 
+#if !wxUSE_UTF8_LOCALE_ONLY
+int wxString::DoPrintfWchar(const wxChar *format, ...)
+{
+    va_list argptr;
+    va_start(argptr, format);
+
+#if wxUSE_UNICODE_WCHAR
+    // Avoid creating a temporary wxString for the format, it's not needed.
+    int iLen = DoStringPrintfV<wchar_t>(*this, format, argptr);
+#else
+    int iLen = PrintfV(format, argptr);
+#endif
+
+    va_end(argptr);
+
+    return iLen;
+}
+#endif // !wxUSE_UTF8_LOCALE_ONLY
+
+#if wxUSE_UNICODE_UTF8
+int wxString::DoPrintfUtf8(const char *format, ...)
+{
+    va_list argptr;
+    va_start(argptr, format);
+
+    // This function is only used under UTF-8 locales, so we can use the
+    // narrow vsnprintf() with the format string directly.
+    int iLen = DoStringPrintfV<char>(*this, format, argptr);
+
+    va_end(argptr);
+
+    return iLen;
+}
+#endif // wxUSE_UNICODE_UTF8
+
 // ----------------------------------------------------------------------------
 // misc other operations
 // ----------------------------------------------------------------------------
@@ -556,6 +556,62 @@ const wxScopedWCharBuffer wxScanfConvertFormatW(const wchar_t *format)
 // wxFormatString
 // ----------------------------------------------------------------------------
 
+// Information about the format string which is expensive to compute and so is
+// cached by wxFormatString::GetInfo() for the recently used format strings.
+struct wxFormatStringInfo
+{
+    // The pointer to the format string and a copy of its contents, used to
+    // check that the cached information corresponds to the string: notice
+    // that it's not enough to compare just the pointers as the same buffer
+    // can be reused for different strings.
+    const void* ptr = nullptr;
+    std::string contents;
+    bool wide = false;
+
+    // True if the format string contains only ASCII characters, so that its
+    // conversion to another character type doesn't depend on the locale.
+    bool ascii = false;
+
+    // Types of all the arguments, as ArgumentType values, or -1 for the
+    // arguments without any format specifiers.
+    std::vector<int> argTypes;
+
+    // The cached results of AsChar() and AsWChar(), if they were called.
+#if !wxUSE_UNICODE_WCHAR
+    wxScopedCharBuffer convertedChar;
+#endif
+#if !wxUSE_UTF8_LOCALE_ONLY
+    wxScopedWCharBuffer convertedWChar;
+#endif
+
+    // Return true if the format string converted to the given character type
+    // can be cached.
+    bool CanCacheConversion(bool toWide) const
+    {
+        return ascii || toWide == wide;
+    }
+};
+
+namespace
+{
+
+// Store the converted format string in the cache, making a copy of it if it
+// refers to the input format string as the input may not exist any longer
+// when the cached value is used.
+template <typename CharType>
+void
+CacheConvertedFormat(wxScopedCharTypeBuffer<CharType>& cache,
+                     const wxScopedCharTypeBuffer<CharType>& converted,
+                     const CharType* input)
+{
+    if ( converted.data() == input )
+        cache = wxCharTypeBuffer<CharType>(input);
+    else
+        cache = converted;
+}
+
+} // anonymous namespace
+
 #if !wxUSE_UNICODE_WCHAR
 const char* wxFormatString::InputAsChar()
 {
@@ -572,10 +628,12 @@ const char* wxFormatString::InputAsChar()
         return m_cstr->AsInternal();
 
     // the last case is that wide string was passed in: in that case, we need
-    // to convert it:
+    // to convert it, and for the same reason as above it must be converted
+    // to UTF-8 and not using wxConvLibc, which could fail for the non-ASCII
+    // strings if the C locale wasn't set up
     wxASSERT( m_wchar );
 
-    m_char = wxConvLibc.cWC2MB(m_wchar.data());
+    m_char = wxConvUTF8.cWC2MB(m_wchar.data());
 
     return m_char.data();
 }
@@ -583,7 +641,25 @@ const char* wxFormatString::InputAsChar()
 const char* wxFormatString::AsChar()
 {
     if ( !m_convertedChar )
-        m_convertedChar = wxPrintfFormatConverterUtf8().Convert(InputAsChar());
+    {
+        const wxFormatStringInfo& info = GetInfo();
+        if ( info.convertedChar )
+        {
+            m_convertedChar = info.convertedChar;
+        }
+        else
+        {
+            const char* const input = InputAsChar();
+            m_convertedChar = wxPrintfFormatConverterUtf8().Convert(input);
+
+            // Don't reuse the info reference as the conversion could have
+            // used wxString::Format() itself, e.g. when asserting, and so
+            // replaced the cache entry by the one for another format string.
+            wxFormatStringInfo& infoNew = GetInfo();
+            if ( infoNew.CanCacheConversion(false /* to char */) )
+                CacheConvertedFormat(infoNew.convertedChar, m_convertedChar, input);
+        }
+    }
 
     return m_convertedChar.data();
 }
@@ -625,7 +701,25 @@ const wchar_t* wxFormatString::InputAsWChar()
 const wchar_t* wxFormatString::AsWChar()
 {
     if ( !m_convertedWChar )
-        m_convertedWChar = wxPrintfFormatConverterWchar().Convert(InputAsWChar());
+    {
+        const wxFormatStringInfo& info = GetInfo();
+        if ( info.convertedWChar )
+        {
+            m_convertedWChar = info.convertedWChar;
+        }
+        else
+        {
+            const wchar_t* const input = InputAsWChar();
+            m_convertedWChar = wxPrintfFormatConverterWchar().Convert(input);
+
+            // Don't reuse the info reference as the conversion could have
+            // used wxString::Format() itself, e.g. when asserting, and so
+            // replaced the cache entry by the one for another format string.
+            wxFormatStringInfo& infoNew = GetInfo();
+            if ( infoNew.CanCacheConversion(true /* to wchar_t */) )
+                CacheConvertedFormat(infoNew.convertedWChar, m_convertedWChar, input);
+        }
+    }
 
     return m_convertedWChar.data();
 }
@@ -705,31 +799,106 @@ wxFormatString::ArgumentType ArgTypeFromParamType(wxPrintfArgType type)
     return wxFormatString::Arg_Unknown;
 }
 
+// Parse the format string and return the types of all its arguments, as
+// stored in wxFormatStringInfo::argTypes.
+template<typename CharType>
+std::vector<int> ParseArgumentTypes(const CharType *format)
+{
+    wxPrintfConvSpecParser<CharType> parser(format);
+
+    std::vector<int> argTypes(parser.nargs);
+    for ( unsigned n = 0; n < parser.nargs; ++n )
+    {
+        auto const pspec = parser.pspec[n];
+        argTypes[n] = pspec ? ArgTypeFromParamType(pspec->m_type) : -1;
+    }
+
+    return argTypes;
+}
+
+// The number of recently used format strings for which we keep the
+// information: it doesn't need to be big as the same format is typically
+// used many times in a row, e.g. in a loop.
+const unsigned FORMAT_CACHE_SIZE = 32;
+
+// The cache is per-thread to avoid locking and is a trivial object to avoid
+// any overhead when accessing it, see also FormatCacheDeleter below.
+thread_local wxFormatStringInfo* gs_formatCache[FORMAT_CACHE_SIZE];
+
+// This object frees the memory used by the cache elements when the thread
+// exits, it has to be separate from the cache as it has a non-trivial dtor.
+struct FormatCacheDeleter
+{
+    ~FormatCacheDeleter()
+    {
+        for ( auto& info : gs_formatCache )
+        {
+            delete info;
+            info = nullptr;
+        }
+    }
+};
+
 template<typename CharType>
-wxFormatString::ArgumentType DoGetArgumentType(const CharType *format,
-                                               unsigned n)
+wxFormatStringInfo& GetFormatStringInfo(const CharType* format)
 {
-    wxCHECK_MSG( format, wxFormatString::Arg_Unknown,
+    static const CharType s_empty[] = { 0 };
+    wxCHECK_MSG( format, GetFormatStringInfo(s_empty),
                  "empty format string not allowed here" );
 
-    wxPrintfConvSpecParser<CharType> parser(format);
+    const bool wide = sizeof(CharType) != sizeof(char);
+    const size_t size = wxStrlen(format)*sizeof(CharType);
 
-    if ( n > parser.nargs )
+    // Note that the cache slot is determined only by the pointer value, so
+    // using different strings at the same address evicts the old entry.
+    wxFormatStringInfo*& info =
+        gs_formatCache[(wxPtrToUInt(format) >> 3) % FORMAT_CACHE_SIZE];
+
+    if ( info &&
+            info->ptr == format &&
+                info->wide == wide &&
+                    info->contents.size() == size &&
+                        memcmp(info->contents.data(), format, size) == 0 )
     {
-        // The n-th argument doesn't appear in the format string and is unused.
-        // This can happen e.g. if a translation of the format string is used
-        // and the translation language tends to avoid numbers in singular forms.
-        // The translator would then typically replace "%d" with "One" (e.g. in
-        // Hebrew). Passing too many vararg arguments does not harm, so its
-        // better to be more permissive here and allow legitimate uses in favour
-        // of catching harmless errors.
-        return wxFormatString::Arg_Unused;
+        return *info;
     }
 
-    wxCHECK_MSG( parser.pspec[n-1] != nullptr, wxFormatString::Arg_Unknown,
-                 "requested argument not found - invalid format string?" );
+    // Parse the format before modifying the cache because the parser could
+    // use wxString::Format() itself (when asserting) and so modify it too.
+    std::vector<int> argTypes = ParseArgumentTypes(format);
+
+    if ( !info )
+    {
+        static thread_local FormatCacheDeleter s_cacheDeleter;
+        wxUnusedVar(s_cacheDeleter);
+
+        info = new wxFormatStringInfo;
+    }
+
+    info->ptr = format;
+    info->contents.assign(reinterpret_cast<const char*>(format), size);
+    info->wide = wide;
+
+    info->ascii = true;
+    for ( const CharType* p = format; *p; ++p )
+    {
+        if ( static_cast<wxUint32>(*p) >= 0x80 )
+        {
+            info->ascii = false;
+            break;
+        }
+    }
+
+    info->argTypes = std::move(argTypes);
+
+#if !wxUSE_UNICODE_WCHAR
+    info->convertedChar.reset();
+#endif
+#if !wxUSE_UTF8_LOCALE_ONLY
+    info->convertedWChar.reset();
+#endif
 
-    return ArgTypeFromParamType(parser.pspec[n-1]->m_type);
+    return *info;
 }
 
 #if wxDEBUG_LEVEL
@@ -739,7 +908,7 @@ void DoValidateFormat(const CharType* format, const std::vector<int>& argTypes)
 {
     wxPrintfConvSpecParser<CharType> parser(format);
 
-    // For the reasons mentioned in the comment in DoGetArgumentType() above,
+    // For the reasons mentioned in the comment in GetArgumentType() below,
     // we ignore any extraneous argument types, so we only check that the
     // format format specifiers we actually have match the types.
     for ( unsigned n = 0; n < parser.nargs; ++n )
@@ -792,23 +961,72 @@ void DoValidateFormat(const CharType* format, const std::vector<int>& argTypes)
 
 } // anonymous namespace
 
-wxFormatString::ArgumentType wxFormatString::GetArgumentType(unsigned n) const
+wxFormatStringInfo& wxFormatString::GetInfo() const
 {
     if ( m_char )
-        return DoGetArgumentType(m_char.data(), n);
+        return GetFormatStringInfo(m_char.data());
     else if ( m_wchar )
-        return DoGetArgumentType(m_wchar.data(), n);
+        return GetFormatStringInfo(m_wchar.data());
     else if ( m_str )
-        return DoGetArgumentType(m_str->wx_str(), n);
-    else if ( m_cstr )
-        return DoGetArgumentType(m_cstr->AsInternal(), n);
+        return GetFormatStringInfo(m_str->wx_str());
+
+    wxASSERT_MSG( m_cstr, "invalid wxFormatString - not initialized?" );
+
+    return GetFormatStringInfo(m_cstr->AsInternal());
+}
 
-    wxFAIL_MSG( "unreachable code" );
-    return Arg_Unknown;
+wxFormatString::ArgumentType wxFormatString::GetArgumentType(unsigned n) const
+{
+    const std::vector<int>& argTypes = GetInfo().argTypes;
+
+    if ( n > argTypes.size() )
+    {
+        // The n-th argument doesn't appear in the format string and is unused.
+        // This can happen e.g. if a translation of the format string is used
+        // and the translation language tends to avoid numbers in singular forms.
+        // The translator would then typically replace "%d" with "One" (e.g. in
+        // Hebrew). Passing too many vararg arguments does not harm, so its
+        // better to be more permissive here and allow legitimate uses in favour
+        // of catching harmless errors.
+        return Arg_Unused;
+    }
+
+    const int argType = argTypes[n - 1];
+    wxCHECK_MSG( argType != -1, Arg_Unknown,
+                 "requested argument not found - invalid format string?" );
+
+    return static_cast<ArgumentType>(argType);
 }
 
 #if wxDEBUG_LEVEL
 
+void wxFormatString::Validate(std::initializer_list<int> argTypes) const
+{
+    // Check if the format specifiers match the arguments using the cached
+    // information, which is fast, and only parse the format string again to
+    // give the detailed error message if they don't.
+    const std::vector<int>& formatTypes = GetInfo().argTypes;
+    if ( formatTypes.size() <= argTypes.size() )
+    {
+        bool ok = true;
+
+        const int* arg = argTypes.begin();
+        for ( const int type : formatTypes )
+        {
+            if ( type == -1 || (type & *arg++) != type )
+            {
+                ok = false;
+                break;
+            }
+        }
+
+        if ( ok )
+            return;
+    }
+
+    Validate(std::vector<int>(argTypes));
+}
+
 void wxFormatString::Validate(const std::vector<int>& argTypes) const
 {
     if ( m_char )
@@ -89,55 +89,33 @@ bool wxTextFile::OnRead(const wxMBConv& conv)
     // file should be opened
     wxASSERT_MSG( m_file.IsOpened(), wxT("can't read closed file") );
 
-    wxString str;
-    if ( !m_file.ReadAll(&str, conv) )
-    {
-        wxLogError(_("Failed to read text file \"%s\"."), GetName());
-        return false;
-    }
+    wxTextFileReader reader(m_file, conv);
 
-    // now break the buffer in lines
-
-    // the beginning of the current line, changes inside the loop
-    wxString::const_iterator lineStart = str.begin();
-    const wxString::const_iterator end = str.end();
-    for ( wxString::const_iterator p = lineStart; p != end; ++p )
+    wxStringView line;
+    wxTextFileType lineType;
+    while ( reader.GetNextLine(&line, &lineType) )
     {
-        const wxChar ch = *p;
-        if ( ch == '\r' || ch == '\n' )
+        if ( reader.EncodingChanged() )
         {
-            // Determine the kind of line ending this is.
-            wxTextFileType lineType = wxTextFileType_None;
-            if ( ch == '\r' )
-            {
-                wxString::const_iterator next = p + 1;
-                if ( next != end && *next == '\n' )
-                    lineType = wxTextFileType_Dos;
-                else
-                    lineType = wxTextFileType_Mac;
-            }
-            else // ch == '\n'
-            {
-                lineType = wxTextFileType_Unix;
-            }
-
-            AddLine(wxString(lineStart, p), lineType);
+            // The file without BOM turned out not to be in UTF-8 only after
+            // we had already decoded some non-ASCII lines as UTF-8, so read
+            // it again using the fallback encoding for all of it, as would be
+            // the case if it were decoded at once.
+            Clear();
 
-            // DOS EOL is the only one consisting of two chars, not one.
-            if ( lineType == wxTextFileType_Dos )
-                ++p;
+            if ( !reader.Rewind() )
+                break;
 
-            lineStart = p + 1;
+            continue;
         }
+
+        AddLine(line.ToString(), lineType);
     }
 
-    // anything in the last line?
-    if ( lineStart != end )
+    if ( reader.Error() )
     {
-        // Add the last line; notice that it is certainly not terminated with a
-        // newline, otherwise it would be handled above.
-        wxString lastLine(lineStart, end);
-        AddLine(lastLine, wxTextFileType_None);
+        wxLogError(_("Failed to read text file \"%s\"."), GetName());
+        return false;
     }
 
     return true;
@@ -187,4 +165,284 @@ bool wxTextFile::OnWrite(wxTextFileType typeNew, const wxMBConv& conv)
     return fileTmp.Commit();
 }
 
+// ============================================================================
+// wxTextFileReader class implementation
+// ============================================================================
+
+wxTextFileReader::wxTextFileReader(wxFile& file, const wxMBConv& conv)
+    : m_file(file),
+      m_conv(conv.Clone()),
+      m_start(file.Tell())
+{
+    m_unitLen = 0;
+
+    m_started =
+    m_eof =
+    m_error =
+    m_nonASCII =
+    m_encodingChanged = false;
+}
+
+wxTextFileReader::~wxTextFileReader()
+{
+    delete m_conv;
+}
+
+bool wxTextFileReader::Rewind()
+{
+    if ( m_start == wxInvalidOffset || m_file.Seek(m_start) == wxInvalidOffset )
+    {
+        m_error = true;
+        return false;
+    }
+
+    m_raw.SetDataLen(0);
+    m_text.clear();
+    m_rest = wxStringView();
+
+    m_started =
+    m_eof =
+    m_error =
+    m_nonASCII =
+    m_encodingChanged = false;
+
+    return true;
+}
+
+bool wxTextFileReader::InitEOL()
+{
+    size_t unitLen = m_conv->GetMBNulLen();
+    if ( unitLen == wxCONV_FAILED )
+    {
+        // The conversion may need to see the input before knowing which
+        // encoding it uses, as is the case for wxConvAuto, so let it examine
+        // the first few bytes of it. Notice that we don't give it more than
+        // strictly necessary to avoid passing it an incomplete character,
+        // which could result in it wrongly deciding that the input is not in
+        // UTF-8.
+        const char* const data = static_cast<const char*>(m_raw.GetData());
+        const size_t len = m_raw.GetDataLen();
+        for ( size_t n = 1; n <= len && n <= 4; n++ )
+        {
+            m_conv->ToWChar(nullptr, 0, data, n);
+
+            unitLen = m_conv->GetMBNulLen();
+            if ( unitLen != wxCONV_FAILED )
+                break;
+        }
+
+        if ( unitLen == wxCONV_FAILED )
+            return false;
+    }
+
+    if ( unitLen > WXSIZEOF(m_lf) ||
+            m_conv->FromWChar(m_cr, unitLen, L"\r", 1) != unitLen ||
+                m_conv->FromWChar(m_lf, unitLen, L"\n", 1) != unitLen )
+    {
+        // We can't find the line terminators in the raw data in this weird
+        // encoding, so just decode it all at once.
+        unitLen = wxNO_LEN;
+    }
+
+    m_unitLen = unitLen;
+
+    return true;
+}
+
+size_t
+wxTextFileReader::FindLastEOL(const char* data, size_t len, size_t from) const
+{
+    if ( m_unitLen == wxNO_LEN )
+        return 0;
+
+    // Start from the last complete code unit which was already present
+    // before, as it could be CR we didn't use the last time.
+    from /= m_unitLen;
+    from = from ? (from - 1)*m_unitLen : 0;
+
+    for ( size_t n = len - len % m_unitLen; n > from; )
+    {
+        n -= m_unitLen;
+
+        if ( memcmp(data + n, m_lf, m_unitLen) == 0 )
+            return n + m_unitLen;
+
+        // Don't break CR LF pair: if CR is the last character we have, we
+        // need to read more data to know if it's followed by LF.
+        if ( memcmp(data + n, m_cr, m_unitLen) == 0 &&
+                n + 2*m_unitLen <= len )
+            return n + m_unitLen;
+    }
+
+    return 0;
+}
+
+bool wxTextFileReader::ReadMore()
+{
+    static const size_t CHUNK_SIZE = 65536;
+
+    m_text.clear();
+    m_rest = wxStringView();
+
+    for ( ;; )
+    {
+        if ( m_eof || m_error )
+            return false;
+
+        const size_t lenOld = m_raw.GetDataLen();
+        char* const data = static_cast<char*>(m_raw.GetWriteBuf(lenOld + CHUNK_SIZE));
+
+        const ssize_t nRead = m_file.Read(data + lenOld, CHUNK_SIZE);
+        if ( nRead == wxInvalidOffset )
+        {
+            m_raw.UngetWriteBuf(lenOld);
+            m_error = true;
+            return false;
+        }
+
+        const size_t len = lenOld + nRead;
+        m_raw.UngetWriteBuf(len);
+
+        if ( !nRead )
+            m_eof = true;
+
+        size_t lenLines;
+        if ( m_eof )
+        {
+            // Decode everything remaining, whether it ends with EOL or not.
+            lenLines = len;
+        }
+        else
+        {
+            if ( !m_unitLen && !InitEOL() )
+                continue;
+
+            lenLines = FindLastEOL(data, len, lenOld);
+        }
+
+        if ( !lenLines )
+            continue;
+
+        // wxConvAuto decodes the input without BOM as UTF-8, but switches to
+        // its fallback encoding as soon as it finds invalid UTF-8 in it. As we
+        // decode the file in chunks, this could happen in the middle of it,
+        // so remember if we had already returned anything which would have
+        // been decoded differently if the switch had happened at the start.
+        wxConvAuto* const convAuto = dynamic_cast<wxConvAuto*>(m_conv);
+        const bool guessingUTF8 = convAuto && convAuto->IsUTF8() &&
+                                    convAuto->GetBOM() == wxBOM_None;
+
+        // At the end of the file, wxConvAuto must switch to the fallback
+        // encoding even if the invalid UTF-8 looks like the beginning of a
+        // valid sequence, as there won't be any more data to complete it, so
+        // give it a byte which can't be part of any UTF-8 sequence.
+        if ( m_eof && guessingUTF8 &&
+                wxConvUTF8.ToWChar(nullptr, 0, data, lenLines) == wxCONV_FAILED )
+            convAuto->ToWChar(nullptr, 0, "\x80", 1);
+
+        if ( m_started )
+        {
+            m_text = wxString(data, *m_conv, lenLines);
+        }
+        else
+        {
+            // Make sure the conversion is really used for the beginning of
+            // the file, as the BOM, if any, must be skipped there, while
+            // wxString ctor doesn't call it at all in UTF-8 build if the
+            // input is UTF-8.
+            size_t lenText = 0;
+            const wxWCharBuffer wbuf = m_conv->cMB2WC(data, lenLines, &lenText);
+            if ( lenText )
+                m_text.assign(wbuf.data(), lenText);
+
+            m_started = true;
+        }
+        if ( m_text.empty() )
+        {
+            // Decoding non-empty input may only yield empty string if it
+            // failed, unless the input consisted of just the BOM which is
+            // skipped by wxConvAuto.
+            size_t lenBOM = 0;
+            const wxBOM bom = wxConvAuto::DetectBOM(data, lenLines);
+            if ( bom != wxBOM_None && bom != wxBOM_Unknown )
+                wxConvAuto::GetBOMChars(bom, &lenBOM);
+            if ( lenBOM != lenLines )
+                m_error = true;
+
+            return false;
+        }
+
+        if ( guessingUTF8 && !m_conv->IsUTF8() )
+        {
+            if ( m_nonASCII )
+                m_encodingChanged = true;
+        }
+        else if ( !m_nonASCII && m_conv->IsUTF8() &&
+                    convAuto && convAuto->GetBOM() == wxBOM_None )
+        {
+            for ( size_t n = 0; n < lenLines; n++ )
+            {
+                if ( static_cast<unsigned char>(data[n]) >= 0x80 )
+                {
+                    m_nonASCII = true;
+                    break;
+                }
+            }
+        }
+
+        memmove(data, data + lenLines, len - lenLines);
+        m_raw.SetDataLen(len - lenLines);
+
+        m_rest = wxStringView(m_text);
+
+        return true;
+    }
+}
+
+bool wxTextFileReader::GetNextLine(wxStringView* line, wxTextFileType* type)
+{
+    wxCHECK_MSG( line, false, wxS("Output line must be non-null") );
+
+    if ( m_rest.empty() && !ReadMore() )
+        return false;
+
+    const wxStringCharType* const start = m_rest.begin();
+    const wxStringCharType* const end = m_rest.end();
+
+    const wxStringCharType* p = start;
+    while ( p != end && *p != wxS('\n') && *p != wxS('\r') )
+        p++;
+
+    // ReadMore() only returns complete lines unless we reached the end of
+    // file, so we don't need to check for it here.
+    wxTextFileType lineType;
+    size_t lenEOL = 1;
+    if ( p == end )
+    {
+        lineType = wxTextFileType_None;
+        lenEOL = 0;
+    }
+    else if ( *p == wxS('\n') )
+    {
+        lineType = wxTextFileType_Unix;
+    }
+    else if ( p + 1 != end && p[1] == wxS('\n') )
+    {
+        lineType = wxTextFileType_Dos;
+        lenEOL = 2;
+    }
+    else
+    {
+        lineType = wxTextFileType_Mac;
+    }
+
+    *line = wxStringView(start, p - start);
+    if ( type )
+        *type = lineType;
+
+    m_rest.remove_prefix(p - start + lenEOL);
+
+    return true;
+}
+
 #endif // wxUSE_TEXTFILE
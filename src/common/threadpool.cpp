@@ -0,0 +1,624 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/threadpool.cpp
+// Purpose:     wxThreadPool and wxTaskGroup implementation
+// Author:      wxWidgets team
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+#if wxUSE_THREADS
+
+#include "wx/threadpool.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/intl.h"
+    #include "wx/log.h"
+    #include "wx/module.h"
+#endif // WX_PRECOMP
+
+#include "wx/thread.h"
+#include "wx/except.h"
+
+#include <deque>
+#include <vector>
+
+wxDEFINE_EVENT(wxEVT_TASK_COMPLETED, wxThreadEvent);
+
+// trace mask for the debugging messages used here
+#define wxTRACE_ThreadPool wxT("threadpool")
+
+namespace
+{
+
+typedef std::shared_ptr<wxPrivate::wxTaskBase> wxTaskPtr;
+
+class wxThreadPoolWorker;
+
+// The worker of the pool the current thread belongs to, if any.
+thread_local wxThreadPoolWorker* gs_currentWorker = nullptr;
+
+// ----------------------------------------------------------------------------
+// wxTaskQueue: double-ended queue of tasks protected by a critical section
+// ----------------------------------------------------------------------------
+
+// Each worker thread has its own queue: it adds the tasks it creates to its
+// back and takes them from there too, which is good for locality, while the
+// other threads steal the tasks from its front when they don't have anything
+// to do. As the owner and the thieves work at the opposite ends of the queue
+// and the queue is only accessed by the other threads when they're idle,
+// there is very little contention for its lock.
+class wxTaskQueue
+{
+public:
+    wxTaskQueue() = default;
+
+    void PushBack(wxTaskPtr task)
+    {
+        wxCriticalSectionLocker lock(m_cs);
+        m_tasks.push_back(std::move(task));
+    }
+
+    wxTaskPtr PopBack()
+    {
+        wxCriticalSectionLocker lock(m_cs);
+        if ( m_tasks.empty() )
+            return wxTaskPtr();
+
+        wxTaskPtr task = std::move(m_tasks.back());
+        m_tasks.pop_back();
+        return task;
+    }
+
+    wxTaskPtr PopFront()
+    {
+        wxCriticalSectionLocker lock(m_cs);
+        if ( m_tasks.empty() )
+            return wxTaskPtr();
+
+        wxTaskPtr task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+        return task;
+    }
+
+private:
+    wxCriticalSection m_cs;
+    std::deque<wxTaskPtr> m_tasks;
+
+    wxDECLARE_NO_COPY_CLASS(wxTaskQueue);
+};
+
+// ----------------------------------------------------------------------------
+// wxThreadPoolWorker: one of the threads of the pool
+// ----------------------------------------------------------------------------
+
+class wxThreadPoolWorker : public wxThread
+{
+public:
+    wxThreadPoolWorker(wxThreadPool::Impl& pool, size_t index)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_pool(pool),
+          m_index(index)
+    {
+    }
+
+    wxThreadPool::Impl& GetPool() const { return m_pool; }
+    size_t GetIndex() const { return m_index; }
+
+    wxTaskQueue& GetQueue() { return m_queue; }
+
+protected:
+    virtual ExitCode Entry() override;
+
+private:
+    wxThreadPool::Impl& m_pool;
+    const size_t m_index;
+
+    wxTaskQueue m_queue;
+};
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// wxThreadPool::Impl: the real pool implementation
+// ----------------------------------------------------------------------------
+
+class wxThreadPool::Impl
+{
+public:
+    explicit Impl(wxThreadPool& pool)
+        : m_pool(pool),
+          m_sleepCond(m_sleepMutex),
+          m_waitCond(m_waitMutex)
+    {
+    }
+
+    wxThreadPool& GetPool() const { return m_pool; }
+
+    // Start the given number of workers, return false if none could be.
+    bool Start(int numThreads);
+
+    // Finish executing all tasks and stop all workers.
+    void Stop();
+
+    int GetThreadCount() const { return static_cast<int>(m_workers.size()); }
+
+    // Add a new task and wake up a worker to execute it if necessary.
+    void Enqueue(const wxTaskPtr& task);
+
+    // Get the next task to execute by the given worker, which may be null if
+    // the current thread is not a worker of this pool.
+    wxTaskPtr FindTask(wxThreadPoolWorker* worker);
+
+    // Block the worker thread until a new task is added, return false if the
+    // pool is being shut down and there are no more tasks.
+    bool WaitForTask();
+
+    // Implementation of wxThreadPool::WaitUntil() and NotifyWaiters().
+    void WaitUntil(bool (*done)(const void*), const void* data);
+    void NotifyWaiters();
+
+private:
+    wxThreadPool& m_pool;
+
+    std::vector<wxThreadPoolWorker*> m_workers;
+
+    // Queue of the tasks submitted from the threads not belonging to the
+    // pool, e.g. the main thread. Unlike the per-worker queues, this one is
+    // used in FIFO order.
+    wxTaskQueue m_injected;
+
+    // The number of tasks in all the queues, which is used to avoid locking
+    // m_sleepMutex unless necessary.
+    std::atomic<int> m_numQueued{0};
+
+    // The mutex and condition used by the idle workers, the number of them
+    // and the flag set when the pool is being destroyed.
+    wxMutex m_sleepMutex;
+    wxCondition m_sleepCond;
+    std::atomic<int> m_numSleeping{0};
+    bool m_stopping = false;
+
+    // The mutex and condition used by the threads waiting for the tasks to
+    // finish in WaitUntil(), the number of such threads and the number of the
+    // workers among them, which must also be woken up when a task is added.
+    wxMutex m_waitMutex;
+    wxCondition m_waitCond;
+    std::atomic<int> m_numWaiting{0};
+    std::atomic<int> m_numWaitingWorkers{0};
+
+    // The index of the worker to start stealing the tasks from.
+    std::atomic<unsigned> m_nextVictim{0};
+
+    wxDECLARE_NO_COPY_CLASS(Impl);
+};
+
+bool wxThreadPool::Impl::Start(int numThreads)
+{
+    for ( int n = 0; n < numThreads; n++ )
+    {
+        std::unique_ptr<wxThreadPoolWorker>
+            worker(new wxThreadPoolWorker(*this, m_workers.size()));
+        if ( worker->Run() != wxTHREAD_NO_ERROR )
+        {
+            wxLogDebug("Failed to start a thread pool worker.");
+            break;
+        }
+
+        m_workers.push_back(worker.release());
+    }
+
+    return !m_workers.empty();
+}
+
+void wxThreadPool::Impl::Stop()
+{
+    {
+        wxMutexLocker lock(m_sleepMutex);
+        m_stopping = true;
+        m_sleepCond.Broadcast();
+    }
+
+    for ( wxThreadPoolWorker* worker : m_workers )
+    {
+        worker->Wait();
+        delete worker;
+    }
+
+    m_workers.clear();
+}
+
+void wxThreadPool::Impl::Enqueue(const wxTaskPtr& task)
+{
+    wxThreadPoolWorker* const worker = gs_currentWorker;
+    if ( worker && &worker->GetPool() == this )
+        worker->GetQueue().PushBack(task);
+    else
+        m_injected.PushBack(task);
+
+    // Note that the order of the operations here and in WaitForTask() is
+    // important: as both m_numQueued and m_numSleeping are sequentially
+    // consistent atomics, either the sleeping thread sees that there is a new
+    // task or we see that it is sleeping and wake it up.
+    m_numQueued++;
+
+    if ( m_numSleeping.load() > 0 )
+    {
+        wxMutexLocker lock(m_sleepMutex);
+        m_sleepCond.Signal();
+    }
+
+    // The workers blocked in WaitUntil() can execute the new task too.
+    if ( m_numWaitingWorkers.load() > 0 )
+    {
+        wxMutexLocker lock(m_waitMutex);
+        m_waitCond.Broadcast();
+    }
+}
+
+wxTaskPtr wxThreadPool::Impl::FindTask(wxThreadPoolWorker* worker)
+{
+    if ( m_numQueued.load() <= 0 )
+        return wxTaskPtr();
+
+    wxTaskPtr task;
+    if ( worker )
+        task = worker->GetQueue().PopBack();
+
+    if ( !task )
+        task = m_injected.PopFront();
+
+    if ( !task )
+    {
+        // Try stealing a task from the other workers, starting with a
+        // different one every time to avoid all idle threads trying to steal
+        // from the same victim.
+        const size_t numWorkers = m_workers.size();
+        const size_t first = m_nextVictim++ % numWorkers;
+        for ( size_t n = 0; n < numWorkers && !task; n++ )
+        {
+            wxThreadPoolWorker* const victim = m_workers[(first + n) % numWorkers];
+            if ( victim != worker )
+                task = victim->GetQueue().PopFront();
+        }
+    }
+
+    if ( task )
+        m_numQueued--;
+
+    return task;
+}
+
+bool wxThreadPool::Impl::WaitForTask()
+{
+    wxMutexLocker lock(m_sleepMutex);
+
+    m_numSleeping++;
+    while ( m_numQueued.load() <= 0 && !m_stopping )
+        m_sleepCond.Wait();
+    m_numSleeping--;
+
+    return m_numQueued.load() > 0 || !m_stopping;
+}
+
+void wxThreadPool::Impl::WaitUntil(bool (*done)(const void*), const void* data)
+{
+    wxThreadPoolWorker* const worker = gs_currentWorker;
+    const bool isWorker = worker && &worker->GetPool() == this;
+
+    while ( !done(data) )
+    {
+        // If we're one of the workers, help executing the tasks instead of
+        // just blocking, this is not only more efficient but also prevents
+        // deadlocks when all workers wait for the tasks that are still queued.
+        if ( isWorker )
+        {
+            if ( wxTaskPtr task = FindTask(worker) )
+            {
+                task->Execute();
+                continue;
+            }
+        }
+
+        // Block until some task finishes or, for the workers, a new task is
+        // added. As in Enqueue() the order of updating the counters and
+        // checking the conditions matters here.
+        wxMutexLocker lock(m_waitMutex);
+
+        m_numWaiting++;
+        if ( isWorker )
+            m_numWaitingWorkers++;
+
+        if ( !done(data) && !(isWorker && m_numQueued.load() > 0) )
+            m_waitCond.Wait();
+
+        if ( isWorker )
+            m_numWaitingWorkers--;
+        m_numWaiting--;
+    }
+}
+
+void wxThreadPool::Impl::NotifyWaiters()
+{
+    if ( m_numWaiting.load() > 0 )
+    {
+        wxMutexLocker lock(m_waitMutex);
+        m_waitCond.Broadcast();
+    }
+}
+
+wxThread::ExitCode wxThreadPoolWorker::Entry()
+{
+    gs_currentWorker = this;
+
+    wxLogTrace(wxTRACE_ThreadPool, "Worker %zu started.", m_index);
+
+    for ( ;; )
+    {
+        if ( wxTaskPtr task = m_pool.FindTask(this) )
+        {
+            task->Execute();
+            continue;
+        }
+
+        if ( !m_pool.WaitForTask() )
+            break;
+    }
+
+    wxLogTrace(wxTRACE_ThreadPool, "Worker %zu stopped.", m_index);
+
+    gs_currentWorker = nullptr;
+
+    return 0;
+}
+
+// ============================================================================
+// wxTaskBase implementation
+// ============================================================================
+
+namespace wxPrivate
+{
+
+void wxTaskBase::Execute()
+{
+    int status = wxTASK_PENDING;
+    if ( m_group && m_group->IsCancelled() )
+    {
+        if ( m_status.compare_exchange_strong(status, wxTASK_CANCELLED) )
+            Finish();
+        return;
+    }
+
+    // The task could have been cancelled while it was in the queue.
+    if ( !m_status.compare_exchange_strong(status, wxTASK_RUNNING) )
+        return;
+
+    // Don't let the exception escape, this would terminate the worker thread
+    // and leave the task running forever, but store it to rethrow it later.
+    wxTRY
+    {
+        DoExecute();
+    }
+    wxCATCH_ALL
+    (
+        m_exception = std::current_exception();
+    )
+
+    m_status = wxTASK_DONE;
+    Finish();
+}
+
+void wxTaskBase::RethrowIfFailed()
+{
+#if wxUSE_EXCEPTIONS
+    if ( m_exception )
+        std::rethrow_exception(m_exception);
+#endif // wxUSE_EXCEPTIONS
+}
+
+bool wxTaskBase::Cancel()
+{
+    int status = wxTASK_PENDING;
+    if ( !m_status.compare_exchange_strong(status, wxTASK_CANCELLED) )
+        return status == wxTASK_CANCELLED;
+
+    // Notice that the task remains in the queue, but will be just skipped
+    // when it gets to it.
+    Finish();
+
+    return true;
+}
+
+void wxTaskBase::Finish()
+{
+    // Notice that the group may be destroyed as soon as we update it, so we
+    // must not use it after this.
+    if ( m_group )
+        m_group->OnTaskFinished();
+
+    m_pool.NotifyWaiters();
+
+    if ( m_handler.load() )
+        DoNotify();
+}
+
+void wxTaskBase::NotifyOnCompletion(wxEvtHandler* handler, int id)
+{
+    wxCHECK_RET( handler, "must have a valid handler" );
+
+    m_id = id;
+    m_handler = handler;
+
+    // If the task finished before we set the handler, Finish() might not have
+    // seen it, so check for this. DoNotify() ensures that we don't notify
+    // twice if it did.
+    if ( IsFinished() )
+        DoNotify();
+}
+
+void wxTaskBase::DoNotify()
+{
+    if ( m_notified.exchange(true) )
+        return;
+
+    wxThreadEvent* const event = new wxThreadEvent(wxEVT_TASK_COMPLETED, m_id);
+    event->SetInt(GetStatus());
+
+    m_handler.load()->QueueEvent(event);
+}
+
+static bool IsTaskFinished(const void* data)
+{
+    return static_cast<const wxTaskBase*>(data)->IsFinished();
+}
+
+bool wxTaskBase::Wait()
+{
+    m_pool.WaitUntil(IsTaskFinished, this);
+
+    return GetStatus() == wxTASK_DONE;
+}
+
+} // namespace wxPrivate
+
+// ============================================================================
+// wxTaskGroup implementation
+// ============================================================================
+
+void wxTaskGroup::OnTaskFinished()
+{
+    m_pending--;
+}
+
+static bool IsGroupFinished(const void* data)
+{
+    return !static_cast<const std::atomic<int>*>(data)->load();
+}
+
+void wxTaskGroup::Wait()
+{
+    m_pool.WaitUntil(IsGroupFinished, &m_pending);
+}
+
+// ============================================================================
+// wxThreadPool implementation
+// ============================================================================
+
+namespace
+{
+
+wxThreadPool* gs_defaultPool = nullptr;
+int gs_defaultThreadCount = 0;
+
+} // anonymous namespace
+
+wxThreadPool::wxThreadPool(int numThreads)
+    : m_impl(new Impl(*this))
+{
+    if ( numThreads <= 0 )
+        numThreads = wxThread::GetCPUCount();
+    if ( numThreads <= 0 )
+        numThreads = 1;
+
+    wxLogTrace(wxTRACE_ThreadPool, "Starting %d workers.", numThreads);
+
+    if ( !m_impl->Start(numThreads) )
+    {
+        wxLogError(_("Failed to start any thread pool threads."));
+    }
+}
+
+wxThreadPool::~wxThreadPool()
+{
+    m_impl->Stop();
+}
+
+/* static */
+wxThreadPool& wxThreadPool::GetDefault()
+{
+    static wxCriticalSection s_cs;
+    wxCriticalSectionLocker lock(s_cs);
+
+    if ( !gs_defaultPool )
+        gs_defaultPool = new wxThreadPool(gs_defaultThreadCount);
+
+    return *gs_defaultPool;
+}
+
+/* static */
+void wxThreadPool::SetDefaultThreadCount(int numThreads)
+{
+    wxASSERT_MSG( !gs_defaultPool,
+                  "must be called before the default pool is created" );
+
+    gs_defaultThreadCount = numThreads;
+}
+
+int wxThreadPool::GetThreadCount() const
+{
+    return m_impl->GetThreadCount();
+}
+
+bool wxThreadPool::IsWorkerThread() const
+{
+    wxThreadPoolWorker* const worker = gs_currentWorker;
+    return worker && &worker->GetPool() == m_impl.get();
+}
+
+void wxThreadPool::Enqueue(const std::shared_ptr<wxPrivate::wxTaskBase>& task)
+{
+    // We can still work, albeit without any parallelism, if we couldn't
+    // create any threads.
+    if ( !GetThreadCount() )
+    {
+        task->Execute();
+        return;
+    }
+
+    m_impl->Enqueue(task);
+}
+
+void wxThreadPool::WaitUntil(bool (*done)(const void*), const void* data)
+{
+    m_impl->WaitUntil(done, data);
+}
+
+void wxThreadPool::NotifyWaiters()
+{
+    m_impl->NotifyWaiters();
+}
+
+// ----------------------------------------------------------------------------
+// wxThreadPoolModule: destroys the default pool on shutdown
+// ----------------------------------------------------------------------------
+
+class wxThreadPoolModule : public wxModule
+{
+public:
+    wxThreadPoolModule() = default;
+
+    virtual bool OnInit() override { return true; }
+    virtual void OnExit() override
+    {
+        delete gs_defaultPool;
+        gs_defaultPool = nullptr;
+    }
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxThreadPoolModule);
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxThreadPoolModule, wxModule);
+
+#endif // wxUSE_THREADS
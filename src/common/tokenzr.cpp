@@ -249,7 +249,12 @@ size_t wxStringTokenizer::CountTokens() const
 
 wxString wxStringTokenizer::GetNextToken()
 {
-    wxString token;
+    return GetNextTokenView().ToString();
+}
+
+wxStringView wxStringTokenizer::GetNextTokenView()
+{
+    wxStringView token;
     do
     {
         if ( !HasMoreTokens() )
@@ -268,7 +273,7 @@ wxString wxStringTokenizer::GetNextToken()
         {
             // no more delimiters, the token is everything till the end of
             // string
-            token.assign(m_pos, m_stringEnd);
+            token = m_string.GetView(m_pos, m_stringEnd);
 
             // skip the token
             m_pos = m_stringEnd;
@@ -284,7 +289,7 @@ wxString wxStringTokenizer::GetNextToken()
             if ( m_mode == wxTOKEN_RET_DELIMS )
                 ++tokenEnd;
 
-            token.assign(m_pos, tokenEnd);
+            token = m_string.GetView(m_pos, tokenEnd);
 
             // skip the token and the trailing delimiter
             m_pos = pos + 1;
@@ -43,6 +43,7 @@
 #include "wx/tokenzr.h"
 #include "wx/fontmap.h"
 #include "wx/stdpaths.h"
+#include "wx/thread.h"
 #include "wx/version.h"
 #include "wx/uilocale.h"
 
@@ -53,8 +54,13 @@
     #include "wx/msw/missing.h"
 #endif
 
+#ifdef __UNIX__
+    #include <sys/mman.h>
+#endif
+
 #include <memory>
 #include <unordered_set>
+#include <vector>
 
 // ----------------------------------------------------------------------------
 // simple types
@@ -471,8 +477,38 @@ public:
     void  init(wxPluralFormsToken::Number nplurals, wxPluralFormsNode* plural);
 
 private:
+    // The expression is compiled into a flat sequence of instructions for a
+    // simple stack machine, which is much faster to evaluate than recursively
+    // walking the tree. The opcodes reuse the token types: T_NUMBER and T_N
+    // push a value on the stack, the binary operators replace the two values
+    // on top of it with the result, T_QUESTION pops the condition and jumps to
+    // the instruction with the given index if it's false and T_COLON jumps to
+    // it unconditionally.
+    struct Instruction
+    {
+        wxPluralFormsToken::Type op;
+        wxPluralFormsToken::Number arg;
+    };
+
+    // Maximal depth of the stack used by the compiled code, more complex
+    // expressions are evaluated using the tree.
+    static const int MAX_STACK_DEPTH = 32;
+
+    // Results for the numbers in [0, NUM_CACHED_RESULTS) range, which are by
+    // far the most commonly used ones, are computed only once.
+    static const int NUM_CACHED_RESULTS = 256;
+
+    // Append the code for the given node and return false if it's too complex.
+    bool compile(const wxPluralFormsNode* node, int depth);
+
+    // Evaluate the expression without using the cached results.
+    int doEvaluate(wxPluralFormsToken::Number n) const;
+
     wxPluralFormsToken::Number m_nplurals;
     wxPluralFormsNodePtr m_plural;
+
+    std::vector<Instruction> m_code;
+    std::vector<int> m_results;
 };
 
 void wxPluralFormsCalculator::init(wxPluralFormsToken::Number nplurals,
@@ -480,22 +516,181 @@ void wxPluralFormsCalculator::init(wxPluralFormsToken::Number nplurals,
 {
     m_nplurals = nplurals;
     m_plural.reset(plural);
+
+    m_code.clear();
+    if ( !compile(plural, 1) )
+        m_code.clear();
+
+    m_results.resize(NUM_CACHED_RESULTS);
+    for ( int n = 0; n < NUM_CACHED_RESULTS; n++ )
+        m_results[n] = doEvaluate(n);
 }
 
-int wxPluralFormsCalculator::evaluate(int n) const
+bool wxPluralFormsCalculator::compile(const wxPluralFormsNode* node, int depth)
+{
+    if ( depth > MAX_STACK_DEPTH )
+        return false;
+
+    const wxPluralFormsToken& token = node->token();
+    const Instruction instr = { token.type(), 0 };
+    switch ( token.type() )
+    {
+        case wxPluralFormsToken::T_NUMBER:
+            m_code.push_back(instr);
+            m_code.back().arg = token.number();
+            return true;
+
+        case wxPluralFormsToken::T_N:
+            m_code.push_back(instr);
+            return true;
+
+        case wxPluralFormsToken::T_EQUAL:
+        case wxPluralFormsToken::T_NOT_EQUAL:
+        case wxPluralFormsToken::T_GREATER:
+        case wxPluralFormsToken::T_GREATER_OR_EQUAL:
+        case wxPluralFormsToken::T_LESS:
+        case wxPluralFormsToken::T_LESS_OR_EQUAL:
+        case wxPluralFormsToken::T_REMINDER:
+        case wxPluralFormsToken::T_LOGICAL_AND:
+        case wxPluralFormsToken::T_LOGICAL_OR:
+            // As the expressions don't have any side effects, there is no
+            // need to short-circuit the logical operators.
+            if ( !compile(node->node(0), depth) ||
+                    !compile(node->node(1), depth + 1) )
+                return false;
+
+            m_code.push_back(instr);
+            return true;
+
+        case wxPluralFormsToken::T_QUESTION:
+            {
+                if ( !compile(node->node(0), depth) )
+                    return false;
+
+                const size_t jumpToElse = m_code.size();
+                m_code.push_back(instr);
+
+                if ( !compile(node->node(1), depth) )
+                    return false;
+
+                const size_t jumpToEnd = m_code.size();
+                const Instruction jump = { wxPluralFormsToken::T_COLON, 0 };
+                m_code.push_back(jump);
+
+                m_code[jumpToElse].arg = m_code.size();
+
+                if ( !compile(node->node(2), depth) )
+                    return false;
+
+                m_code[jumpToEnd].arg = m_code.size();
+            }
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+int wxPluralFormsCalculator::doEvaluate(wxPluralFormsToken::Number n) const
 {
     if (m_plural.get() == nullptr)
     {
         return 0;
     }
-    wxPluralFormsToken::Number number = m_plural->evaluate(n);
-    if (number < 0 || number > m_nplurals)
+
+    wxPluralFormsToken::Number number;
+    if ( m_code.empty() )
+    {
+        number = m_plural->evaluate(n);
+    }
+    else
+    {
+        wxPluralFormsToken::Number stack[MAX_STACK_DEPTH];
+        int top = -1;
+
+        const Instruction* const code = m_code.data();
+        const size_t size = m_code.size();
+        for ( size_t pc = 0; pc < size; pc++ )
+        {
+            const Instruction& instr = code[pc];
+            switch ( instr.op )
+            {
+                case wxPluralFormsToken::T_NUMBER:
+                    stack[++top] = instr.arg;
+                    continue;
+
+                case wxPluralFormsToken::T_N:
+                    stack[++top] = n;
+                    continue;
+
+                case wxPluralFormsToken::T_QUESTION:
+                    if ( !stack[top--] )
+                        pc = instr.arg - 1;
+                    continue;
+
+                case wxPluralFormsToken::T_COLON:
+                    pc = instr.arg - 1;
+                    continue;
+
+                default:
+                    break;
+            }
+
+            const wxPluralFormsToken::Number rhs = stack[top--];
+            wxPluralFormsToken::Number& lhs = stack[top];
+            switch ( instr.op )
+            {
+                case wxPluralFormsToken::T_EQUAL:
+                    lhs = lhs == rhs;
+                    break;
+                case wxPluralFormsToken::T_NOT_EQUAL:
+                    lhs = lhs != rhs;
+                    break;
+                case wxPluralFormsToken::T_GREATER:
+                    lhs = lhs > rhs;
+                    break;
+                case wxPluralFormsToken::T_GREATER_OR_EQUAL:
+                    lhs = lhs >= rhs;
+                    break;
+                case wxPluralFormsToken::T_LESS:
+                    lhs = lhs < rhs;
+                    break;
+                case wxPluralFormsToken::T_LESS_OR_EQUAL:
+                    lhs = lhs <= rhs;
+                    break;
+                case wxPluralFormsToken::T_REMINDER:
+                    lhs = rhs != 0 ? lhs % rhs : 0;
+                    break;
+                case wxPluralFormsToken::T_LOGICAL_AND:
+                    lhs = lhs && rhs;
+                    break;
+                case wxPluralFormsToken::T_LOGICAL_OR:
+                    lhs = lhs || rhs;
+                    break;
+                default:
+                    wxFAIL_MSG( "unexpected plural forms instruction" );
+                    return 0;
+            }
+        }
+
+        number = stack[0];
+    }
+
+    if (number < 0 || number >= m_nplurals)
     {
         return 0;
     }
     return number;
 }
 
+int wxPluralFormsCalculator::evaluate(int n) const
+{
+    if ( n >= 0 && static_cast<size_t>(n) < m_results.size() )
+        return m_results[n];
+
+    return doEvaluate(n);
+}
+
 
 class wxPluralFormsParser
 {
@@ -862,6 +1057,18 @@ public:
     // fills the hash with string-translation pairs
     bool FillHash(wxTranslationsHashMap& hash, const wxString& domain) const;
 
+    // return true if GetString() can be used instead of FillHash(), which is
+    // the case for UTF-8 catalogs containing the hash table
+    bool CanLookupLazily() const;
+
+    // find the translation of the given message in the catalog hash table and
+    // convert it to wxString only when it's requested for the first time;
+    // key is the key used in the hash filled by FillHash(), i.e. msgid
+    // possibly followed by the plural form index
+    const wxString *GetString(const wxString& key,
+                              const wxString& msgid,
+                              unsigned index);
+
     // return the charset of the strings in this catalog or empty string if
     // none/unknown
     wxString GetCharset() const { return m_charset; }
@@ -891,6 +1098,11 @@ private:
     // all data is stored here
     DataBuffer m_data;
 
+#ifdef __UNIX__
+    // if not null, m_data points to this mapping of the catalog file
+    void *m_mapped = nullptr;
+#endif // __UNIX__
+
     // data description
     size_t32          m_numStrings;   // number of strings in this domain
     const
@@ -899,6 +1111,24 @@ private:
 
     wxString m_charset;               // from the message catalog header
 
+    // the hash table created by msgfmt, may be empty
+    size_t32          m_nHashSize = 0;
+    const size_t32   *m_pHashTable = nullptr;
+
+    // translations already retrieved by GetString() and the (most recent)
+    // keys not found in the catalog, which are also remembered to avoid
+    // looking them up again when searching in several catalogs
+    wxTranslationsHashMap m_translations;
+    std::unordered_set<wxString> m_missing;
+    wxCRIT_SECT_DECLARE_MEMBER(m_csTranslations);
+
+    // return the index of the original string equal to msgid or m_numStrings
+    size_t32 FindOrigString(const char* msgid) const;
+
+    // return true if the string table at the given offset and all the strings
+    // in it are inside m_data
+    bool IsValidStringTable(size_t32 ofsTable) const;
+
 
     // swap the 2 halves of 32 bit integer if needed
     size_t32 Swap(size_t32 ui) const
@@ -908,18 +1138,11 @@ private:
                             : ui;
     }
 
+    // n must be less than m_numStrings, the string offsets were checked to be
+    // valid in LoadData() so no checks are needed here
     const char* StringAtOfs(const wxMsgTableEntry* pTable, size_t32 n) const
     {
-        const wxMsgTableEntry * const ent = pTable + n;
-
-        // this check could fail for a corrupt message catalog
-        size_t32 ofsString = Swap(ent->ofsString);
-        if ( ofsString + Swap(ent->nLen) > m_data.length())
-        {
-            return nullptr;
-        }
-
-        return m_data.data() + ofsString;
+        return m_data.data() + Swap(pTable[n].ofsString);
     }
 
     bool m_bSwapped;   // wrong endianness?
@@ -937,6 +1160,10 @@ wxMsgCatalogFile::wxMsgCatalogFile()
 
 wxMsgCatalogFile::~wxMsgCatalogFile()
 {
+#ifdef __UNIX__
+    if ( m_mapped )
+        munmap(m_mapped, m_data.length());
+#endif // __UNIX__
 }
 
 // open disk file and read in its contents
@@ -955,19 +1182,37 @@ bool wxMsgCatalogFile::LoadFile(const wxString& filename,
     size_t nSize = wx_truncate_cast(size_t, lenFile);
     wxASSERT_MSG( nSize == lenFile + size_t(0), wxS("message catalog bigger than 4GB?") );
 
-    wxMemoryBuffer filedata;
+    DataBuffer data;
 
-    // read the whole file in memory
-    if ( fileMsg.Read(filedata.GetWriteBuf(nSize), nSize) != lenFile )
-        return false;
+#ifdef __UNIX__
+    // map the file in memory instead of reading it, as we may need only a
+    // small part of it if the strings are looked up lazily
+    if ( nSize )
+    {
+        void* const
+            mapped = mmap(nullptr, nSize, PROT_READ, MAP_PRIVATE, fileMsg.fd(), 0);
+        if ( mapped != MAP_FAILED )
+        {
+            m_mapped = mapped;
+            data = DataBuffer::CreateNonOwned(static_cast<char*>(mapped), nSize);
+        }
+    }
+
+    if ( !m_mapped )
+#endif // __UNIX__
+    {
+        wxMemoryBuffer filedata;
 
-    filedata.UngetWriteBuf(nSize);
+        // read the whole file in memory
+        if ( fileMsg.Read(filedata.GetWriteBuf(nSize), nSize) != lenFile )
+            return false;
 
-    bool ok = LoadData
-              (
-                  DataBuffer::CreateOwned((char*)filedata.release(), nSize),
-                  rPluralFormsCalculator
-              );
+        filedata.UngetWriteBuf(nSize);
+
+        data = DataBuffer::CreateOwned((char*)filedata.release(), nSize);
+    }
+
+    bool ok = LoadData(data, rPluralFormsCalculator);
     if ( !ok )
     {
         wxLogWarning(_("'%s' is not a valid message catalog."), filename);
@@ -994,8 +1239,8 @@ bool wxMsgCatalogFile::LoadData(const DataBuffer& data,
     }
 
     if ( !bValid ) {
-        // it's either too short or has incorrect magic number
-        wxLogWarning(_("Invalid message catalog."));
+        // it's either too short or has incorrect magic number, the caller
+        // logs a warning about it
         return false;
     }
 
@@ -1003,16 +1248,36 @@ bool wxMsgCatalogFile::LoadData(const DataBuffer& data,
 
     // initialize
     m_numStrings  = Swap(pHeader->numStrings);
+
+    // check all the strings once here as they may be accessed lazily later
+    // and we don't want to check them every time
+    const size_t32 ofsOrigTable = Swap(pHeader->ofsOrigTable);
+    const size_t32 ofsTransTable = Swap(pHeader->ofsTransTable);
+    if ( !IsValidStringTable(ofsOrigTable) ||
+            !IsValidStringTable(ofsTransTable) )
+        return false;
+
     m_pOrigTable  = reinterpret_cast<const wxMsgTableEntry*>(data.data() +
-                    Swap(pHeader->ofsOrigTable));
+                    ofsOrigTable);
     m_pTransTable = reinterpret_cast<const wxMsgTableEntry*>(data.data() +
-                    Swap(pHeader->ofsTransTable));
+                    ofsTransTable);
+
+    // only use the hash table if it's valid, we don't need it otherwise
+    const size_t32 nHashSize = Swap(pHeader->nHashSize);
+    const size_t32 ofsHashTable = Swap(pHeader->ofsHashTable);
+    if ( nHashSize > 2 && ofsHashTable % sizeof(size_t32) == 0 &&
+            ofsHashTable < data.length() &&
+            (data.length() - ofsHashTable) / sizeof(size_t32) >= nHashSize )
+    {
+        m_nHashSize = nHashSize;
+        m_pHashTable = reinterpret_cast<const size_t32*>(data.data() +
+                       ofsHashTable);
+    }
 
     // now parse catalog's header and try to extract catalog charset and
     // plural forms formula from it:
 
-    const char* headerData = StringAtOfs(m_pOrigTable, 0);
-    if ( headerData && headerData[0] == '\0' )
+    if ( m_numStrings && StringAtOfs(m_pOrigTable, 0)[0] == '\0' )
     {
         // Extract the charset:
         const char * const header = StringAtOfs(m_pTransTable, 0);
@@ -1096,14 +1361,10 @@ bool wxMsgCatalogFile::FillHash(wxTranslationsHashMap& hash,
     for (size_t32 i = 0; i < m_numStrings; i++)
     {
         const char *data = StringAtOfs(m_pOrigTable, i);
-        if (!data)
-            return false; // may happen for invalid MO files
 
         wxString msgid;
         msgid = wxString(data, *inputConv);
         data = StringAtOfs(m_pTransTable, i);
-        if (!data)
-            return false; // may happen for invalid MO files
 
         size_t length = Swap(m_pTransTable[i].nLen);
         size_t offset = 0;
@@ -1133,6 +1394,138 @@ bool wxMsgCatalogFile::FillHash(wxTranslationsHashMap& hash,
     return true;
 }
 
+bool wxMsgCatalogFile::IsValidStringTable(size_t32 ofsTable) const
+{
+    const size_t length = m_data.length();
+    if ( ofsTable > length ||
+            (length - ofsTable) / sizeof(wxMsgTableEntry) < m_numStrings )
+        return false;
+
+    const wxMsgTableEntry* const
+        table = reinterpret_cast<const wxMsgTableEntry*>(m_data.data() + ofsTable);
+    for ( size_t32 n = 0; n < m_numStrings; n++ )
+    {
+        // the string must be followed by NUL which is not counted in its
+        // length, so check that it's really there
+        const size_t32 ofsString = Swap(table[n].ofsString);
+        if ( ofsString >= length )
+            return false;
+
+        const size_t32 nLen = Swap(table[n].nLen);
+        if ( nLen >= length - ofsString || m_data.data()[ofsString + nLen] )
+            return false;
+    }
+
+    return true;
+}
+
+bool wxMsgCatalogFile::CanLookupLazily() const
+{
+    return m_pHashTable && m_charset.IsSameAs(wxS("utf-8"), false);
+}
+
+size_t32 wxMsgCatalogFile::FindOrigString(const char* msgid) const
+{
+    // this is the same hash function as used by msgfmt
+    wxUint64 hval = 0;
+    for ( const char* p = msgid; *p; p++ )
+    {
+        hval <<= 4;
+        hval += static_cast<unsigned char>(*p);
+
+        const wxUint64 g = hval & (~wxUint64(0) << 28);
+        if ( g )
+        {
+            hval ^= g >> 24;
+            hval ^= g;
+        }
+    }
+
+    const size_t len = strlen(msgid);
+    const size_t32 hash = static_cast<size_t32>(hval);
+    const size_t32 incr = 1 + hash % (m_nHashSize - 2);
+
+    size_t32 idx = hash % m_nHashSize;
+
+    // the table is never full, but don't loop forever for corrupted files
+    for ( size_t32 probe = 0; probe < m_nHashSize; probe++ )
+    {
+        // hash table entries are 1-based string indices and 0 means unused
+        const size_t32 nstr = Swap(m_pHashTable[idx]);
+        if ( !nstr )
+            break;
+
+        if ( nstr <= m_numStrings )
+        {
+            // compare only the first part of plural forms entries
+            const char* const orig = StringAtOfs(m_pOrigTable, nstr - 1);
+            const size_t lenOrig = Swap(m_pOrigTable[nstr - 1].nLen);
+            if ( lenOrig >= len && memcmp(orig, msgid, len) == 0 &&
+                    (lenOrig == len || orig[len] == '\0') )
+                return nstr - 1;
+        }
+
+        if ( idx >= m_nHashSize - incr )
+            idx -= m_nHashSize - incr;
+        else
+            idx += incr;
+    }
+
+    return m_numStrings;
+}
+
+const wxString *wxMsgCatalogFile::GetString(const wxString& key,
+                                            const wxString& msgid,
+                                            unsigned index)
+{
+    wxCRIT_SECT_LOCKER(lock, m_csTranslations);
+
+    const wxTranslationsHashMap::const_iterator it = m_translations.find(key);
+    if ( it != m_translations.end() )
+        return &it->second;
+
+    if ( m_missing.count(key) )
+        return nullptr;
+
+    wxString msgstr;
+
+    const size_t32 n = FindOrigString(msgid.utf8_str());
+    const char* const data = n < m_numStrings ? StringAtOfs(m_pTransTable, n)
+                                              : nullptr;
+    if ( data )
+    {
+        // skip the strings corresponding to the preceding plural forms, see
+        // the comment in FillHash() about using wxStrnlen() here
+        const size_t length = Swap(m_pTransTable[n].nLen);
+        size_t offset = 0;
+        for ( ; index && offset < length; index-- )
+            offset += wxStrnlen(data + offset, length - offset) + 1;
+
+        if ( offset < length )
+        {
+            msgstr = wxString::FromUTF8(data + offset,
+                                        wxStrnlen(data + offset,
+                                                  length - offset));
+        }
+    }
+
+    // empty translations are not used, just as in FillHash()
+    if ( msgstr.empty() )
+    {
+        // don't let the set of missing keys grow indefinitely if many
+        // different dynamically created strings are looked up, forgetting
+        // about them just means that we'll look them up again if needed
+        static const size_t MAX_MISSING = 4096;
+        if ( m_missing.size() >= MAX_MISSING )
+            m_missing.clear();
+
+        m_missing.insert(key);
+        return nullptr;
+    }
+
+    return &(m_translations[key] = msgstr);
+}
+
 
 // ----------------------------------------------------------------------------
 // wxMsgCatalog class
@@ -1151,13 +1544,22 @@ wxMsgCatalog *wxMsgCatalog::CreateFromFile(const wxString& filename,
 {
     std::unique_ptr<wxMsgCatalog> cat(new wxMsgCatalog(domain));
 
-    wxMsgCatalogFile file;
+    std::unique_ptr<wxMsgCatalogFile> file(new wxMsgCatalogFile);
 
-    if ( !file.LoadFile(filename, cat->m_pluralFormsCalculator) )
+    if ( !file->LoadFile(filename, cat->m_pluralFormsCalculator) )
         return nullptr;
 
-    if ( !file.FillHash(cat->m_messages, domain) )
-        return nullptr;
+    // Avoid converting all the strings in advance if possible: typically only
+    // a small fraction of them is used by the application.
+    if ( file->CanLookupLazily() )
+    {
+        cat->m_file = std::move(file);
+    }
+    else
+    {
+        if ( !file->FillHash(cat->m_messages, domain) )
+            return nullptr;
+    }
 
     return cat.release();
 }
@@ -1186,6 +1588,15 @@ const wxString *wxMsgCatalog::GetString(const wxString& str, unsigned n, const w
     {
         index = m_pluralFormsCalculator->evaluate(n);
     }
+    if ( m_file )
+    {
+        const wxString
+            msgid = context.empty() ? str : context + wxS('\x04') + str;
+
+        return m_file->GetString(index == 0 ? msgid : msgid + wxChar(index),
+                                 msgid, index);
+    }
+
     wxTranslationsHashMap::const_iterator i;
     if (index != 0)
     {
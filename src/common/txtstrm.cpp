@@ -36,6 +36,8 @@ wxTextInputStream::wxTextInputStream(wxInputStream &s,
 #if SIZEOF_WCHAR_T == 2
     m_lastWChar = 0;
 #endif // SIZEOF_WCHAR_T == 2
+
+    m_canReadAhead = s.IsSeekable();
 }
 
 wxTextInputStream::~wxTextInputStream()
@@ -269,8 +271,128 @@ double wxTextInputStream::ReadDouble()
     return wxStrtod(word.c_str(), 0);
 }
 
+bool wxTextInputStream::CanReadLineBytes() const
+{
+    // We can't use the raw bytes if there are some bytes or characters already
+    // read from the stream but not returned yet by GetChar().
+    if ( m_validBegin != m_validEnd )
+        return false;
+
+#if SIZEOF_WCHAR_T == 2
+    if ( m_lastWChar )
+        return false;
+#endif // SIZEOF_WCHAR_T == 2
+
+    // In the encodings using single byte code units, i.e. ASCII-compatible
+    // ones, CR and LF bytes can't occur inside multibyte sequences, so we can
+    // look for them without decoding the input. Notice that this is not the
+    // case for wxConvAuto before it examined the input (it returns
+    // wxCONV_FAILED from here then), but it is after it's done it.
+    return m_conv->GetMBNulLen() == 1;
+}
+
+wxString wxTextInputStream::ReadLineBytes()
+{
+    static const size_t CHUNK_SIZE = 256;
+
+    m_lineBytes.Clear();
+
+    for ( ;; )
+    {
+        char* const start = static_cast<char*>(m_lineBytes.GetAppendBuf(CHUNK_SIZE));
+
+        size_t len = 0;
+        if ( m_canReadAhead )
+        {
+            len = m_input.Read(start, CHUNK_SIZE).LastRead();
+        }
+        else // Don't read beyond EOL, this could block.
+        {
+            while ( len < CHUNK_SIZE )
+            {
+                const int c = m_input.GetC();
+                if ( c == wxEOF )
+                    break;
+
+                start[len++] = static_cast<char>(c);
+                if ( c == '\n' || c == '\r' )
+                    break;
+            }
+        }
+
+        if ( !len )
+        {
+            m_lineBytes.UngetAppendBuf(0);
+            break;
+        }
+
+        const char* const end = start + len;
+        const char* p = start;
+        while ( p != end && *p != '\n' && *p != '\r' )
+            p++;
+
+        if ( p == end )
+        {
+            m_lineBytes.UngetAppendBuf(len);
+            continue;
+        }
+
+        m_lineBytes.UngetAppendBuf(p - start);
+
+        const char* next = p + 1;
+        bool eofAfterCR = false;
+        if ( *p == '\r' )
+        {
+            if ( next != end )
+            {
+                if ( *next == '\n' )
+                    next++;
+            }
+            else // We need to read one more byte to know if it's DOS EOL.
+            {
+                const int c = m_input.GetC();
+                if ( c == wxEOF )
+                    eofAfterCR = true;
+                else if ( c != '\n' )
+                    m_input.Ungetch(static_cast<char>(c));
+            }
+        }
+
+        if ( next != end )
+        {
+            // Put back the bytes after the end of this line.
+            m_input.Ungetch(next, end - next);
+        }
+        else if ( m_input.Eof() && !eofAfterCR )
+        {
+            // We may have hit EOF when reading ahead, but for consistency with
+            // the case when we don't do it, only report it when reading the
+            // next line.
+            m_input.Reset();
+        }
+
+        break;
+    }
+
+    if ( m_lineBytes.IsEmpty() )
+        return wxString();
+
+    wxString line(static_cast<const char*>(m_lineBytes.GetData()),
+                  *m_conv, m_lineBytes.GetDataLen());
+    if ( line.empty() )
+    {
+        // Decoding failed, see the comment in ReadLine().
+        m_input.Reset(wxSTREAM_READ_ERROR);
+    }
+
+    return line;
+}
+
 wxString wxTextInputStream::ReadLine()
 {
+    if ( CanReadLineBytes() )
+        return ReadLineBytes();
+
     wxString line;
 
     for ( ;; )
@@ -455,6 +455,23 @@ wxWebRequest::Storage wxWebRequest::GetStorage() const
     return m_impl->GetStorage();
 }
 
+bool wxWebRequest::SetDataConsumer(wxWebResponseConsumer* consumer)
+{
+    wxCHECK_IMPL( false );
+
+    wxCHECK_MSG( m_impl->GetState() == wxWebRequest::State_Idle, false,
+                 "Consumer must be set before starting the request" );
+
+    return m_impl->SetDataConsumer(consumer);
+}
+
+void wxWebRequest::ResumeTransfer()
+{
+    wxCHECK_IMPL_VOID();
+
+    m_impl->ResumeTransfer();
+}
+
 void wxWebRequest::Start()
 {
     wxCHECK_IMPL_VOID();
@@ -883,6 +900,13 @@ wxString wxWebResponse::GetDataFile() const
     return m_impl->GetDataFile();
 }
 
+wxLongLong wxWebResponse::GetTiming(Timing timing) const
+{
+    wxCHECK_IMPL( -1 );
+
+    return m_impl->GetTiming(timing);
+}
+
 
 //
 // wxWebSessionImpl
@@ -1073,6 +1097,30 @@ bool wxWebSession::EnablePersistentStorage(bool enable)
     return m_impl->EnablePersistentStorage(enable);
 }
 
+bool wxWebSession::SetMaxConnectionsPerHost(int maxConnections)
+{
+    wxCHECK_MSG( maxConnections >= 0, false, "invalid number of connections" );
+
+    return m_impl->SetMaxConnectionsPerHost(maxConnections);
+}
+
+bool wxWebSession::SetMaxConnections(int maxConnections)
+{
+    wxCHECK_MSG( maxConnections >= 0, false, "invalid number of connections" );
+
+    return m_impl->SetMaxConnections(maxConnections);
+}
+
+bool wxWebSession::EnableConnectionReuse(bool enable)
+{
+    return m_impl->EnableConnectionReuse(enable);
+}
+
+bool wxWebSession::EnableMultiplexing(bool enable)
+{
+    return m_impl->EnableMultiplexing(enable);
+}
+
 // ----------------------------------------------------------------------------
 // Module ensuring all global/singleton objects are destroyed on shutdown.
 // ----------------------------------------------------------------------------
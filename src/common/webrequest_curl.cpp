@@ -128,6 +128,22 @@ wxWebResponseCURL::wxWebResponseCURL(wxWebRequestCURL& request) :
 
 size_t wxWebResponseCURL::CURLOnWrite(void* buffer, size_t size)
 {
+    wxWebRequestCURL& request = static_cast<wxWebRequestCURL&>(m_request);
+    if ( wxWebResponseConsumer* const consumer = request.GetDataConsumer() )
+    {
+        // Pass the data directly to the consumer without copying it. If it
+        // can't accept it now, libcurl will keep it and pass it to us again
+        // when the transfer is resumed.
+        if ( !consumer->OnData(buffer, size) )
+        {
+            request.OnTransferPaused();
+            return CURL_WRITEFUNC_PAUSE;
+        }
+
+        m_request.ReportDataReceived(size);
+        return size;
+    }
+
     void* buf = GetDataBuffer(size);
     memcpy(buf, buffer, size);
     ReportDataReceived(size);
@@ -216,6 +232,90 @@ int wxWebResponseCURL::GetStatus() const
     return status;
 }
 
+wxLongLong wxWebResponseCURL::GetTiming(wxWebResponse::Timing timing) const
+{
+    // All times returned by libcurl are counted from the start of the
+    // transfer, which is exactly what we need.
+#if CURL_AT_LEAST_VERSION(7, 61, 0)
+    if ( wxWebSessionCURL::CurlRuntimeAtLeastVersion(7, 61, 0) )
+    {
+        CURLINFO info;
+        switch ( timing )
+        {
+            case wxWebResponse::Timing_NameLookup:
+                info = CURLINFO_NAMELOOKUP_TIME_T;
+                break;
+
+            case wxWebResponse::Timing_Connect:
+                info = CURLINFO_CONNECT_TIME_T;
+                break;
+
+            case wxWebResponse::Timing_TLSHandshake:
+                info = CURLINFO_APPCONNECT_TIME_T;
+                break;
+
+            case wxWebResponse::Timing_FirstByte:
+                info = CURLINFO_STARTTRANSFER_TIME_T;
+                break;
+
+            case wxWebResponse::Timing_Total:
+                info = CURLINFO_TOTAL_TIME_T;
+                break;
+
+            default:
+                wxFAIL_MSG( "unknown timing" );
+                return -1;
+        }
+
+        curl_off_t usec = 0;
+        if ( curl_easy_getinfo(GetHandle(), info, &usec) != CURLE_OK )
+            return -1;
+
+        return wxLongLong(usec);
+    }
+#endif // curl >= 7.61
+
+    CURLINFO info;
+    switch ( timing )
+    {
+        case wxWebResponse::Timing_NameLookup:
+            info = CURLINFO_NAMELOOKUP_TIME;
+            break;
+
+        case wxWebResponse::Timing_Connect:
+            info = CURLINFO_CONNECT_TIME;
+            break;
+
+        case wxWebResponse::Timing_TLSHandshake:
+            info = CURLINFO_APPCONNECT_TIME;
+            break;
+
+        case wxWebResponse::Timing_FirstByte:
+            info = CURLINFO_STARTTRANSFER_TIME;
+            break;
+
+        case wxWebResponse::Timing_Total:
+            info = CURLINFO_TOTAL_TIME;
+            break;
+
+        default:
+            wxFAIL_MSG( "unknown timing" );
+            return -1;
+    }
+
+    wxGCC_WARNING_SUPPRESS(deprecated-declarations)
+
+    double sec = 0;
+    const CURLcode rc = curl_easy_getinfo(GetHandle(), info, &sec);
+
+    wxGCC_WARNING_RESTORE(deprecated-declarations)
+
+    if ( rc != CURLE_OK )
+        return -1;
+
+    return wxLongLong(static_cast<wxLongLong_t>(sec*1000000));
+}
+
 //
 // wxWebRequestCURL
 //
@@ -279,6 +379,8 @@ wxWebRequestCURL::wxWebRequestCURL(wxWebSession & session,
     // Enable all supported authentication methods
     curl_easy_setopt(m_handle, CURLOPT_HTTPAUTH, CURLAUTH_ANY);
     curl_easy_setopt(m_handle, CURLOPT_PROXYAUTH, CURLAUTH_ANY);
+    // Use the connection options of the session
+    m_sessionImpl.SetupRequestHandle(m_handle);
 }
 
 wxWebRequestCURL::~wxWebRequestCURL()
@@ -406,6 +508,43 @@ void wxWebRequestCURL::DestroyHeaderList()
     }
 }
 
+bool wxWebRequestCURL::SetDataConsumer(wxWebResponseConsumer* consumer)
+{
+    m_consumer = consumer;
+
+    // The data is not stored anywhere when it is passed to the consumer.
+    if ( consumer )
+        m_storage = wxWebRequest::Storage_None;
+
+    return true;
+}
+
+void wxWebRequestCURL::ResumeTransfer()
+{
+    // This function can be called from any thread, but libcurl can only be
+    // used from the main one, so resume the transfer from there, keeping this
+    // object alive until then.
+    IncRef();
+    const wxWebRequestImplPtr self(this);
+
+    GetHandler()->CallAfter([self]()
+        {
+            static_cast<wxWebRequestCURL*>(self.get())->DoResumeTransfer();
+        });
+}
+
+void wxWebRequestCURL::DoResumeTransfer()
+{
+    if ( !m_paused || GetState() != wxWebRequest::State_Active )
+        return;
+
+    // Reset the flag before resuming, as the consumer may be called from
+    // curl_easy_pause() and pause the transfer again.
+    m_paused = false;
+
+    curl_easy_pause(m_handle, CURLPAUSE_CONT);
+}
+
 wxFileOffset wxWebRequestCURL::GetBytesSent() const
 {
     return m_bytesSent;
@@ -894,6 +1033,76 @@ SocketPollerImpl* SocketPollerImpl::Create(wxEvtHandler* hndlr)
 int wxWebSessionCURL::ms_activeSessions = 0;
 unsigned int wxWebSessionCURL::ms_runtimeVersion = 0;
 
+namespace
+{
+
+// Handle used for sharing DNS cache and TLS sessions between all requests of
+// all sessions, so that resolving the host name and performing the full TLS
+// handshake is only done once even if the connections can't be reused.
+CURLSH* gs_shareHandle = nullptr;
+
+// Locks protecting the different kinds of data in gs_shareHandle, they are
+// also passed to the lock functions below as their user data pointer.
+wxMutex* gs_shareLocks = nullptr;
+
+void wxCURLShareLock(CURL* WXUNUSED(handle),
+                     curl_lock_data data,
+                     curl_lock_access WXUNUSED(access),
+                     void* userptr)
+{
+    if ( data < CURL_LOCK_DATA_LAST )
+        static_cast<wxMutex*>(userptr)[data].Lock();
+}
+
+void wxCURLShareUnlock(CURL* WXUNUSED(handle),
+                       curl_lock_data data,
+                       void* userptr)
+{
+    if ( data < CURL_LOCK_DATA_LAST )
+        static_cast<wxMutex*>(userptr)[data].Unlock();
+}
+
+void CreateShareHandle()
+{
+    gs_shareHandle = curl_share_init();
+    if ( !gs_shareHandle )
+    {
+        wxLogDebug("curl_share_init() failed");
+        return;
+    }
+
+    gs_shareLocks = new wxMutex[CURL_LOCK_DATA_LAST];
+
+    curl_share_setopt(gs_shareHandle, CURLSHOPT_USERDATA, gs_shareLocks);
+    curl_share_setopt(gs_shareHandle, CURLSHOPT_LOCKFUNC, wxCURLShareLock);
+    curl_share_setopt(gs_shareHandle, CURLSHOPT_UNLOCKFUNC, wxCURLShareUnlock);
+    curl_share_setopt(gs_shareHandle, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(gs_shareHandle, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+}
+
+void DestroyShareHandle()
+{
+    if ( !gs_shareHandle )
+        return;
+
+    // This fails if the handle is still used by some easy handle, in which
+    // case the locks may still be used too, so we have to leak them.
+    const CURLSHcode rc = curl_share_cleanup(gs_shareHandle);
+    if ( rc == CURLSHE_OK )
+    {
+        delete [] gs_shareLocks;
+    }
+    else
+    {
+        wxLogDebug("curl_share_cleanup() failed: %s", curl_share_strerror(rc));
+    }
+
+    gs_shareHandle = nullptr;
+    gs_shareLocks = nullptr;
+}
+
+} // anonymous namespace
+
 wxWebSessionCURL::wxWebSessionCURL() :
     m_handle(nullptr)
 {
@@ -908,6 +1117,8 @@ wxWebSessionCURL::wxWebSessionCURL() :
         {
             curl_version_info_data* data = curl_version_info(CURLVERSION_NOW);
             ms_runtimeVersion = data->version_num;
+
+            CreateShareHandle();
         }
     }
 
@@ -930,7 +1141,10 @@ wxWebSessionCURL::~wxWebSessionCURL()
     // Global CURL cleanup if this is the last session
     --ms_activeSessions;
     if ( ms_activeSessions == 0 )
+    {
+        DestroyShareHandle();
         curl_global_cleanup();
+    }
 }
 
 wxWebRequestImplPtr
@@ -954,12 +1168,137 @@ wxWebSessionCURL::CreateRequest(wxWebSession& session,
             curl_multi_setopt(m_handle, CURLMOPT_SOCKETFUNCTION, SocketCallback);
             curl_multi_setopt(m_handle, CURLMOPT_TIMERDATA, this);
             curl_multi_setopt(m_handle, CURLMOPT_TIMERFUNCTION, TimerCallback);
+
+            ApplyConnectionOptions();
         }
     }
 
     return wxWebRequestImplPtr(new wxWebRequestCURL(session, *this, handler, url, id));
 }
 
+void wxWebSessionCURL::ApplyConnectionOptions()
+{
+    // Options set before the multi handle creation will be applied when it is
+    // created.
+    if ( !m_handle )
+        return;
+
+#if CURL_AT_LEAST_VERSION(7, 30, 0)
+    curl_multi_setopt(m_handle, CURLMOPT_MAX_HOST_CONNECTIONS,
+                      m_maxHostConnections);
+    curl_multi_setopt(m_handle, CURLMOPT_MAX_TOTAL_CONNECTIONS,
+                      m_maxConnections);
+
+    // Also make the connection cache big enough to keep all the connections
+    // open, otherwise they would be closed and reopened again.
+    curl_multi_setopt(m_handle, CURLMOPT_MAXCONNECTS, m_maxConnections);
+#endif // curl >= 7.30
+
+#if CURL_AT_LEAST_VERSION(7, 47, 0)
+    if ( m_multiplexing != -1 )
+    {
+        curl_multi_setopt(m_handle, CURLMOPT_PIPELINING,
+                          m_multiplexing ? CURLPIPE_MULTIPLEX
+                                         : CURLPIPE_NOTHING);
+    }
+#endif // curl >= 7.47
+}
+
+void wxWebSessionCURL::SetupRequestHandle(CURL* curl) const
+{
+    if ( gs_shareHandle )
+        curl_easy_setopt(curl, CURLOPT_SHARE, gs_shareHandle);
+
+    if ( !m_reuseConnections )
+    {
+        curl_easy_setopt(curl, CURLOPT_FRESH_CONNECT, 1L);
+        curl_easy_setopt(curl, CURLOPT_FORBID_REUSE, 1L);
+    }
+
+#if CURL_AT_LEAST_VERSION(7, 47, 0)
+    switch ( m_multiplexing )
+    {
+        case 0:
+            curl_easy_setopt(curl, CURLOPT_HTTP_VERSION,
+                             static_cast<long>(CURL_HTTP_VERSION_1_1));
+            break;
+
+        case 1:
+            curl_easy_setopt(curl, CURLOPT_HTTP_VERSION,
+                             static_cast<long>(CURL_HTTP_VERSION_2TLS));
+
+            // Prefer waiting for an existing connection to find out if it
+            // supports multiplexing to opening a new one.
+            curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+            break;
+    }
+#endif // curl >= 7.47
+}
+
+bool wxWebSessionCURL::SetMaxConnectionsPerHost(int maxConnections)
+{
+#if CURL_AT_LEAST_VERSION(7, 30, 0)
+    if ( !CurlRuntimeAtLeastVersion(7, 30, 0) )
+        return false;
+
+    m_maxHostConnections = maxConnections;
+    ApplyConnectionOptions();
+
+    return true;
+#else
+    wxUnusedVar(maxConnections);
+
+    return false;
+#endif
+}
+
+bool wxWebSessionCURL::SetMaxConnections(int maxConnections)
+{
+#if CURL_AT_LEAST_VERSION(7, 30, 0)
+    if ( !CurlRuntimeAtLeastVersion(7, 30, 0) )
+        return false;
+
+    m_maxConnections = maxConnections;
+    ApplyConnectionOptions();
+
+    return true;
+#else
+    wxUnusedVar(maxConnections);
+
+    return false;
+#endif
+}
+
+bool wxWebSessionCURL::EnableConnectionReuse(bool enable)
+{
+    m_reuseConnections = enable;
+
+    return true;
+}
+
+bool wxWebSessionCURL::EnableMultiplexing(bool enable)
+{
+#if CURL_AT_LEAST_VERSION(7, 47, 0)
+    if ( !CurlRuntimeAtLeastVersion(7, 47, 0) )
+        return false;
+
+    // Multiplexing can't be enabled if libcurl was built without HTTP/2
+    // support, but it can always be disabled.
+    if ( enable &&
+            !(curl_version_info(CURLVERSION_NOW)->features & CURL_VERSION_HTTP2) )
+        return false;
+
+    m_multiplexing = enable;
+    ApplyConnectionOptions();
+
+    return true;
+#else
+    wxUnusedVar(enable);
+
+    return false;
+#endif
+}
+
 bool wxWebSessionCURL::StartRequest(wxWebRequestCURL & request)
 {
     // Add request easy handle to multi handle
@@ -46,6 +46,7 @@
 #include "wx/dnd.h"
 #include "wx/selstore.h"
 #include "wx/stopwatch.h"
+#include "wx/thread.h"
 #include "wx/weakref.h"
 #include "wx/generic/private/markuptext.h"
 #include "wx/generic/private/rowheightcache.h"
@@ -54,6 +55,10 @@
 #include "wx/private/markupparser.h"
 #endif // wxUSE_ACCESSIBILITY
 
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
 //-----------------------------------------------------------------------------
 // classes
 //-----------------------------------------------------------------------------
@@ -528,6 +533,29 @@ public:
     void InsertChild(wxDataViewMainWindow* window,
                      wxDataViewTreeNode *node, unsigned index);
 
+    // Add all the given nodes as children of this one. This is much more
+    // efficient than calling InsertChild() for each of them, as the children
+    // are sorted at most once (and only if this node is currently open, the
+    // sorting is deferred until it is opened otherwise).
+    void InsertChildren(wxDataViewMainWindow* window,
+                        const wxDataViewTreeNodes& nodes);
+
+    // Replace the children of this node with the given ones, which must be
+    // in the order corresponding to the model if !keepSortOrder, or still
+    // sorted in the current sort order if keepSortOrder is true (which is
+    // the case if the new children are a subset of the existing ones).
+    //
+    // The nodes no longer present in the list are not deleted by this
+    // function, it is the caller responsibility to do it.
+    void ReplaceChildren(wxDataViewTreeNodes& nodes, bool keepSortOrder)
+    {
+        wxCHECK_RET( m_branchData != nullptr, "leaf node doesn't have children" );
+
+        m_branchData->children.swap(nodes);
+        if ( !keepSortOrder )
+            m_branchData->sortOrder = SortOrder();
+    }
+
     void RemoveChild(unsigned index)
     {
         wxCHECK_RET( m_branchData != nullptr, "leaf node doesn't have children" );
@@ -729,6 +757,8 @@ public:
     // notifications from wxDataViewModel
     bool ItemAdded( const wxDataViewItem &parent, const wxDataViewItem &item );
     bool ItemDeleted( const wxDataViewItem &parent, const wxDataViewItem &item );
+    bool ItemsAdded( const wxDataViewItem &parent, const wxDataViewItemArray &items );
+    bool ItemsDeleted( const wxDataViewItem &parent, const wxDataViewItemArray &items );
     bool ItemChanged( const wxDataViewItem &item )
     {
         return DoItemChanged(item, wxNOT_FOUND);
@@ -738,6 +768,7 @@ public:
     void Resort()
     {
         ClearRowHeightCache();
+        ResetCacheHint();
 
         if (!IsVirtualList())
         {
@@ -863,6 +894,18 @@ public:
     void RefreshRows( unsigned int from, unsigned int to );
     void RefreshRowsAfter( unsigned int firstRow );
 
+    // Cache hints support, see wxDataViewCtrl::SetCacheHintLookAhead().
+    void SetCacheHintLookAhead(unsigned int count)
+    {
+        m_cacheHintLookAhead = count;
+        ResetCacheHint();
+    }
+
+    void ResetCacheHint() { m_cacheHintFrom = m_cacheHintTo = (unsigned)-1; }
+
+    // Can be called from any thread to refresh the given rows later.
+    void OnRowsReady(unsigned int from, unsigned int to);
+
     // returns the colour to be used for drawing the rules
     wxColour GetRuleColour() const
     {
@@ -962,6 +1005,10 @@ private:
 
     int RecalculateCount() const;
 
+    // Update the selection and the current row after inserting the given
+    // number of rows at the given position.
+    void OnRowsInserted(unsigned row, unsigned count);
+
     // Return false only if the event was vetoed by its handler.
     bool SendExpanderEvent(wxEventType type, const wxDataViewItem& item);
 
@@ -1068,6 +1115,30 @@ private:
     wxDataViewRenderer* m_editorRenderer;
 
 private:
+    // Send wxEVT_DATAVIEW_CACHE_HINT for the given rows, possibly extended by
+    // the look ahead, unless the last hint sent already covers them.
+    void SendCacheHint(unsigned int from, unsigned int to);
+
+    // Refresh the rows accumulated by OnRowsReady().
+    void RefreshReadyRows();
+
+    // The number of rows to add on both sides of the rows being painted in
+    // the cache hint events. If it is non-zero, the hints are also coalesced.
+    unsigned int m_cacheHintLookAhead;
+
+    // The range of rows of the last cache hint sent or -1.
+    unsigned int m_cacheHintFrom,
+                 m_cacheHintTo;
+
+    // The range of rows which became ready and need to be refreshed or -1.
+    // It is protected by m_readyRowsCS as it's updated by OnRowsReady()
+    // which can be called from any thread.
+    unsigned int m_readyFrom,
+                 m_readyTo;
+#if wxUSE_THREADS
+    wxCriticalSection m_readyRowsCS;
+#endif // wxUSE_THREADS
+
     wxDECLARE_DYNAMIC_CLASS(wxDataViewMainWindow);
     wxDECLARE_EVENT_TABLE();
 };
@@ -1086,6 +1157,10 @@ public:
         { return m_mainWindow->ItemAdded( parent , item ); }
     virtual bool ItemDeleted( const wxDataViewItem &parent, const wxDataViewItem &item ) override
         { return m_mainWindow->ItemDeleted( parent, item ); }
+    virtual bool ItemsAdded( const wxDataViewItem &parent, const wxDataViewItemArray &items ) override
+        { return m_mainWindow->ItemsAdded( parent, items ); }
+    virtual bool ItemsDeleted( const wxDataViewItem &parent, const wxDataViewItemArray &items ) override
+        { return m_mainWindow->ItemsDeleted( parent, items ); }
     virtual bool ItemChanged( const wxDataViewItem & item ) override
         { return m_mainWindow->ItemChanged(item);  }
     virtual bool ValueChanged( const wxDataViewItem & item , unsigned int col ) override
@@ -1928,6 +2003,49 @@ void wxDataViewTreeNode::InsertChild(wxDataViewMainWindow* window,
     }
 }
 
+void wxDataViewTreeNode::InsertChildren(wxDataViewMainWindow* window,
+                                        const wxDataViewTreeNodes& nodes)
+{
+    if ( nodes.empty() )
+        return;
+
+    if (!m_branchData)
+        m_branchData = new BranchNodeData;
+
+    wxDataViewTreeNodes& children = m_branchData->children;
+    const size_t oldCount = children.size();
+
+    children.reserve(oldCount + nodes.size());
+    children.insert(children.end(), nodes.begin(), nodes.end());
+
+    const SortOrder sortOrder = window->GetSortOrder();
+    if ( sortOrder.IsNone() || !m_branchData->open )
+    {
+        // Either we don't need to sort at all or we can postpone sorting
+        // until the node is opened, which may never happen, and Resort()
+        // will sort all the children at once then.
+        m_branchData->sortOrder = SortOrder();
+        return;
+    }
+
+    wxGenericTreeModelNodeCmp cmp(window, sortOrder);
+
+    if ( oldCount == 0 || m_branchData->sortOrder != sortOrder )
+    {
+        std::sort(children.begin(), children.end(), cmp);
+    }
+    else
+    {
+        // Existing children are already sorted, so we only need to sort the
+        // new ones and merge the two sorted ranges, which is linear.
+        const wxDataViewTreeNodes::iterator middle = children.begin() + oldCount;
+        std::sort(middle, children.end(), cmp);
+        std::inplace_merge(children.begin(), middle, children.end(), cmp);
+    }
+
+    m_branchData->sortOrder = sortOrder;
+}
+
 
 void wxDataViewTreeNode::Resort(wxDataViewMainWindow* window)
 {
@@ -1948,8 +2066,11 @@ void wxDataViewTreeNode::Resort(wxDataViewMainWindow* window)
         // using model-specific sort order, which can change at any time.
         if ( m_branchData->sortOrder != sortOrder || !sortOrder.UsesColumn() )
         {
-            std::sort(m_branchData->children.begin(),
-                      m_branchData->children.end(),
+            // Note that we can't just reverse the children when only the sort
+            // direction changes: the model Compare() doesn't have to be
+            // symmetric, e.g. wxDataViewTreeStore always puts the containers
+            // before the leaves, whatever the sort direction.
+            std::sort(nodes.begin(), nodes.end(),
                       wxGenericTreeModelNodeCmp(window, sortOrder));
 
             m_branchData->sortOrder = sortOrder;
@@ -2102,6 +2223,11 @@ wxDataViewMainWindow::wxDataViewMainWindow( wxDataViewCtrl *parent, wxWindowID i
     m_useCellFocus = false;
     m_currentRow = (unsigned)-1;
     m_lineHeight = GetDefaultRowHeight();
+
+    m_cacheHintLookAhead = 0;
+    ResetCacheHint();
+    m_readyFrom =
+    m_readyTo = (unsigned)-1;
     if (GetOwner()->HasFlag(wxDV_VARIABLE_LINE_HEIGHT))
     {
         m_rowHeightCache = new HeightCache();
@@ -2543,10 +2669,7 @@ void wxDataViewMainWindow::OnPaint( wxPaintEvent &WXUNUSED(event) )
             (int)(GetRowCount( ) - item_start));
     unsigned int item_last = item_start + item_count;
 
-    // Send the event to wxDataViewCtrl itself.
-    wxDataViewEvent cache_event(wxEVT_DATAVIEW_CACHE_HINT, m_owner, nullptr);
-    cache_event.SetCache(item_start, item_last - 1);
-    m_owner->ProcessWindowEvent(cache_event);
+    SendCacheHint(item_start, item_last - 1);
 
     // compute which columns needs to be redrawn
     unsigned int cols = GetOwner()->GetColumnCount();
@@ -3108,6 +3231,9 @@ bool wxDataViewMainWindow::ItemAdded(const wxDataViewItem & parent, const wxData
         wxDataViewVirtualListModel *list_model =
             (wxDataViewVirtualListModel*) GetModel();
         m_count = list_model->GetCount();
+
+        // The rows after the new one were shifted.
+        ResetCacheHint();
     }
     else
     {
@@ -3208,7 +3334,7 @@ bool wxDataViewMainWindow::ItemAdded(const wxDataViewItem & parent, const wxData
         InvalidateCount();
     }
 
-    m_selection.OnItemsInserted(GetRowByItem(item), 1);
+    OnRowsInserted(GetRowByItem(item), 1);
 
     GetOwner()->InvalidateColBestWidths();
     UpdateDisplay();
@@ -3216,6 +3342,15 @@ bool wxDataViewMainWindow::ItemAdded(const wxDataViewItem & parent, const wxData
     return true;
 }
 
+void wxDataViewMainWindow::OnRowsInserted(unsigned row, unsigned count)
+{
+    m_selection.OnItemsInserted(row, count);
+
+    // The current item remains the same, but its row may have changed.
+    if ( HasCurrentRow() && row != (unsigned)-1 && m_currentRow >= row )
+        ChangeCurrentRow(m_currentRow + count);
+}
+
 bool wxDataViewMainWindow::ItemDeleted(const wxDataViewItem& parent,
                                        const wxDataViewItem& item)
 {
@@ -3225,6 +3360,8 @@ bool wxDataViewMainWindow::ItemDeleted(const wxDataViewItem& parent,
             (wxDataViewVirtualListModel*) GetModel();
         m_count = list_model->GetCount();
 
+        ResetCacheHint();
+
         m_selection.OnItemDelete(GetRowByItem(item));
     }
     else // general case
@@ -3339,6 +3476,283 @@ bool wxDataViewMainWindow::ItemDeleted(const wxDataViewItem& parent,
     return true;
 }
 
+bool wxDataViewMainWindow::ItemsAdded(const wxDataViewItem& parent,
+                                      const wxDataViewItemArray& items)
+{
+    // Adding items to a virtual list only updates the items count, so there
+    // is nothing to optimize, and there is no gain for a single item neither.
+    if ( IsVirtualList() || items.size() < 2 )
+    {
+        for ( size_t n = 0; n < items.size(); n++ )
+        {
+            if ( !ItemAdded(parent, items[n]) )
+                return false;
+        }
+
+        return true;
+    }
+
+    // specific positions (rows) are unclear, so clear whole height cache
+    ClearRowHeightCache();
+
+    const FindNodeResult findResult = FindNode(parent);
+    wxDataViewTreeNode *parentNode = findResult.m_node;
+
+    // The checks below are the same as in ItemAdded(), see the comments there.
+    if ( !findResult.m_subtreeRealized )
+        return true;
+
+    if ( !parentNode )
+        return false;
+
+    if ( !parentNode->HasChildren() )
+    {
+        parentNode->SetHasChildren(true);
+        return true;
+    }
+
+    if ( !parentNode->IsOpen() && parentNode->GetChildNodes().empty() )
+        return true;
+
+    wxDataViewModel * const model = GetModel();
+
+    wxDataViewTreeNodes newNodes;
+    newNodes.reserve(items.size());
+
+    std::unordered_set<const wxDataViewTreeNode*> newNodesSet;
+    for ( size_t n = 0; n < items.size(); n++ )
+    {
+        wxDataViewTreeNode *itemNode = new wxDataViewTreeNode(parentNode, items[n]);
+        itemNode->SetHasChildren(model->IsContainer(items[n]));
+
+        newNodes.push_back(itemNode);
+        newNodesSet.insert(itemNode);
+    }
+
+    if ( GetSortOrder().IsNone() )
+    {
+        // Without sorting the children must be in the same order as in the
+        // model, so merge the new nodes with the existing ones in a single
+        // pass over the model children instead of looking for the position
+        // of each of them separately, as ItemAdded() does.
+        const wxDataViewTreeNodes& oldNodes = parentNode->GetChildNodes();
+
+        std::unordered_map<void*, wxDataViewTreeNode*> nodesByItem;
+        nodesByItem.reserve(oldNodes.size() + newNodes.size());
+        for ( size_t n = 0; n < oldNodes.size(); n++ )
+            nodesByItem[oldNodes[n]->GetItem().GetID()] = oldNodes[n];
+        for ( size_t n = 0; n < newNodes.size(); n++ )
+            nodesByItem[newNodes[n]->GetItem().GetID()] = newNodes[n];
+
+        wxDataViewItemArray modelChildren;
+        model->GetChildren(parent, modelChildren);
+
+        wxDataViewTreeNodes children;
+        children.reserve(nodesByItem.size());
+        for ( size_t n = 0; n < modelChildren.size(); n++ )
+        {
+            const auto it = nodesByItem.find(modelChildren[n].GetID());
+            if ( it == nodesByItem.end() )
+            {
+                // This can be the case for the items added to the model but
+                // for which we haven't been notified yet.
+                continue;
+            }
+
+            children.push_back(it->second);
+            nodesByItem.erase(it);
+        }
+
+        // This is not supposed to happen, but don't lose any nodes we may have
+        // and which are not in the model, just append them at the end.
+        if ( !nodesByItem.empty() )
+        {
+            wxFAIL_MSG( "adding non-existent item?" );
+
+            for ( size_t n = 0; n < oldNodes.size(); n++ )
+            {
+                if ( nodesByItem.count(oldNodes[n]->GetItem().GetID()) )
+                    children.push_back(oldNodes[n]);
+            }
+
+            for ( size_t n = 0; n < newNodes.size(); n++ )
+            {
+                if ( nodesByItem.count(newNodes[n]->GetItem().GetID()) )
+                    children.push_back(newNodes[n]);
+            }
+        }
+
+        parentNode->ReplaceChildren(children, false /* not sorted */);
+    }
+    else
+    {
+        parentNode->InsertChildren(this, newNodes);
+    }
+
+    parentNode->ChangeSubTreeCount(+static_cast<int>(newNodes.size()));
+
+    InvalidateCount();
+
+    // Update the selection and the current row if the new items are visible.
+    // Notice that we need to do it in the order of increasing row indices, as
+    // the rows above the current one must be already accounted for, and we
+    // can handle all consecutive new rows at once.
+    const int parentRow = parentNode == m_root ? -1 : GetRowByItem(parent);
+    if ( parentNode->IsOpen() && (parentNode == m_root || parentRow != -1) )
+    {
+        const wxDataViewTreeNodes& children = parentNode->GetChildNodes();
+
+        unsigned row = parentRow + 1;
+        unsigned runStart = 0,
+                 runLength = 0;
+        for ( size_t n = 0; n < children.size(); n++ )
+        {
+            if ( newNodesSet.count(children[n]) )
+            {
+                if ( !runLength )
+                    runStart = row;
+
+                runLength++;
+            }
+            else if ( runLength )
+            {
+                OnRowsInserted(runStart, runLength);
+                runLength = 0;
+            }
+
+            row += 1 + children[n]->GetSubTreeCount();
+        }
+
+        if ( runLength )
+            OnRowsInserted(runStart, runLength);
+    }
+
+    GetOwner()->InvalidateColBestWidths();
+    UpdateDisplay();
+
+    return true;
+}
+
+bool wxDataViewMainWindow::ItemsDeleted(const wxDataViewItem& parent,
+                                        const wxDataViewItemArray& items)
+{
+    if ( IsVirtualList() || items.size() < 2 )
+    {
+        for ( size_t n = 0; n < items.size(); n++ )
+        {
+            if ( !ItemDeleted(parent, items[n]) )
+                return false;
+        }
+
+        return true;
+    }
+
+    const FindNodeResult findResult = FindNode(parent);
+    wxDataViewTreeNode *parentNode = findResult.m_node;
+
+    // See the comments in ItemDeleted() for the explanation of these checks.
+    if ( !findResult.m_subtreeRealized )
+        return true;
+
+    if ( !parentNode )
+        return true;
+
+    wxCHECK_MSG( parentNode->HasChildren(), false, "parent node doesn't have children?" );
+
+    std::unordered_set<void*> deletedItems;
+    deletedItems.reserve(items.size());
+    for ( size_t n = 0; n < items.size(); n++ )
+        deletedItems.insert(items[n].GetID());
+
+    const int parentRow = parentNode == m_root ? -1 : GetRowByItem(parent);
+    const bool isVisible = parentNode->IsOpen() &&
+                                (parentNode == m_root || parentRow != -1);
+
+    // Partition the children into the remaining and deleted ones in a single
+    // pass, remembering the rows occupied by the deleted subtrees.
+    const wxDataViewTreeNodes& children = parentNode->GetChildNodes();
+
+    wxDataViewTreeNodes remainingNodes,
+                        deletedNodes;
+    remainingNodes.reserve(children.size());
+
+    wxVector< std::pair<unsigned, unsigned> > deletedRows;
+    int countDeletedRows = 0;
+
+    unsigned row = parentRow + 1;
+    for ( size_t n = 0; n < children.size(); n++ )
+    {
+        wxDataViewTreeNode* const node = children[n];
+        const unsigned rows = 1 + node->GetSubTreeCount();
+
+        if ( deletedItems.count(node->GetItem().GetID()) )
+        {
+            deletedNodes.push_back(node);
+            deletedRows.push_back(std::make_pair(row, rows));
+            countDeletedRows += rows;
+        }
+        else
+        {
+            remainingNodes.push_back(node);
+        }
+
+        row += rows;
+    }
+
+    if ( !deletedNodes.empty() )
+    {
+        if ( m_rowHeightCache )
+        {
+            if ( isVisible )
+                m_rowHeightCache->Remove(deletedRows[0].first);
+            else
+                ClearRowHeightCache();
+        }
+
+        // Removing some children doesn't change the order of the remaining
+        // ones, so they're still sorted if they were.
+        parentNode->ReplaceChildren(remainingNodes, true /* still sorted */);
+
+        for ( size_t n = 0; n < deletedNodes.size(); n++ )
+            delete deletedNodes[n];
+
+        parentNode->ChangeSubTreeCount(-countDeletedRows);
+
+        InvalidateCount();
+    }
+
+    // If the last child was removed, the parent node may have become a leaf.
+    if ( parentNode->GetChildNodes().empty() )
+    {
+        bool isContainer = GetModel()->IsContainer(parent);
+        parentNode->SetHasChildren(isContainer);
+        if ( isContainer && parentNode->IsOpen() && !deletedNodes.empty() )
+            parentNode->ToggleOpen(this);
+    }
+
+    if ( deletedNodes.empty() )
+        return true;
+
+    // Update the selection starting from the last deleted row, so that the
+    // indices of the previous ones are not affected.
+    if ( isVisible && !m_selection.IsEmpty() )
+    {
+        for ( size_t n = deletedRows.size(); n > 0; n-- )
+        {
+            m_selection.OnItemsDeleted(deletedRows[n - 1].first,
+                                       deletedRows[n - 1].second);
+        }
+    }
+
+    if ( HasCurrentRow() && m_currentRow >= GetRowCount() )
+        ChangeCurrentRow(m_count - 1);
+
+    GetOwner()->InvalidateColBestWidths();
+    UpdateDisplay();
+
+    return true;
+}
+
 bool wxDataViewMainWindow::DoItemChanged(const wxDataViewItem & item, int view_column)
 {
     if ( !IsVirtualList() )
@@ -3399,6 +3813,8 @@ bool wxDataViewMainWindow::Cleared()
     m_selection.Clear();
     m_currentRow = (unsigned)-1;
 
+    ResetCacheHint();
+
     ClearRowHeightCache();
 
     if (GetModel())
@@ -3705,6 +4121,83 @@ void wxDataViewMainWindow::RefreshRows( unsigned int from, unsigned int to )
         Refresh( true, &intersect_rect );
 }
 
+void wxDataViewMainWindow::SendCacheHint(unsigned int from, unsigned int to)
+{
+    if ( m_cacheHintLookAhead )
+    {
+        // Avoid sending the same hint again and again while scrolling inside
+        // the range of the previous one.
+        if ( m_cacheHintFrom != (unsigned)-1 &&
+                from >= m_cacheHintFrom && to <= m_cacheHintTo )
+            return;
+
+        from = from > m_cacheHintLookAhead ? from - m_cacheHintLookAhead : 0;
+
+        const unsigned int count = GetRowCount();
+        to = count - to > m_cacheHintLookAhead ? to + m_cacheHintLookAhead
+                                               : count - 1;
+
+        m_cacheHintFrom = from;
+        m_cacheHintTo = to;
+    }
+
+    // Send the event to wxDataViewCtrl itself.
+    wxDataViewEvent cache_event(wxEVT_DATAVIEW_CACHE_HINT, m_owner, nullptr);
+    cache_event.SetCache(from, to);
+    m_owner->ProcessWindowEvent(cache_event);
+}
+
+void wxDataViewMainWindow::OnRowsReady(unsigned int from, unsigned int to)
+{
+    bool needToSchedule;
+
+    {
+#if wxUSE_THREADS
+        wxCriticalSectionLocker lock(m_readyRowsCS);
+#endif // wxUSE_THREADS
+
+        // Merge the notifications received before the rows are refreshed.
+        needToSchedule = m_readyFrom == (unsigned)-1;
+        if ( needToSchedule )
+        {
+            m_readyFrom = from;
+            m_readyTo = to;
+        }
+        else
+        {
+            m_readyFrom = wxMin(m_readyFrom, from);
+            m_readyTo = wxMax(m_readyTo, to);
+        }
+    }
+
+    if ( needToSchedule )
+        CallAfter(&wxDataViewMainWindow::RefreshReadyRows);
+}
+
+void wxDataViewMainWindow::RefreshReadyRows()
+{
+    unsigned int from, to;
+
+    {
+#if wxUSE_THREADS
+        wxCriticalSectionLocker lock(m_readyRowsCS);
+#endif // wxUSE_THREADS
+
+        from = m_readyFrom;
+        to = m_readyTo;
+
+        m_readyFrom =
+        m_readyTo = (unsigned)-1;
+    }
+
+    // Rows could have been deleted in the meanwhile.
+    const unsigned int count = GetRowCount();
+    if ( from >= count )
+        return;
+
+    RefreshRows(from, wxMin(to, count - 1));
+}
+
 void wxDataViewMainWindow::RefreshRowsAfter( unsigned int firstRow )
 {
     wxSize client_size = GetClientSize();
@@ -4426,6 +4919,8 @@ static void BuildTreeHelper( wxDataViewMainWindow *window, const wxDataViewModel
     wxDataViewItemArray children;
     unsigned int num = model->GetChildren( item, children);
 
+    wxDataViewTreeNodes nodes;
+    nodes.reserve(num);
     for ( unsigned int index = 0; index < num; index++ )
     {
         wxDataViewTreeNode *n = new wxDataViewTreeNode(node, children[index]);
@@ -4433,9 +4928,13 @@ static void BuildTreeHelper( wxDataViewMainWindow *window, const wxDataViewModel
         if( model->IsContainer(children[index]) )
             n->SetHasChildren( true );
 
-        node->InsertChild(window, n, index);
+        nodes.push_back(n);
     }
 
+    // Inserting all children at once ensures that they're sorted only once,
+    // instead of looking for the insertion position of each of them.
+    node->InsertChildren(window, nodes);
+
     if ( node->IsOpen() )
         node->ChangeSubTreeCount(+num);
 }
@@ -5694,6 +6193,18 @@ wxHeaderCtrl* wxDataViewCtrl::GenericGetHeader() const
     return m_headerArea;
 }
 
+void wxDataViewCtrl::SetCacheHintLookAhead(unsigned int count)
+{
+    m_clientArea->SetCacheHintLookAhead(count);
+}
+
+void wxDataViewCtrl::NotifyRowsReady(unsigned int from, unsigned int to)
+{
+    wxCHECK_RET( from <= to, "invalid range of ready rows" );
+
+    m_clientArea->OnRowsReady(from, to);
+}
+
 #ifdef __WXMSW__
 WXLRESULT wxDataViewCtrl::MSWWindowProc(WXUINT nMsg,
                                         WXWPARAM wParam,
@@ -40,6 +40,8 @@
 #include "wx/generic/private/listctrl.h"
 #include "wx/generic/private/widthcalc.h"
 
+#include <unordered_map>
+
 #ifdef __WXMAC__
     #include "wx/osx/private.h"
 #endif
@@ -92,27 +94,125 @@ static const int HEADER_IMAGE_MARGIN_IN_REPORT_MODE = 2;
 static const int MARGIN_AROUND_CHECKBOX = 5;
 
 // ----------------------------------------------------------------------------
-// wxListItemData
+// private functions
+// ----------------------------------------------------------------------------
+
+// Return true if the text starts with (or is equal to, if partial is false)
+// the given string, which must be already in lower case, while ignoring the
+// case of the text itself. This is similar to text.Lower().StartsWith(str) but
+// avoids allocating a new string, which is important when searching a control
+// with many items.
+static bool
+MatchesNoCase(const wxString& text, const wxString& strLower, bool partial)
+{
+    wxString::const_iterator it = text.begin();
+    const wxString::const_iterator end = text.end();
+    for ( wxString::const_iterator
+            itStr = strLower.begin(); itStr != strLower.end();
+            ++itStr, ++it )
+    {
+        if ( it == end || wxTolower(*it) != *itStr )
+            return false;
+    }
+
+    return partial || it == end;
+}
+
 // ----------------------------------------------------------------------------
+// pools of items text and attributes
+// ----------------------------------------------------------------------------
+
+// Many items, especially the ones in the same column, have the same text or
+// attributes, so each distinct value is stored only once in the pools below,
+// shared by all the controls, and the items just point to it. The values are
+// reference counted and removed from the pool when they're not used by any
+// item any more.
+//
+// Notice that the pools are only used from the main thread, so they don't
+// need to be protected by a lock.
+
+namespace
+{
+
+// The attributes are hashed using their colours only, as they're much more
+// commonly used than the fonts, which are only compared for equality.
+struct wxItemAttrHash
+{
+    size_t operator()(const wxItemAttr& attr) const
+    {
+        size_t hash = attr.HasFont();
+        if ( attr.HasTextColour() )
+            hash = hash*31 + attr.GetTextColour().GetRGBA();
+        if ( attr.HasBackgroundColour() )
+            hash = hash*31 + attr.GetBackgroundColour().GetRGBA();
 
-wxListItemData::wxListItemData(wxListItemData&& other)
+        return hash;
+    }
+};
+
+template <typename T, typename Hash = std::hash<T>>
+class wxListValuesPool
 {
-    m_owner = other.m_owner;
+public:
+    // Return the pointer to the pooled value equal to the given one, which
+    // remains valid until it's passed to Release().
+    const T* Acquire(const T& value)
+    {
+        typename Values::iterator it = m_values.find(value);
+        if ( it == m_values.end() )
+            it = m_values.emplace(value, 0).first;
+
+        it->second++;
+
+        return &it->first;
+    }
+
+    void Release(const T* value)
+    {
+        const typename Values::iterator it = m_values.find(*value);
+        wxCHECK_RET( it != m_values.end(), "releasing unknown value" );
+
+        if ( !--it->second )
+            m_values.erase(it);
+    }
+
+private:
+    // Map the values to the number of items using them.
+    using Values = std::unordered_map<T, unsigned, Hash>;
+    Values m_values;
+};
+
+wxListValuesPool<wxString> gs_textPool;
+wxListValuesPool<wxItemAttr, wxItemAttrHash> gs_attrPool;
+
+} // anonymous namespace
 
+// ----------------------------------------------------------------------------
+// wxListItemData
+// ----------------------------------------------------------------------------
+
+wxListItemData::wxListItemData(wxListItemData&& other) noexcept
+    : m_image(other.m_image),
+      m_ownsAttr(other.m_ownsAttr),
+      m_data(other.m_data)
+{
     // Take ownership of the pointers from the other object and reset them.
     std::swap(m_attr, other.m_attr);
     std::swap(m_rect, other.m_rect);
+    std::swap(m_text, other.m_text);
 }
 
-wxListItemData& wxListItemData::operator=(wxListItemData&& other)
+wxListItemData& wxListItemData::operator=(wxListItemData&& other) noexcept
 {
     m_image = other.m_image;
     m_data = other.m_data;
-    m_owner = other.m_owner;
 
-    // Swap them to let our pointers be deleted by the other object if necessary.
+    // Swap them to let our pointers be released by the other object if
+    // necessary, which is why the ownership flag must be swapped too.
+    std::swap(m_ownsAttr, other.m_ownsAttr);
     std::swap(m_attr, other.m_attr);
     std::swap(m_rect, other.m_rect);
+    std::swap(m_text, other.m_text);
 
     return *this;
 }
@@ -120,16 +220,38 @@ wxListItemData& wxListItemData::operator=(wxListItemData&& other)
 wxListItemData::~wxListItemData()
 {
     // in the virtual list control the attributes are managed by the main
-    // program, so don't delete them
-    if ( !m_owner->IsVirtual() )
-        delete m_attr;
+    // program, so don't release them
+    if ( m_ownsAttr && m_attr )
+        gs_attrPool.Release(m_attr);
+
+    if ( m_text )
+        gs_textPool.Release(m_text);
 
     delete m_rect;
 }
 
+const wxString& wxListItemData::GetText() const
+{
+    static const wxString s_empty;
+
+    return m_text ? *m_text : s_empty;
+}
+
+void wxListItemData::SetText(const wxString& text)
+{
+    if ( text == GetText() )
+        return;
+
+    const wxString* const textOld = m_text;
+    m_text = text.empty() ? nullptr : gs_textPool.Acquire(text);
+
+    if ( textOld )
+        gs_textPool.Release(textOld);
+}
+
 wxListItemData::wxListItemData(wxListMainWindow *owner)
 {
-    m_owner = owner;
+    m_ownsAttr = !owner->IsVirtual();
 
     if ( !owner->InReportView() )
         m_rect = new wxRect;
@@ -161,12 +283,20 @@ void wxListItemData::SetItem( const wxListItem &info )
     if ( info.m_mask & wxLIST_MASK_DATA )
         m_data = info.m_data;
 
-    if ( info.HasAttributes() )
+    // in the virtual list control the attributes are returned by
+    // OnGetItemAttr() and can't be changed using SetItem()
+    if ( info.HasAttributes() && m_ownsAttr )
     {
+        wxItemAttr attr;
         if ( m_attr )
-            m_attr->AssignFrom(*info.GetAttributes());
-        else
-            m_attr = new wxItemAttr(*info.GetAttributes());
+            attr = *m_attr;
+        attr.AssignFrom(*info.GetAttributes());
+
+        const wxItemAttr* const attrOld = m_attr;
+        m_attr = gs_attrPool.Acquire(attr);
+
+        if ( attrOld )
+            gs_attrPool.Release(attrOld);
     }
 
     if ( m_rect )
@@ -239,7 +369,7 @@ void wxListItemData::GetItem( wxListItem &info ) const
         mask = -1;
 
     if ( mask & wxLIST_MASK_TEXT )
-        info.m_text = m_text;
+        info.m_text = GetText();
     if ( mask & wxLIST_MASK_IMAGE )
         info.m_image = m_image;
     if ( mask & wxLIST_MASK_DATA )
@@ -586,6 +716,7 @@ void wxListLineData::SetPosition( int x, int y, int WXUNUSED(spacing) )
 
 void wxListLineData::InitItems( int num )
 {
+    m_items.reserve( num );
     for (int i = 0; i < num; i++)
         m_items.emplace_back( m_owner );
 }
@@ -620,12 +751,12 @@ int wxListLineData::GetImage( int index ) const
     return m_items.at(index).GetImage();
 }
 
-wxItemAttr *wxListLineData::GetAttr() const
+const wxItemAttr *wxListLineData::GetAttr() const
 {
     return m_items.at(0).GetAttr();
 }
 
-void wxListLineData::SetAttr(wxItemAttr *attr)
+void wxListLineData::SetAttr(const wxItemAttr *attr)
 {
     m_items.at(0).SetAttr(attr);
 }
@@ -1554,6 +1685,12 @@ void wxListMainWindow::Init()
 
     m_hasCheckBoxes = false;
     m_extendRulesAndAlternateColour = false;
+
+    m_cacheHintLookAhead = 0;
+    ResetCacheHint();
+
+    m_readyFrom =
+    m_readyTo = (size_t)-1;
 }
 
 wxListMainWindow::wxListMainWindow()
@@ -1969,6 +2106,99 @@ void wxListMainWindow::RefreshAfter( size_t lineFrom )
     }
 }
 
+void wxListMainWindow::SendCacheHint(size_t visibleFrom, size_t visibleTo)
+{
+    size_t hintFrom = visibleFrom,
+           hintTo = visibleTo;
+
+    if ( m_cacheHintLookAhead )
+    {
+        // Don't send the same hint again if the visible lines are still
+        // covered by the previous one, which happens most of the time when
+        // scrolling by a few lines.
+        if ( m_cacheHintFrom != (size_t)-1 &&
+                visibleFrom >= m_cacheHintFrom && visibleTo <= m_cacheHintTo )
+            return;
+
+        hintFrom = visibleFrom > m_cacheHintLookAhead
+                    ? visibleFrom - m_cacheHintLookAhead
+                    : 0;
+
+        const size_t count = GetItemCount();
+        hintTo = count - visibleTo > m_cacheHintLookAhead
+                    ? visibleTo + m_cacheHintLookAhead
+                    : count - 1;
+
+        m_cacheHintFrom = hintFrom;
+        m_cacheHintTo = hintTo;
+    }
+
+    wxListEvent evCache(wxEVT_LIST_CACHE_HINT, GetParent()->GetId());
+    evCache.SetEventObject( GetParent() );
+    evCache.m_oldItemIndex = hintFrom;
+    evCache.m_item.m_itemId =
+    evCache.m_itemIndex = hintTo;
+    GetParent()->GetEventHandler()->ProcessEvent( evCache );
+}
+
+void wxListMainWindow::OnLinesReady(size_t lineFrom, size_t lineTo)
+{
+    bool needToSchedule;
+
+    {
+#if wxUSE_THREADS
+        wxCriticalSectionLocker lock(m_readyLinesCS);
+#endif // wxUSE_THREADS
+
+        // Merge all notifications received before we get to refreshing the
+        // lines, there is no need to refresh them more than once.
+        needToSchedule = m_readyFrom == (size_t)-1;
+        if ( needToSchedule )
+        {
+            m_readyFrom = lineFrom;
+            m_readyTo = lineTo;
+        }
+        else
+        {
+            if ( lineFrom < m_readyFrom )
+                m_readyFrom = lineFrom;
+            if ( lineTo > m_readyTo )
+                m_readyTo = lineTo;
+        }
+    }
+
+    // CallAfter() is thread-safe, unlike refreshing the window directly.
+    if ( needToSchedule )
+        CallAfter(&wxListMainWindow::RefreshReadyLines);
+}
+
+void wxListMainWindow::RefreshReadyLines()
+{
+    size_t lineFrom, lineTo;
+
+    {
+#if wxUSE_THREADS
+        wxCriticalSectionLocker lock(m_readyLinesCS);
+#endif // wxUSE_THREADS
+
+        lineFrom = m_readyFrom;
+        lineTo = m_readyTo;
+
+        m_readyFrom =
+        m_readyTo = (size_t)-1;
+    }
+
+    // The number of items could have changed since the notification.
+    const size_t count = GetItemCount();
+    if ( lineFrom >= count )
+        return;
+
+    if ( lineTo >= count )
+        lineTo = count - 1;
+
+    RefreshLines(lineFrom, lineTo);
+}
+
 void wxListMainWindow::RefreshSelected()
 {
     if ( IsEmpty() )
@@ -2058,15 +2288,7 @@ void wxListMainWindow::OnPaint( wxPaintEvent &WXUNUSED(event) )
 
         // tell the caller cache to cache the data
         if ( IsVirtual() )
-        {
-            wxListEvent evCache(wxEVT_LIST_CACHE_HINT,
-                                GetParent()->GetId());
-            evCache.SetEventObject( GetParent() );
-            evCache.m_oldItemIndex = visibleFrom;
-            evCache.m_item.m_itemId =
-            evCache.m_itemIndex = visibleTo;
-            GetParent()->GetEventHandler()->ProcessEvent( evCache );
-        }
+            SendCacheHint(visibleFrom, visibleTo);
 
         for ( size_t line = visibleFrom; line <= visibleEnd; line++ )
         {
@@ -3530,17 +3752,13 @@ void wxListMainWindow::SetItem( wxListItem &item )
         if ( item.m_mask & wxLIST_MASK_STATE )
             SetItemState( item.m_itemId, item.m_state, item.m_state );
 
-        if (InReportView())
+        // Don't measure the item here, as this requires creating a DC and
+        // is too slow when setting many items, just invalidate the cached
+        // column width and let it be recomputed when it's really needed.
+        if ( InReportView() &&
+                (item.m_mask & (wxLIST_MASK_TEXT | wxLIST_MASK_IMAGE)) )
         {
-            //  update the Max Width Cache if needed
-            int width = GetItemWidthWithImage(&item);
-
-            wxColWidthInfo& widthInfo = m_aColWidths.at(item.m_col);
-            if ( width > widthInfo.nMaxWidth )
-            {
-                widthInfo.nMaxWidth = width;
-                widthInfo.bNeedsUpdate = true;
-            }
+            m_aColWidths.at(item.m_col).bNeedsUpdate = true;
         }
     }
 
@@ -3753,6 +3971,7 @@ void wxListMainWindow::SetItemCount(long count)
     m_countVirt = count;
 
     ResetVisibleLinesRange();
+    ResetCacheHint();
 
     // scrollbars must be reset
     m_dirty = true;
@@ -4276,23 +4495,12 @@ void wxListMainWindow::DeleteItem( long lindex )
 
     if ( InReportView() )
     {
-        //  mark the Column Max Width cache as dirty if the items in the line
-        //  we're deleting contain the Max Column Width
-        wxListLineData * const line = GetLine(index);
-        wxListItem      item;
-
-        size_t i = 0;
-        for ( const auto& it : line->m_items )
-        {
-            it.GetItem(item);
-
-            int itemWidth;
-            itemWidth = GetItemWidthWithImage(&item);
-
-            wxColWidthInfo& widthInfo = m_aColWidths.at(i++);
-            if ( itemWidth >= widthInfo.nMaxWidth )
-                widthInfo.bNeedsUpdate = true;
-        }
+        //  mark the Column Max Width cache as dirty as the line we're
+        //  deleting could have contained the widest item: checking whether
+        //  it really did would require measuring all of its items, which is
+        //  more expensive than recomputing the width lazily if necessary
+        for ( auto& widthInfo : m_aColWidths )
+            widthInfo.bNeedsUpdate = true;
 
         ResetVisibleLinesRange();
     }
@@ -4393,6 +4601,7 @@ void wxListMainWindow::DoDeleteAllItems()
     {
         m_countVirt = 0;
         m_selStore.Clear();
+        ResetCacheHint();
     }
     else
     {
@@ -4443,25 +4652,15 @@ long wxListMainWindow::FindItem(long start, const wxString& str, bool partial )
         return wxNOT_FOUND;
 
     long pos = start;
-    wxString str_upper = str.Upper();
+    const wxString str_lower = str.Lower();
     if (pos < 0)
         pos = 0;
 
     size_t count = GetItemCount();
     for ( size_t i = (size_t)pos; i < count; i++ )
     {
-        wxListLineData *line = GetLine(i);
-        wxString line_upper = line->GetText(0).Upper();
-        if (!partial)
-        {
-            if (line_upper == str_upper )
-                return i;
-        }
-        else
-        {
-            if (line_upper.find(str_upper) == 0)
-                return i;
-        }
+        if ( LineMatches(i, str_lower, partial) )
+            return i;
     }
 
     return wxNOT_FOUND;
@@ -4476,10 +4675,8 @@ long wxListMainWindow::FindItem(long start, wxUIntPtr data)
     size_t count = GetItemCount();
     for (size_t i = (size_t)pos; i < count; i++)
     {
-        wxListLineData *line = GetLine(i);
-        wxListItem item;
-        line->GetItem( 0, item );
-        if (item.m_data == data)
+        // don't use GetItem() here to avoid copying the item text
+        if (GetLine(i)->m_items[0].m_data == data)
             return i;
     }
 
@@ -4559,15 +4756,10 @@ void wxListMainWindow::InsertItem( wxListItem &item )
         const unsigned col = item.GetColumn();
         wxCHECK_RET( col < m_aColWidths.size(), "invalid item column" );
 
-        // calculate the width of the item and adjust the max column width
-        wxColWidthInfo& widthInfo = m_aColWidths[col];
-        int width = GetItemWidthWithImage(&item);
-        item.SetWidth(width);
-        if (width > widthInfo.nMaxWidth)
-        {
-            widthInfo.nMaxWidth = width;
-            widthInfo.bNeedsUpdate = true;
-        }
+        // the max column width needs to be recalculated, but do it lazily
+        // instead of measuring every item when it's inserted, as this is
+        // prohibitively slow when adding many items
+        m_aColWidths[col].bNeedsUpdate = true;
     }
 
     wxListLineData line(this);
@@ -4687,12 +4879,10 @@ struct wxListLineComparator
     bool operator()(const wxListLineData& line1,
                     const wxListLineData& line2) const
     {
-        wxListItem item;
-        line1.GetItem( 0, item );
-        wxUIntPtr data1 = item.m_data;
-        line2.GetItem( 0, item );
-        wxUIntPtr data2 = item.m_data;
-        return m_f(data1, data2, m_data) < 0;
+        // Access the item data directly instead of using GetItem() as the
+        // latter copies the item text, which is relatively expensive and is
+        // done O(N log N) times here.
+        return m_f(line1.m_items[0].m_data, line2.m_items[0].m_data, m_data) < 0;
     }
 
     const wxListCtrlCompare m_f;
@@ -4706,7 +4896,12 @@ void wxListMainWindow::SortItems( wxListCtrlCompare fn, wxIntPtr data )
     HighlightAll(false);
     ResetCurrent();
 
-    std::sort(m_lines.begin(), m_lines.end(), wxListLineComparator(fn, data));
+    // Use stable sort to preserve the relative order of the items that
+    // compare equal, which is what users expect when sorting by a column
+    // containing duplicate values. Note that this only moves the lines
+    // themselves, and not the items inside them, so it's relatively cheap.
+    std::stable_sort(m_lines.begin(), m_lines.end(),
+                     wxListLineComparator(fn, data));
 
     m_dirty = true;
 }
@@ -4808,7 +5003,7 @@ wxListMainWindow::PrefixFindItem(size_t idParent,
 
     // look for the item starting with the given prefix after it
     while ( ( itemid < (size_t)GetItemCount() ) &&
-            !GetLine(itemid)->GetText(0).Lower().StartsWith(prefix) )
+            !LineMatches(itemid, prefix, true) )
     {
         itemid += 1;
     }
@@ -4821,7 +5016,7 @@ wxListMainWindow::PrefixFindItem(size_t idParent,
 
         // and try all the items (stop when we get to the one we started from)
         while ( ( itemid < (size_t)GetItemCount() ) && itemid != idParent &&
-                    !GetLine(itemid)->GetText(0).Lower().StartsWith(prefix) )
+                    !LineMatches(itemid, prefix, true) )
         {
             itemid += 1;
         }
@@ -4829,7 +5024,7 @@ wxListMainWindow::PrefixFindItem(size_t idParent,
         // documentation
         if ( !( itemid < (size_t)GetItemCount() ) ||
              ( ( itemid == idParent ) &&
-               !GetLine(itemid)->GetText(0).Lower().StartsWith(prefix) ) )
+               !LineMatches(itemid, prefix, true) ) )
         {
             itemid = (size_t)-1;
         }
@@ -4838,6 +5033,20 @@ wxListMainWindow::PrefixFindItem(size_t idParent,
     return itemid;
 }
 
+bool
+wxListMainWindow::LineMatches(size_t line,
+                              const wxString& strLower,
+                              bool partial) const
+{
+    if ( IsVirtual() )
+    {
+        return MatchesNoCase(GetListCtrl()->OnGetItemText(line, 0),
+                             strLower, partial);
+    }
+
+    return MatchesNoCase(m_lines[line].m_items[0].GetText(), strLower, partial);
+}
+
 // -------------------------------------------------------------------------------------
 // wxGenericListCtrl
 // -------------------------------------------------------------------------------------
@@ -5785,6 +5994,21 @@ void wxGenericListCtrl::RefreshItems(long itemFrom, long itemTo)
     m_mainWin->RefreshLines(itemFrom, itemTo);
 }
 
+void wxGenericListCtrl::SetCacheHintLookAhead(long count)
+{
+    wxCHECK_RET( count >= 0, wxS("invalid cache hint look ahead") );
+
+    m_mainWin->SetCacheHintLookAhead(count);
+}
+
+void wxGenericListCtrl::NotifyItemsReady(long itemFrom, long itemTo)
+{
+    wxCHECK_RET( itemFrom >= 0 && itemFrom <= itemTo,
+                 wxS("invalid range of ready items") );
+
+    m_mainWin->OnLinesReady(itemFrom, itemTo);
+}
+
 void wxGenericListCtrl::EnableBellOnNoMatch( bool on )
 {
     m_mainWin->EnableBellOnNoMatch(on);
@@ -194,14 +194,71 @@ public:
     }
 
     int GetX() const { return m_x; }
-    int GetY() const { return m_y; }
+
+    // the item vertical position is stored relative to its parent, so that
+    // expanding or collapsing an item only needs to update its ancestors
+    int GetY() const
+    {
+        if ( !m_parent )
+            return m_yRel;
+
+        m_parent->UpdateChildrenOffsets(m_indexInParent);
+
+        return m_parent->GetY() + m_yRel;
+    }
 
     void SetX(int x) { m_x = x; }
-    void SetY(int y) { m_y = y; }
+    void SetY(int y) { m_yRel = m_parent ? y - m_parent->GetY() : y; }
+
+    // set the position of this item relative to its parent and its index in
+    // the parent children array, this is done when laying it out
+    void SetRelativeY(size_t index, int y)
+    {
+        m_indexInParent = index;
+        m_yRel = y;
+    }
+
+    size_t GetIndexInParent() const { return m_indexInParent; }
+
+    // mark the offsets of the children starting from the given one as being
+    // out of date, they will be recomputed when they're needed
+    void InvalidateChildrenOffsets(size_t from)
+    {
+        if ( m_numValidOffsets > from )
+            m_numValidOffsets = from;
+    }
+
+    // mark the offsets of all children as up to date
+    void ValidateChildrenOffsets() { m_numValidOffsets = m_children.size(); }
 
     int GetHeight() const { return m_height; }
     int GetWidth() const { return m_width; }
 
+    // the total height of this item and all its visible descendants and the
+    // rightmost coordinate of any of them, as computed during the last layout
+    // (the height is 0 if the item had never been laid out)
+    int GetSubtreeHeight() const { return m_heightSubtree; }
+    int GetSubtreeRight() const { return m_rightSubtree; }
+
+    void SetSubtreeExtent(int height, int right)
+    {
+        m_heightSubtree = height;
+        m_rightSubtree = right;
+    }
+
+    // get the nesting level of this item, the root item has level 0
+    int GetLevel() const
+    {
+        int level = 0;
+        for ( const wxGenericTreeItem* p = m_parent; p; p = p->m_parent )
+            level++;
+        return level;
+    }
+
+    // compute the rightmost coordinate of this item subtree from its own
+    // width and the extents of its children
+    int ComputeSubtreeRight(bool isHiddenRoot) const;
+
     int GetTextHeight() const
     {
         wxASSERT_MSG( m_heightText != -1, "must call CalculateSize() first" );
@@ -343,10 +400,18 @@ private:
     // expanded+selected states
     int                 m_images[wxTreeItemIcon_Max];
 
-    wxCoord             m_x;            // (virtual) offset from top
-    wxCoord             m_y;            // (virtual) offset from left
+    // update the offsets of the children up to the given one if necessary
+    void UpdateChildrenOffsets(size_t upTo) const;
+
+    wxCoord             m_x;            // (virtual) offset from left
+    mutable wxCoord     m_yRel;         // offset from the parent top
+    size_t              m_indexInParent;// index in the parent children
+    mutable size_t      m_numValidOffsets; // number of the children with
+                                           // up to date m_yRel
     int                 m_width;        // width of this item
     int                 m_height;       // height of this item
+    int                 m_heightSubtree;// height of the visible subtree
+    int                 m_rightSubtree; // right edge of the visible subtree
 
     // use bitfields to save size
     unsigned int        m_isCollapsed :1;
@@ -619,7 +684,9 @@ wxGenericTreeItem::wxGenericTreeItem(wxGenericTreeItem *parent,
 
     m_data = data;
     m_state = wxTREE_ITEMSTATE_NONE;
-    m_x = m_y = 0;
+    m_x = m_yRel = 0;
+    m_indexInParent = 0;
+    m_numValidOffsets = 0;
 
     m_isCollapsed = true;
     m_hasHilight = false;
@@ -634,6 +701,8 @@ wxGenericTreeItem::wxGenericTreeItem(wxGenericTreeItem *parent,
     // We don't know the height here yet.
     m_width = 0;
     m_height = 0;
+    m_heightSubtree = 0;
+    m_rightSubtree = 0;
 
     m_widthText = -1;
     m_heightText = -1;
@@ -682,10 +751,58 @@ size_t wxGenericTreeItem::GetChildrenCount(bool recursively) const
     return total;
 }
 
+void wxGenericTreeItem::UpdateChildrenOffsets(size_t upTo) const
+{
+    // the index may be stale if the tree is being modified, in which case the
+    // positions will be recalculated soon anyhow
+    if ( upTo >= m_children.size() )
+        return;
+
+    // the first child offset only depends on this item own height, so it
+    // doesn't change when its siblings subtrees do
+    if ( !m_numValidOffsets )
+        m_numValidOffsets = 1;
+
+    for ( ; m_numValidOffsets <= upTo; ++m_numValidOffsets )
+    {
+        const wxGenericTreeItem* const prev = m_children[m_numValidOffsets - 1];
+        m_children[m_numValidOffsets]->m_yRel = prev->m_yRel +
+                                                    prev->m_heightSubtree;
+    }
+}
+
+int wxGenericTreeItem::ComputeSubtreeRight(bool isHiddenRoot) const
+{
+    int right = isHiddenRoot ? 0 : m_x + m_width;
+
+    if ( IsExpanded() || isHiddenRoot )
+    {
+        const size_t count = m_children.GetCount();
+        for ( size_t n = 0; n < count; ++n )
+        {
+            if ( m_children[n]->m_rightSubtree > right )
+                right = m_children[n]->m_rightSubtree;
+        }
+    }
+
+    return right;
+}
+
 void wxGenericTreeItem::GetSize( int &x, int &y,
                                  const wxGenericTreeCtrl *theButton )
 {
-    int bottomY=m_y+theButton->GetLineHeight(this);
+    // use the cached subtree extent if possible to avoid walking all the items
+    if ( theButton->IsLayoutValid() && m_heightSubtree )
+    {
+        const int bottom = GetY() + m_heightSubtree;
+        if ( y < bottom )
+            y = bottom;
+        if ( x < m_rightSubtree )
+            x = m_rightSubtree;
+        return;
+    }
+
+    int bottomY=GetY()+theButton->GetLineHeight(this);
     if ( y < bottomY )
         y = bottomY;
     int width = m_x +  m_width;
@@ -707,14 +824,16 @@ wxGenericTreeItem *wxGenericTreeItem::HitTest(const wxPoint& point,
                                               int &flags,
                                               int level)
 {
+    const int y = GetY();
+
     // for a hidden root node, don't evaluate it, but do evaluate children
     if ( !(level == 0 && theCtrl->HasFlag(wxTR_HIDE_ROOT)) )
     {
         // evaluate the item
         int h = theCtrl->GetLineHeight(this);
-        if ((point.y > m_y) && (point.y < m_y + h))
+        if ((point.y > y) && (point.y < y + h))
         {
-            int y_mid = m_y + h/2;
+            int y_mid = y + h/2;
             if (point.y < y_mid )
                 flags |= wxTREE_HITTEST_ONITEMUPPERPART;
             else
@@ -791,7 +910,34 @@ wxGenericTreeItem *wxGenericTreeItem::HitTest(const wxPoint& point,
 
     // evaluate children
     size_t count = m_children.GetCount();
-    for ( size_t n = 0; n < count; n++ )
+    size_t n = 0;
+    if ( theCtrl->IsLayoutValid() && count )
+    {
+        // the children are laid out in order, so find the only one which can
+        // contain the point using binary search instead of checking all of
+        // them, which is too slow for items with very many children
+        UpdateChildrenOffsets(count - 1);
+
+        size_t lo = 0,
+               hi = count;
+        while ( lo < hi )
+        {
+            const size_t mid = lo + (hi - lo) / 2;
+            const wxGenericTreeItem* const child = m_children[mid];
+            if ( point.y >= y + child->m_yRel + child->m_heightSubtree )
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+
+        if ( lo == count )
+            return nullptr;
+
+        n = lo;
+        count = lo + 1;
+    }
+
+    for ( ; n < count; n++ )
     {
         wxGenericTreeItem *res = m_children[n]->HitTest( point,
                                                          theCtrl,
@@ -853,6 +999,8 @@ wxGenericTreeItem::DoCalculateSize(wxGenericTreeCtrl* control,
     if ( m_width != 0 ) // Size known, nothing to do
         return;
 
+    const int heightOld = m_height;
+
     if ( m_widthText == -1 )
     {
         bool fontChanged;
@@ -907,9 +1055,39 @@ wxGenericTreeItem::DoCalculateSize(wxGenericTreeCtrl* control,
     m_height += control->FromDIP(2); // See CalculateLineHeight().
 
     if (m_height > control->m_lineHeight)
+    {
         control->m_lineHeight = m_height;
 
+        // the positions of all the items change if they all use this height
+        if ( !control->HasFlag(wxTR_HAS_VARIABLE_ROW_HEIGHT) )
+            control->m_layoutValid = false;
+    }
+
     m_width = state_w + image_w + m_widthText + 2;
+
+    // if this item had been already laid out, check if the cached layout
+    // information is still valid: if the height changed, the positions of all
+    // the following items have to be recomputed, but the width can just be
+    // accounted for by updating the extent of all the subtrees containing it
+    if ( m_heightSubtree )
+    {
+        if ( heightOld != m_height &&
+                control->HasFlag(wxTR_HAS_VARIABLE_ROW_HEIGHT) )
+        {
+            control->m_layoutValid = false;
+        }
+
+        const int right = m_x + m_width;
+        for ( wxGenericTreeItem* item = this; item; item = item->m_parent )
+        {
+            if ( item->m_rightSubtree < right )
+                item->m_rightSubtree = right;
+
+            // collapsed items extent doesn't include their children
+            if ( item->m_parent && !item->m_parent->IsExpanded() )
+                break;
+        }
+    }
 }
 
 void wxGenericTreeItem::RecursiveResetSize()
@@ -962,6 +1140,7 @@ void wxGenericTreeCtrl::Init()
     m_select_me = nullptr;
     m_hasFocus = false;
     m_dirty = false;
+    m_layoutValid = false;
 
     m_lineHeight = 10;
     m_indent = 0;
@@ -1663,7 +1842,16 @@ wxTreeItemId wxGenericTreeCtrl::DoInsertItem(const wxTreeItemId& parentId,
         return AddRoot(text, image, selImage, data);
     }
 
-    m_dirty = true;     // do this first so stuff below doesn't cause flicker
+    // Adding children to a collapsed item doesn't change the positions of any
+    // visible items, so we don't need to recalculate them, which is important
+    // when the children are only added on demand from wxEVT_TREE_ITEM_EXPANDING
+    // handler for the trees with a huge number of items.
+    const bool hidden = !parent->IsExpanded() && IsLayoutValid() &&
+                            !(parent == m_anchor && HasFlag(wxTR_HIDE_ROOT));
+    const bool hadPlus = parent->HasPlus();
+
+    if ( !hidden )
+        m_dirty = true; // do this first so stuff below doesn't cause flicker
 
     wxGenericTreeItem *item =
         new wxGenericTreeItem( parent, text, image, selImage, data );
@@ -1676,6 +1864,10 @@ wxTreeItemId wxGenericTreeCtrl::DoInsertItem(const wxTreeItemId& parentId,
     parent->Insert( item, previous == (size_t)-1 ? parent->GetChildren().size()
                                                  : previous );
 
+    // the parent may need to show the expansion button now
+    if ( hidden && !hadPlus )
+        RefreshLine(parent);
+
     InvalidateBestSize();
     return item;
 }
@@ -1897,7 +2089,7 @@ void wxGenericTreeCtrl::Expand(const wxTreeItemId& itemId)
     item->Expand();
     if ( !IsFrozen() )
     {
-        CalculatePositions();
+        UpdateLayoutOfSubtree(item);
 
         RefreshSubtree(item);
     }
@@ -1947,7 +2139,7 @@ void wxGenericTreeCtrl::Collapse(const wxTreeItemId& itemId)
     }
 #endif
 
-    CalculatePositions();
+    UpdateLayoutOfSubtree(item);
 
     RefreshSubtree(item);
 
@@ -2757,18 +2949,15 @@ wxGenericTreeCtrl::PaintLevel(wxGenericTreeItem *item,
         int count = children.GetCount();
         if (count > 0)
         {
-            int n = 0, oldY;
-            do {
-                oldY = y;
-                PaintLevel(children[n], dc, 1, y);
-            } while (++n < count);
+            int oldY;
+            PaintChildren(item, dc, 1, y, oldY);
 
             if ( !HasFlag(wxTR_NO_LINES) && HasFlag(wxTR_LINES_AT_ROOT)
                     && count > 0 )
             {
                 // draw line down to last child
                 origY += GetLineHeight(children[0])>>1;
-                oldY += GetLineHeight(children[n-1])>>1;
+                oldY += GetLineHeight(children[count-1])>>1;
                 dc.DrawLine(3, origY, 3, oldY);
             }
         }
@@ -2776,7 +2965,10 @@ wxGenericTreeCtrl::PaintLevel(wxGenericTreeItem *item,
     }
 
     item->SetX(x+m_spacing);
-    item->SetY(y);
+
+    // the position is already up to date if the layout is valid
+    if ( !IsLayoutValid() )
+        item->SetY(y);
 
     int h = GetLineHeight(item);
     int y_top = y;
@@ -2896,17 +3088,13 @@ wxGenericTreeCtrl::PaintLevel(wxGenericTreeItem *item,
         int count = children.GetCount();
         if (count > 0)
         {
-            int n = 0, oldY;
-            ++level;
-            do {
-                oldY = y;
-                PaintLevel(children[n], dc, level, y);
-            } while (++n < count);
+            int oldY;
+            PaintChildren(item, dc, level + 1, y, oldY);
 
             if (!HasFlag(wxTR_NO_LINES) && count > 0)
             {
                 // draw line down to last child
-                oldY += GetLineHeight(children[n-1])>>1;
+                oldY += GetLineHeight(children[count-1])>>1;
                 if (HasButtons())
                     y_mid += 5;
 
@@ -2932,6 +3120,71 @@ wxGenericTreeCtrl::PaintLevel(wxGenericTreeItem *item,
     }
 }
 
+void
+wxGenericTreeCtrl::PaintChildren(wxGenericTreeItem *item,
+                                 wxDC& dc,
+                                 int level,
+                                 int& y,
+                                 int& lastY)
+{
+    wxArrayGenericTreeItems& children = item->GetChildren();
+    const size_t count = children.GetCount();
+
+    size_t from = 0,
+           to = count;
+
+    // if the layout is up to date, we only need to paint the children which
+    // are at least partially visible, which can be found using binary search
+    // as they're ordered by their position
+    if ( IsLayoutValid() && children[0]->GetY() == y )
+    {
+        const wxRect rectUpdate = GetUpdateRegion().GetBox();
+        const int yTop = dc.DeviceToLogicalY(rectUpdate.GetTop());
+        const int yBottom = dc.DeviceToLogicalY(rectUpdate.GetBottom() + 1);
+
+        size_t lo = 0,
+               hi = count;
+        while ( lo < hi )
+        {
+            const size_t mid = lo + (hi - lo) / 2;
+            const wxGenericTreeItem* const child = children[mid];
+            if ( child->GetY() + child->GetSubtreeHeight() <= yTop )
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        from = lo;
+
+        hi = count;
+        while ( lo < hi )
+        {
+            const size_t mid = lo + (hi - lo) / 2;
+            if ( children[mid]->GetY() < yBottom )
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        to = lo;
+
+        if ( from < count )
+            y = children[from]->GetY();
+    }
+
+    for ( size_t n = from; n < to; ++n )
+    {
+        lastY = y;
+        PaintLevel(children[n], dc, level, y);
+    }
+
+    // skip the remaining children, if any
+    if ( to < count || from == to )
+    {
+        const wxGenericTreeItem* const last = children[count - 1];
+        lastY = last->GetY();
+        y = lastY + last->GetSubtreeHeight();
+    }
+}
+
 void wxGenericTreeCtrl::DrawDropEffect(wxGenericTreeItem *item)
 {
     if ( item )
@@ -3974,37 +4227,50 @@ wxGenericTreeCtrl::CalculateLevel(wxGenericTreeItem *item,
                                   int level,
                                   int &y )
 {
+    const int yStart = y;
+    int right = 0;
+
     int x = level*m_indent;
     if (!HasFlag(wxTR_HIDE_ROOT))
     {
         x += m_indent;
     }
-    else if (level == 0)
+
+    // a hidden root is not evaluated, but its children are always calculated
+    if ( level != 0 || !HasFlag(wxTR_HIDE_ROOT) )
     {
-        // a hidden root is not evaluated, but its
-        // children are always calculated
-        goto Recurse;
-    }
+        item->CalculateSize(this, dc);
 
-    item->CalculateSize(this, dc);
+        // set its position, the vertical one is set by the caller
+        item->SetX( x+m_spacing );
+        y += GetLineHeight(item);
 
-    // set its position
-    item->SetX( x+m_spacing );
-    item->SetY( y );
-    y += GetLineHeight(item);
+        right = item->GetX() + item->GetWidth();
 
-    if ( !item->IsExpanded() )
-    {
-        // we don't need to calculate collapsed branches
-        return;
+        if ( !item->IsExpanded() )
+        {
+            // we don't need to calculate collapsed branches
+            item->InvalidateChildrenOffsets(0);
+            item->SetSubtreeExtent(y - yStart, right);
+            return;
+        }
     }
 
-  Recurse:
     wxArrayGenericTreeItems& children = item->GetChildren();
     size_t n, count = children.GetCount();
     ++level;
     for (n = 0; n < count; ++n )
-        CalculateLevel( children[n], dc, level, y );  // recurse
+    {
+        wxGenericTreeItem* const child = children[n];
+        child->SetRelativeY( n, y - yStart );
+        CalculateLevel( child, dc, level, y );  // recurse
+
+        if ( child->GetSubtreeRight() > right )
+            right = child->GetSubtreeRight();
+    }
+
+    item->ValidateChildrenOffsets();
+    item->SetSubtreeExtent(y - yStart, right);
 }
 
 void wxGenericTreeCtrl::CalculatePositions()
@@ -4019,8 +4285,88 @@ void wxGenericTreeCtrl::CalculatePositions()
 
     dc.SetPen( m_dottedPen );
 
-    int y = 2;
-    CalculateLevel( m_anchor, dc, 0, y ); // start recursion
+    // if the common line height changes while we're calculating the positions,
+    // the positions of the items before the one which changed it are wrong, so
+    // we need to do it again, but this can happen at most once
+    for ( int attempt = 0; attempt < 2; ++attempt )
+    {
+        m_layoutValid = true;
+
+        int y = 2;
+        m_anchor->SetY( y );
+        CalculateLevel( m_anchor, dc, 0, y ); // start recursion
+
+        if ( m_layoutValid )
+            break;
+    }
+
+    m_layoutValid = true;
+}
+
+void wxGenericTreeCtrl::UpdateLayoutOfSubtree(wxGenericTreeItem *item)
+{
+    // we can only update the layout incrementally if it's currently valid
+    if ( !IsLayoutValid() || !item->GetSubtreeHeight() )
+    {
+        CalculatePositions();
+        return;
+    }
+
+    wxClientDC dc(this);
+    PrepareDC( dc );
+
+    dc.SetFont( m_normalFont );
+
+    dc.SetPen( m_dottedPen );
+
+    const int heightOld = item->GetSubtreeHeight();
+    int rightOld = item->GetSubtreeRight();
+
+    int y = item->GetY();
+    CalculateLevel( item, dc, item->GetLevel(), y );
+
+    if ( !m_layoutValid )
+    {
+        // the common line height has changed, so all items need to be updated
+        CalculatePositions();
+        return;
+    }
+
+    // update the extent of all the parent items: as the positions of the
+    // items are relative to their parents, the only other thing to do is to
+    // mark the positions of the siblings following this item, and of all its
+    // ancestors, as needing to be recomputed, which is done on demand
+    const int dy = item->GetSubtreeHeight() - heightOld;
+    for ( wxGenericTreeItem *child = item, *parent = item->GetParent();
+          parent;
+          child = parent, parent = parent->GetParent() )
+    {
+        const int rightParentOld = parent->GetSubtreeRight();
+
+        int right = rightParentOld;
+        if ( child->GetSubtreeRight() > right )
+        {
+            right = child->GetSubtreeRight();
+        }
+        else if ( child->GetSubtreeRight() < rightOld &&
+                    rightOld == rightParentOld )
+        {
+            // this child may have been the widest one, so the parent may
+            // become narrower now
+            right = parent->ComputeSubtreeRight(parent == m_anchor &&
+                                                    HasFlag(wxTR_HIDE_ROOT));
+        }
+
+        if ( !dy && right == rightParentOld )
+            break;
+
+        parent->SetSubtreeExtent(parent->GetSubtreeHeight() + dy, right);
+
+        if ( dy )
+            parent->InvalidateChildrenOffsets(child->GetIndexInParent() + 1);
+
+        rightOld = rightParentOld;
+    }
 }
 
 void wxGenericTreeCtrl::Refresh(bool eraseBackground, const wxRect *rect)
@@ -23,6 +23,7 @@
 #include "wx/unix/private/epolldispatcher.h"
 #include "wx/unix/private.h"
 #include "wx/stopwatch.h"
+#include "wx/recguard.h"
 
 #ifndef WX_PRECOMP
     #include "wx/log.h"
@@ -33,6 +34,8 @@
 #include <errno.h>
 #include <unistd.h>
 
+#include <vector>
+
 #define wxEpollDispatcher_Trace wxT("epolldispatcher")
 
 // ============================================================================
@@ -68,9 +71,67 @@ static uint32_t GetEpollMask(int flags, int fd)
                    wxT("Registered fd %d for exceptional events"), fd);
     }
 
+    if ( flags & wxFDIO_EDGE_TRIGGERED )
+    {
+        ep |= EPOLLET;
+        wxLogTrace(wxEpollDispatcher_Trace,
+                   wxT("Using edge-triggered notifications for fd %d"), fd);
+    }
+
     return ep;
 }
 
+// We store the handler pointer directly in epoll_data, so that we don't need
+// to look it up when dispatching the events, and use its lowest bit, which is
+// always 0 because the handlers are aligned, to remember whether the fd is
+// edge-triggered, as this is not returned by epoll_wait().
+static void SetEpollData(epoll_event& ev, wxFDIOHandler* handler, int flags)
+{
+    wxUIntPtr data = wxPtrToUInt(handler);
+    wxASSERT_MSG( !(data & 1), wxT("unexpectedly unaligned handler") );
+
+    if ( flags & wxFDIO_EDGE_TRIGGERED )
+        data |= 1;
+
+    ev.data.u64 = 0;
+    ev.data.ptr = wxUIntToPtr(data);
+}
+
+static wxFDIOHandler* GetEpollHandler(const epoll_event& ev, bool* edgeTriggered)
+{
+    const wxUIntPtr data = wxPtrToUInt(ev.data.ptr);
+
+    *edgeTriggered = (data & 1) != 0;
+
+    return static_cast<wxFDIOHandler*>(wxUIntToPtr(data & ~static_cast<wxUIntPtr>(1)));
+}
+
+// initial and maximal size of the buffer used for epoll_wait() events
+static const int INITIAL_EVENTS_BUFFER_SIZE = 16;
+static const int MAX_EVENTS_BUFFER_SIZE = 4096;
+
+namespace
+{
+
+// The state of Dispatch() in the current thread: the same dispatcher is used
+// by the event loops of all threads, so it can't be stored in it.
+struct DispatchState
+{
+    // the buffer for the events returned by epoll_wait(), it grows when it
+    // gets filled up entirely, so that many events occurring at once can be
+    // retrieved by a single call
+    std::vector<epoll_event> events;
+
+    // incremented while Dispatch() is running: the handlers called from it
+    // may reenter it (e.g. from a nested event loop) and the buffer must not
+    // be reused or reallocated while the outer call is still iterating on it
+    wxRecursionGuardFlag depth = 0;
+};
+
+thread_local DispatchState gs_dispatchState;
+
+} // anonymous namespace
+
 // ----------------------------------------------------------------------------
 // wxEpollDispatcher
 // ----------------------------------------------------------------------------
@@ -94,6 +155,8 @@ wxEpollDispatcher::wxEpollDispatcher(int epollDescriptor)
     wxASSERT_MSG( epollDescriptor != -1, wxT("invalid descriptor") );
 
     m_epollDescriptor = epollDescriptor;
+
+    ResetStats();
 }
 
 wxEpollDispatcher::~wxEpollDispatcher()
@@ -108,7 +171,7 @@ bool wxEpollDispatcher::RegisterFD(int fd, wxFDIOHandler* handler, int flags)
 {
     epoll_event ev;
     ev.events = GetEpollMask(flags, fd);
-    ev.data.ptr = handler;
+    SetEpollData(ev, handler, flags);
 
     const int ret = epoll_ctl(m_epollDescriptor, EPOLL_CTL_ADD, fd, &ev);
     if ( ret != 0 )
@@ -128,7 +191,7 @@ bool wxEpollDispatcher::ModifyFD(int fd, wxFDIOHandler* handler, int flags)
 {
     epoll_event ev;
     ev.events = GetEpollMask(flags, fd);
-    ev.data.ptr = handler;
+    SetEpollData(ev, handler, flags);
 
     const int ret = epoll_ctl(m_epollDescriptor, EPOLL_CTL_MOD, fd, &ev);
     if ( ret != 0 )
@@ -202,11 +265,43 @@ bool wxEpollDispatcher::HasPending() const
     return DoPoll(&event, 1, 0) >= 1;
 }
 
+wxEpollDispatcher::Stats wxEpollDispatcher::GetStats() const
+{
+    Stats stats;
+    stats.wakeups = m_wakeups.load(std::memory_order_relaxed);
+    stats.events = m_events.load(std::memory_order_relaxed);
+    stats.maxEvents = m_maxEvents.load(std::memory_order_relaxed);
+
+    return stats;
+}
+
+void wxEpollDispatcher::ResetStats()
+{
+    m_wakeups.store(0, std::memory_order_relaxed);
+    m_events.store(0, std::memory_order_relaxed);
+    m_maxEvents.store(0, std::memory_order_relaxed);
+}
+
 int wxEpollDispatcher::Dispatch(int timeout)
 {
-    epoll_event events[16];
+    DispatchState& state = gs_dispatchState;
+
+    wxRecursionGuard guard(state.depth);
+
+    // the shared buffer is still in use by the outer call if we're reentered,
+    // so use a small buffer on the stack instead: this only happens for
+    // nested event loops and there is no need to retrieve many events then
+    epoll_event nestedEvents[INITIAL_EVENTS_BUFFER_SIZE];
+
+    const bool nested = guard.IsInside();
+    if ( !nested && state.events.empty() )
+        state.events.resize(INITIAL_EVENTS_BUFFER_SIZE);
 
-    const int rc = DoPoll(events, WXSIZEOF(events), timeout);
+    epoll_event * const events = nested ? nestedEvents : &state.events[0];
+    const int numEventsMax = nested ? INITIAL_EVENTS_BUFFER_SIZE
+                                    : static_cast<int>(state.events.size());
+
+    const int rc = DoPoll(events, numEventsMax, timeout);
 
     if ( rc == -1 )
     {
@@ -215,10 +310,23 @@ int wxEpollDispatcher::Dispatch(int timeout)
         return -1;
     }
 
+    if ( rc > 0 )
+    {
+        m_wakeups.fetch_add(1, std::memory_order_relaxed);
+        m_events.fetch_add(rc, std::memory_order_relaxed);
+
+        unsigned long maxEvents = m_maxEvents.load(std::memory_order_relaxed);
+        while ( static_cast<unsigned long>(rc) > maxEvents &&
+                    !m_maxEvents.compare_exchange_weak(maxEvents, rc,
+                                                       std::memory_order_relaxed) )
+            ;
+    }
+
     int numEvents = 0;
     for ( epoll_event *p = events; p < events + rc; p++ )
     {
-        wxFDIOHandler * const handler = (wxFDIOHandler *)(p->data.ptr);
+        bool edgeTriggered;
+        wxFDIOHandler * const handler = GetEpollHandler(*p, &edgeTriggered);
         if ( !handler )
         {
             wxFAIL_MSG( wxT("null handler in epoll_event?") );
@@ -229,7 +337,27 @@ int wxEpollDispatcher::Dispatch(int timeout)
         // OnReadWaiting() on EPOLLHUP as this is what epoll_wait() returns
         // when the write end of a pipe is closed while with select() the
         // remaining pipe end becomes ready for reading when this happens
-        if ( p->events & (EPOLLIN | EPOLLHUP) )
+        if ( edgeTriggered )
+        {
+            // we won't be notified about this event again, so we need to
+            // call all the handler functions and not just the first one
+            const bool canRead = (p->events & (EPOLLIN | EPOLLHUP)) != 0;
+            const bool canWrite = (p->events & EPOLLOUT) != 0;
+
+            if ( canRead )
+                handler->OnReadWaiting();
+            if ( canWrite )
+                handler->OnWriteWaiting();
+
+            if ( !canRead && !canWrite )
+            {
+                if ( !(p->events & EPOLLERR) )
+                    continue;
+
+                handler->OnExceptionWaiting();
+            }
+        }
+        else if ( p->events & (EPOLLIN | EPOLLHUP) )
             handler->OnReadWaiting();
         else if ( p->events & EPOLLOUT )
             handler->OnWriteWaiting();
@@ -241,6 +369,17 @@ int wxEpollDispatcher::Dispatch(int timeout)
         numEvents++;
     }
 
+    // if the buffer was filled up completely, there are probably more events
+    // available, so make it bigger to get them all at once the next time (but
+    // only do it from the outermost call, as only it uses this buffer)
+    if ( !nested && rc == numEventsMax && numEventsMax < MAX_EVENTS_BUFFER_SIZE )
+    {
+        state.events.resize(2*numEventsMax);
+
+        wxLogTrace(wxEpollDispatcher_Trace,
+                   wxT("Increased events buffer size to %d"), 2*numEventsMax);
+    }
+
     return numEvents;
 }
 
@@ -60,6 +60,7 @@ wxConsoleEventLoop::wxConsoleEventLoop()
     m_dispatcher = nullptr;
     m_wakeupPipe = nullptr;
     m_wakeupSource = nullptr;
+    m_timerFD = nullptr;
 
     // Create the pipe.
     std::unique_ptr<wxWakeUpPipeMT> wakeupPipe(new wxWakeUpPipeMT);
@@ -87,10 +88,32 @@ wxConsoleEventLoop::wxConsoleEventLoop()
     m_dispatcher = wxFDIODispatcher::Get();
 
     m_wakeupPipe = wakeupPipe.release();
+
+#if wxUSE_TIMER && wxUSE_EPOLL_DISPATCHER
+    // Use timerfd for waiting for the timers if we can, this is optional and
+    // we fall back on using the dispatcher timeout if it's not available.
+    std::unique_ptr<wxTimerFD> timerFD(new wxTimerFD);
+    if ( timerFD->IsOk() &&
+            m_dispatcher->RegisterFD(timerFD->GetFD(),
+                                     timerFD.get(),
+                                     wxFDIO_INPUT | wxFDIO_EDGE_TRIGGERED) )
+    {
+        m_timerFD = timerFD.release();
+    }
+#endif // wxUSE_TIMER && wxUSE_EPOLL_DISPATCHER
 }
 
 wxConsoleEventLoop::~wxConsoleEventLoop()
 {
+#if wxUSE_TIMER && wxUSE_EPOLL_DISPATCHER
+    if ( m_timerFD )
+    {
+        m_dispatcher->UnregisterFD(m_timerFD->GetFD());
+
+        delete m_timerFD;
+    }
+#endif // wxUSE_TIMER && wxUSE_EPOLL_DISPATCHER
+
     if ( m_wakeupPipe )
     {
         delete m_wakeupSource;
@@ -180,13 +203,27 @@ bool wxConsoleEventLoop::Dispatch()
 int wxConsoleEventLoop::DispatchTimeout(unsigned long timeout)
 {
 #if wxUSE_TIMER
-    // check if we need to decrease the timeout to account for a timer
-    wxUsecClock_t nextTimer;
-    if ( wxTimerScheduler::Get().GetNext(&nextTimer) )
+#if wxUSE_EPOLL_DISPATCHER
+    if ( m_timerFD )
+    {
+        // the dispatcher will return when the timer expires, no need to
+        // change the timeout
+        m_timerFD->Update();
+    }
+    else
+#endif // wxUSE_EPOLL_DISPATCHER
     {
-        unsigned long timeUntilNextTimer = wxMilliClockToLong(nextTimer / 1000);
-        if ( timeUntilNextTimer < timeout )
-            timeout = timeUntilNextTimer;
+        // check if we need to decrease the timeout to account for a timer
+        wxUsecClock_t nextTimer;
+        if ( wxTimerScheduler::Get().GetNext(&nextTimer) )
+        {
+            // round the timeout up, otherwise we'd keep polling without
+            // blocking during the last millisecond before the timer expiration
+            unsigned long timeUntilNextTimer =
+                wxMilliClockToLong((nextTimer + 999) / 1000);
+            if ( timeUntilNextTimer < timeout )
+                timeout = timeUntilNextTimer;
+        }
     }
 #endif // wxUSE_TIMER
 
@@ -35,6 +35,12 @@
 #include <sys/time.h>
 #include <signal.h>
 
+#if wxUSE_EPOLL_DISPATCHER
+    #include <sys/timerfd.h>
+    #include <errno.h>
+    #include <unistd.h>
+#endif // wxUSE_EPOLL_DISPATCHER
+
 #include "wx/unix/private/timer.h"
 
 // trace mask for the debugging messages used here
@@ -46,25 +52,25 @@
 
 wxTimerScheduler *wxTimerScheduler::ms_instance = nullptr;
 
+// the number of children of each node of the heap: using 4 instead of 2 makes
+// the heap shallower and more cache friendly, at the price of more comparisons
+// when sifting down, which is a good trade off in practice
+static const size_t HEAP_ARITY = 4;
+
 void wxTimerScheduler::AddTimer(wxUnixTimerImpl *timer, wxUsecClock_t expiration)
 {
-    DoAddTimer(wxTimerSchedule(timer, expiration));
+    DoAddTimer(wxTimerSchedule(timer, expiration, m_nextOrder++));
 }
 
 void wxTimerScheduler::DoAddTimer(const wxTimerSchedule& s)
 {
-    // do an insertion sort to keep the list sorted in expiration order
-    wxTimerList::iterator node;
-    for ( node = m_timers.begin(); node != m_timers.end(); ++node )
-    {
-        wxASSERT_MSG( node->m_timer != s.m_timer,
-                      wxT("adding the same timer twice?") );
+    wxASSERT_MSG( s.m_timer->m_heapIndex >= m_timers.size() ||
+                    m_timers[s.m_timer->m_heapIndex].m_timer != s.m_timer,
+                  wxT("adding the same timer twice?") );
 
-        if ( node->m_expiration > s.m_expiration )
-            break;
-    }
-
-    m_timers.insert(node, s);
+    m_timers.push_back(s);
+    s.m_timer->m_heapIndex = m_timers.size() - 1;
+    SiftUp(m_timers.size() - 1);
 
     wxLogTrace(wxTrace_Timer, wxT("Inserted timer %d expiring at %s"),
                s.m_timer->GetId(),
@@ -75,28 +81,99 @@ void wxTimerScheduler::RemoveTimer(wxUnixTimerImpl *timer)
 {
     wxLogTrace(wxTrace_Timer, wxT("Removing timer %d"), timer->GetId());
 
-    for ( wxTimerList::iterator node = m_timers.begin();
-          node != m_timers.end();
-          ++node )
+    const size_t n = timer->m_heapIndex;
+    wxCHECK_RET( n < m_timers.size() && m_timers[n].m_timer == timer,
+                 wxT("removing inexistent timer?") );
+
+    DoRemoveTimer(n);
+}
+
+void wxTimerScheduler::DoRemoveTimer(size_t n)
+{
+    const size_t last = m_timers.size() - 1;
+    if ( n != last )
+    {
+        // replace the removed element with the last one and move it to its
+        // correct place, which may be either above or below this one
+        const bool up = m_timers[last].ExpiresBefore(m_timers[n]);
+
+        Place(n, m_timers[last]);
+        m_timers.pop_back();
+
+        if ( up )
+            SiftUp(n);
+        else
+            SiftDown(n);
+    }
+    else
+    {
+        m_timers.pop_back();
+    }
+}
+
+void wxTimerScheduler::SiftUp(size_t n)
+{
+    const wxTimerSchedule s = m_timers[n];
+    while ( n > 0 )
+    {
+        const size_t parent = (n - 1) / HEAP_ARITY;
+        if ( !s.ExpiresBefore(m_timers[parent]) )
+            break;
+
+        Place(n, m_timers[parent]);
+        n = parent;
+    }
+
+    Place(n, s);
+}
+
+void wxTimerScheduler::SiftDown(size_t n)
+{
+    const size_t count = m_timers.size();
+    const wxTimerSchedule s = m_timers[n];
+    for ( ;; )
     {
-        if ( node->m_timer == timer )
+        const size_t first = n*HEAP_ARITY + 1;
+        if ( first >= count )
+            break;
+
+        // find the child expiring first
+        size_t child = first;
+        const size_t end = wxMin(first + HEAP_ARITY, count);
+        for ( size_t i = first + 1; i < end; ++i )
         {
-            m_timers.erase(node);
-            return;
+            if ( m_timers[i].ExpiresBefore(m_timers[child]) )
+                child = i;
         }
+
+        if ( !m_timers[child].ExpiresBefore(s) )
+            break;
+
+        Place(n, m_timers[child]);
+        n = child;
     }
 
-    wxFAIL_MSG( wxT("removing inexistent timer?") );
+    Place(n, s);
 }
 
-bool wxTimerScheduler::GetNext(wxUsecClock_t *remaining) const
+bool wxTimerScheduler::GetNextExpiration(wxUsecClock_t *expiration) const
 {
     if ( m_timers.empty() )
       return false;
 
-    wxCHECK_MSG( remaining, false, wxT("null pointer") );
+    wxCHECK_MSG( expiration, false, wxT("null pointer") );
+
+    *expiration = m_timers.front().m_expiration;
+
+    return true;
+}
+
+bool wxTimerScheduler::GetNext(wxUsecClock_t *remaining) const
+{
+    if ( !GetNextExpiration(remaining) )
+      return false;
 
-    *remaining = m_timers.begin()->m_expiration - wxGetUTCTimeUSec();
+    *remaining -= wxGetUTCTimeUSec();
     if ( *remaining < 0 )
     {
         // timer already expired, don't wait at all before notifying it
@@ -115,26 +192,22 @@ bool wxTimerScheduler::NotifyExpired()
 
     typedef wxVector<wxUnixTimerImpl *> TimerImpls;
     TimerImpls toNotify;
-    for ( wxTimerList::iterator next,
-            cur = m_timers.begin(); cur != m_timers.end(); cur = next )
+    while ( !m_timers.empty() )
     {
-        wxTimerSchedule s = *cur;
+        const wxTimerSchedule& s = m_timers.front();
         if ( s.m_expiration > now )
         {
-            // as the list is sorted by expiration time, we can skip the rest
+            // as the heap top is the timer expiring first, the others haven't
+            // expired either
             break;
         }
 
-        // remember next as we will delete the node pointed to by cur
-        next = cur;
-        ++next;
-
-        m_timers.erase(cur);
-
         // check whether we need to keep this timer
         wxUnixTimerImpl * const timer = s.m_timer;
         if ( timer->IsOneShot() )
         {
+            DoRemoveTimer(0);
+
             // the timer needs to be stopped but don't call its Stop() from
             // here as it would attempt to remove the timer from our list and
             // we had already done it, so we just need to reset its state
@@ -146,13 +219,24 @@ bool wxTimerScheduler::NotifyExpired()
             // the current time instead of just offsetting it from the current
             // expiration time because it could happen that we're late and the
             // current expiration time is (far) in the past
-            s.m_expiration = now + timer->GetInterval()*1000;
-            DoAddTimer(s);
+            //
+            // notice that this is done in place, which is cheaper than
+            // removing the timer from the heap and adding it back
+            wxTimerSchedule& next = m_timers.front();
+            next.m_expiration = now + timer->GetInterval()*1000;
+            if ( next.m_expiration == now )
+            {
+                // don't notify the timer with zero interval again in this loop
+                ++next.m_expiration;
+            }
+
+            next.m_order = m_nextOrder++;
+            SiftDown(0);
         }
 
         // we can't notify the timer from this loop as the timer event handler
         // could modify m_timers (for example, but not only, by stopping this
-        // timer) which would render our iterators invalid, so do it after the
+        // timer) which would render our indices invalid, so do it after the
         // loop end
         toNotify.push_back(timer);
     }
@@ -179,6 +263,7 @@ wxUnixTimerImpl::wxUnixTimerImpl(wxTimer* timer)
                : wxTimerImpl(timer)
 {
     m_isRunning = false;
+    m_heapIndex = static_cast<size_t>(-1);
 }
 
 bool wxUnixTimerImpl::Start(int milliseconds, bool oneShot)
@@ -212,6 +297,81 @@ wxUnixTimerImpl::~wxUnixTimerImpl()
     wxASSERT_MSG( !m_isRunning, wxT("must have been stopped before") );
 }
 
+#if wxUSE_EPOLL_DISPATCHER
+
+// ============================================================================
+// wxTimerFD implementation
+// ============================================================================
+
+wxTimerFD::wxTimerFD()
+{
+    // use CLOCK_REALTIME because wxTimerScheduler uses wxGetUTCTimeUSec()
+    m_fd = timerfd_create(CLOCK_REALTIME, TFD_NONBLOCK | TFD_CLOEXEC);
+    if ( m_fd == -1 )
+    {
+        wxLogTrace(wxTrace_Timer,
+                   wxT("Creating timerfd failed (%s), not using it"),
+                   wxSysErrorMsgStr());
+    }
+
+    m_expiration = 0;
+}
+
+wxTimerFD::~wxTimerFD()
+{
+    if ( m_fd != -1 )
+        close(m_fd);
+}
+
+void wxTimerFD::Update()
+{
+    wxUsecClock_t expiration;
+    if ( !wxTimerScheduler::Get().GetNextExpiration(&expiration) )
+        expiration = 0;
+
+    // avoid the system call if the next timer to expire didn't change, which
+    // is the most common case
+    if ( expiration == m_expiration )
+        return;
+
+    // notice that if the expiration time is already in the past, the timer
+    // just fires immediately, while setting it to 0 disarms it
+    itimerspec spec;
+    spec.it_interval.tv_sec = 0;
+    spec.it_interval.tv_nsec = 0;
+    spec.it_value.tv_sec = (expiration / 1000000).ToLong();
+    spec.it_value.tv_nsec = (expiration % 1000000).ToLong()*1000;
+
+    if ( timerfd_settime(m_fd, TFD_TIMER_ABSTIME, &spec, nullptr) != 0 )
+    {
+        wxLogTrace(wxTrace_Timer, wxT("Arming timerfd failed: %s"),
+                   wxSysErrorMsgStr());
+
+        // try again the next time
+        m_expiration = 0;
+        return;
+    }
+
+    m_expiration = expiration;
+}
+
+void wxTimerFD::OnReadWaiting()
+{
+    // just reset the readiness state, the timers will be notified by the
+    // event loop after the dispatcher returns
+    wxUint64 expirations;
+    while ( read(m_fd, &expirations, sizeof(expirations)) == -1 )
+    {
+        if ( errno != EINTR )
+            break;
+    }
+
+    // the timer is disarmed now
+    m_expiration = 0;
+}
+
+#endif // wxUSE_EPOLL_DISPATCHER
+
 // ============================================================================
 // wxTimerUnixModule: responsible for freeing the global timer scheduler
 // ============================================================================
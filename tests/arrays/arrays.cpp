@@ -411,6 +411,152 @@ TEST_CASE("wxSortedArrayString", "[dynarray]")
     CHECK( ad.Index("AB") == 2 );
     CHECK( ad.Index("A") == wxNOT_FOUND );
     CHECK( ad.Index("z") == wxNOT_FOUND );
+
+    ad.Merge(wxArrayString{"b", "ab", "A"});
+    REQUIRE( ad.size() == 6 );
+    CHECK( ad[0] == "A" );
+    CHECK( ad[1] == "a" );
+    CHECK( ad[2] == "Aa" );
+    CHECK( ad[3] == "AB" );
+    CHECK( ad[4] == "ab" );
+    CHECK( ad[5] == "b" );
+}
+
+// Return an array of strings with many common prefixes, duplicates and
+// strings differing in case only.
+static wxArrayString GetStringsToSort()
+{
+    static const char* const parts[] =
+        { "", "a", "A", "ab", "aB", "b", "Z", "z", "0", "\xc3\xa9", "\xc3\x89" };
+
+    wxArrayString strings;
+
+    unsigned seed = 17;
+    for ( int n = 0; n < 5000; n++ )
+    {
+        wxString s;
+        for ( int len = n % 7; len > 0; len-- )
+        {
+            seed = seed * 1103515245 + 12345;
+            s += wxString::FromUTF8(parts[(seed >> 16) % WXSIZEOF(parts)]);
+        }
+
+        strings.push_back(s);
+    }
+
+    strings.push_back(wxString("x\0y", 3));
+    strings.push_back(wxString("x\0Y", 3));
+    strings.push_back(wxString("x"));
+
+    return strings;
+}
+
+TEST_CASE("wxArrayString::SortBig", "[dynarray]")
+{
+    const wxArrayString strings = GetStringsToSort();
+
+    wxArrayString expected(strings);
+    wxArrayString actual(strings);
+
+    expected.Sort(wxStringSortAscending);
+    actual.Sort();
+    CHECK( actual == expected );
+
+    expected.Sort(wxStringSortDescending);
+    actual.Sort(true /* reverse */);
+    CHECK( actual == expected );
+
+    expected.Sort(wxDictionaryStringSortAscending);
+    actual.SortNoCase();
+    CHECK( actual == expected );
+
+    expected.Sort(wxDictionaryStringSortDescending);
+    actual.SortNoCase(true /* reverse */);
+    CHECK( actual == expected );
+}
+
+TEST_CASE("wxSortedArrayString::Merge", "[dynarray]")
+{
+    const wxArrayString strings = GetStringsToSort();
+
+    wxArrayString expected(strings);
+    expected.Sort();
+
+    SECTION("Ctor")
+    {
+        const wxSortedArrayString sorted(strings);
+        CHECK( sorted == expected );
+    }
+
+    SECTION("Merge")
+    {
+        wxSortedArrayString sorted;
+        sorted.Add("foo");
+        sorted.Add("bar");
+        sorted.Merge(strings);
+
+        expected.push_back("foo");
+        expected.push_back("bar");
+        expected.Sort();
+        CHECK( sorted == expected );
+    }
+
+    SECTION("Custom")
+    {
+        wxSortedArrayString sorted(wxDictionaryStringSortDescending);
+        const std::vector<wxString> all = strings.AsVector();
+        sorted.Merge(std::vector<wxString>(all.begin(), all.begin() + 1000));
+        sorted.Merge(std::vector<wxString>(all.begin() + 1000, all.end()));
+
+        expected.Sort(wxDictionaryStringSortDescending);
+        CHECK( sorted == expected );
+    }
+}
+
+TEST_CASE("wxArrayStringIndex", "[dynarray]")
+{
+    wxArrayString strings = GetStringsToSort();
+
+    SECTION("Case")
+    {
+        const wxArrayStringIndex index(strings);
+
+        for ( size_t n = 0; n < strings.size(); n++ )
+        {
+            INFO("String #" << n);
+            CHECK( index.Index(strings[n]) == strings.Index(strings[n]) );
+        }
+
+        CHECK( index.Index("not there") == wxNOT_FOUND );
+        CHECK( index.Index(wxString("x\0y", 3)) == 5000 );
+        CHECK( index.Index(wxString("x\0z", 3)) == wxNOT_FOUND );
+    }
+
+    SECTION("NoCase")
+    {
+        const wxArrayStringIndex index(strings, false /* ignore case */);
+
+        for ( size_t n = 0; n < strings.size(); n++ )
+        {
+            INFO("String #" << n);
+
+            const wxString& s = strings[n];
+            CHECK( index.Index(s) == strings.Index(s, false) );
+            CHECK( index.Index(s.Upper()) == strings.Index(s, false) );
+        }
+
+        CHECK( index.Index(wxString("X\0Y", 3)) == 5000 );
+    }
+
+    SECTION("Rebuild")
+    {
+        wxArrayStringIndex index(strings);
+        CHECK( index.Index("not there") == wxNOT_FOUND );
+
+        strings.push_back("not there");
+        index.Rebuild();
+        CHECK( index.Index("not there") == 5003 );
+    }
 }
 
 TEST_CASE("Arrays::Split", "[dynarray]")
@@ -66,6 +66,9 @@ public:
     int GetNumericParameter() const { return m_numParam; }
     const wxString& GetStringParameter() const { return m_strParam; }
 
+    void SetBytesPerRun(size_t bytes) { m_bytesPerRun = bytes; }
+    void SetExtraInfo(const wxString& info) { m_extraInfo = info; }
+
 private:
     // output the results of a single benchmark if successful or just return
     // false if anything went wrong
@@ -80,6 +83,12 @@ private:
          m_runTime, // minimum time to run a single benchmark if m_numRuns == 0
          m_numParam;
     wxString m_strParam;
+
+    // amount of data processed by the currently running benchmark or 0
+    size_t m_bytesPerRun;
+
+    // additional information to show after the benchmark results
+    wxString m_extraInfo;
 };
 
 wxIMPLEMENT_APP_CONSOLE(BenchApp);
@@ -102,6 +111,16 @@ wxString Bench::GetStringParameter(const wxString& defVal)
     return !val.empty() ? val : defVal;
 }
 
+void Bench::SetBytesPerRun(size_t bytes)
+{
+    wxGetApp().SetBytesPerRun(bytes);
+}
+
+void Bench::SetExtraInfo(const wxString& info)
+{
+    wxGetApp().SetExtraInfo(info);
+}
+
 // ============================================================================
 // BenchApp implementation
 // ============================================================================
@@ -111,6 +130,7 @@ BenchApp::BenchApp()
     m_numRuns = 0; // this means to use m_runTime
     m_runTime = 500; // default minimum
     m_numParam = 0;
+    m_bytesPerRun = 0;
 }
 
 bool BenchApp::OnInit()
@@ -282,6 +302,9 @@ int BenchApp::OnRun()
 
 bool BenchApp::RunSingleBenchmark(Bench::Function* func)
 {
+    m_bytesPerRun = 0;
+    m_extraInfo.clear();
+
     if ( !func->Init() )
         return false;
 
@@ -362,6 +385,15 @@ bool BenchApp::RunSingleBenchmark(Bench::Function* func)
         );
     }
 
+    if ( m_bytesPerRun && m > 0 )
+    {
+        // Bytes per microsecond are the same as 1000 times GB/s.
+        wxPrintf("\t%.2f GB/s\n", m_bytesPerRun / m / 1000.);
+    }
+
+    if ( !m_extraInfo.empty() )
+        wxPrintf("\t%s\n", m_extraInfo);
+
     fflush(stdout);
 
     return true;
@@ -93,6 +93,23 @@ long GetNumericParameter(long defValue = 1);
  */
 wxString GetStringParameter(const wxString& defValue = wxString());
 
+/**
+    Set the amount of data processed by a single run of the benchmark.
+
+    If this function is called, either from the benchmark initialization
+    function or from the benchmark itself, the throughput corresponding to the
+    average run time is shown in addition to the time itself.
+ */
+void SetBytesPerRun(size_t bytes);
+
+/**
+    Set additional information to show after the benchmark results.
+
+    This can be used by the benchmarks collecting some statistics while they
+    run, typically from their shutdown function.
+ */
+void SetExtraInfo(const wxString& info);
+
 } // namespace Bench
 
 /**
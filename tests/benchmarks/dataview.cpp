@@ -0,0 +1,202 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/dataview.cpp
+// Purpose:     wxDataViewCtrl benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/app.h"
+#include "wx/dataview.h"
+
+#include "bench.h"
+
+#if wxUSE_DATAVIEWCTRL
+
+namespace
+{
+
+// Synthetic model with a single top level container item having many
+// children, which may be expanded, sorted by either of its two columns and
+// to which more children can be added in bulk.
+class BenchDataViewModel : public wxDataViewModel
+{
+public:
+    explicit BenchDataViewModel(unsigned count)
+        : m_count(count),
+          m_added(0)
+    {
+    }
+
+    unsigned GetCount() const { return m_count; }
+
+    wxDataViewItem GetRootItem() const { return MakeItem(0); }
+
+    // Add the given number of new children to the root item and notify the
+    // control about them at once.
+    void AddItems(unsigned num)
+    {
+        wxDataViewItemArray items;
+        items.reserve(num);
+        for ( unsigned n = 0; n < num; n++ )
+            items.push_back(MakeItem(1 + m_count + m_added + n));
+
+        m_added += num;
+
+        ItemsAdded(GetRootItem(), items);
+    }
+
+    // Remove all the items added by AddItems() and notify the control.
+    void RemoveAddedItems()
+    {
+        wxDataViewItemArray items;
+        items.reserve(m_added);
+        for ( unsigned n = 0; n < m_added; n++ )
+            items.push_back(MakeItem(1 + m_count + n));
+
+        m_added = 0;
+
+        ItemsDeleted(GetRootItem(), items);
+    }
+
+    void GetValue(wxVariant& variant,
+                  const wxDataViewItem& item,
+                  unsigned int col) const override
+    {
+        const unsigned n = GetIndex(item);
+
+        // Use different, pseudo-random, orders for both columns.
+        variant = static_cast<long>(col == 0 ? (n * 2654435761u) % 1000003
+                                             : (n * 40503u) % 65537);
+    }
+
+    bool SetValue(const wxVariant& WXUNUSED(variant),
+                  const wxDataViewItem& WXUNUSED(item),
+                  unsigned int WXUNUSED(col)) override
+    {
+        return false;
+    }
+
+    wxDataViewItem GetParent(const wxDataViewItem& item) const override
+    {
+        return GetIndex(item) == 0 ? wxDataViewItem() : GetRootItem();
+    }
+
+    bool IsContainer(const wxDataViewItem& item) const override
+    {
+        return !item.IsOk() || GetIndex(item) == 0;
+    }
+
+    unsigned int GetChildren(const wxDataViewItem& item,
+                             wxDataViewItemArray& children) const override
+    {
+        if ( !item.IsOk() )
+        {
+            children.push_back(GetRootItem());
+            return 1;
+        }
+
+        if ( GetIndex(item) != 0 )
+            return 0;
+
+        const unsigned total = m_count + m_added;
+        children.reserve(total);
+        for ( unsigned n = 0; n < total; n++ )
+            children.push_back(MakeItem(1 + n));
+
+        return total;
+    }
+
+private:
+    // Item IDs must be non-null, so offset the indices by one.
+    static wxDataViewItem MakeItem(unsigned n)
+    {
+        return wxDataViewItem(wxUIntToPtr(n + 1));
+    }
+
+    static unsigned GetIndex(const wxDataViewItem& item)
+    {
+        return wxPtrToUInt(item.GetID()) - 1;
+    }
+
+    const unsigned m_count;
+    unsigned m_added;
+};
+
+wxDataViewCtrl* gs_dvc = nullptr;
+BenchDataViewModel* gs_model = nullptr;
+
+bool DataViewInit()
+{
+    gs_dvc = new wxDataViewCtrl(wxTheApp->GetTopWindow(), wxID_ANY);
+    gs_dvc->AppendTextColumn("First", 0);
+    gs_dvc->AppendTextColumn("Second", 1);
+
+    gs_model = new BenchDataViewModel(Bench::GetNumericParameter(100000));
+    gs_dvc->AssociateModel(gs_model);
+    gs_model->DecRef();
+
+    gs_dvc->GetColumn(0)->SetSortOrder(true);
+
+    return true;
+}
+
+void DataViewDone()
+{
+    delete gs_dvc;
+    gs_dvc = nullptr;
+    gs_model = nullptr;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(DataViewExpandSorted, DataViewInit, DataViewDone)
+{
+    // Recreate the tree to ensure that the children are really built, and
+    // sorted, when expanding the item and not reused from the previous run.
+    gs_model->Cleared();
+
+    const wxDataViewItem root = gs_model->GetRootItem();
+    gs_dvc->Expand(root);
+
+    return gs_dvc->IsExpanded(root);
+}
+
+BENCHMARK_FUNC_WITH_INIT(DataViewSortByColumn, DataViewInit, DataViewDone)
+{
+    static unsigned s_col = 0;
+
+    gs_dvc->Expand(gs_model->GetRootItem());
+
+    s_col = 1 - s_col;
+    gs_dvc->GetColumn(s_col)->SetSortOrder(true);
+    gs_model->Resort();
+
+    return gs_dvc->GetSortingColumn() == gs_dvc->GetColumn(s_col);
+}
+
+BENCHMARK_FUNC_WITH_INIT(DataViewToggleSortOrder, DataViewInit, DataViewDone)
+{
+    static bool s_ascending = true;
+
+    gs_dvc->Expand(gs_model->GetRootItem());
+
+    s_ascending = !s_ascending;
+    gs_dvc->GetColumn(0)->SetSortOrder(s_ascending);
+    gs_model->Resort();
+
+    return gs_dvc->GetColumn(0)->IsSortOrderAscending() == s_ascending;
+}
+
+BENCHMARK_FUNC_WITH_INIT(DataViewBulkInsert, DataViewInit, DataViewDone)
+{
+    gs_dvc->Expand(gs_model->GetRootItem());
+
+    gs_model->AddItems(gs_model->GetCount() / 10);
+    gs_model->RemoveAddedItems();
+
+    return gs_dvc->IsExpanded(gs_model->GetRootItem());
+}
+
+#endif // wxUSE_DATAVIEWCTRL
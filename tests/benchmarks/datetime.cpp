@@ -11,9 +11,159 @@
 
 #include "bench.h"
 
+#include <string.h>
+
 BENCHMARK_FUNC(ParseDate)
 {
     wxDateTime dt;
     return dt.ParseDate("May 23, 2011") && dt.GetMonth() == wxDateTime::May;
 }
 
+// ----------------------------------------------------------------------------
+// Parsing and formatting many timestamps, as e.g. when reading a log file
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Number of timestamps parsed or formatted by each benchmark iteration.
+const int NUM_TIMESTAMPS = 100;
+
+const char* GetTimestamp(int n)
+{
+    static char timestamps[NUM_TIMESTAMPS][32];
+    static bool initialized = false;
+    if ( !initialized )
+    {
+        for ( int i = 0; i < NUM_TIMESTAMPS; i++ )
+        {
+            sprintf(timestamps[i], "2011-%02d-%02dT%02d:%02d:%02d",
+                    i % 12 + 1, i % 28 + 1, i % 24, i % 60, (7*i) % 60);
+        }
+
+        initialized = true;
+    }
+
+    return timestamps[n];
+}
+
+const wxString& GetTimestampString(int n)
+{
+    static wxString timestamps[NUM_TIMESTAMPS];
+    if ( timestamps[0].empty() )
+    {
+        for ( int i = 0; i < NUM_TIMESTAMPS; i++ )
+            timestamps[i] = GetTimestamp(i);
+    }
+
+    return timestamps[n];
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(ParseISOCombined)
+{
+    wxDateTime dt;
+    for ( int n = 0; n < NUM_TIMESTAMPS; n++ )
+    {
+        if ( !dt.ParseISOCombined(GetTimestampString(n)) )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC(ParseISOCombinedBuffer)
+{
+    wxDateTime dt;
+    for ( int n = 0; n < NUM_TIMESTAMPS; n++ )
+    {
+        const char* const s = GetTimestamp(n);
+        if ( !dt.ParseISOCombined(s, s + strlen(s)) )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC(ParseRfc3339Buffer)
+{
+    static char buf[NUM_TIMESTAMPS][40];
+    if ( !*buf[0] )
+    {
+        for ( int n = 0; n < NUM_TIMESTAMPS; n++ )
+            sprintf(buf[n], "%s.%03d+02:00", GetTimestamp(n), n);
+    }
+
+    wxDateTime dt;
+    for ( int n = 0; n < NUM_TIMESTAMPS; n++ )
+    {
+        if ( !dt.ParseRfc3339Date(buf[n], buf[n] + strlen(buf[n])) )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC(ParseFormatCustom)
+{
+    wxDateTime dt;
+    wxString::const_iterator end;
+    for ( int n = 0; n < NUM_TIMESTAMPS; n++ )
+    {
+        if ( !dt.ParseFormat(GetTimestampString(n), "%Y-%m-%dT%H:%M:%S", &end) )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC(ParseDateTimeFormat)
+{
+    static const wxDateTimeFormat format("%Y-%m-%dT%H:%M:%S");
+
+    wxDateTime dt;
+    wxString::const_iterator end;
+    for ( int n = 0; n < NUM_TIMESTAMPS; n++ )
+    {
+        if ( !format.Parse(dt, GetTimestampString(n), &end) )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC(FormatISOCombined)
+{
+    const wxDateTime dt(23, wxDateTime::May, 2011, 12, 34, 56);
+
+    size_t len = 0;
+    for ( int n = 0; n < NUM_TIMESTAMPS; n++ )
+        len += dt.FormatISOCombined().length();
+
+    return len == 19*NUM_TIMESTAMPS;
+}
+
+BENCHMARK_FUNC(FormatCustom)
+{
+    const wxDateTime dt(23, wxDateTime::May, 2011, 12, 34, 56);
+
+    size_t len = 0;
+    for ( int n = 0; n < NUM_TIMESTAMPS; n++ )
+        len += dt.Format("%d/%m/%Y %H:%M:%S").length();
+
+    return len == 19*NUM_TIMESTAMPS;
+}
+
+BENCHMARK_FUNC(FormatDateTimeFormat)
+{
+    static const wxDateTimeFormat format("%d/%m/%Y %H:%M:%S");
+
+    const wxDateTime dt(23, wxDateTime::May, 2011, 12, 34, 56);
+
+    size_t len = 0;
+    for ( int n = 0; n < NUM_TIMESTAMPS; n++ )
+        len += format.Format(dt).length();
+
+    return len == 19*NUM_TIMESTAMPS;
+}
@@ -0,0 +1,245 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/events.cpp
+// Purpose:     Events queuing and processing benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench.h"
+
+#include "wx/app.h"
+#include "wx/event.h"
+#include "wx/thread.h"
+#include "wx/time.h"
+
+#include <memory>
+#include <vector>
+
+#if wxUSE_THREADS
+
+namespace
+{
+
+// The number of events queued by each thread in a single benchmark iteration.
+const int NUM_EVENTS_PER_THREAD = 10000;
+
+// Handler counting the events it receives and remembering the last value
+// received from each thread.
+class CountingHandler : public wxEvtHandler
+{
+public:
+    explicit CountingHandler(long numThreads)
+        : m_last(numThreads, -1)
+    {
+        Bind(wxEVT_THREAD, &CountingHandler::OnThread, this);
+    }
+
+    long GetCount() const { return m_count; }
+
+    // Return true if the last events from all threads were received.
+    bool GotAllLast() const
+    {
+        for ( int last : m_last )
+        {
+            if ( last != NUM_EVENTS_PER_THREAD - 1 )
+                return false;
+        }
+
+        return true;
+    }
+
+private:
+    void OnThread(wxThreadEvent& event)
+    {
+        m_count++;
+        m_last[event.GetId()] = event.GetInt();
+    }
+
+    long m_count = 0;
+    std::vector<int> m_last;
+};
+
+// Thread queuing the events to the given handler.
+class QueueThread : public wxThread
+{
+public:
+    QueueThread(wxEvtHandler& handler, int id, bool coalesce)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_handler(handler),
+          m_id(id),
+          m_coalesce(coalesce)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        for ( int n = 0; n < NUM_EVENTS_PER_THREAD; n++ )
+        {
+            wxThreadEvent* const event = new wxThreadEvent(wxEVT_THREAD, m_id);
+            event->SetInt(n);
+
+            if ( m_coalesce )
+                m_handler.QueueCoalescedEvent(event);
+            else
+                m_handler.QueueEvent(event);
+        }
+
+        return 0;
+    }
+
+private:
+    wxEvtHandler& m_handler;
+    const int m_id;
+    const bool m_coalesce;
+};
+
+// The total number of events queued and processed and the time taken by it.
+long gs_numQueued = 0;
+long gs_numProcessed = 0;
+wxLongLong gs_totalTime;
+
+void DoneQueueEvent()
+{
+    if ( gs_totalTime > 0 )
+    {
+        Bench::SetExtraInfo(wxString::Format
+                            (
+                                "%.0f events per second, %ld of %ld processed",
+                                gs_numQueued * 1e6 / gs_totalTime.ToDouble(),
+                                gs_numProcessed,
+                                gs_numQueued
+                            ));
+    }
+
+    gs_numQueued = 0;
+    gs_numProcessed = 0;
+    gs_totalTime = 0;
+}
+
+// Queue events from the number of threads given by the numeric parameter, 16
+// by default, to a single handler in the main thread and process them there.
+bool DoQueueEvents(bool coalesce)
+{
+    const long numThreads = Bench::GetNumericParameter(16);
+
+    CountingHandler handler(numThreads);
+
+    const wxLongLong start = wxGetUTCTimeUSec();
+
+    std::vector<std::unique_ptr<QueueThread>> threads;
+    for ( long n = 0; n < numThreads; n++ )
+    {
+        threads.emplace_back(new QueueThread(handler, n, coalesce));
+        if ( threads.back()->Run() != wxTHREAD_NO_ERROR )
+            return false;
+    }
+
+    while ( !handler.GotAllLast() )
+        wxTheApp->ProcessPendingEvents();
+
+    for ( const auto& thread : threads )
+        thread->Wait();
+
+    gs_totalTime += wxGetUTCTimeUSec() - start;
+    gs_numQueued += numThreads * NUM_EVENTS_PER_THREAD;
+    gs_numProcessed += handler.GetCount();
+
+    return coalesce || handler.GetCount() == numThreads * NUM_EVENTS_PER_THREAD;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(QueueEventThreads, nullptr, DoneQueueEvent)
+{
+    return DoQueueEvents(false);
+}
+
+// Same as above, but coalesce the events from each thread.
+BENCHMARK_FUNC_WITH_INIT(QueueCoalescedEventThreads, nullptr, DoneQueueEvent)
+{
+    return DoQueueEvents(true);
+}
+
+#endif // wxUSE_THREADS
+
+// ----------------------------------------------------------------------------
+// Dynamic event tables benchmarks
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// The number of different event types used by the benchmarks below.
+const int NUM_EVENT_TYPES = 20;
+
+class DispatchHandler : public wxEvtHandler
+{
+public:
+    void OnEvent(wxEvent& WXUNUSED(event)) { m_count++; }
+
+    long m_count = 0;
+};
+
+std::unique_ptr<DispatchHandler> gs_dispatchHandler;
+std::vector<wxEventType> gs_eventTypes;
+
+// Bind the number of handlers given by the numeric parameter, 100 by default,
+// to different event types and ids, as is typical for the real programs.
+bool InitDispatch()
+{
+    while ( gs_eventTypes.size() < NUM_EVENT_TYPES )
+        gs_eventTypes.push_back(wxNewEventType());
+
+    gs_dispatchHandler.reset(new DispatchHandler);
+
+    const long numHandlers = Bench::GetNumericParameter(100);
+    for ( long n = 0; n < numHandlers; n++ )
+    {
+        gs_dispatchHandler->Bind(gs_eventTypes[n % NUM_EVENT_TYPES],
+                                 &DispatchHandler::OnEvent,
+                                 gs_dispatchHandler.get(),
+                                 static_cast<int>(n));
+    }
+
+    return true;
+}
+
+void DoneDispatch()
+{
+    gs_dispatchHandler.reset();
+}
+
+} // anonymous namespace
+
+// Dispatch events handled by the first bound handler, which is the worst case
+// as it's the last one to be checked.
+BENCHMARK_FUNC_WITH_INIT(DynamicEventDispatch, InitDispatch, DoneDispatch)
+{
+    wxThreadEvent event(gs_eventTypes[0], 0);
+
+    for ( int n = 0; n < 1000; n++ )
+    {
+        if ( !gs_dispatchHandler->ProcessEventLocally(event) )
+            return false;
+    }
+
+    return true;
+}
+
+// Dispatch events for which there are no handlers at all, which is common for
+// events such as wxEVT_UPDATE_UI or wxEVT_IDLE.
+BENCHMARK_FUNC_WITH_INIT(DynamicEventDispatchMiss, InitDispatch, DoneDispatch)
+{
+    wxIdleEvent event;
+
+    for ( int n = 0; n < 1000; n++ )
+    {
+        if ( gs_dispatchHandler->ProcessEventLocally(event) )
+            return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,175 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/fdio.cpp
+// Purpose:     File descriptors IO dispatching benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench.h"
+
+#if wxUSE_EPOLL_DISPATCHER
+
+#include "wx/time.h"
+#include "wx/unix/private/epolldispatcher.h"
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+// Handler consuming the events signalled using an eventfd.
+class EventFDHandler : public wxFDIOHandler
+{
+public:
+    explicit EventFDHandler(int fd) : m_fd(fd) { }
+    virtual ~EventFDHandler() { close(m_fd); }
+
+    int GetFD() const { return m_fd; }
+
+    virtual void OnReadWaiting() override;
+    virtual void OnWriteWaiting() override { }
+    virtual void OnExceptionWaiting() override { }
+
+private:
+    const int m_fd;
+
+    wxDECLARE_NO_COPY_CLASS(EventFDHandler);
+};
+
+// All the data used by the benchmarks below.
+struct DispatchData
+{
+    std::unique_ptr<wxEpollDispatcher> dispatcher;
+    std::vector<std::unique_ptr<EventFDHandler>> handlers;
+
+    // The number of the current benchmark iteration.
+    unsigned iteration = 0;
+
+    // The time when all the descriptors were signalled in this iteration.
+    wxLongLong start;
+
+    // The number of the handled events and their total latency, i.e. the time
+    // between the end of signalling and handling them, in microseconds.
+    unsigned long handled = 0;
+    wxLongLong totalLatency;
+} gs_data;
+
+void EventFDHandler::OnReadWaiting()
+{
+    eventfd_t value;
+    if ( eventfd_read(m_fd, &value) == 0 )
+    {
+        gs_data.handled++;
+        gs_data.totalLatency += wxGetUTCTimeUSec() - gs_data.start;
+    }
+}
+
+// Create the dispatcher monitoring the number of descriptors given by the
+// numeric parameter, 10000 by default.
+bool InitDispatch(int flags)
+{
+    gs_data.dispatcher.reset(wxEpollDispatcher::Create());
+    if ( !gs_data.dispatcher )
+        return false;
+
+    const long numFDs = Bench::GetNumericParameter(10000);
+    for ( long n = 0; n < numFDs; n++ )
+    {
+        const int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if ( fd == -1 )
+            return false;
+
+        gs_data.handlers.emplace_back(new EventFDHandler(fd));
+        if ( !gs_data.dispatcher->RegisterFD(fd,
+                                             gs_data.handlers.back().get(),
+                                             flags) )
+            return false;
+    }
+
+    return true;
+}
+
+bool InitDispatchLevel()
+{
+    return InitDispatch(wxFDIO_INPUT);
+}
+
+bool InitDispatchEdge()
+{
+    return InitDispatch(wxFDIO_INPUT | wxFDIO_EDGE_TRIGGERED);
+}
+
+void DoneDispatch()
+{
+    if ( gs_data.dispatcher )
+    {
+        const wxEpollDispatcher::Stats& stats = gs_data.dispatcher->GetStats();
+        if ( stats.wakeups && gs_data.handled )
+        {
+            Bench::SetExtraInfo(wxString::Format
+                                (
+                                    "%.1f events per wakeup (%lu max), "
+                                    "%.1fus average latency",
+                                    static_cast<double>(stats.events) /
+                                        stats.wakeups,
+                                    stats.maxEvents,
+                                    gs_data.totalLatency.ToDouble() /
+                                        gs_data.handled
+                                ));
+        }
+
+        for ( const auto& handler : gs_data.handlers )
+            gs_data.dispatcher->UnregisterFD(handler->GetFD());
+    }
+
+    gs_data = DispatchData();
+}
+
+// Signal every 10th descriptor, as if data arrived on some of the monitored
+// sockets, and dispatch the events for all of them.
+bool DoDispatch()
+{
+    const size_t numFDs = gs_data.handlers.size();
+    const size_t first = gs_data.iteration++ % 10;
+
+    const unsigned long handledBefore = gs_data.handled;
+    unsigned long numSignalled = 0;
+
+    for ( size_t n = first; n < numFDs; n += 10 )
+    {
+        if ( eventfd_write(gs_data.handlers[n]->GetFD(), 1) != 0 )
+            return false;
+
+        numSignalled++;
+    }
+
+    gs_data.start = wxGetUTCTimeUSec();
+
+    while ( gs_data.handled - handledBefore < numSignalled )
+    {
+        if ( gs_data.dispatcher->Dispatch(0) <= 0 )
+            return false;
+    }
+
+    return true;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(EpollDispatch, InitDispatchLevel, DoneDispatch)
+{
+    return DoDispatch();
+}
+
+BENCHMARK_FUNC_WITH_INIT(EpollDispatchEdge, InitDispatchEdge, DoneDispatch)
+{
+    return DoDispatch();
+}
+
+#endif // wxUSE_EPOLL_DISPATCHER
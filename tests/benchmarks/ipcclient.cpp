@@ -9,20 +9,71 @@
 
 #include "bench.h"
 
+#include "wx/app.h"
 #include "wx/evtloop.h"
+#include "wx/time.h"
 
 // do this before including wx/ipc.h under Windows to use TCP even there
 #define wxUSE_DDE_FOR_IPC 0
 #include "wx/ipc.h"
 #include "../../samples/ipc/ipcsetup.h"
 
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
 namespace
 {
 
+// The number of requests sent by a single iteration of the request benchmarks.
+const int NUM_REQUESTS = 1000;
+
+// Statistics collected by the request benchmarks: the latencies of all
+// requests, in microseconds, and the total time taken by them.
+std::vector<double> gs_latencies;
+wxLongLong gs_totalTime;
+
+// Dispatch the socket events and process the IPC events generated by them:
+// this is needed because the event loop is not running, so pending events
+// wouldn't be processed otherwise.
+void DispatchEvents(wxEventLoop& loop)
+{
+    loop.Dispatch();
+    wxTheApp->ProcessPendingEvents();
+}
+
+void ResetStats()
+{
+    gs_latencies.clear();
+    gs_totalTime = 0;
+}
+
+void ReportStats()
+{
+    if ( gs_latencies.empty() || gs_totalTime <= 0 )
+        return;
+
+    std::sort(gs_latencies.begin(), gs_latencies.end());
+
+    const auto percentile = [](int p)
+    {
+        return gs_latencies[(gs_latencies.size() - 1) * p / 100];
+    };
+
+    Bench::SetExtraInfo(wxString::Format
+                        (
+                            "%.0f msgs/s, latency p50=%.0fus p90=%.0fus p99=%.0fus",
+                            gs_latencies.size() * 1e6 / gs_totalTime.ToDouble(),
+                            percentile(50),
+                            percentile(90),
+                            percentile(99)
+                        ));
+}
+
 class PokeAdviseConn : public wxConnection
 {
 public:
-    PokeAdviseConn() { m_gotAdvised = false; }
+    PokeAdviseConn() { m_gotAdvised = false; m_numFailed = 0; }
 
     bool GotAdvised()
     {
@@ -57,10 +108,46 @@ public:
         return true;
     }
 
+    // remember the time when the asynchronous request was sent
+    void RequestSent(int requestId)
+    {
+        m_pending[requestId] = wxGetUTCTimeUSec();
+    }
+
+    bool HasPendingRequests() const { return !m_pending.empty(); }
+
+    int GetNumFailedRequests() const { return m_numFailed; }
+
+    virtual bool OnRequestReply(int requestId,
+                                const void *data,
+                                size_t WXUNUSED(size),
+                                wxIPCFormat WXUNUSED(format))
+    {
+        const auto it = m_pending.find(requestId);
+        if ( it == m_pending.end() )
+        {
+            m_numFailed++;
+            return false;
+        }
+
+        if ( data )
+            gs_latencies.push_back((wxGetUTCTimeUSec() - it->second).ToDouble());
+        else
+            m_numFailed++;
+
+        m_pending.erase(it);
+
+        return true;
+    }
+
 private:
     wxString m_item;
     bool m_gotAdvised;
 
+    // the send times of the asynchronous requests without replies yet
+    std::unordered_map<int, wxLongLong> m_pending;
+    int m_numFailed;
+
     wxDECLARE_NO_COPY_CLASS(PokeAdviseConn);
 };
 
@@ -78,7 +165,14 @@ public:
 
         wxString service;
         int port = Bench::GetNumericParameter();
-        if ( !port )
+        if ( host.find('/') != wxString::npos )
+        {
+            // allow specifying the path of a Unix domain socket to connect
+            // to instead of the host name
+            service = host;
+            host = IPC_HOST;
+        }
+        else if ( !port )
             service = IPC_SERVICE;
         else
             service.Printf("%d", port);
@@ -160,10 +254,102 @@ BENCHMARK_FUNC_WITH_INIT(IPCPokeAdvise, ConnInit, ConnDone)
         return false;
 
     while ( !conn->GotAdvised() )
-        loop.Dispatch();
+        DispatchEvents(loop);
 
     if ( conn->GetItem() != s )
         return false;
 
     return true;
 }
+
+// ----------------------------------------------------------------------------
+// Request benchmarks
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+bool RequestInit()
+{
+    if ( !ConnInit() )
+        return false;
+
+    ResetStats();
+
+    // Set the item returned by the server to something non-trivial.
+    return theConnection->Get()->Poke(IPC_BENCHMARK_ITEM, wxString(100, '@'));
+}
+
+void RequestDone()
+{
+    ReportStats();
+
+    ConnDone();
+}
+
+// Send NUM_REQUESTS asynchronous requests, possibly batching them, and wait
+// for all the replies.
+bool DoRequestAsync(bool batch)
+{
+    wxEventLoop loop;
+
+    PokeAdviseConn * const conn = theConnection->Get();
+
+    const wxLongLong start = wxGetUTCTimeUSec();
+
+    if ( batch )
+        conn->BeginBatch();
+
+    for ( int n = 0; n < NUM_REQUESTS; n++ )
+    {
+        const int id = conn->RequestAsync(IPC_BENCHMARK_ITEM, wxIPC_UTF8TEXT);
+        if ( !id )
+            return false;
+
+        conn->RequestSent(id);
+    }
+
+    if ( batch && !conn->EndBatch() )
+        return false;
+
+    while ( conn->HasPendingRequests() )
+        DispatchEvents(loop);
+
+    gs_totalTime += wxGetUTCTimeUSec() - start;
+
+    return conn->GetNumFailedRequests() == 0;
+}
+
+} // anonymous namespace
+
+// Send requests one by one, waiting for the reply to each of them.
+BENCHMARK_FUNC_WITH_INIT(IPCRequest, RequestInit, RequestDone)
+{
+    PokeAdviseConn * const conn = theConnection->Get();
+
+    for ( int n = 0; n < NUM_REQUESTS; n++ )
+    {
+        const wxLongLong start = wxGetUTCTimeUSec();
+
+        if ( !conn->Request(IPC_BENCHMARK_ITEM, nullptr, wxIPC_UTF8TEXT) )
+            return false;
+
+        const wxLongLong time = wxGetUTCTimeUSec() - start;
+        gs_latencies.push_back(time.ToDouble());
+        gs_totalTime += time;
+    }
+
+    return true;
+}
+
+// Send all requests without waiting for the replies.
+BENCHMARK_FUNC_WITH_INIT(IPCRequestAsync, RequestInit, RequestDone)
+{
+    return DoRequestAsync(false);
+}
+
+// Same as above, but send all requests at once.
+BENCHMARK_FUNC_WITH_INIT(IPCRequestAsyncBatch, RequestInit, RequestDone)
+{
+    return DoRequestAsync(true);
+}
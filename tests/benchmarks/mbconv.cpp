@@ -10,6 +10,8 @@
 #include "wx/strconv.h"
 #include "wx/string.h"
 
+#include <string>
+
 #include "bench.h"
 
 namespace
@@ -76,3 +78,121 @@ BENCHMARK_FUNC(UTF16Sys)
     return ConvertToMB(wxCSConv("UTF-16LE"));
 }
 
+
+// ----------------------------------------------------------------------------
+// UTF-8 conversions throughput
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Mostly ASCII text, as typically found in e.g. log files.
+const char* const UTF8_ASCII =
+    "Lorem ipsum dolor sit amet, consectetur adipisicing elit, sed do eiusmod "
+    "tempor incididunt ut labore et dolore magna aliqua. Caf\xc3\xa9 2026.\n";
+
+// Mostly Chinese characters, encoded using 3 bytes each, with some ASCII.
+const char* const UTF8_CJK =
+    "\xe4\xb8\xad\xe6\x96\x87\xe6\x96\x87\xe6\x9c\xac\xe5\xa4\x84\xe7\x90\x86"
+    "\xe6\xb5\x8b\xe8\xaf\x95\xef\xbc\x8c\xe5\x8c\x85\xe5\x90\xab\xe5\xb8\xb8"
+    "\xe7\x94\xa8\xe6\xb1\x89\xe5\xad\x97\xe5\x92\x8c\xe6\xa0\x87\xe7\x82\xb9"
+    "\xe7\xac\xa6\xe5\x8f\xb7\xe3\x80\x82" " 2026\n";
+
+// Emoji, encoded using 4 bytes each and outside of the BMP.
+const char* const UTF8_EMOJI =
+    "\xf0\x9f\x98\x80\xf0\x9f\x98\x83\xf0\x9f\x98\x84\xf0\x9f\x98\x81"
+    "\xf0\x9f\x98\x86\xf0\x9f\x98\x85\xf0\x9f\xa4\xa3\xf0\x9f\x98\x82"
+    "\xf0\x9f\x99\x82\xf0\x9f\x99\x83" " ok\n";
+
+struct UTF8Data
+{
+    std::string utf8;
+    wxWCharBuffer wide;
+    size_t wideLen = 0;
+
+    // output buffers, allocated in advance to only measure the conversion
+    wxCharBuffer utf8Out;
+    wxWCharBuffer wideOut;
+};
+
+UTF8Data gs_utf8;
+
+// Prepare the text consisting of the given string repeated to make its size
+// equal to the numeric parameter value in KiB, 1MiB by default.
+bool InitUTF8(const char* text)
+{
+    const size_t size = Bench::GetNumericParameter(1024)*1024;
+
+    gs_utf8.utf8.clear();
+    gs_utf8.utf8.reserve(size + strlen(text));
+    while ( gs_utf8.utf8.length() < size )
+        gs_utf8.utf8 += text;
+
+    gs_utf8.wide = wxConvUTF8.cMB2WC(gs_utf8.utf8.data(),
+                                     gs_utf8.utf8.length(),
+                                     &gs_utf8.wideLen);
+    if ( !gs_utf8.wide.data() )
+        return false;
+
+    gs_utf8.utf8Out.extend(gs_utf8.utf8.length());
+    gs_utf8.wideOut.extend(gs_utf8.wideLen);
+
+    Bench::SetBytesPerRun(gs_utf8.utf8.length());
+
+    return true;
+}
+
+bool InitUTF8ASCII() { return InitUTF8(UTF8_ASCII); }
+bool InitUTF8CJK() { return InitUTF8(UTF8_CJK); }
+bool InitUTF8Emoji() { return InitUTF8(UTF8_EMOJI); }
+
+void DoneUTF8()
+{
+    gs_utf8 = UTF8Data();
+}
+
+bool ConvertFromUTF8()
+{
+    return wxConvUTF8.ToWChar(gs_utf8.wideOut.data(), gs_utf8.wideLen,
+                              gs_utf8.utf8.data(), gs_utf8.utf8.length())
+            == gs_utf8.wideLen;
+}
+
+bool ConvertToUTF8()
+{
+    return wxConvUTF8.FromWChar(gs_utf8.utf8Out.data(), gs_utf8.utf8.length(),
+                                gs_utf8.wide.data(), gs_utf8.wideLen)
+            == gs_utf8.utf8.length();
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(UTF8ToWCharASCII, InitUTF8ASCII, DoneUTF8)
+{
+    return ConvertFromUTF8();
+}
+
+BENCHMARK_FUNC_WITH_INIT(UTF8ToWCharCJK, InitUTF8CJK, DoneUTF8)
+{
+    return ConvertFromUTF8();
+}
+
+BENCHMARK_FUNC_WITH_INIT(UTF8ToWCharEmoji, InitUTF8Emoji, DoneUTF8)
+{
+    return ConvertFromUTF8();
+}
+
+BENCHMARK_FUNC_WITH_INIT(UTF8FromWCharASCII, InitUTF8ASCII, DoneUTF8)
+{
+    return ConvertToUTF8();
+}
+
+BENCHMARK_FUNC_WITH_INIT(UTF8FromWCharCJK, InitUTF8CJK, DoneUTF8)
+{
+    return ConvertToUTF8();
+}
+
+BENCHMARK_FUNC_WITH_INIT(UTF8FromWCharEmoji, InitUTF8Emoji, DoneUTF8)
+{
+    return ConvertToUTF8();
+}
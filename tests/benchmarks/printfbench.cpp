@@ -132,3 +132,64 @@ BENCHMARK_FUNC(SystemSnprintf)
     return true;
 }
 
+
+// ----------------------------------------------------------------------------
+// wxString::Format() benchmarks
+// ----------------------------------------------------------------------------
+
+BENCHMARK_FUNC(StringFormatShort)
+{
+    const wxString s = wxString::Format("This is a short %s string with very few words", "test");
+
+    return s.length() > 0;
+}
+
+BENCHMARK_FUNC(StringFormatLong)
+{
+    const wxString s = wxString::Format
+                       (
+                        "This is a reasonably long string with various %s arguments, exactly %d, "
+                        "and is used as benchmark for %s - %% %.2f %d %s",
+                        "(many!!)", 6, "this program", 23.342f, 999,
+                        g_verylongString
+                       );
+
+    return s.length() > 0;
+}
+
+BENCHMARK_FUNC(StringFormatWithPositionals)
+{
+#if wxUSE_PRINTF_POS_PARAMS
+    const wxString s = wxString::Format
+                       (
+                        "This is a %2$s and thus is harder to parse... nonetheless, %1$s !",
+                        "test it", "string with positional arguments"
+                       );
+
+    return s.length() > 0;
+#else
+    return true;
+#endif
+}
+
+BENCHMARK_FUNC(StringFormatLogRecord)
+{
+    static int s_record = 0;
+    static const wxString s_name("some.config.value");
+
+    s_record++;
+
+    const wxString s = wxString::Format("Record %d: %s = %.2f",
+                                        s_record, s_name, s_record / 7.);
+
+    return s.length() > 0;
+}
+
+BENCHMARK_FUNC(StringPrintfReuse)
+{
+    static wxString s_buf;
+
+    s_buf.Printf("%s:%d: %s", "file.cpp", 1234, "message");
+
+    return s_buf.length() > 0;
+}
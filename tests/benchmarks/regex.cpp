@@ -12,6 +12,8 @@
 
 #include "bench.h"
 
+#if wxUSE_REGEX
+
 // ----------------------------------------------------------------------------
 // Benchmark relative costs of compiling and matching for a simple regex
 // ----------------------------------------------------------------------------
@@ -29,11 +31,40 @@ BENCHMARK_FUNC(REMatch)
     return re.Matches("foo");
 }
 
+BENCHMARK_FUNC(REMatchJIT)
+{
+    static wxRegEx re(RE_SIMPLE, wxRE_JIT);
+    return re.Matches("foo");
+}
+
 BENCHMARK_FUNC(RECompileAndMatch)
 {
     return wxRegEx(RE_SIMPLE).Matches("foo");
 }
 
+// Compiled patterns are cached by default, so also check how long does it
+// take to really compile them.
+static bool DisableRECache()
+{
+    wxRegEx::SetCacheSize(0);
+    return true;
+}
+
+static void EnableRECache()
+{
+    wxRegEx::SetCacheSize(32);
+}
+
+BENCHMARK_FUNC_WITH_INIT(RECompileUncached, DisableRECache, EnableRECache)
+{
+    return wxRegEx(RE_SIMPLE).IsValid();
+}
+
+BENCHMARK_FUNC_WITH_INIT(RECompileJITUncached, DisableRECache, EnableRECache)
+{
+    return wxRegEx(RE_SIMPLE, wxRE_JIT).IsValid();
+}
+
 // ----------------------------------------------------------------------------
 // Benchmark the cost of using a more complicated regex
 // ----------------------------------------------------------------------------
@@ -53,15 +84,17 @@ const wxString& GetTestText()
     return text;
 }
 
-} // anonymous namespace
+// This is too simplistic, but good enough for benchmarking.
+const char* const RE_TD = "<td>[^<]*</td>";
 
-BENCHMARK_FUNC(REFindTD)
+bool FindAllTD(const wxRegEx& re)
 {
-    // This is too simplistic, but good enough for benchmarking.
-    static wxRegEx re("<td>[^<]*</td>", wxRE_ICASE | wxRE_NEWLINE);
+    const wxString& text = GetTestText();
+    const wxChar* p = text.c_str();
+    const wxChar* const end = p + text.length();
 
     int matches = 0;
-    for ( const wxChar* p = GetTestText().c_str(); re.Matches(p); ++matches )
+    for ( ; re.Matches(p, 0, end - p); ++matches )
     {
         size_t start, len;
         if ( !re.GetMatch(&start, &len) )
@@ -70,5 +103,25 @@ BENCHMARK_FUNC(REFindTD)
         p += start + len;
     }
 
-    return matches == 21; // result of "grep -c"
+    // This is one more than "grep -c" finds as one of the cells spans two
+    // lines.
+    return matches == 22;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(REFindTD)
+{
+    static wxRegEx re(RE_TD, wxRE_ICASE | wxRE_NEWLINE);
+
+    return FindAllTD(re);
+}
+
+BENCHMARK_FUNC(REFindTDJIT)
+{
+    static wxRegEx re(RE_TD, wxRE_ICASE | wxRE_NEWLINE | wxRE_JIT);
+
+    return FindAllTD(re);
 }
+
+#endif // wxUSE_REGEX
@@ -0,0 +1,314 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/socket.cpp
+// Purpose:     wxSocket loopback throughput benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench.h"
+
+#include "wx/socket.h"
+
+#if wxUSE_SOCKETS && wxUSE_THREADS
+
+#include "wx/file.h"
+#include "wx/filename.h"
+#include "wx/thread.h"
+#include "wx/time.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+// The number of messages sent by a single benchmark iteration.
+const int NUM_MESSAGES = 1000;
+
+// The size of the file sent by the file benchmarks.
+const int FILE_SIZE = 4*1024*1024;
+
+// Thread reading everything from the socket and counting the bytes read.
+class DrainThread : public wxThread
+{
+public:
+    explicit DrainThread(wxSocketBase& socket)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_socket(socket)
+    {
+    }
+
+    std::atomic<wxUint64> m_numRead{0};
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        std::vector<char> buf(64*1024);
+        for ( ;; )
+        {
+            const wxUint32 n = m_socket.Read(&buf[0], buf.size()).LastReadCount();
+            if ( !n )
+                break;
+
+            m_numRead += n;
+        }
+
+        return 0;
+    }
+
+private:
+    wxSocketBase& m_socket;
+};
+
+std::unique_ptr<wxSocketClient> gs_client;
+std::unique_ptr<wxSocketBase> gs_peer;
+std::unique_ptr<DrainThread> gs_drain;
+
+// The number of bytes written and the time taken by it.
+wxUint64 gs_numWritten = 0;
+wxLongLong gs_totalTime;
+
+bool InitSockets()
+{
+    wxIPV4address addr;
+    addr.LocalHost();
+    addr.Service(19901); // Arbitrary port number
+
+    wxSocketServer server(addr, wxSOCKET_BLOCK | wxSOCKET_REUSEADDR);
+    if ( !server.IsOk() )
+        return false;
+
+    gs_client.reset(new wxSocketClient(wxSOCKET_BLOCK | wxSOCKET_WAITALL));
+    gs_client->Connect(addr, false);
+
+    gs_peer.reset(server.Accept());
+    if ( !gs_peer || !gs_client->WaitOnConnect(10) )
+        return false;
+
+    gs_peer->SetFlags(wxSOCKET_BLOCK);
+
+    gs_drain.reset(new DrainThread(*gs_peer));
+    if ( gs_drain->Run() != wxTHREAD_NO_ERROR )
+        return false;
+
+    gs_numWritten = 0;
+    gs_totalTime = 0;
+
+    return true;
+}
+
+void DoneSockets()
+{
+    if ( gs_totalTime > 0 )
+    {
+        Bench::SetExtraInfo(wxString::Format
+                            (
+                                "%.1f MB/s",
+                                gs_numWritten / gs_totalTime.ToDouble()
+                            ));
+    }
+
+    gs_client.reset();
+    if ( gs_drain )
+    {
+        gs_drain->Wait();
+        gs_drain.reset();
+    }
+    gs_peer.reset();
+}
+
+// Wait until everything written was read by the other end and update the
+// statistics.
+bool FinishWriting(wxLongLong start, wxUint32 numWritten)
+{
+    if ( gs_client->Error() )
+        return false;
+
+    gs_numWritten += numWritten;
+
+    while ( gs_drain->m_numRead < gs_numWritten )
+        wxThread::Yield();
+
+    gs_totalTime += wxGetUTCTimeUSec() - start;
+
+    return true;
+}
+
+// Return the size of the message payload, which can be changed using the
+// numeric parameter and is 100 bytes by default.
+wxUint32 GetPayloadSize()
+{
+    return Bench::GetNumericParameter(100);
+}
+
+// Header and trailer used by the message benchmarks, just as WriteMsg() does.
+char gs_header[8];
+char gs_trailer[8];
+
+} // anonymous namespace
+
+// Write messages consisting of a header, payload and trailer using a separate
+// call for each of their parts.
+BENCHMARK_FUNC_WITH_INIT(SocketWriteSplit, InitSockets, DoneSockets)
+{
+    std::vector<char> payload(GetPayloadSize());
+
+    const wxLongLong start = wxGetUTCTimeUSec();
+
+    wxUint32 total = 0;
+    for ( int n = 0; n < NUM_MESSAGES; n++ )
+    {
+        total += gs_client->Write(gs_header, sizeof(gs_header)).LastWriteCount();
+        total += gs_client->Write(&payload[0], payload.size()).LastWriteCount();
+        total += gs_client->Write(gs_trailer, sizeof(gs_trailer)).LastWriteCount();
+    }
+
+    return FinishWriting(start, total);
+}
+
+// Same as above, but write all parts of the message at once.
+BENCHMARK_FUNC_WITH_INIT(SocketWriteV, InitSockets, DoneSockets)
+{
+    std::vector<char> payload(GetPayloadSize());
+
+    const wxSocketIOVec vec[] =
+    {
+        { gs_header, sizeof(gs_header) },
+        { &payload[0], static_cast<wxUint32>(payload.size()) },
+        { gs_trailer, sizeof(gs_trailer) },
+    };
+
+    const wxLongLong start = wxGetUTCTimeUSec();
+
+    wxUint32 total = 0;
+    for ( int n = 0; n < NUM_MESSAGES; n++ )
+        total += gs_client->WriteV(vec, WXSIZEOF(vec)).LastWriteCount();
+
+    return FinishWriting(start, total);
+}
+
+// Use WriteMsg() which writes the messages in the same format.
+BENCHMARK_FUNC_WITH_INIT(SocketWriteMsg, InitSockets, DoneSockets)
+{
+    std::vector<char> payload(GetPayloadSize());
+
+    const wxLongLong start = wxGetUTCTimeUSec();
+
+    wxUint32 total = 0;
+    for ( int n = 0; n < NUM_MESSAGES; n++ )
+    {
+        // Account for the header and trailer too.
+        total += gs_client->WriteMsg(&payload[0], payload.size())
+                            .LastWriteCount() + 16;
+    }
+
+    return FinishWriting(start, total);
+}
+
+// Push back some data and read it in several parts, this only uses the
+// pushback buffer and doesn't read anything from the socket itself.
+BENCHMARK_FUNC_WITH_INIT(SocketUnread, InitSockets, DoneSockets)
+{
+    char buf[64];
+
+    for ( int n = 0; n < NUM_MESSAGES; n++ )
+    {
+        gs_client->Unread(buf, sizeof(buf));
+
+        for ( int part = 0; part < 4; part++ )
+        {
+            gs_client->Read(buf, sizeof(buf) / 4);
+            if ( gs_client->LastReadCount() != sizeof(buf) / 4 )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// File sending benchmarks
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+wxString gs_filename;
+
+bool InitFile()
+{
+    if ( !InitSockets() )
+        return false;
+
+    gs_filename = wxFileName::CreateTempFileName("wxsockbench");
+
+    wxFile file(gs_filename, wxFile::write);
+    if ( !file.IsOpened() )
+        return false;
+
+    std::vector<char> data(FILE_SIZE);
+    for ( size_t n = 0; n < data.size(); n++ )
+        data[n] = static_cast<char>(n);
+
+    return file.Write(&data[0], data.size()) == data.size();
+}
+
+void DoneFile()
+{
+    DoneSockets();
+
+    if ( !gs_filename.empty() )
+    {
+        wxRemoveFile(gs_filename);
+        gs_filename.clear();
+    }
+}
+
+} // anonymous namespace
+
+// Send the file by reading it into a buffer and writing it.
+BENCHMARK_FUNC_WITH_INIT(SocketSendFileCopy, InitFile, DoneFile)
+{
+    wxFile file(gs_filename);
+    if ( !file.IsOpened() )
+        return false;
+
+    std::vector<char> buf(64*1024);
+
+    const wxLongLong start = wxGetUTCTimeUSec();
+
+    wxUint32 total = 0;
+    for ( ;; )
+    {
+        const ssize_t n = file.Read(&buf[0], buf.size());
+        if ( n <= 0 )
+            break;
+
+        total += gs_client->Write(&buf[0], n).LastWriteCount();
+    }
+
+    if ( total != FILE_SIZE )
+        return false;
+
+    return FinishWriting(start, total);
+}
+
+// Send the file using WriteFile().
+BENCHMARK_FUNC_WITH_INIT(SocketSendFile, InitFile, DoneFile)
+{
+    wxFile file(gs_filename);
+    if ( !file.IsOpened() )
+        return false;
+
+    const wxLongLong start = wxGetUTCTimeUSec();
+
+    if ( gs_client->WriteFile(file, FILE_SIZE).LastWriteCount() != FILE_SIZE )
+        return false;
+
+    return FinishWriting(start, FILE_SIZE);
+}
+
+#endif // wxUSE_SOCKETS && wxUSE_THREADS
@@ -10,6 +10,7 @@
 #include "wx/string.h"
 #include "wx/ffile.h"
 #include "wx/arrstr.h"
+#include "wx/hashmap.h"
 
 #include "bench.h"
 #include "htmlparser/htmlpars.h"
@@ -59,6 +60,38 @@ const wxString& GetTestAsciiString()
     return testString;
 }
 
+const wxString& GetTestUTF8String()
+{
+    static wxString testString;
+    if ( testString.empty() )
+    {
+        long num = Bench::GetNumericParameter();
+        if ( !num )
+            num = 1;
+
+        for ( long n = 0; n < num; n++ )
+            testString += wxString::FromUTF8(utf8str);
+    }
+
+    return testString;
+}
+
+// Access all characters of the string in pseudo-random order.
+bool IndexRandomly(const wxString& s)
+{
+    const size_t len = s.length();
+    size_t pos = 0;
+    for ( size_t n = 0; n < len; n++ )
+    {
+        // Use a big prime step to jump all over the string.
+        pos = (pos + 7919) % len;
+        if ( s[pos] == '~' )
+            return false;
+    }
+
+    return true;
+}
+
 } // anonymous namespace
 
 // this is just a baseline
@@ -245,6 +278,66 @@ BENCHMARK_FUNC(ForStringRIter)
     return true;
 }
 
+// Index-based access to the non-ASCII strings is much more expensive in UTF-8
+// build, check that it's still reasonably fast for all access patterns.
+BENCHMARK_FUNC(ForStringIndexUTF8)
+{
+    const wxString& s = GetTestUTF8String();
+    const size_t len = s.length();
+    for ( size_t n = 0; n < len; n++ )
+    {
+        if ( s[n] == '~' )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC(ForStringRIndexUTF8)
+{
+    const wxString& s = GetTestUTF8String();
+    for ( size_t n = s.length(); n > 0; n-- )
+    {
+        if ( s[n - 1] == '~' )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC(RandomIndexASCII)
+{
+    return IndexRandomly(GetTestAsciiString());
+}
+
+BENCHMARK_FUNC(RandomIndexUTF8)
+{
+    return IndexRandomly(GetTestUTF8String());
+}
+
+// Appending to the string shouldn't make the subsequent index access to it
+// slower than for a string which is not modified.
+BENCHMARK_FUNC(AppendIndexUTF8)
+{
+    const wxString chunk = wxString::FromUTF8("\xd0\x9f\xd1\x80\xd0\xb8"
+                                              "\xd0\xb2\xd0\xb5\xd1\x82 "
+                                              "world ");
+    const size_t chunkLen = chunk.length();
+
+    wxString s;
+    size_t len = 0;
+    for ( size_t n = 0; n < 1000; n++ )
+    {
+        s += chunk;
+        len += chunkLen;
+
+        if ( s[(n*7919) % len] == '~' )
+            return false;
+    }
+
+    return true;
+}
+
 // ----------------------------------------------------------------------------
 // wxString::Replace()
 // ----------------------------------------------------------------------------
@@ -329,6 +422,117 @@ BENCHMARK_FUNC(ArrStrSort)
     return !a.empty();
 }
 
+// Return the array of strings similar to the names in a symbol table, with
+// long common prefixes, in random order.
+static const wxArrayString& GetSymbols()
+{
+    static wxArrayString s_symbols;
+    if ( s_symbols.empty() )
+    {
+        static const char* const prefixes[] =
+            { "wxString::", "wxArrayString::", "wxDateTime::", "WXDLLIMPEXP_" };
+
+        unsigned seed = 1;
+        for ( int i = 0; i < 10000; ++i )
+        {
+            seed = seed * 1103515245 + 12345;
+            s_symbols.push_back(wxString::Format("%sSymbol%u",
+                                prefixes[i % WXSIZEOF(prefixes)], seed >> 8));
+        }
+    }
+
+    return s_symbols;
+}
+
+BENCHMARK_FUNC(ArrStrSortSymbols)
+{
+    wxArrayString a(GetSymbols());
+    a.Sort();
+    return !a.empty();
+}
+
+BENCHMARK_FUNC(ArrStrSortSymbolsWithFunction)
+{
+    wxArrayString a(GetSymbols());
+    a.Sort(wxStringSortAscending);
+    return !a.empty();
+}
+
+BENCHMARK_FUNC(ArrStrSortNoCaseSymbols)
+{
+    wxArrayString a(GetSymbols());
+    a.SortNoCase();
+    return !a.empty();
+}
+
+BENCHMARK_FUNC(ArrStrSortNoCaseSymbolsWithFunction)
+{
+    wxArrayString a(GetSymbols());
+    a.Sort(wxDictionaryStringSortAscending);
+    return !a.empty();
+}
+
+BENCHMARK_FUNC(SortedArrStrAddSymbols)
+{
+    const wxArrayString& symbols = GetSymbols();
+
+    wxSortedArrayString a;
+    for ( size_t n = 0; n < symbols.size(); ++n )
+        a.Add(symbols[n]);
+    return !a.empty();
+}
+
+BENCHMARK_FUNC(SortedArrStrMergeSymbols)
+{
+    wxSortedArrayString a;
+    a.Merge(GetSymbols());
+    return !a.empty();
+}
+
+BENCHMARK_FUNC(ArrStrIndexSymbols)
+{
+    const wxArrayString& symbols = GetSymbols();
+
+    bool found = true;
+    for ( size_t n = 0; n < 100; ++n )
+        found &= symbols.Index(symbols[n * 97]) != wxNOT_FOUND;
+    return found;
+}
+
+BENCHMARK_FUNC(ArrStrIndexSymbolsHashed)
+{
+    static wxArrayStringIndex s_index(GetSymbols());
+
+    const wxArrayString& symbols = GetSymbols();
+
+    bool found = true;
+    for ( size_t n = 0; n < 100; ++n )
+        found &= s_index.Index(symbols[n * 97]) != wxNOT_FOUND;
+    return found;
+}
+
+BENCHMARK_FUNC(ArrStrIndexNoCaseSymbols)
+{
+    const wxArrayString& symbols = GetSymbols();
+
+    bool found = true;
+    for ( size_t n = 0; n < 10; ++n )
+        found &= symbols.Index(symbols[n * 997].Upper(), false) != wxNOT_FOUND;
+    return found;
+}
+
+BENCHMARK_FUNC(ArrStrIndexNoCaseSymbolsHashed)
+{
+    static wxArrayStringIndex s_index(GetSymbols(), false);
+
+    const wxArrayString& symbols = GetSymbols();
+
+    bool found = true;
+    for ( size_t n = 0; n < 10; ++n )
+        found &= s_index.Index(symbols[n * 997].Upper()) != wxNOT_FOUND;
+    return found;
+}
+
 BENCHMARK_FUNC(VectorStrPushBack)
 {
     std::vector<wxString> v;
@@ -421,6 +625,19 @@ BENCHMARK_FUNC(StringCmpNoCase)
     return s.CmpNoCase(s) == 0;
 }
 
+BENCHMARK_FUNC(StringCmpNoCaseDifferentCase)
+{
+    const wxString& s = GetTestAsciiString();
+    static const wxString s_upper = s.Upper();
+
+    return s.CmpNoCase(s_upper) == 0;
+}
+
+BENCHMARK_FUNC(StringHashNoCase)
+{
+    return wxStringHashNoCase()(GetTestAsciiString()) != 0;
+}
+
 // Also benchmark various native functions under MSW. Surprisingly/annoyingly
 // they sometimes have vastly better performance than alternatives, especially
 // for case-sensitive comparison (see #10375).
@@ -0,0 +1,130 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/threadpool.cpp
+// Purpose:     wxThreadPool benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench.h"
+
+#include "wx/threadpool.h"
+
+#if wxUSE_THREADS
+
+#include "wx/thread.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+// The counter incremented by all the tasks below.
+std::atomic<long> gs_counter{0};
+
+void DoTask()
+{
+    gs_counter++;
+}
+
+// Return the number of tasks to run, which can be changed using the numeric
+// parameter and is 100 by default.
+long GetNumTasks()
+{
+    return Bench::GetNumericParameter(100);
+}
+
+// Thread executing the same trivial task, used for comparison with the pool.
+class TaskThread : public wxThread
+{
+public:
+    TaskThread() : wxThread(wxTHREAD_JOINABLE) { }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        DoTask();
+        return 0;
+    }
+};
+
+bool InitPool()
+{
+    // Create the default pool outside of the benchmark itself.
+    return wxThreadPool::GetDefault().GetThreadCount() > 0;
+}
+
+} // anonymous namespace
+
+// Run the tasks one after another, waiting for each of them to finish before
+// starting the next one: this measures the task spawn overhead and latency.
+BENCHMARK_FUNC_WITH_INIT(ThreadPoolSpawn, InitPool, nullptr)
+{
+    wxThreadPool& pool = wxThreadPool::GetDefault();
+
+    const long numTasks = GetNumTasks();
+    for ( long n = 0; n < numTasks; n++ )
+    {
+        if ( !pool.Submit(DoTask).Wait() )
+            return false;
+    }
+
+    return true;
+}
+
+// Same as above, but create a new thread for each task.
+BENCHMARK_FUNC(RawThreadSpawn)
+{
+    const long numTasks = GetNumTasks();
+    for ( long n = 0; n < numTasks; n++ )
+    {
+        TaskThread thread;
+        if ( thread.Run() != wxTHREAD_NO_ERROR )
+            return false;
+
+        thread.Wait();
+    }
+
+    return true;
+}
+
+// Submit all tasks at once and wait until they all finish.
+BENCHMARK_FUNC_WITH_INIT(ThreadPoolBatch, InitPool, nullptr)
+{
+    const long counterBefore = gs_counter;
+
+    wxTaskGroup group;
+
+    const long numTasks = GetNumTasks();
+    for ( long n = 0; n < numTasks; n++ )
+        group.Run(DoTask);
+
+    group.Wait();
+
+    return gs_counter - counterBefore == numTasks;
+}
+
+// Same as above, but create a thread for each task.
+BENCHMARK_FUNC(RawThreadBatch)
+{
+    const long counterBefore = gs_counter;
+
+    const long numTasks = GetNumTasks();
+    std::vector<std::unique_ptr<TaskThread>> threads;
+    for ( long n = 0; n < numTasks; n++ )
+    {
+        threads.emplace_back(new TaskThread);
+        if ( threads.back()->Run() != wxTHREAD_NO_ERROR )
+            return false;
+    }
+
+    for ( const auto& thread : threads )
+        thread->Wait();
+
+    return gs_counter - counterBefore == numTasks;
+}
+
+#endif // wxUSE_THREADS
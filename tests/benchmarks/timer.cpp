@@ -0,0 +1,80 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/timer.cpp
+// Purpose:     wxTimer benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench.h"
+
+#include "wx/timer.h"
+
+#if wxUSE_TIMER
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+// The timers used by the benchmarks below, their number can be changed using
+// the numeric parameter and is 10000 by default.
+std::vector<std::unique_ptr<wxTimer>> gs_timers;
+
+bool InitTimers()
+{
+    const long numTimers = Bench::GetNumericParameter(10000);
+    for ( long n = 0; n < numTimers; n++ )
+        gs_timers.emplace_back(new wxTimer);
+
+    return true;
+}
+
+void DoneTimers()
+{
+    gs_timers.clear();
+}
+
+// Return the interval for the timer with the given index: use intervals which
+// are long enough for the timers to never expire while the benchmark is
+// running and mix them up to avoid always adding the timers at the end.
+int GetInterval(size_t n)
+{
+    return 60000 + static_cast<int>((n * 7919) % 10007);
+}
+
+} // anonymous namespace
+
+// Start all timers and then stop them in a different order.
+BENCHMARK_FUNC_WITH_INIT(TimerStartStop, InitTimers, DoneTimers)
+{
+    const size_t numTimers = gs_timers.size();
+    for ( size_t n = 0; n < numTimers; n++ )
+        gs_timers[n]->Start(GetInterval(n));
+
+    for ( size_t n = 0; n < numTimers; n++ )
+        gs_timers[(n * 7919) % numTimers]->Stop();
+
+    return !gs_timers.empty() && !gs_timers[0]->IsRunning();
+}
+
+// Restart all timers several times, as happens when timers are used for
+// timeouts which are reset on each activity.
+BENCHMARK_FUNC_WITH_INIT(TimerRestart, InitTimers, DoneTimers)
+{
+    const size_t numTimers = gs_timers.size();
+    for ( int i = 0; i < 5; i++ )
+    {
+        for ( size_t n = 0; n < numTimers; n++ )
+            gs_timers[n]->Start(GetInterval(n + i));
+    }
+
+    for ( size_t n = 0; n < numTimers; n++ )
+        gs_timers[n]->Stop();
+
+    return !gs_timers.empty() && !gs_timers[0]->IsRunning();
+}
+
+#endif // wxUSE_TIMER
@@ -26,6 +26,10 @@
 #include "testableframe.h"
 #include "asserthelper.h"
 
+#include <memory>
+#include <utility>
+#include <vector>
+
 // ----------------------------------------------------------------------------
 // test class
 // ----------------------------------------------------------------------------
@@ -861,6 +865,564 @@ TEST_CASE_METHOD(MultiColumnsDataViewCtrlTestCase,
     CHECK( m_lastColumn->GetWidth() >= lastColumnMinWidth );
 }
 
+namespace
+{
+
+// Simple list model allowing to delete several rows at once, which results in
+// a single ItemsDeleted() notification.
+class IndexListTestModel : public wxDataViewIndexListModel
+{
+public:
+    explicit IndexListTestModel(unsigned count)
+        : wxDataViewIndexListModel(count)
+    {
+        for ( unsigned n = 0; n < count; n++ )
+            m_values.push_back(wxString::Format("%u", n));
+    }
+
+    void DeleteRows(const wxArrayInt& rows)
+    {
+        wxArrayInt sorted = rows;
+        sorted.Sort([](int* a, int* b) { return *b - *a; });
+        for ( size_t n = 0; n < sorted.size(); n++ )
+            m_values.erase(m_values.begin() + sorted[n]);
+
+        RowsDeleted(rows);
+    }
+
+    void ChangeRow(unsigned row, const wxString& value)
+    {
+        m_values[row] = value;
+
+        RowChanged(row);
+    }
+
+    void GetValueByRow(wxVariant& variant,
+                       unsigned int row,
+                       unsigned int WXUNUSED(col)) const override
+    {
+        variant = m_values[row];
+    }
+
+    bool SetValueByRow(const wxVariant& WXUNUSED(variant),
+                       unsigned int WXUNUSED(row),
+                       unsigned int WXUNUSED(col)) override
+    {
+        return false;
+    }
+
+private:
+    wxVector<wxString> m_values;
+};
+
+// Virtual list model whose deleted rows can still be found by the notifiers,
+// unlike those of wxDataViewIndexListModel.
+class VirtualListTestModel : public wxDataViewVirtualListModel
+{
+public:
+    explicit VirtualListTestModel(unsigned count)
+        : wxDataViewVirtualListModel(count)
+    {
+        for ( unsigned n = 0; n < count; n++ )
+            m_values.push_back(wxString::Format("%u", n));
+    }
+
+    void InsertRow(unsigned row, const wxString& value)
+    {
+        m_values.insert(m_values.begin() + row, value);
+
+        RowInserted(row);
+    }
+
+    void DeleteRow(unsigned row)
+    {
+        m_values.erase(m_values.begin() + row);
+
+        RowDeleted(row);
+    }
+
+    void DeleteRows(const wxArrayInt& rows)
+    {
+        wxArrayInt sorted = rows;
+        sorted.Sort([](int* a, int* b) { return *b - *a; });
+        for ( size_t n = 0; n < sorted.size(); n++ )
+            m_values.erase(m_values.begin() + sorted[n]);
+
+        RowsDeleted(rows);
+    }
+
+    void GetValueByRow(wxVariant& variant,
+                       unsigned int row,
+                       unsigned int WXUNUSED(col)) const override
+    {
+        variant = m_values[row];
+    }
+
+    bool SetValueByRow(const wxVariant& WXUNUSED(variant),
+                       unsigned int WXUNUSED(row),
+                       unsigned int WXUNUSED(col)) override
+    {
+        return false;
+    }
+
+private:
+    wxVector<wxString> m_values;
+};
+
+// Filter model showing only the rows containing the given string.
+class SubstringFilterModel : public wxDataViewFilterListModel
+{
+public:
+    explicit SubstringFilterModel(wxDataViewListModel* source)
+        : wxDataViewFilterListModel(source)
+    {
+    }
+
+    void SetSearch(const wxString& search) { m_search = search; }
+
+    bool IsRowShown(unsigned int sourceRow) const override
+    {
+        m_numChecked++;
+
+        wxVariant value;
+        GetSourceModel()->GetValueByRow(value, sourceRow, 0);
+        return value.GetString().Contains(m_search);
+    }
+
+    mutable unsigned m_numChecked = 0;
+
+private:
+    wxString m_search;
+};
+
+} // anonymous namespace
+
+TEST_CASE("wxDVC::FilterModel", "[wxDataViewCtrl][filter]")
+{
+    wxObjectDataPtr<IndexListTestModel> source(new IndexListTestModel(100));
+    wxObjectDataPtr<SubstringFilterModel>
+        model(new SubstringFilterModel(source.get()));
+
+    CHECK( model->GetCount() == 100 );
+
+    model->SetSearch("1");
+    model->Refilter();
+    CHECK( model->m_numChecked == 100 );
+
+    // 1, 10..19 and 21, 31, ..., 91.
+    REQUIRE( model->GetCount() == 19 );
+    CHECK( model->GetSourceRow(0) == 1 );
+    CHECK( model->GetSourceRow(1) == 10 );
+    CHECK( model->FindRow(21) == 11 );
+    CHECK( model->FindRow(22) == wxNOT_FOUND );
+
+    wxVariant value;
+    model->GetValueByRow(value, 18, 0);
+    CHECK( value.GetString() == "91" );
+
+    // Refining the filter must only check the rows matching the old one.
+    model->m_numChecked = 0;
+    model->SetSearch("11");
+    model->RefineFilter();
+    CHECK( model->m_numChecked == 19 );
+    REQUIRE( model->GetCount() == 1 );
+    CHECK( model->GetSourceRow(0) == 11 );
+
+    // Changing the source model should update the filtered rows.
+    source->ChangeRow(50, "110");
+    REQUIRE( model->GetCount() == 2 );
+    CHECK( model->GetSourceRow(1) == 50 );
+
+    source->ChangeRow(11, "eleven");
+    REQUIRE( model->GetCount() == 1 );
+    CHECK( model->GetSourceRow(0) == 50 );
+
+    model->ResetFilter();
+    CHECK( model->GetCount() == 100 );
+}
+
+TEST_CASE("wxDVC::FilterModelUpdate", "[wxDataViewCtrl][filter]")
+{
+    wxObjectDataPtr<VirtualListTestModel> source(new VirtualListTestModel(100));
+    wxObjectDataPtr<SubstringFilterModel>
+        model(new SubstringFilterModel(source.get()));
+
+    model->SetSearch("1");
+    model->Refilter();
+    REQUIRE( model->GetCount() == 19 );
+
+    // Inserting a row must only check it and shift the following ones.
+    model->m_numChecked = 0;
+    source->InsertRow(5, "x1");
+    CHECK( model->m_numChecked == 1 );
+    REQUIRE( model->GetCount() == 20 );
+    CHECK( model->GetSourceRow(0) == 1 );
+    CHECK( model->GetSourceRow(1) == 5 );
+    CHECK( model->GetSourceRow(2) == 11 );
+
+    source->InsertRow(0, "none");
+    CHECK( model->m_numChecked == 2 );
+    REQUIRE( model->GetCount() == 20 );
+    CHECK( model->GetSourceRow(0) == 2 );
+    CHECK( model->FindRow(12) == 2 );
+
+    // Deleting rows must not check anything at all.
+    source->DeleteRow(0);
+    CHECK( model->m_numChecked == 2 );
+    REQUIRE( model->GetCount() == 20 );
+    CHECK( model->GetSourceRow(0) == 1 );
+    CHECK( model->GetSourceRow(1) == 5 );
+
+    // Delete "0", "1" and "x1" at once.
+    wxArrayInt rows;
+    rows.push_back(5);
+    rows.push_back(0);
+    rows.push_back(1);
+    source->DeleteRows(rows);
+    CHECK( model->m_numChecked == 2 );
+    REQUIRE( model->GetCount() == 18 );
+    CHECK( model->GetSourceRow(0) == 8 );
+
+    wxVariant value;
+    model->GetValueByRow(value, 0, 0);
+    CHECK( value.GetString() == "10" );
+    model->GetValueByRow(value, 17, 0);
+    CHECK( value.GetString() == "91" );
+}
+
+TEST_CASE("wxDVC::DeleteRows", "[wxDataViewCtrl][delete]")
+{
+    std::unique_ptr<wxDataViewCtrl> dvc(new wxDataViewCtrl(
+                                            wxTheApp->GetTopWindow(),
+                                            wxID_ANY,
+                                            wxDefaultPosition,
+                                            wxSize(400, 200),
+                                            wxDV_MULTIPLE));
+
+    IndexListTestModel* const model = new IndexListTestModel(10);
+    dvc->AssociateModel(model);
+    model->DecRef();
+
+    dvc->AppendTextColumn("Value", 0);
+
+    dvc->Select(model->GetItem(1));
+    dvc->Select(model->GetItem(7));
+
+    wxArrayInt rows;
+    rows.push_back(5);
+    rows.push_back(2);
+    rows.push_back(3);
+    model->DeleteRows(rows);
+
+    // The selected rows must have been shifted by the number of deleted rows
+    // preceding them.
+    wxDataViewItemArray sel;
+    REQUIRE( dvc->GetSelections(sel) == 2 );
+
+    wxVariant value;
+    model->GetValue(value, sel[0], 0);
+    CHECK( value.GetString() == "1" );
+    model->GetValue(value, sel[1], 0);
+    CHECK( value.GetString() == "7" );
+
+    CHECK( model->GetRow(sel[1]) == 4 );
+}
+
+#ifdef wxHAS_GENERIC_DATAVIEWCTRL
+
+namespace
+{
+
+// Tree model with only top level items, which, unlike the list models, can
+// add several items with a single ItemsAdded() notification.
+class FlatTreeTestModel : public wxDataViewModel
+{
+public:
+    explicit FlatTreeTestModel(unsigned count)
+    {
+        for ( unsigned n = 0; n < count; n++ )
+            m_items.push_back(NewItem(wxString::Format("%u", n)));
+    }
+
+    wxDataViewItem GetItem(unsigned pos) const { return m_items[pos]; }
+
+    void InsertItems(unsigned pos, const wxArrayString& values)
+    {
+        wxDataViewItemArray items;
+        for ( size_t n = 0; n < values.size(); n++ )
+            items.push_back(NewItem(values[n]));
+
+        m_items.insert(m_items.begin() + pos, items.begin(), items.end());
+
+        ItemsAdded(wxDataViewItem(), items);
+    }
+
+    void GetValue(wxVariant& variant,
+                  const wxDataViewItem& item,
+                  unsigned int WXUNUSED(col)) const override
+    {
+        variant = m_values[wxPtrToUInt(item.GetID()) - 1];
+    }
+
+    bool SetValue(const wxVariant& WXUNUSED(variant),
+                  const wxDataViewItem& WXUNUSED(item),
+                  unsigned int WXUNUSED(col)) override
+    {
+        return false;
+    }
+
+    wxDataViewItem GetParent(const wxDataViewItem& WXUNUSED(item)) const override
+    {
+        return wxDataViewItem();
+    }
+
+    bool IsContainer(const wxDataViewItem& item) const override
+    {
+        return !item.IsOk();
+    }
+
+    unsigned int GetChildren(const wxDataViewItem& item,
+                             wxDataViewItemArray& children) const override
+    {
+        if ( item.IsOk() )
+            return 0;
+
+        children = m_items;
+        return children.size();
+    }
+
+private:
+    wxDataViewItem NewItem(const wxString& value)
+    {
+        m_values.push_back(value);
+
+        // Item IDs can't be 0, so use the index of the value plus 1.
+        return wxDataViewItem(wxUIntToPtr(m_values.size()));
+    }
+
+    wxVector<wxString> m_values;
+    wxDataViewItemArray m_items;
+};
+
+// Control giving access to the rows of the items.
+class RowsDataViewCtrl : public wxDataViewCtrl
+{
+public:
+    RowsDataViewCtrl()
+        : wxDataViewCtrl(wxTheApp->GetTopWindow(),
+                         wxID_ANY,
+                         wxDefaultPosition,
+                         wxSize(400, 200),
+                         wxDV_MULTIPLE)
+    {
+    }
+
+    using wxDataViewCtrl::GetItemByRow;
+    using wxDataViewCtrl::GetRowByItem;
+
+    unsigned GetRowCount() const
+    {
+        unsigned count = 0;
+        while ( GetItemByRow(count).IsOk() )
+            count++;
+
+        return count;
+    }
+};
+
+// Tree control giving access to the rows of the items.
+class RowsDataViewTreeCtrl : public wxDataViewTreeCtrl
+{
+public:
+    RowsDataViewTreeCtrl()
+        : wxDataViewTreeCtrl(wxTheApp->GetTopWindow(),
+                             wxID_ANY,
+                             wxDefaultPosition,
+                             wxSize(400, 200))
+    {
+    }
+
+    using wxDataViewCtrl::GetItemByRow;
+};
+
+// Model remembering the rows for which the values were requested.
+class RecordingListTestModel : public VirtualListTestModel
+{
+public:
+    explicit RecordingListTestModel(unsigned count)
+        : VirtualListTestModel(count)
+    {
+    }
+
+    void GetValueByRow(wxVariant& variant,
+                       unsigned int row,
+                       unsigned int col) const override
+    {
+        m_requested.push_back(row);
+
+        VirtualListTestModel::GetValueByRow(variant, row, col);
+    }
+
+    mutable std::vector<unsigned> m_requested;
+};
+
+} // anonymous namespace
+
+TEST_CASE("wxDVC::AddItems", "[wxDataViewCtrl][add]")
+{
+    std::unique_ptr<RowsDataViewCtrl> dvc(new RowsDataViewCtrl());
+
+    FlatTreeTestModel* const model = new FlatTreeTestModel(10);
+    dvc->AssociateModel(model);
+    model->DecRef();
+
+    dvc->AppendTextColumn("Value", 0);
+
+    const wxDataViewItem item2 = model->GetItem(2),
+                         item7 = model->GetItem(7);
+    dvc->Select(item2);
+    dvc->Select(item7);
+    dvc->SetCurrentItem(item7);
+
+    // Insert several items in the middle using a single notification.
+    wxArrayString values;
+    values.push_back("a");
+    values.push_back("b");
+    values.push_back("c");
+    model->InsertItems(5, values);
+
+    REQUIRE( dvc->GetRowCount() == 13 );
+
+    wxVariant value;
+    for ( unsigned row = 0; row < 13; row++ )
+    {
+        INFO( "Row " << row );
+
+        const wxDataViewItem item = dvc->GetItemByRow(row);
+        CHECK( item == model->GetItem(row) );
+        CHECK( dvc->GetRowByItem(item) == static_cast<int>(row) );
+
+        model->GetValue(value, item, 0);
+        if ( row < 5 )
+            CHECK( value.GetString() == wxString::Format("%u", row) );
+        else if ( row < 8 )
+            CHECK( value.GetString() == values[row - 5] );
+        else
+            CHECK( value.GetString() == wxString::Format("%u", row - 3) );
+    }
+
+    // The selected row before the new items must be unchanged while the one
+    // after them must have been shifted, but still be the same item.
+    wxDataViewItemArray sel;
+    REQUIRE( dvc->GetSelections(sel) == 2 );
+    CHECK( dvc->IsSelected(item2) );
+    CHECK( dvc->IsSelected(item7) );
+    CHECK( dvc->GetRowByItem(item7) == 10 );
+
+    CHECK( !dvc->IsSelected(model->GetItem(7)) );
+    CHECK( !dvc->IsSelected(model->GetItem(5)) );
+
+    CHECK( dvc->GetCurrentItem() == item7 );
+}
+
+TEST_CASE("wxDVC::CacheHint", "[wxDataViewCtrl][virtual]")
+{
+    std::unique_ptr<wxDataViewCtrl> dvc(new wxDataViewCtrl(
+                                            wxTheApp->GetTopWindow(),
+                                            wxID_ANY,
+                                            wxDefaultPosition,
+                                            wxSize(400, 200)));
+
+    RecordingListTestModel* const model = new RecordingListTestModel(1000);
+    dvc->AssociateModel(model);
+    model->DecRef();
+
+    dvc->AppendTextColumn("Value", 0);
+
+    std::vector<std::pair<int, int>> hints;
+    dvc->Bind(wxEVT_DATAVIEW_CACHE_HINT,
+              [&hints](wxDataViewEvent& event)
+              {
+                  hints.push_back(std::make_pair(event.GetCacheFrom(),
+                                                 event.GetCacheTo()));
+              });
+
+    const int LOOK_AHEAD = 20;
+    dvc->SetCacheHintLookAhead(LOOK_AHEAD);
+
+    dvc->Refresh();
+    dvc->Update();
+    wxYield();
+
+    // The hint must include the rows following the visible ones.
+    REQUIRE( !hints.empty() );
+    CHECK( hints.back().first == 0 );
+    CHECK( hints.back().second >= LOOK_AHEAD );
+
+    // Scrolling by a single line stays inside the previous hint, so no new
+    // hint must be sent.
+    const size_t numHints = hints.size();
+    dvc->Scroll(0, 1);
+    dvc->Update();
+    wxYield();
+    CHECK( hints.size() == numHints );
+
+    // But scrolling far away must send a single new hint extended on both
+    // sides.
+    dvc->EnsureVisible(model->GetItem(500));
+    dvc->Update();
+    wxYield();
+    REQUIRE( hints.size() == numHints + 1 );
+    CHECK( hints.back().first <= 500 - LOOK_AHEAD );
+    CHECK( hints.back().second >= 500 + LOOK_AHEAD );
+
+    // Notifying about the rows becoming ready must refresh just them, with
+    // the overlapping ranges merged together.
+    model->m_requested.clear();
+    dvc->NotifyRowsReady(495, 500);
+    dvc->NotifyRowsReady(500, 505);
+    wxYield();
+    dvc->Update();
+
+    REQUIRE( !model->m_requested.empty() );
+    for ( size_t n = 0; n < model->m_requested.size(); n++ )
+    {
+        INFO( "Row " << model->m_requested[n] );
+        CHECK( model->m_requested[n] >= 495 );
+        CHECK( model->m_requested[n] <= 505 );
+    }
+}
+
+TEST_CASE("wxDVC::ToggleSortOrder", "[wxDataViewCtrl][sort]")
+{
+    std::unique_ptr<RowsDataViewTreeCtrl> dvc(new RowsDataViewTreeCtrl());
+
+    const wxDataViewItem root;
+    const wxDataViewItem leaf1 = dvc->AppendItem(root, "leaf1"),
+                         cont1 = dvc->AppendContainer(root, "cont1"),
+                         leaf2 = dvc->AppendItem(root, "leaf2"),
+                         cont2 = dvc->AppendContainer(root, "cont2");
+
+    // wxDataViewTreeStore ignores the sort direction and always puts the
+    // containers before the leaves, so toggling the sort direction must not
+    // change the order of the items at all.
+    for ( int n = 0; n < 3; n++ )
+    {
+        const bool ascending = n % 2 == 0;
+        INFO( (ascending ? "Ascending" : "Descending") );
+
+        dvc->GetColumn(0)->SetSortOrder(ascending);
+        dvc->GetModel()->Resort();
+
+        CHECK( dvc->GetItemByRow(0) == cont1 );
+        CHECK( dvc->GetItemByRow(1) == cont2 );
+        CHECK( dvc->GetItemByRow(2) == leaf1 );
+        CHECK( dvc->GetItemByRow(3) == leaf2 );
+    }
+}
+
+#endif // wxHAS_GENERIC_DATAVIEWCTRL
+
 #if wxUSE_UIACTIONSIMULATOR
 
 TEST_CASE_METHOD(SingleSelectDataViewCtrlTestCase,
@@ -21,12 +21,17 @@
 #endif // WX_PRECOMP
 
 #include "wx/listctrl.h"
+#include "wx/generic/listctrl.h"
 #include "wx/artprov.h"
 #include "wx/imaglist.h"
 #include "listbasetest.h"
 #include "testableframe.h"
 #include "wx/uiaction.h"
 
+#include <memory>
+#include <utility>
+#include <vector>
+
 // ----------------------------------------------------------------------------
 // test class
 // ----------------------------------------------------------------------------
@@ -49,11 +54,15 @@ private:
         WXUISIM_TEST( ColumnDrag );
         CPPUNIT_TEST( SubitemRect );
         CPPUNIT_TEST( ColumnCount );
+        CPPUNIT_TEST( ColumnInsertDelete );
+        CPPUNIT_TEST( SameValues );
     CPPUNIT_TEST_SUITE_END();
 
     void EditLabel();
     void SubitemRect();
     void ColumnCount();
+    void ColumnInsertDelete();
+    void SameValues();
 #if wxUSE_UIACTIONSIMULATOR
     // Column events are only supported in wxListCtrl currently so we test them
     // here rather than in ListBaseTest
@@ -178,6 +187,67 @@ void ListCtrlTestCase::ColumnCount()
     CHECK(m_list->GetColumnCount() == 0);
 }
 
+void ListCtrlTestCase::ColumnInsertDelete()
+{
+    m_list->InsertColumn(0, "Column 0");
+    m_list->InsertColumn(1, "Column 1");
+    m_list->InsertColumn(2, "Column 2");
+
+    m_list->InsertItem(0, "Item 0");
+    m_list->SetItem(0, 1, "Item 0.1");
+    m_list->SetItem(0, 2, "Item 0.2");
+
+    // Inserting and deleting columns must preserve the contents of the
+    // other ones.
+    m_list->InsertColumn(1, "New column");
+    CHECK( m_list->GetItemText(0, 0) == "Item 0" );
+    CHECK( m_list->GetItemText(0, 1) == "" );
+    CHECK( m_list->GetItemText(0, 2) == "Item 0.1" );
+    CHECK( m_list->GetItemText(0, 3) == "Item 0.2" );
+
+    m_list->DeleteColumn(1);
+    m_list->DeleteColumn(1);
+    CHECK( m_list->GetColumnCount() == 2 );
+    CHECK( m_list->GetItemText(0, 0) == "Item 0" );
+    CHECK( m_list->GetItemText(0, 1) == "Item 0.2" );
+}
+
+void ListCtrlTestCase::SameValues()
+{
+    m_list->InsertColumn(0, "Column 0");
+    m_list->InsertColumn(1, "Column 1");
+
+    for ( long n = 0; n < 3; n++ )
+    {
+        m_list->InsertItem(n, "Item");
+        m_list->SetItem(n, 1, "Same");
+        m_list->SetItemTextColour(n, *wxRED);
+    }
+
+    // Changing the text or attributes of one item must not affect the other
+    // items having the same ones.
+    m_list->SetItemText(1, "Other");
+    m_list->SetItem(2, 1, "");
+    m_list->SetItemBackgroundColour(1, *wxBLUE);
+    m_list->SetItemTextColour(2, *wxGREEN);
+
+    CHECK( m_list->GetItemText(0) == "Item" );
+    CHECK( m_list->GetItemText(0, 1) == "Same" );
+    CHECK( m_list->GetItemText(1) == "Other" );
+    CHECK( m_list->GetItemText(1, 1) == "Same" );
+    CHECK( m_list->GetItemText(2) == "Item" );
+    CHECK( m_list->GetItemText(2, 1) == "" );
+
+    CHECK( m_list->GetItemTextColour(0) == *wxRED );
+    CHECK( m_list->GetItemTextColour(1) == *wxRED );
+    CHECK( m_list->GetItemBackgroundColour(1) == *wxBLUE );
+    CHECK( m_list->GetItemTextColour(2) == *wxGREEN );
+
+    m_list->DeleteItem(0);
+    CHECK( m_list->GetItemText(0, 1) == "Same" );
+    CHECK( m_list->GetItemTextColour(0) == *wxRED );
+}
+
 #if wxUSE_UIACTIONSIMULATOR
 void ListCtrlTestCase::ColumnDrag()
 {
@@ -238,4 +308,94 @@ void ListCtrlTestCase::ColumnClick()
 }
 #endif // wxUSE_UIACTIONSIMULATOR
 
+// ----------------------------------------------------------------------------
+// virtual generic control tests
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Virtual control remembering the items for which the text was requested.
+class RecordingListCtrl : public wxGenericListCtrl
+{
+public:
+    RecordingListCtrl()
+        : wxGenericListCtrl(wxTheApp->GetTopWindow(), wxID_ANY,
+                            wxDefaultPosition, wxSize(400, 200),
+                            wxLC_REPORT | wxLC_VIRTUAL)
+    {
+        AppendColumn("Value");
+        SetItemCount(1000);
+    }
+
+    virtual wxString OnGetItemText(long item, long WXUNUSED(col)) const override
+    {
+        m_requested.push_back(item);
+
+        return wxString::Format("%ld", item);
+    }
+
+    mutable std::vector<long> m_requested;
+};
+
+} // anonymous namespace
+
+TEST_CASE("wxGenericListCtrl::CacheHint", "[listctrl][virtual]")
+{
+    std::unique_ptr<RecordingListCtrl> list(new RecordingListCtrl());
+
+    std::vector<std::pair<long, long>> hints;
+    list->Bind(wxEVT_LIST_CACHE_HINT,
+               [&hints](wxListEvent& event)
+               {
+                   hints.push_back(std::make_pair(event.GetCacheFrom(),
+                                                  event.GetCacheTo()));
+               });
+
+    const long LOOK_AHEAD = 20;
+    list->SetCacheHintLookAhead(LOOK_AHEAD);
+
+    list->Refresh();
+    list->Update();
+    wxYield();
+
+    // The hint must include the items following the visible ones.
+    REQUIRE( !hints.empty() );
+    CHECK( hints.back().first == 0 );
+    CHECK( hints.back().second >= LOOK_AHEAD );
+
+    // Scrolling by a single line stays inside the previous hint, so no new
+    // hint must be sent.
+    const size_t numHints = hints.size();
+    list->EnsureVisible(list->GetTopItem() + list->GetCountPerPage());
+    list->Update();
+    wxYield();
+    CHECK( hints.size() == numHints );
+
+    // But scrolling far away must send a single new hint extended on both
+    // sides.
+    list->EnsureVisible(500);
+    list->Update();
+    wxYield();
+    REQUIRE( hints.size() == numHints + 1 );
+    CHECK( hints.back().first <= 500 - LOOK_AHEAD );
+    CHECK( hints.back().second >= 500 + LOOK_AHEAD );
+
+    // Notifying about the items becoming ready must refresh just them, with
+    // the overlapping ranges merged together.
+    list->m_requested.clear();
+    list->NotifyItemsReady(495, 500);
+    list->NotifyItemsReady(500, 505);
+    wxYield();
+    list->Update();
+
+    REQUIRE( !list->m_requested.empty() );
+    for ( size_t n = 0; n < list->m_requested.size(); n++ )
+    {
+        INFO( "Item " << list->m_requested[n] );
+        CHECK( list->m_requested[n] >= 495 );
+        CHECK( list->m_requested[n] <= 505 );
+    }
+}
+
 #endif // wxUSE_LISTCTRL
@@ -53,6 +53,7 @@ private:
         CPPUNIT_TEST( Iteration );
         CPPUNIT_TEST( Parent );
         CPPUNIT_TEST( CollapseExpand );
+        CPPUNIT_TEST( ExpandLayout );
         CPPUNIT_TEST( AssignImageList );
         CPPUNIT_TEST( Focus );
         CPPUNIT_TEST( Bold );
@@ -82,6 +83,7 @@ private:
     void Iteration();
     void Parent();
     void CollapseExpand();
+    void ExpandLayout();
     void AssignImageList();
     void Focus();
     void Bold();
@@ -541,6 +543,70 @@ void TreeCtrlTestCase::CollapseExpand()
     CPPUNIT_ASSERT(!m_tree->IsExpanded(m_root));
 }
 
+void TreeCtrlTestCase::ExpandLayout()
+{
+    wxRect rect1, rect2, rectGrandchild;
+    REQUIRE( m_tree->GetBoundingRect(m_child1, rect1) );
+    REQUIRE( m_tree->GetBoundingRect(m_grandchild, rectGrandchild) );
+    REQUIRE( m_tree->GetBoundingRect(m_child2, rect2) );
+    CHECK( rect2.y > rectGrandchild.y );
+
+    // Collapsing an item must move the items after it up.
+    m_tree->Collapse(m_child1);
+    wxRect rect;
+    REQUIRE( m_tree->GetBoundingRect(m_child2, rect) );
+    CHECK( rect.y == rectGrandchild.y );
+
+    // And expanding it again must move them back.
+    m_tree->Expand(m_child1);
+    REQUIRE( m_tree->GetBoundingRect(m_child2, rect) );
+    CHECK( rect.y == rect2.y );
+
+    // Check that adding children on demand, when the item is being expanded,
+    // works too.
+    m_tree->SetItemHasChildren(m_child2);
+    m_tree->Bind(wxEVT_TREE_ITEM_EXPANDING, [this](wxTreeEvent& event)
+        {
+            if ( !m_tree->GetChildrenCount(event.GetItem()) )
+            {
+                for ( int n = 0; n < 10; n++ )
+                    m_tree->AppendItem(event.GetItem(), wxString::Format("%d", n));
+            }
+        });
+
+    m_tree->Expand(m_child2);
+    CHECK( m_tree->IsExpanded(m_child2) );
+    CHECK( m_tree->GetChildrenCount(m_child2) == 10 );
+
+    wxTreeItemIdValue cookie;
+    const wxTreeItemId first = m_tree->GetFirstChild(m_child2, cookie);
+    REQUIRE( m_tree->GetBoundingRect(first, rect) );
+    CHECK( rect.y > rect2.y );
+
+    // Items following the expanded one at all levels must be moved and found
+    // by hit testing at their new positions.
+    const wxTreeItemId last = m_tree->GetLastChild(m_child2);
+    m_tree->Collapse(m_child1);
+    REQUIRE( m_tree->GetBoundingRect(last, rect) );
+    m_tree->Expand(m_child1);
+    REQUIRE( m_tree->GetBoundingRect(last, rect2) );
+    CHECK( rect2.y == rect.y + rectGrandchild.y - rect1.y );
+
+    int flags = 0;
+    CHECK( m_tree->HitTest(rect2.GetPosition() + wxPoint(2, 2), flags) == last );
+
+#ifdef wxHAS_GENERIC_TREECTRL
+    // Collapsing a subtree wider than all the other items must make the tree
+    // narrower again.
+    m_tree->AppendItem(m_grandchild, wxString('x', 500));
+    m_tree->Expand(m_grandchild);
+    const int widthExpanded = m_tree->GetVirtualSize().x;
+
+    m_tree->Collapse(m_child1);
+    CHECK( m_tree->GetVirtualSize().x < widthExpanded );
+#endif // wxHAS_GENERIC_TREECTRL
+}
+
 void TreeCtrlTestCase::AssignImageList()
 {
     wxSize size(16, 16);
@@ -2042,6 +2042,196 @@ TEST_CASE("wxDateTime::UNow", "[datetime][now][unow]")
     CHECK( gotMS );
 }
 
+TEST_CASE("wxDateTime::ParseISO", "[datetime][iso]")
+{
+    wxDateTime dt;
+
+    SECTION("Buffer")
+    {
+        const char* const buf = "2024-02-29T13:14:15,and more";
+
+        REQUIRE( dt.ParseISOCombined(buf, buf + 19) );
+        CHECK( dt == wxDateTime(29, wxDateTime::Feb, 2024, 13, 14, 15) );
+
+        CHECK( !dt.ParseISOCombined(buf, buf + 20) );
+        CHECK( !dt.ParseISOCombined(buf, buf + 17) );
+        CHECK( !dt.ParseISOCombined(buf, buf + 19, ' ') );
+
+        REQUIRE( dt.ParseISODate(buf, buf + 10) );
+        CHECK( dt == wxDateTime(29, wxDateTime::Feb, 2024, 13, 14, 15) );
+
+        REQUIRE( dt.ParseISOTime(buf + 11, buf + 19) );
+        CHECK( dt == wxDateTime(29, wxDateTime::Feb, 2024, 13, 14, 15) );
+
+        const char* const invalidDate = "2023-02-29";
+        CHECK( !dt.ParseISODate(invalidDate, invalidDate + 10) );
+
+        const char* const invalidTime = "24:00:00";
+        CHECK( !dt.ParseISOTime(invalidTime, invalidTime + 8) );
+    }
+
+    SECTION("Default")
+    {
+        // The fields not specified in the string are taken from the existing
+        // date.
+        dt.Set(1, wxDateTime::Mar, 2020, 1, 2, 3, 456);
+
+        REQUIRE( dt.ParseISODate("2021-04-05") );
+        CHECK( dt == wxDateTime(5, wxDateTime::Apr, 2021, 1, 2, 3, 456) );
+
+        REQUIRE( dt.ParseISOTime("07:08:09") );
+        CHECK( dt == wxDateTime(5, wxDateTime::Apr, 2021, 7, 8, 9, 456) );
+
+        REQUIRE( dt.ParseISOCombined("2022-10-11 12:13:14", ' ') );
+        CHECK( dt == wxDateTime(11, wxDateTime::Oct, 2022, 12, 13, 14, 456) );
+    }
+
+    SECTION("Format")
+    {
+        dt.Set(2, wxDateTime::Jan, 2023, 3, 4, 5);
+        CHECK( dt.FormatISODate() == "2023-01-02" );
+        CHECK( dt.FormatISOTime() == "03:04:05" );
+        CHECK( dt.FormatISOCombined() == "2023-01-02T03:04:05" );
+        CHECK( dt.FormatISOCombined(' ') == "2023-01-02 03:04:05" );
+    }
+}
+
+TEST_CASE("wxDateTime::ParseRfc3339Date", "[datetime][rfc3339]")
+{
+    static const struct Rfc3339TestData
+    {
+        const char* str;
+        wxDateTime::wxDateTime_t day;
+        wxDateTime::Month mon;
+        int year;
+        wxDateTime::wxDateTime_t hour, min, sec, msec;
+    } testData[] =
+    {
+        { "1985-04-12T23:20:50.52Z", 12, wxDateTime::Apr, 1985, 23, 20, 50, 520 },
+        { "1996-12-19T16:39:57-08:00", 20, wxDateTime::Dec, 1996, 0, 39, 57, 0 },
+        { "1937-01-01T12:00:27.87+00:20", 1, wxDateTime::Jan, 1937, 11, 40, 27, 870 },
+        { "2024-02-29t01:02:03.456789z", 29, wxDateTime::Feb, 2024, 1, 2, 3, 456 },
+        { "2000-01-01 00:00:00+01:00", 31, wxDateTime::Dec, 1999, 23, 0, 0, 0 },
+        { "1969-12-31T23:59:59.999Z", 31, wxDateTime::Dec, 1969, 23, 59, 59, 999 },
+        { "0001-01-01T00:00:00Z", 1, wxDateTime::Jan, 1, 0, 0, 0, 0 },
+    };
+
+    for ( const auto& d : testData )
+    {
+        INFO("Parsing \"" << d.str << "\"");
+
+        const wxDateTime
+            expected = wxDateTime(d.day, d.mon, d.year, d.hour, d.min, d.sec,
+                                  d.msec).MakeFromUTC();
+
+        wxDateTime dt;
+        wxString::const_iterator end;
+        const wxString str(d.str);
+        REQUIRE( dt.ParseRfc3339Date(str, &end) );
+        CHECK( end == str.end() );
+        CHECK( dt.GetValue() == expected.GetValue() );
+
+        const size_t len = strlen(d.str);
+        REQUIRE( dt.ParseRfc3339Date(d.str, d.str + len) == d.str + len );
+        CHECK( dt.GetValue() == expected.GetValue() );
+    }
+
+    static const char* const invalid[] =
+    {
+        "",
+        "1985-04-12",
+        "1985-04-12T23:20:50",
+        "1985-4-12T23:20:50Z",
+        "1985-04-12T23:20:50.Z",
+        "1985-04-31T23:20:50Z",
+        "1985-04-12T24:20:50Z",
+        "1985-04-12T23:20:50+0100",
+        "1985-04-12X23:20:50Z",
+    };
+
+    for ( const auto& s : invalid )
+    {
+        INFO("Parsing \"" << s << "\"");
+
+        wxDateTime dt;
+        CHECK( !dt.ParseRfc3339Date(s, s + strlen(s)) );
+    }
+
+    // The parsing stops after the date.
+    const char* const buf = "2001-02-03T04:05:06Z,next";
+    wxDateTime dt;
+    CHECK( dt.ParseRfc3339Date(buf, buf + strlen(buf)) == buf + 20 );
+}
+
+TEST_CASE("wxDateTimeFormat", "[datetime][format]")
+{
+    static const char* const formats[] =
+    {
+        "%Y-%m-%d %H:%M:%S",
+        "%d/%m/%y %H:%M:%S.%l",
+        "%FT%T",
+        "[%Y%m%d]  %H%M %%",
+        "%d %b %Y %H:%M",       // Not handled by wxDateTimeFormat itself.
+        "%j",                   // Same.
+    };
+
+    const wxDateTime dates[] =
+    {
+        wxDateTime(29, wxDateTime::Feb, 2024, 23, 59, 58, 765),
+        wxDateTime(1, wxDateTime::Jan, 2000),
+        wxDateTime(31, wxDateTime::Dec, 1999, 12, 0, 1, 2),
+    };
+
+    for ( const auto& f : formats )
+    {
+        const wxDateTimeFormat format(f);
+        CHECK( format.GetFormat() == f );
+
+        for ( const auto& date : dates )
+        {
+            const wxString s = date.Format(f);
+
+            INFO("Format \"" << f << "\", date \"" << s << "\"");
+
+            CHECK( format.Format(date) == s );
+            CHECK( format.Format(date, wxDateTime::UTC) ==
+                    date.Format(f, wxDateTime::UTC) );
+
+            const wxDateTime dateDef(3, wxDateTime::Mar, 2003, 3, 3, 3, 3);
+
+            wxDateTime dtExpected, dt;
+            wxString::const_iterator endExpected, end;
+            const bool ok = dtExpected.ParseFormat(s, f, dateDef, &endExpected);
+            CHECK( format.Parse(dt, s, dateDef, &end) == ok );
+            if ( ok )
+            {
+                CHECK( end == endExpected );
+                CHECK( dt == dtExpected );
+            }
+
+            const wxString input = s + " trailing";
+            const wxScopedCharBuffer buf = input.utf8_str();
+            dt = wxDateTime();
+            const char* const p = format.Parse(dt, buf.data(),
+                                               buf.data() + buf.length(),
+                                               dateDef);
+            CHECK( (p != nullptr) == ok );
+            if ( p )
+            {
+                CHECK( p == buf.data() + strlen(s.utf8_str()) );
+                CHECK( dt == dtExpected );
+            }
+        }
+    }
+
+    wxDateTime dt;
+    wxString::const_iterator end;
+    const wxDateTimeFormat format("%Y-%m-%d");
+    CHECK( !format.Parse(dt, "2001-13-01", &end) );
+    CHECK( !format.Parse(dt, "2001-02-29", &end) );
+    CHECK( !format.Parse(dt, "2001/02/28", &end) );
+}
+
 TEST_CASE("Easter", "[datetime][holiday][easter]")
 {
     std::vector<wxDateTime> easters =
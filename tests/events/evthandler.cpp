@@ -14,6 +14,12 @@
 
 
 #include "wx/event.h"
+#include "wx/evtloop.h"
+#include "wx/thread.h"
+#include "wx/time.h"
+
+#include <memory>
+#include <vector>
 
 // ----------------------------------------------------------------------------
 // test events and their handlers
@@ -510,6 +516,325 @@ TEST_CASE("Event::UnbindFromHandler", "[event][bind][unbind]")
     handler.ProcessEvent(e);
 }
 
+TEST_CASE("Event::ManyHandlers", "[event][bind]")
+{
+    // Bind enough handlers to use the index of the dynamic event table
+    // entries and check that the order of calling them is preserved.
+    wxEvtHandler handler;
+
+    const wxEventTypeTag<wxEvent> otherType(wxNewEventType());
+
+    std::vector<int> called;
+    for ( int n = 0; n < 50; n++ )
+    {
+        handler.Bind(MyEventType, [&called, n](MyEvent& event)
+            {
+                called.push_back(n);
+                event.Skip();
+            });
+
+        handler.Bind(otherType, [](wxEvent&) { FAIL("Unexpected event"); });
+    }
+
+    MyEvent e;
+    CHECK( !handler.ProcessEvent(e) );
+
+    REQUIRE( called.size() == 50 );
+    for ( int n = 0; n < 50; n++ )
+        CHECK( called[n] == 49 - n );
+
+    // Check that unbinding handlers, including from inside of a handler,
+    // works as expected.
+    called.clear();
+
+    bool unbound = false;
+    auto unbinder = [&](MyEvent& event)
+    {
+        called.push_back(-1);
+        unbound = handler.Unbind(otherType, GlobalOnEvent);
+        event.Skip();
+    };
+
+    handler.Bind(otherType, GlobalOnEvent);
+    handler.Bind(MyEventType, unbinder);
+    handler.Bind(MyEventType, [&called](MyEvent& event)
+        {
+            called.push_back(100);
+            event.Skip(false);
+        },
+        1);
+
+    CHECK( !handler.ProcessEvent(e) );
+    CHECK( unbound );
+    REQUIRE( called.size() == 51 );
+    CHECK( called[0] == -1 );
+    CHECK( called[1] == 49 );
+
+    // The handler with the matching id must be found too.
+    called.clear();
+
+    MyEvent e1;
+    e1.SetId(1);
+    CHECK( handler.ProcessEvent(e1) );
+    REQUIRE( called.size() == 1 );
+    CHECK( called[0] == 100 );
+
+    CHECK( handler.Unbind(MyEventType, unbinder) );
+    CHECK( !handler.Unbind(MyEventType, unbinder) );
+
+    // Destroying the sink must remove its handlers from the index too.
+    {
+        MyHandler sink;
+        handler.Bind(MyEventType, &MyHandler::OnMyEvent, &sink);
+    }
+
+    called.clear();
+    CHECK( !handler.ProcessEvent(e) );
+    CHECK( called.size() == 50 );
+}
+
+TEST_CASE("Event::QueueEvent", "[event][queue]")
+{
+    class OrderHandler : public wxEvtHandler
+    {
+    public:
+        OrderHandler()
+        {
+            Bind(wxEVT_THREAD, &OrderHandler::OnThread, this);
+        }
+
+        // The index of the next expected event from each thread.
+        std::vector<int> m_next;
+        bool m_inOrder = true;
+        int m_count = 0;
+
+    private:
+        void OnThread(wxThreadEvent& event)
+        {
+            int& next = m_next[event.GetId()];
+            if ( event.GetInt() != next )
+                m_inOrder = false;
+
+            next = event.GetInt() + 1;
+            m_count++;
+        }
+    };
+
+    OrderHandler handler;
+
+    SECTION("Single")
+    {
+        handler.m_next.resize(1);
+
+        for ( int n = 0; n < 10; n++ )
+        {
+            wxThreadEvent* const event = new wxThreadEvent(wxEVT_THREAD, 0);
+            event->SetInt(n);
+            handler.QueueEvent(event);
+        }
+
+        CHECK( wxTheApp->HasPendingEvents() );
+
+        wxTheApp->ProcessPendingEvents();
+
+        CHECK( handler.m_count == 10 );
+        CHECK( handler.m_inOrder );
+        CHECK( !wxTheApp->HasPendingEvents() );
+    }
+
+#if wxUSE_THREADS
+    SECTION("Threads")
+    {
+        class QueueThread : public wxThread
+        {
+        public:
+            QueueThread(wxEvtHandler& handler, int id, int numEvents)
+                : wxThread(wxTHREAD_JOINABLE),
+                  m_handler(handler),
+                  m_id(id),
+                  m_numEvents(numEvents)
+            {
+            }
+
+        protected:
+            virtual ExitCode Entry() override
+            {
+                for ( int n = 0; n < m_numEvents; n++ )
+                {
+                    wxThreadEvent* const event =
+                        new wxThreadEvent(wxEVT_THREAD, m_id);
+                    event->SetInt(n);
+                    m_handler.QueueEvent(event);
+                }
+
+                return 0;
+            }
+
+        private:
+            wxEvtHandler& m_handler;
+            const int m_id;
+            const int m_numEvents;
+        };
+
+        const int NUM_THREADS = 8;
+        const int NUM_EVENTS = 10000;
+
+        handler.m_next.resize(NUM_THREADS);
+
+        std::vector<std::unique_ptr<QueueThread>> threads;
+        for ( int n = 0; n < NUM_THREADS; n++ )
+        {
+            threads.emplace_back(new QueueThread(handler, n, NUM_EVENTS));
+            REQUIRE( threads.back()->Run() == wxTHREAD_NO_ERROR );
+        }
+
+        // Process the events while they're being queued.
+        bool running = true;
+        while ( running )
+        {
+            running = false;
+            for ( const auto& thread : threads )
+            {
+                if ( thread->IsRunning() )
+                    running = true;
+            }
+
+            wxTheApp->ProcessPendingEvents();
+        }
+
+        for ( const auto& thread : threads )
+            thread->Wait();
+
+        wxTheApp->ProcessPendingEvents();
+
+        CHECK( handler.m_count == NUM_THREADS * NUM_EVENTS );
+        CHECK( handler.m_inOrder );
+    }
+#endif // wxUSE_THREADS
+
+    SECTION("Delete")
+    {
+        // Queue some events for a handler and destroy it before processing
+        // them: this must not crash nor leak the events.
+        std::unique_ptr<wxEvtHandler> other(new wxEvtHandler);
+        for ( int n = 0; n < 10; n++ )
+        {
+            other->QueueEvent(new wxThreadEvent());
+            handler.QueueEvent(new wxThreadEvent(wxEVT_THREAD, 0));
+        }
+
+        handler.m_next.resize(1);
+        other.reset();
+
+        wxTheApp->ProcessPendingEvents();
+
+        CHECK( handler.m_count == 10 );
+    }
+}
+
+TEST_CASE("Event::QueueCoalescedEvent", "[event][queue]")
+{
+    class ValueHandler : public wxEvtHandler
+    {
+    public:
+        ValueHandler()
+        {
+            Bind(wxEVT_THREAD, &ValueHandler::OnThread, this);
+        }
+
+        // The values of all processed events in order.
+        std::vector<int> m_values;
+
+    private:
+        void OnThread(wxThreadEvent& event)
+        {
+            m_values.push_back(event.GetId() * 1000 + event.GetInt());
+        }
+    };
+
+    ValueHandler handler;
+
+    auto queue = [&handler](int id, int value)
+    {
+        wxThreadEvent* const event = new wxThreadEvent(wxEVT_THREAD, id);
+        event->SetInt(value);
+        handler.QueueCoalescedEvent(event);
+    };
+
+    SECTION("Coalesce")
+    {
+        for ( int n = 0; n < 100; n++ )
+        {
+            queue(1, n);
+            queue(2, n);
+        }
+
+        wxTheApp->ProcessPendingEvents();
+
+        REQUIRE( handler.m_values.size() == 2 );
+        CHECK( handler.m_values[0] == 1099 );
+        CHECK( handler.m_values[1] == 2099 );
+
+        // Events queued after processing the previous ones are not coalesced
+        // with them.
+        queue(1, 1);
+        wxTheApp->ProcessPendingEvents();
+
+        REQUIRE( handler.m_values.size() == 3 );
+        CHECK( handler.m_values[2] == 1001 );
+    }
+
+    SECTION("Delete")
+    {
+        queue(1, 1);
+        handler.DeletePendingEvents();
+
+        wxTheApp->ProcessPendingEvents();
+        CHECK( handler.m_values.empty() );
+
+        // Check that we can still queue more events after deleting them.
+        queue(1, 2);
+        wxTheApp->ProcessPendingEvents();
+
+        REQUIRE( handler.m_values.size() == 1 );
+        CHECK( handler.m_values[0] == 1002 );
+    }
+
+#if wxUSE_TIMER
+    SECTION("MinInterval")
+    {
+        handler.SetCoalescedEventMinInterval(wxEVT_THREAD, 1, 200);
+
+        // The first event is processed immediately.
+        queue(1, 1);
+        wxTheApp->ProcessPendingEvents();
+        REQUIRE( handler.m_values.size() == 1 );
+
+        // But the subsequent ones are delayed, while the events with the other
+        // ids are not.
+        queue(1, 2);
+        queue(1, 3);
+        queue(2, 1);
+        wxTheApp->ProcessPendingEvents();
+
+        REQUIRE( handler.m_values.size() == 2 );
+        CHECK( handler.m_values[1] == 2001 );
+
+        wxEventLoop loop;
+
+        const wxMilliClock_t end = wxGetLocalTimeMillis() + 10000;
+        while ( handler.m_values.size() < 3 && wxGetLocalTimeMillis() < end )
+        {
+            loop.DispatchTimeout(10);
+            wxTheApp->ProcessPendingEvents();
+        }
+
+        REQUIRE( handler.m_values.size() == 3 );
+        CHECK( handler.m_values[2] == 1003 );
+    }
+#endif // wxUSE_TIMER
+}
+
 // This is a compilation-time-only test: just check that a class inheriting
 // from wxEvtHandler non-publicly can use Bind() with its method, this used to
 // result in compilation errors.
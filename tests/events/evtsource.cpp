@@ -12,3 +12,237 @@
 // ----------------------------------------------------------------------------
 
 #include "testprec.h"
+
+#if wxUSE_EPOLL_DISPATCHER
+
+#include "wx/unix/private/epolldispatcher.h"
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+// Handler counting the notifications for an eventfd and optionally reading
+// from it.
+class EventFDHandler : public wxFDIOHandler
+{
+public:
+    EventFDHandler(bool consume)
+        : m_fd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+          m_consume(consume)
+    {
+    }
+
+    virtual ~EventFDHandler() { close(m_fd); }
+
+    int GetFD() const { return m_fd; }
+
+    void Signal() { eventfd_write(m_fd, 1); }
+
+    virtual void OnReadWaiting() override
+    {
+        m_count++;
+
+        eventfd_t value;
+        if ( m_consume )
+            eventfd_read(m_fd, &value);
+    }
+
+    virtual void OnWriteWaiting() override { }
+    virtual void OnExceptionWaiting() override { }
+
+    int m_count = 0;
+
+private:
+    const int m_fd;
+    const bool m_consume;
+};
+
+// Handler dispatching the events from inside its notification, as happens
+// when a nested event loop is run from an event handler.
+class NestedDispatchHandler : public EventFDHandler
+{
+public:
+    NestedDispatchHandler(wxEpollDispatcher& dispatcher,
+                          std::vector<std::unique_ptr<EventFDHandler>>& others)
+        : EventFDHandler(true),
+          m_dispatcher(dispatcher),
+          m_others(others)
+    {
+    }
+
+    virtual void OnReadWaiting() override
+    {
+        EventFDHandler::OnReadWaiting();
+
+        for ( const auto& other : m_others )
+            other->Signal();
+        m_nestedEvents += m_dispatcher.Dispatch(0);
+    }
+
+    int m_nestedEvents = 0;
+
+private:
+    wxEpollDispatcher& m_dispatcher;
+    std::vector<std::unique_ptr<EventFDHandler>>& m_others;
+};
+
+} // anonymous namespace
+
+TEST_CASE("wxEpollDispatcher", "[evtloop][epoll]")
+{
+    std::unique_ptr<wxEpollDispatcher> dispatcher(wxEpollDispatcher::Create());
+    REQUIRE( dispatcher );
+
+    SECTION("Many")
+    {
+        // Use more descriptors than fit into the initial events buffer.
+        const int NUM_FDS = 100;
+        std::vector<std::unique_ptr<EventFDHandler>> handlers;
+        for ( int n = 0; n < NUM_FDS; n++ )
+        {
+            handlers.emplace_back(new EventFDHandler(true));
+            REQUIRE( dispatcher->RegisterFD(handlers[n]->GetFD(),
+                                            handlers[n].get(),
+                                            wxFDIO_INPUT) );
+        }
+
+        for ( int i = 0; i < 3; i++ )
+        {
+            for ( const auto& handler : handlers )
+                handler->Signal();
+
+            int numEvents = 0;
+            while ( numEvents < NUM_FDS )
+            {
+                const int rc = dispatcher->Dispatch(0);
+                REQUIRE( rc > 0 );
+
+                numEvents += rc;
+            }
+
+            CHECK( numEvents == NUM_FDS );
+            CHECK( !dispatcher->HasPending() );
+        }
+
+        for ( const auto& handler : handlers )
+        {
+            CHECK( handler->m_count == 3 );
+            dispatcher->UnregisterFD(handler->GetFD());
+        }
+
+        // All events must have been retrieved at once after the buffer grew.
+        const wxEpollDispatcher::Stats& stats = dispatcher->GetStats();
+        CHECK( stats.events == 3*NUM_FDS );
+        CHECK( stats.maxEvents == NUM_FDS );
+        CHECK( stats.wakeups < 3*NUM_FDS/16 );
+    }
+
+    SECTION("EdgeTriggered")
+    {
+        // Don't read from the descriptors to check when we're notified again.
+        EventFDHandler level(false),
+                       edge(false);
+        REQUIRE( dispatcher->RegisterFD(level.GetFD(), &level, wxFDIO_INPUT) );
+        REQUIRE( dispatcher->RegisterFD(edge.GetFD(), &edge,
+                                        wxFDIO_INPUT | wxFDIO_EDGE_TRIGGERED) );
+
+        level.Signal();
+        edge.Signal();
+        CHECK( dispatcher->Dispatch(0) == 2 );
+
+        // Level-triggered descriptor is still readable, so we get notified
+        // about it again, but not about the edge-triggered one.
+        CHECK( dispatcher->Dispatch(0) == 1 );
+        CHECK( level.m_count == 2 );
+        CHECK( edge.m_count == 1 );
+
+        // Until it gets signalled again.
+        edge.Signal();
+        CHECK( dispatcher->Dispatch(0) == 2 );
+        CHECK( edge.m_count == 2 );
+
+        dispatcher->UnregisterFD(level.GetFD());
+        dispatcher->UnregisterFD(edge.GetFD());
+    }
+
+    SECTION("Nested")
+    {
+        // Use edge-triggered descriptors, so that the nested call doesn't get
+        // the events for them again and only returns the events for "inner"
+        // ones, which are signalled by the nesting handler.
+        const int NUM_FDS = 40;
+        const int NUM_INNER = 5;
+        std::vector<std::unique_ptr<EventFDHandler>> handlers;
+        for ( int n = 0; n < NUM_FDS; n++ )
+        {
+            handlers.emplace_back(new EventFDHandler(true));
+            REQUIRE( dispatcher->RegisterFD(handlers[n]->GetFD(),
+                                            handlers[n].get(),
+                                            wxFDIO_INPUT | wxFDIO_EDGE_TRIGGERED) );
+        }
+
+        std::vector<std::unique_ptr<EventFDHandler>> inner;
+        for ( int n = 0; n < NUM_INNER; n++ )
+        {
+            inner.emplace_back(new EventFDHandler(true));
+            REQUIRE( dispatcher->RegisterFD(inner[n]->GetFD(),
+                                            inner[n].get(),
+                                            wxFDIO_INPUT) );
+        }
+
+        NestedDispatchHandler nesting(*dispatcher, inner);
+        REQUIRE( dispatcher->RegisterFD(nesting.GetFD(), &nesting,
+                                        wxFDIO_INPUT | wxFDIO_EDGE_TRIGGERED) );
+
+        // Do it several times to let the outer buffer grow.
+        for ( int i = 1; i <= 3; i++ )
+        {
+            // Signal the nesting handler first for it to be dispatched before
+            // the others, whose events are still in the buffer then.
+            nesting.Signal();
+            for ( const auto& handler : handlers )
+                handler->Signal();
+
+            // The nested call may also get the events not retrieved by the
+            // outer one yet if they didn't fit into its buffer, so count all
+            // of them together: there must be one for each descriptor.
+            const int nestedBefore = nesting.m_nestedEvents;
+            int outerEvents = 0;
+            while ( outerEvents + nesting.m_nestedEvents - nestedBefore
+                        < NUM_FDS + 1 + NUM_INNER )
+            {
+                const int rc = dispatcher->Dispatch(0);
+                REQUIRE( rc > 0 );
+
+                outerEvents += rc;
+            }
+
+            const int numEvents = outerEvents + nesting.m_nestedEvents - nestedBefore;
+
+            // If the nested call overwrote the outer buffer, some events would
+            // have been lost and others dispatched twice.
+            CHECK( numEvents == NUM_FDS + 1 + NUM_INNER );
+            CHECK( nesting.m_count == i );
+
+            for ( const auto& handler : inner )
+                CHECK( handler->m_count == i );
+            for ( const auto& handler : handlers )
+                CHECK( handler->m_count == i );
+
+            CHECK( !dispatcher->HasPending() );
+        }
+
+        for ( const auto& handler : handlers )
+            dispatcher->UnregisterFD(handler->GetFD());
+        for ( const auto& handler : inner )
+            dispatcher->UnregisterFD(handler->GetFD());
+        dispatcher->UnregisterFD(nesting.GetFD());
+    }
+}
+
+#endif // wxUSE_EPOLL_DISPATCHER
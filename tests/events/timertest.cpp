@@ -21,6 +21,9 @@
 #include "wx/evtloop.h"
 #include "wx/timer.h"
 
+#include <memory>
+#include <vector>
+
 // --------------------------------------------------------------------------
 // helper class counting the number of timer events
 // --------------------------------------------------------------------------
@@ -137,3 +140,71 @@ void TimerEventTestCase::Multiple()
     // more than one
     CPPUNIT_ASSERT( numTicks > 1 );
 }
+
+TEST_CASE("wxTimer::Order", "[timer]")
+{
+    class OrderHandler : public wxEvtHandler
+    {
+    public:
+        OrderHandler()
+        {
+            Bind(wxEVT_TIMER, &OrderHandler::OnTimer, this);
+        }
+
+        std::vector<int> m_ids;
+
+    private:
+        void OnTimer(wxTimerEvent& event)
+        {
+            m_ids.push_back(event.GetId());
+        }
+    };
+
+    OrderHandler handler;
+
+    // Start the timers in an order different from their expiration order and
+    // stop some of them to check that this doesn't affect the others.
+    const int NUM_TIMERS = 20;
+    std::vector<std::unique_ptr<wxTimer>> timers;
+    for ( int n = 0; n < NUM_TIMERS; n++ )
+    {
+        timers.emplace_back(new wxTimer(&handler, n));
+        timers.back()->StartOnce(20 + ((n * 7) % NUM_TIMERS) * 10);
+    }
+
+    for ( int n = 0; n < NUM_TIMERS; n += 5 )
+        timers[n]->Stop();
+
+    // Restarting a timer moves it to the end.
+    timers[1]->StartOnce(20 + NUM_TIMERS * 10);
+
+    const size_t numExpected = NUM_TIMERS - NUM_TIMERS / 5;
+
+    wxEventLoop loop;
+
+    const wxMilliClock_t end = wxGetLocalTimeMillis() + 10000;
+    while ( handler.m_ids.size() < numExpected &&
+                wxGetLocalTimeMillis() < end )
+    {
+        loop.DispatchTimeout(100);
+    }
+
+    REQUIRE( handler.m_ids.size() == numExpected );
+
+    for ( size_t n = 0; n < handler.m_ids.size(); n++ )
+    {
+        const int id = handler.m_ids[n];
+        INFO("Timer #" << n << " is " << id);
+
+        CHECK( id % 5 != 0 );
+        CHECK( !timers[id]->IsRunning() );
+
+        if ( n > 0 )
+        {
+            const int prev = handler.m_ids[n - 1];
+            CHECK( timers[prev]->GetInterval() < timers[id]->GetInterval() );
+        }
+    }
+
+    CHECK( handler.m_ids.back() == 1 );
+}
@@ -556,3 +556,24 @@ void HashesTestCase::wxHashSetTest()
     CPPUNIT_ASSERT( it->ptr == &dummy );
     CPPUNIT_ASSERT( it->str == wxT("ABC") );
 }
+
+WX_DECLARE_HASH_MAP( wxString, int, wxStringHashNoCase, wxStringEqualNoCase,
+                     NoCaseHashMap );
+
+TEST_CASE("wxStringHashNoCase", "[hashmap]")
+{
+    const wxStringHashNoCase hash;
+    CHECK( hash("Hello, World") == hash("hello, world") );
+    CHECK( hash("Hello, World") == hash("HELLO, WORLD") );
+    CHECK( hash("Hello") != hash("Hello!") );
+
+    NoCaseHashMap m;
+    m["Key"] = 1;
+    m["KEY"] = 2;
+    m["Other"] = 3;
+
+    CHECK( m.size() == 2 );
+    CHECK( m["key"] == 2 );
+    CHECK( m.find("oThEr") != m.end() );
+    CHECK( m.find("Others") == m.end() );
+}
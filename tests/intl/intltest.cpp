@@ -20,6 +20,10 @@
 #include "wx/intl.h"
 #include "wx/uilocale.h"
 #include "wx/scopeguard.h"
+#include "wx/file.h"
+#include "wx/filename.h"
+
+#include "testfile.h"
 
 #include "wx/private/glibc.h"
 
@@ -290,6 +294,285 @@ TEST_CASE("wxTranslations::AddCatalog", "[translations]")
     }
 }
 
+TEST_CASE("wxTranslations::GetTranslatedString", "[translations]")
+{
+    wxFileTranslationsLoader::AddCatalogLookupPathPrefix("./intl");
+
+    const wxString domain("internat");
+
+    wxTranslations trans;
+    trans.SetLanguage(wxLANGUAGE_FRENCH);
+    REQUIRE( trans.AddAvailableCatalog(domain) );
+
+    const wxString* s = trans.GetTranslatedString("&Open bogus file", domain);
+    REQUIRE( s );
+    CHECK( *s == "&Ouvrir un fichier" );
+
+    // Looking up the same string again must return the same result.
+    CHECK( trans.GetTranslatedString("&Open bogus file", domain) == s );
+
+    s = trans.GetTranslatedString("Enter your number:", domain);
+    REQUIRE( s );
+    CHECK( *s == wxString::FromUTF8("Entrez votre num\xc3\xa9ro:") );
+
+    CHECK( !trans.GetTranslatedString("Not translated", domain) );
+    CHECK( !trans.GetTranslatedString("Not translated", domain) );
+
+    // Check the strings with context.
+    s = trans.GetTranslatedString("Result", domain);
+    REQUIRE( s );
+    CHECK( *s == "Resultat" );
+
+    s = trans.GetTranslatedString("Result", domain, "title");
+    REQUIRE( s );
+    CHECK( *s == wxString::FromUTF8("R\xc3\xa9sultat") );
+
+    CHECK( !trans.GetTranslatedString("Result", domain, "bogus") );
+
+    // And plural forms, French uses "plural=(n > 1)".
+    s = trans.GetTranslatedString("%d file", 0, domain);
+    REQUIRE( s );
+    CHECK( *s == "%d fichier" );
+
+    s = trans.GetTranslatedString("%d file", 1, domain);
+    REQUIRE( s );
+    CHECK( *s == "%d fichier" );
+
+    s = trans.GetTranslatedString("%d file", 2, domain);
+    REQUIRE( s );
+    CHECK( *s == "%d fichiers" );
+
+    s = trans.GetTranslatedString("%d file", 123456, domain);
+    REQUIRE( s );
+    CHECK( *s == "%d fichiers" );
+
+    CHECK( trans.GetHeaderValue("Plural-Forms", domain) ==
+            "nplurals=2; plural=(n > 1);" );
+}
+
+namespace
+{
+
+// Create a catalog with the given plural forms expression and a single
+// message "x" whose translations are just the indices of the plural forms.
+wxMsgCatalog* CreateCatalogWithPluralForms(const char* expr)
+{
+    wxString header("Content-Type: text/plain; charset=UTF-8\n"
+                    "Plural-Forms: ");
+    header += expr;
+    header += "\n";
+
+    const wxCharBuffer headerUTF8 = header.utf8_str();
+    const wxUint32 lenHeader = headerUTF8.length();
+
+    static const char msgid[] = "\0x\0xs";
+    static const char msgstr[] = "0\0001\0002\0003\0004\0005";
+
+    // Header followed by the original and translated strings tables with
+    // two entries each: the catalog header and our message.
+    const wxUint32 ofsStrings = 7*4 + 2*2*2*4;
+    const wxUint32 ofsHeader = ofsStrings + sizeof(msgid);
+    const wxUint32 ofsMsgstr = ofsHeader + lenHeader + 1;
+    const wxUint32 words[] =
+    {
+        0x950412de, 0, 2, 7*4, 7*4 + 2*2*4, 0, 0,
+        0, ofsStrings,
+        sizeof(msgid) - 2, ofsStrings + 1,
+        lenHeader, ofsHeader,
+        sizeof(msgstr) - 1, ofsMsgstr,
+    };
+
+    wxMemoryBuffer data;
+    data.AppendData(words, sizeof(words));
+    data.AppendData(msgid, sizeof(msgid));
+    data.AppendData(headerUTF8.data(), lenHeader + 1);
+    data.AppendData(msgstr, sizeof(msgstr));
+
+    const size_t len = data.GetDataLen();
+    return wxMsgCatalog::CreateFromData
+           (
+                wxScopedCharBuffer::CreateOwned
+                (
+                    static_cast<char*>(data.release()),
+                    len
+                ),
+                "test"
+           );
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxMsgCatalog::PluralForms", "[translations]")
+{
+    struct PluralFormsTest
+    {
+        const char* expr;
+        int (*func)(unsigned n);
+    };
+
+    const PluralFormsTest tests[] =
+    {
+        {
+            "nplurals=2; plural=(n != 1);",
+            [](unsigned n) { return n != 1 ? 1 : 0; }
+        },
+        {
+            "nplurals=3; plural=(n==1 ? 0 : n%10>=2 && n%10<=4 && "
+            "(n%100<10 || n%100>=20) ? 1 : 2);",
+            [](unsigned n)
+            {
+                return n == 1 ? 0
+                              : n%10 >= 2 && n%10 <= 4 &&
+                                (n%100 < 10 || n%100 >= 20) ? 1 : 2;
+            }
+        },
+        {
+            "nplurals=6; plural=(n==0 ? 0 : n==1 ? 1 : n==2 ? 2 : "
+            "n%100>=3 && n%100<=10 ? 3 : n%100>=11 ? 4 : 5);",
+            [](unsigned n)
+            {
+                return n == 0 ? 0 : n == 1 ? 1 : n == 2 ? 2
+                                  : n%100 >= 3 && n%100 <= 10 ? 3
+                                  : n%100 >= 11 ? 4 : 5;
+            }
+        },
+        {
+            // Division by zero results in 0.
+            "nplurals=2; plural=n%(n>5);",
+            [](unsigned) { return 0; }
+        },
+        {
+            // Invalid results are replaced by 0 too.
+            "nplurals=2; plural=n;",
+            [](unsigned n) { return n < 2 ? static_cast<int>(n) : 0; }
+        },
+        {
+            // Expression deeper than the stack used by compiled code.
+            "nplurals=2; plural=(n%2==(n%3==(n%4==(n%5==(n%6==(n%7==(n%8=="
+            "(n%9==(n%10==(n%11==(n%12==(n%13==(n%14==(n%15==(n%16==(n%17=="
+            "(n%18==(n%19==(n%20==(n%21==(n%22==(n%23==(n%24==(n%25==(n%26=="
+            "(n%27==(n%28==(n%29==(n%30==(n%31==(n%32==(n%33==(n%34==0)))))))"
+            "))))))))))))))))))))))))));",
+            [](unsigned n)
+            {
+                unsigned value = n % 34 == 0;
+                for ( unsigned d = 33; d >= 2; d-- )
+                    value = n % d == value;
+                return static_cast<int>(value);
+            }
+        },
+    };
+
+    for ( const auto& test : tests )
+    {
+        INFO("Plural forms: " << test.expr);
+
+        std::unique_ptr<wxMsgCatalog> cat(CreateCatalogWithPluralForms(test.expr));
+        REQUIRE( cat );
+
+        for ( unsigned n = 0; n < 1000; n++ )
+        {
+            INFO("n = " << n);
+
+            const wxString* const s = cat->GetString("x", n);
+            REQUIRE( s );
+            CHECK( *s == wxString::Format("%d", test.func(n)) );
+        }
+    }
+}
+
+namespace
+{
+
+// Log target just counting the messages logged to it.
+class CountingLog : public wxLog
+{
+public:
+    int m_count = 0;
+
+protected:
+    void DoLogRecord(wxLogLevel WXUNUSED(level),
+                     const wxString& WXUNUSED(msg),
+                     const wxLogRecordInfo& WXUNUSED(info)) override
+    {
+        m_count++;
+    }
+};
+
+} // anonymous namespace
+
+TEST_CASE("wxMsgCatalog::Invalid", "[translations]")
+{
+    wxFile fileOrig("./intl/fr/internat.mo");
+    REQUIRE( fileOrig.IsOpened() );
+
+    const size_t len = fileOrig.Length();
+    wxCharBuffer data(len);
+    REQUIRE( fileOrig.Read(data.data(), len) == static_cast<ssize_t>(len) );
+
+    TempFile tmp(wxFileName::CreateTempFileName("intl"));
+
+    // Number of messages logged by the last call to load().
+    int numLogged = 0;
+
+    // Load the catalog with the word at the given offset replaced with the
+    // given value (which is the case if the offset is 0).
+    const auto load = [&](size_t ofs, wxUint32 value)
+    {
+        wxCharBuffer corrupted(data);
+        if ( ofs )
+        {
+            value = wxUINT32_SWAP_ON_BE(value);
+            memcpy(corrupted.data() + ofs, &value, sizeof(value));
+        }
+
+        wxFile file(tmp.GetName(), wxFile::write);
+        file.Write(corrupted.data(), len);
+        file.Close();
+
+        CountingLog log;
+        wxLog* const logOld = wxLog::SetActiveTarget(&log);
+
+        std::unique_ptr<wxMsgCatalog>
+            cat(wxMsgCatalog::CreateFromFile(tmp.GetName(), "internat"));
+
+        wxLog::SetActiveTarget(logOld);
+        numLogged = log.m_count;
+
+        return cat;
+    };
+
+    const auto getWord = [&](size_t ofs)
+    {
+        wxUint32 value;
+        memcpy(&value, data.data() + ofs, sizeof(value));
+        return wxUINT32_SWAP_ON_BE(value);
+    };
+
+    // Check that the original catalog is valid.
+    CHECK( load(0, 0) );
+    CHECK( numLogged == 0 );
+
+    // Offset of the last entry in the translated strings table.
+    const wxUint32 numStrings = getWord(8);
+    const size_t ofsLast = getWord(16) + (numStrings - 1)*8;
+    const wxUint32 ofsString = getWord(ofsLast + 4);
+
+    // Translated strings table is outside of the file. Only a single warning
+    // must be given about it.
+    CHECK_FALSE( load(16, len) );
+    CHECK( numLogged == 1 );
+
+    // String is too long.
+    CHECK_FALSE( load(ofsLast, len) );
+
+    // String offset is outside of the file.
+    CHECK_FALSE( load(ofsLast + 4, len) );
+
+    // String is not followed by NUL inside the file.
+    CHECK_FALSE( load(ofsLast, len - ofsString) );
+}
+
 TEST_CASE("wxTranslations::GetBestTranslation", "[translations]")
 {
     wxFileTranslationsLoader::AddCatalogLookupPathPrefix("./intl");
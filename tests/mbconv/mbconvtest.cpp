@@ -1508,3 +1508,67 @@ TEST_CASE("wxMBConv::cMB2WC", "[mbconv][mb2wc]")
     CHECK( wxConvUTF7.cMB2WC(wxCharBuffer()).length() == 0 );
     CHECK( wxConvUTF7.cMB2WC("+AKM-").length() == 1 );
 }
+
+TEST_CASE("wxMBConvUTF8::ASCIIRuns", "[mbconv][utf8]")
+{
+    // Long runs of ASCII characters are converted specially, check that the
+    // results are the same as when converting the string parts separately.
+    const std::string ascii("The quick brown fox jumps over the lazy dog 0123456789");
+    const char* const specials[] =
+    {
+        "\xC3\xA9",             // U+00E9
+        "\xE4\xB8\xAD",         // U+4E2D
+        "\xF0\x9F\x98\x80",     // U+1F600
+        "\xFF",                 // invalid
+        "\\",
+    };
+
+    wxMBConvStrictUTF8 convStrict;
+    wxMBConvUTF8 convPUA(wxMBConvUTF8::MAP_INVALID_UTF8_TO_PUA);
+    wxMBConvUTF8 convOctal(wxMBConvUTF8::MAP_INVALID_UTF8_TO_OCTAL);
+    const wxMBConv* const convs[] = { &convStrict, &convPUA, &convOctal };
+
+    for ( const wxMBConv* conv : convs )
+    {
+        for ( const char* special : specials )
+        {
+            size_t lenSpecial;
+            const wxWCharBuffer
+                wspecial = conv->cMB2WC(special, strlen(special), &lenSpecial);
+
+            for ( size_t pos = 0; pos <= ascii.length(); pos++ )
+            {
+                INFO("Special \"" << special << "\" at " << pos);
+
+                const std::string prefix = ascii.substr(0, pos);
+                const std::string suffix = ascii.substr(pos);
+                const std::string str = prefix + special + suffix;
+
+                size_t len;
+                const wxWCharBuffer
+                    wstr = conv->cMB2WC(str.data(), str.length(), &len);
+                if ( !wspecial.data() )
+                {
+                    CHECK( !wstr.data() );
+                    CHECK( conv->ToWChar(nullptr, 0, str.c_str()) == wxCONV_FAILED );
+                    continue;
+                }
+
+                REQUIRE( wstr.data() );
+
+                const std::wstring expected =
+                    std::wstring(prefix.begin(), prefix.end()) +
+                    std::wstring(wspecial.data(), lenSpecial) +
+                    std::wstring(suffix.begin(), suffix.end());
+                CHECK( std::wstring(wstr.data(), len) == expected );
+
+                CHECK( conv->ToWChar(nullptr, 0, str.c_str()) == len + 1 );
+                CHECK( std::wstring(conv->cMB2WC(str.c_str())) == expected );
+
+                const wxCharBuffer back = conv->cWC2MB(wstr.data(), len, &len);
+                REQUIRE( back.data() );
+                CHECK( std::string(back.data(), len) == str );
+            }
+        }
+    }
+}
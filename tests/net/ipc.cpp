@@ -11,251 +11,695 @@
 #include "testprec.h"
 
 
-// FIXME: this tests currently sometimes hangs in Connect() for unknown reason
-//        and this prevents buildbot builds from working so disabling it, but
-//        the real problem needs to be fixed, of course
-#if 0
+// this test needs threads as it runs the other side of the connection in a
+// secondary thread
+#if wxUSE_IPC && wxUSE_SOCKETS && wxUSE_THREADS
 
-// this test needs threads as it runs the test server in a secondary thread
-#if wxUSE_THREADS
-
-// for all others, include the necessary headers
 #ifndef WX_PRECOMP
     #include "wx/app.h"
 #endif
 
-#include "wx/ipc.h"
+#include "wx/evtloop.h"
+#include "wx/sckipc.h"
+#include "wx/socket.h"
+#include "wx/stopwatch.h"
 #include "wx/thread.h"
 
-#define wxUSE_SOCKETS_FOR_IPC (!wxUSE_DDE_FOR_IPC)
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// constants
+// ----------------------------------------------------------------------------
 
 namespace
 {
 
-const char *IPC_TEST_PORT = "4242";
 const char *IPC_TEST_TOPIC = "IPC TEST";
 
-} // anonymous namespace
+// Port used by wxTCPServer created by the test.
+const char *IPC_TEST_SERVER_PORT = "4242";
+
+// Port used by the server emulated by the test.
+const unsigned short IPC_TEST_RAW_PORT = 4243;
+
+// Message codes used by wxTCPConnection, they must be the same as in
+// src/common/sckipc.cpp.
+enum
+{
+    IPC_EXECUTE         = 1,
+    IPC_REQUEST         = 2,
+    IPC_ADVISE          = 6,
+    IPC_REQUEST_REPLY   = 8,
+    IPC_FAIL            = 9,
+    IPC_CONNECT         = 10,
+    IPC_DISCONNECT      = 11,
+    IPC_REQUEST_ASYNC   = 12,
+    IPC_REQUEST_ASYNC_REPLY = 13,
+    IPC_REQUEST_ASYNC_FAIL  = 14
+};
+
+// Event loop active during the test: this is needed for the sockets to be
+// destroyed only after processing all the pending events for them, as in the
+// real applications, and not immediately, which would result in using them
+// after deleting them when processing these events.
+class TestEventLoop : public wxEventLoop
+{
+public:
+    TestEventLoop() : m_activator(this) { }
+
+    ~TestEventLoop()
+    {
+        // Destroy the sockets scheduled for destruction by the test before
+        // wxSocketBase::Shutdown() is called.
+        wxTheApp->ProcessPendingEvents();
+        wxTheApp->ProcessIdle();
+    }
+
+private:
+    wxEventLoopActivator m_activator;
+};
+
+// Dispatch the events in the main thread until the condition becomes true,
+// return false if it doesn't happen in a reasonable time.
+template <typename F>
+bool DispatchUntil(wxEventLoop& loop, F cond)
+{
+    wxStopWatch sw;
+    while ( !cond() )
+    {
+        if ( sw.Time() > 10000 )
+            return false;
+
+        loop.DispatchTimeout(10);
+        wxTheApp->ProcessPendingEvents();
+    }
+
+    return true;
+}
 
 // ----------------------------------------------------------------------------
-// test connection class used by IPCTestServer
+// helper for speaking the IPC protocol directly over a blocking socket
 // ----------------------------------------------------------------------------
 
-class IPCTestConnection : public wxConnection
+// This allows to control exactly what is sent and when, which is impossible
+// with wxTCPConnection. The messages are composed using the WriteXXX()
+// functions and are only sent by Send(), all together.
+//
+// All errors are reported by throwing std::runtime_error.
+class RawIPCPeer
 {
 public:
-    IPCTestConnection() { }
+    explicit RawIPCPeer(wxSocketBase *sock)
+        : m_sock(sock)
+    {
+        if ( !m_sock || !m_sock->IsOk() )
+            throw std::runtime_error("invalid socket");
 
-    virtual bool OnExec(const wxString& topic, const wxString& data)
+        m_sock->SetTimeout(10);
+    }
+
+    ~RawIPCPeer()
     {
-        if ( topic != IPC_TEST_TOPIC )
-            return false;
+        m_sock->Destroy();
+    }
+
+    void Write8(wxUint8 i)
+    {
+        m_out.push_back(static_cast<char>(i));
+    }
 
-        return data == "Date";
+    void Write32(wxUint32 i)
+    {
+        for ( int n = 0; n < 4; n++, i >>= 8 )
+            Write8(i & 0xff);
+    }
+
+    void WriteString(const wxString& s)
+    {
+        const wxScopedCharBuffer buf = s.utf8_str();
+        Write32(buf.length());
+        m_out.insert(m_out.end(), buf.data(), buf.data() + buf.length());
+    }
+
+    // write NUL-terminated UTF-8 text as request, reply or advise data
+    void WriteData(const wxString& s)
+    {
+        const wxScopedCharBuffer buf = s.utf8_str();
+        Write32(buf.length() + 1);
+        m_out.insert(m_out.end(), buf.data(), buf.data() + buf.length() + 1);
+    }
+
+    void Send()
+    {
+        m_sock->Write(m_out.data(), m_out.size());
+        if ( m_sock->LastWriteCount() != m_out.size() )
+            throw std::runtime_error("failed to write to socket");
+
+        m_out.clear();
+    }
+
+
+    wxUint8 Read8()
+    {
+        wxUint8 i;
+        ReadExactly(&i, 1);
+        return i;
+    }
+
+    wxUint32 Read32()
+    {
+        unsigned char buf[4];
+        ReadExactly(buf, 4);
+        return buf[0] | (buf[1] << 8) | (buf[2] << 16) | (wxUint32(buf[3]) << 24);
+    }
+
+    wxString ReadString()
+    {
+        std::vector<char> buf(Read32());
+        if ( !buf.empty() )
+            ReadExactly(&buf[0], buf.size());
+
+        return wxString::FromUTF8(buf.data(), buf.size());
+    }
+
+    // read the data written by WriteData()
+    wxString ReadData()
+    {
+        std::vector<char> buf(Read32());
+        if ( buf.empty() )
+            throw std::runtime_error("unexpected empty data");
+
+        ReadExactly(&buf[0], buf.size());
+
+        return wxString::FromUTF8(buf.data(), buf.size() - 1);
+    }
+
+    // read the code of the next message and check that it's the expected one
+    void ExpectCode(int code)
+    {
+        const int actual = Read8();
+        if ( actual != code )
+        {
+            throw std::runtime_error(wxString::Format
+                                     (
+                                        "expected message %d, got %d",
+                                        code, actual
+                                     ).ToStdString());
+        }
+    }
+
+    // read a string and check that it's the expected one
+    void ExpectString(const wxString& expected)
+    {
+        const wxString actual = ReadString();
+        if ( actual != expected )
+        {
+            throw std::runtime_error(wxString::Format
+                                     (
+                                        "expected \"%s\", got \"%s\"",
+                                        expected, actual
+                                     ).ToStdString());
+        }
+    }
+
+    // return the number of bytes which can be read without waiting
+    size_t GetAvailable()
+    {
+        char buf[4096];
+
+        const wxSocketFlags flags = m_sock->GetFlags();
+        m_sock->SetFlags(wxSOCKET_NOWAIT);
+        m_sock->Peek(buf, sizeof(buf));
+        m_sock->SetFlags(flags);
+
+        return m_sock->LastCount();
     }
 
 private:
-    wxDECLARE_NO_COPY_CLASS(IPCTestConnection);
+    void ReadExactly(void *buf, size_t size)
+    {
+        m_sock->Read(buf, size);
+        if ( m_sock->LastReadCount() != size )
+            throw std::runtime_error("failed to read from socket");
+    }
+
+    wxSocketBase* const m_sock;
+    std::vector<char> m_out;
+
+    wxDECLARE_NO_COPY_CLASS(RawIPCPeer);
 };
 
 // ----------------------------------------------------------------------------
-// event dispatching thread class
+// thread running the other side of the connection
 // ----------------------------------------------------------------------------
 
-class EventThread : public wxThread
+class PeerThread : public wxThread
 {
 public:
-    EventThread()
-        : wxThread(wxTHREAD_JOINABLE)
+    PeerThread()
+        : wxThread(wxTHREAD_JOINABLE),
+          m_done(false)
     {
-        Create();
-        Run();
     }
 
+    // wait until the thread is ready to accept the connections
+    void WaitUntilReady() { m_ready.Wait(); }
+
+    bool IsDone() const { return m_done; }
+
+    // only valid after the thread terminated
+    const std::string& GetError() const { return m_error; }
+
 protected:
-    virtual void *Entry()
+    virtual void *Entry() override
     {
-        wxTheApp->MainLoop();
+        try
+        {
+            DoRun();
+        }
+        catch ( const std::exception& e )
+        {
+            m_error = e.what();
+        }
+
+        // don't leave the main thread waiting if we failed early
+        if ( !m_readySignalled )
+            SignalReady();
+
+        m_done = true;
 
         return nullptr;
     }
 
-    wxDECLARE_NO_COPY_CLASS(EventThread);
+    void SignalReady()
+    {
+        m_readySignalled = true;
+        m_ready.Post();
+    }
+
+    virtual void DoRun() = 0;
+
+private:
+    wxSemaphore m_ready;
+    bool m_readySignalled = false;
+    std::atomic<bool> m_done;
+    std::string m_error;
 };
 
 // ----------------------------------------------------------------------------
-// test server class
+// classes used for testing the server side
 // ----------------------------------------------------------------------------
 
-class IPCTestServer : public wxServer
+class TestServerConnection : public wxTCPConnection
 {
 public:
-    IPCTestServer()
+    explicit TestServerConnection(bool& disconnected)
+        : m_disconnected(disconnected)
     {
-        m_conn = nullptr;
+    }
 
-#if wxUSE_SOCKETS_FOR_IPC
-        // we must call this from the main thread
-        wxSocketBase::Initialize();
-#endif // wxUSE_SOCKETS_FOR_IPC
+    virtual const void *OnRequest(const wxString& WXUNUSED(topic),
+                                  const wxString& item,
+                                  size_t *size,
+                                  wxIPCFormat WXUNUSED(format)) override
+    {
+        if ( item == "fail" )
+            return nullptr;
 
-        // we need event dispatching to work for IPC server to work
-        m_thread = new EventThread;
+        m_reply = (item + " reply").utf8_str();
+        *size = m_reply.length() + 1;
 
-        Create(IPC_TEST_PORT);
+        return m_reply.data();
     }
 
-    virtual ~IPCTestServer()
+    virtual bool OnExecute(const wxString& WXUNUSED(topic),
+                           const void *data,
+                           size_t size,
+                           wxIPCFormat format) override
     {
-        wxTheApp->ExitMainLoop();
+        m_executed.push_back(GetTextFromData(data, size, format));
 
-        m_thread->Wait();
-        delete m_thread;
+        return true;
+    }
 
-        delete m_conn;
+    virtual bool OnDisconnect() override
+    {
+        m_disconnected = true;
 
-#if wxUSE_SOCKETS_FOR_IPC
-        wxSocketBase::Shutdown();
-#endif // wxUSE_SOCKETS_FOR_IPC
+        return wxTCPConnection::OnDisconnect();
     }
 
-    virtual wxConnectionBase *OnAcceptConnection(const wxString& topic)
+    static std::vector<wxString> m_executed;
+
+private:
+    bool& m_disconnected;
+    wxCharBuffer m_reply;
+};
+
+std::vector<wxString> TestServerConnection::m_executed;
+
+class TestServer : public wxTCPServer
+{
+public:
+    TestServer() : m_disconnected(false) { }
+
+    virtual wxConnectionBase *OnAcceptConnection(const wxString& topic) override
     {
         if ( topic != IPC_TEST_TOPIC )
             return nullptr;
 
-        m_conn = new IPCTestConnection;
-        return m_conn;
+        return new TestServerConnection(m_disconnected);
     }
 
-private:
-    EventThread *m_thread;
-    IPCTestConnection *m_conn;
-
-    wxDECLARE_NO_COPY_CLASS(IPCTestServer);
+    bool m_disconnected;
 };
 
-static IPCTestServer *gs_server = nullptr;
+// Client sending several asynchronous requests in a single write, so that
+// the server has to handle all of them at once.
+class RawClientThread : public PeerThread
+{
+protected:
+    virtual void DoRun() override
+    {
+        SignalReady();
+
+        wxIPV4address addr;
+        addr.Hostname("localhost");
+        addr.Service(IPC_TEST_SERVER_PORT);
+
+        wxSocketClient * const
+            sock = new wxSocketClient(wxSOCKET_BLOCK | wxSOCKET_WAITALL);
+        if ( !sock->Connect(addr) )
+        {
+            sock->Destroy();
+            throw std::runtime_error("failed to connect");
+        }
+
+        RawIPCPeer peer(sock);
+
+        peer.Write8(IPC_CONNECT);
+        peer.WriteString(IPC_TEST_TOPIC);
+        peer.Send();
+        peer.ExpectCode(IPC_CONNECT);
+
+        peer.Write8(IPC_REQUEST_ASYNC);
+        peer.WriteString("one");
+        peer.Write8(wxIPC_UTF8TEXT);
+        peer.Write32(1);
+
+        peer.Write8(IPC_EXECUTE);
+        peer.Write8(wxIPC_UTF8TEXT);
+        peer.WriteData("exec");
+
+        peer.Write8(IPC_REQUEST_ASYNC);
+        peer.WriteString("fail");
+        peer.Write8(wxIPC_UTF8TEXT);
+        peer.Write32(2);
+
+        peer.Write8(IPC_REQUEST_ASYNC);
+        peer.WriteString("two");
+        peer.Write8(wxIPC_UTF8TEXT);
+        peer.Write32(3);
+
+        peer.Send();
+
+        // The replies must use the IDs of the requests and be sent together.
+        peer.ExpectCode(IPC_REQUEST_ASYNC_REPLY);
+        if ( peer.Read32() != 1 || peer.Read8() != wxIPC_UTF8TEXT )
+            throw std::runtime_error("bad first reply");
+        if ( peer.ReadData() != "one reply" )
+            throw std::runtime_error("bad first reply data");
+
+        // IPC_REQUEST_ASYNC_FAIL with the ID and IPC_REQUEST_ASYNC_REPLY with
+        // the ID, format and "two reply" including the trailing NUL.
+        if ( peer.GetAvailable() != (1 + 4) + (1 + 4 + 1 + 4 + 10) )
+            throw std::runtime_error("replies not sent together");
+
+        peer.ExpectCode(IPC_REQUEST_ASYNC_FAIL);
+        if ( peer.Read32() != 2 )
+            throw std::runtime_error("bad failure ID");
+
+        peer.ExpectCode(IPC_REQUEST_ASYNC_REPLY);
+        if ( peer.Read32() != 3 || peer.Read8() != wxIPC_UTF8TEXT )
+            throw std::runtime_error("bad second reply");
+        if ( peer.ReadData() != "two reply" )
+            throw std::runtime_error("bad second reply data");
+
+        peer.Write8(IPC_DISCONNECT);
+        peer.Send();
+    }
+};
 
 // ----------------------------------------------------------------------------
-// test client class
+// classes used for testing the client side
 // ----------------------------------------------------------------------------
 
-class IPCTestClient : public wxClient
+struct RequestReply
+{
+    int id;
+    bool ok;
+    wxString data;
+};
+
+class TestClientConnection : public wxTCPConnection
 {
 public:
-    IPCTestClient()
+    virtual bool OnRequestReply(int requestId,
+                                const void *data,
+                                size_t size,
+                                wxIPCFormat format) override
     {
-        m_conn = nullptr;
+        RequestReply reply;
+        reply.id = requestId;
+        reply.ok = data != nullptr;
+        if ( data )
+            reply.data = GetTextFromData(data, size, format);
+
+        m_replies.push_back(reply);
+
+        return true;
     }
 
-    virtual ~IPCTestClient()
+    virtual bool OnAdvise(const wxString& WXUNUSED(topic),
+                          const wxString& item,
+                          const void *data,
+                          size_t size,
+                          wxIPCFormat format) override
     {
-        Disconnect();
+        m_advised.push_back(item + "=" + GetTextFromData(data, size, format));
+
+        return true;
     }
 
-    bool
-    Connect(const wxString& host, const wxString& service, const wxString& topic)
-    {
-        m_conn = MakeConnection(host, service, topic);
+    std::vector<RequestReply> m_replies;
+    std::vector<wxString> m_advised;
+};
 
-        return m_conn != nullptr;
+class TestClient : public wxTCPClient
+{
+public:
+    virtual wxConnectionBase *OnMakeConnection() override
+    {
+        return new TestClientConnection;
     }
+};
 
-    void Disconnect()
+// Server replying to the requests in the order, and at the time, chosen by
+// the test.
+class RawServerThread : public PeerThread
+{
+protected:
+    virtual void DoRun() override
     {
-        if ( m_conn )
+        wxIPV4address addr;
+        addr.Service(IPC_TEST_RAW_PORT);
+
+        wxSocketServer server(addr, wxSOCKET_BLOCK |
+                                    wxSOCKET_WAITALL |
+                                    wxSOCKET_REUSEADDR);
+        if ( !server.IsOk() )
+            throw std::runtime_error("failed to create server");
+
+        SignalReady();
+
+        RawIPCPeer peer(server.Accept());
+
+        peer.ExpectCode(IPC_CONNECT);
+        peer.ExpectString(IPC_TEST_TOPIC);
+        peer.Write8(IPC_CONNECT);
+        peer.Send();
+
+        // Asynchronous request followed by the synchronous one: send the
+        // reply to the former and an advise before the reply to the latter,
+        // all in a single write.
+        peer.ExpectCode(IPC_REQUEST_ASYNC);
+        peer.ExpectString("async");
+        peer.Read8();
+        const wxUint32 idAsync = peer.Read32();
+
+        peer.ExpectCode(IPC_REQUEST);
+        peer.ExpectString("sync");
+        peer.Read8();
+
+        peer.Write8(IPC_REQUEST_ASYNC_REPLY);
+        peer.Write32(idAsync);
+        peer.Write8(wxIPC_UTF8TEXT);
+        peer.WriteData("async reply");
+
+        peer.Write8(IPC_ADVISE);
+        peer.WriteString("item");
+        peer.Write8(wxIPC_UTF8TEXT);
+        peer.WriteData("advise");
+
+        peer.Write8(IPC_REQUEST_REPLY);
+        peer.WriteData("sync reply");
+
+        peer.Send();
+
+        // Batched requests must arrive together.
+        wxUint32 ids[3];
+        for ( int n = 0; n < 3; n++ )
         {
-            delete m_conn;
-            m_conn = nullptr;
+            peer.ExpectCode(IPC_REQUEST_ASYNC);
+            peer.ExpectString(wxString::Format("b%d", n + 1));
+            peer.Read8();
+            ids[n] = peer.Read32();
+
+            // The code, "bN" with its length, format and ID.
+            if ( n == 0 && peer.GetAvailable() != 2*(1 + 4 + 2 + 1 + 4) )
+                throw std::runtime_error("batched requests not sent together");
         }
-    }
 
-    wxConnectionBase& GetConn() const
-    {
-        CPPUNIT_ASSERT( m_conn );
+        for ( int n = 0; n < 2; n++ )
+        {
+            peer.Write8(IPC_REQUEST_ASYNC_REPLY);
+            peer.Write32(ids[n]);
+            peer.Write8(wxIPC_UTF8TEXT);
+            peer.WriteData(wxString::Format("b%d reply", n + 1));
+        }
 
-        return *m_conn;
-    }
+        peer.Write8(IPC_REQUEST_ASYNC_FAIL);
+        peer.Write32(ids[2]);
 
-private:
-    wxConnectionBase *m_conn;
+        peer.Send();
 
-    wxDECLARE_NO_COPY_CLASS(IPCTestClient);
+        peer.ExpectCode(IPC_DISCONNECT);
+    }
 };
 
-static IPCTestClient *gs_client = nullptr;
+} // anonymous namespace
 
 // ----------------------------------------------------------------------------
-// the test code itself
+// the tests themselves
 // ----------------------------------------------------------------------------
 
-class IPCTestCase : public CppUnit::TestCase
+TEST_CASE("wxTCPServer::Async", "[ipc]")
 {
-public:
-    IPCTestCase() { }
+    wxSocketBase::Initialize();
 
-private:
-    CPPUNIT_TEST_SUITE( IPCTestCase );
-        CPPUNIT_TEST( Connect );
-        CPPUNIT_TEST( Execute );
-        CPPUNIT_TEST( Disconnect );
-    CPPUNIT_TEST_SUITE_END();
+    {
+        TestEventLoop loop;
 
-    void Connect();
-    void Execute();
-    void Disconnect();
+        TestServerConnection::m_executed.clear();
 
-    wxDECLARE_NO_COPY_CLASS(IPCTestCase);
-};
+        TestServer server;
+        REQUIRE( server.Create(IPC_TEST_SERVER_PORT) );
 
-CPPUNIT_TEST_SUITE_REGISTRATION( IPCTestCase );
-CPPUNIT_TEST_SUITE_NAMED_REGISTRATION( IPCTestCase, "IPCTestCase" );
+        RawClientThread thread;
+        REQUIRE( thread.Run() == wxTHREAD_NO_ERROR );
 
-void IPCTestCase::Connect()
-{
-    gs_server = new IPCTestServer;
-    gs_client = new IPCTestClient;
+        CHECK( DispatchUntil(loop, [&]()
+                {
+                    return thread.IsDone() && server.m_disconnected;
+                }) );
 
-    // connecting to the wrong port should fail
-    CPPUNIT_ASSERT( !gs_client->Connect("localhost", "2424", IPC_TEST_TOPIC) );
+        thread.Wait();
+        CHECK( thread.GetError() == "" );
 
-    // connecting using an unsupported topic should fail (unless the server
-    // expects a ROT-13'd topic name...)
-    CPPUNIT_ASSERT( !gs_client->Connect("localhost", IPC_TEST_PORT, "VCP GRFG") );
+        REQUIRE( TestServerConnection::m_executed.size() == 1 );
+        CHECK( TestServerConnection::m_executed[0] == "exec" );
+    }
 
-    // connecting to the right port on the right topic should succeed
-    CPPUNIT_ASSERT( gs_client->Connect("localhost", IPC_TEST_PORT, IPC_TEST_TOPIC) );
+    wxSocketBase::Shutdown();
 }
 
-void IPCTestCase::Execute()
+TEST_CASE("wxTCPClient::Async", "[ipc]")
 {
-    wxConnectionBase& conn = gs_client->GetConn();
+    wxSocketBase::Initialize();
 
-    const wxString s("Date");
-    CPPUNIT_ASSERT( conn.Execute(s) );
-    CPPUNIT_ASSERT( conn.Execute(s.mb_str(), s.length() + 1) );
-
-    char bytes[] = { 1, 2, 3 };
-    CPPUNIT_ASSERT( conn.Execute(bytes, WXSIZEOF(bytes)) );
-}
-
-void IPCTestCase::Disconnect()
-{
-    if ( gs_client )
     {
-        gs_client->Disconnect();
-        delete gs_client;
-        gs_client = nullptr;
+        TestEventLoop loop;
+
+        RawServerThread thread;
+        REQUIRE( thread.Run() == wxTHREAD_NO_ERROR );
+        thread.WaitUntilReady();
+
+        TestClient client;
+        std::unique_ptr<TestClientConnection>
+            conn(static_cast<TestClientConnection*>(
+                    client.MakeConnection("localhost",
+                                          wxString::Format("%u", IPC_TEST_RAW_PORT),
+                                          IPC_TEST_TOPIC)));
+        REQUIRE( conn );
+
+        const int idAsync = conn->RequestAsync("async", wxIPC_UTF8TEXT);
+        CHECK( idAsync > 0 );
+
+        // The reply to the asynchronous request and the advise arrive before
+        // the reply to the synchronous one and must be handled while waiting
+        // for it.
+        size_t size = 0;
+        const void * const
+            data = conn->Request("sync", &size, wxIPC_UTF8TEXT);
+        REQUIRE( data );
+        CHECK( wxConnectionBase::GetTextFromData(data, size, wxIPC_UTF8TEXT)
+                == "sync reply" );
+
+        REQUIRE( conn->m_replies.size() == 1 );
+        CHECK( conn->m_replies[0].id == idAsync );
+        CHECK( conn->m_replies[0].ok );
+        CHECK( conn->m_replies[0].data == "async reply" );
+
+        REQUIRE( conn->m_advised.size() == 1 );
+        CHECK( conn->m_advised[0] == "item=advise" );
+
+        conn->m_replies.clear();
+
+        int ids[3];
+        conn->BeginBatch();
+        for ( int n = 0; n < 3; n++ )
+        {
+            ids[n] = conn->RequestAsync(wxString::Format("b%d", n + 1),
+                                        wxIPC_UTF8TEXT);
+            CHECK( ids[n] > 0 );
+        }
+        CHECK( conn->EndBatch() );
+
+        // All replies are received at once and must be handled together.
+        CHECK( DispatchUntil(loop, [&]()
+                {
+                    return conn->m_replies.size() == 3 || thread.IsDone();
+                }) );
+
+        REQUIRE( conn->m_replies.size() == 3 );
+        CHECK( conn->m_replies[0].id == ids[0] );
+        CHECK( conn->m_replies[0].data == "b1 reply" );
+        CHECK( conn->m_replies[1].id == ids[1] );
+        CHECK( conn->m_replies[1].data == "b2 reply" );
+        CHECK( conn->m_replies[2].id == ids[2] );
+        CHECK( !conn->m_replies[2].ok );
+
+        conn.reset();
+
+        thread.Wait();
+        CHECK( thread.GetError() == "" );
     }
 
-    if ( gs_server )
-    {
-        delete gs_server;
-        gs_server = nullptr;
-    }
+    wxSocketBase::Shutdown();
 }
 
-#endif // wxUSE_THREADS
-
-#endif // !__WINDOWS__
+#endif // wxUSE_IPC && wxUSE_SOCKETS && wxUSE_THREADS
@@ -25,6 +25,8 @@
 #include "wx/url.h"
 #include "wx/sstream.h"
 #include "wx/evtloop.h"
+#include "wx/file.h"
+#include "wx/filename.h"
 
 #include <memory>
 
@@ -358,4 +360,145 @@ TEST_CASE("wxDatagramSocket::ShortPeek", "[socket][dgram]")
     CHECK(recvbuf[1] == sendbuf1[1]);
 }
 
+// Helper creating a pair of blocking TCP sockets connected to each other over
+// the loopback interface.
+class LoopbackSockets
+{
+public:
+    explicit LoopbackSockets(unsigned short port)
+    {
+        wxIPV4address addr;
+        addr.LocalHost();
+        addr.Service(port);
+
+        wxSocketServer server(addr, wxSOCKET_BLOCK | wxSOCKET_REUSEADDR);
+        REQUIRE( server.IsOk() );
+
+        m_client.reset(new wxSocketClient(wxSOCKET_BLOCK | wxSOCKET_WAITALL));
+        m_client->Connect(addr, false);
+
+        m_peer.reset(server.Accept());
+        REQUIRE( m_peer );
+        m_peer->SetFlags(wxSOCKET_BLOCK | wxSOCKET_WAITALL);
+
+        REQUIRE( m_client->WaitOnConnect(10) );
+        REQUIRE( m_client->IsConnected() );
+    }
+
+    wxSocketBase& GetClient() const { return *m_client; }
+    wxSocketBase& GetPeer() const { return *m_peer; }
+
+private:
+    std::unique_ptr<wxSocketClient> m_client;
+    std::unique_ptr<wxSocketBase> m_peer;
+};
+
+TEST_CASE("wxSocket::VectoredIO", "[socket]")
+{
+    LoopbackSockets sockets(19899); // Arbitrary port number
+    wxSocketBase& client = sockets.GetClient();
+    wxSocketBase& peer = sockets.GetPeer();
+
+    char hello[] = "Hello, ";
+    char empty[] = "";
+    char world[] = "world!";
+    const wxSocketIOVec out[] =
+    {
+        { hello, 7 },
+        { empty, 0 },
+        { world, 6 },
+    };
+
+    client.WriteV(out, WXSIZEOF(out));
+    CHECK( !client.Error() );
+    CHECK( client.LastWriteCount() == 13 );
+
+    char buf1[3], buf2[10];
+    const wxSocketIOVec in[] =
+    {
+        { buf1, sizeof(buf1) },
+        { buf2, sizeof(buf2) },
+    };
+
+    peer.ReadV(in, WXSIZEOF(in));
+    CHECK( !peer.Error() );
+    CHECK( peer.LastReadCount() == 13 );
+    CHECK( wxString(buf1, 3) == "Hel" );
+    CHECK( wxString(buf2, 10) == "lo, world!" );
+
+    SECTION("Unread")
+    {
+        client.Write("abcdef", 6);
+
+        peer.Peek(buf1, 2);
+        CHECK( peer.LastCount() == 2 );
+
+        // Push back more data in front of the data already in the buffer.
+        peer.Unread("xyz", 3);
+
+        const wxSocketIOVec in2[] =
+        {
+            { buf1, sizeof(buf1) },
+            { buf2, 6 },
+        };
+
+        peer.ReadV(in2, WXSIZEOF(in2));
+        CHECK( peer.LastReadCount() == 9 );
+        CHECK( wxString(buf1, 3) == "xyz" );
+        CHECK( wxString(buf2, 6) == "abcdef" );
+        CHECK( !peer.IsData() );
+    }
+
+    SECTION("Msg")
+    {
+        client.WriteMsg("message", 7);
+        CHECK( !client.Error() );
+        CHECK( client.LastWriteCount() == 7 );
+
+        char msg[10];
+        peer.ReadMsg(msg, sizeof(msg));
+        CHECK( !peer.Error() );
+        CHECK( peer.LastReadCount() == 7 );
+        CHECK( wxString(msg, 7) == "message" );
+    }
+}
+
+#if wxUSE_FILE
+
+TEST_CASE("wxSocket::WriteFile", "[socket]")
+{
+    LoopbackSockets sockets(19900); // Arbitrary port number
+
+    const wxString filename = wxFileName::CreateTempFileName("wxsocktest");
+    REQUIRE( !filename.empty() );
+
+    std::string data;
+    for ( int n = 0; n < 100000; n++ )
+        data += static_cast<char>(n % 253);
+
+    wxFile file(filename, wxFile::read_write);
+    REQUIRE( file.Write(data.data(), data.size()) == data.size() );
+    REQUIRE( file.Seek(10) == 10 );
+
+    sockets.GetClient().WriteFile(file, 50000);
+    CHECK( !sockets.GetClient().Error() );
+    CHECK( sockets.GetClient().LastWriteCount() == 50000 );
+    CHECK( file.Tell() == 50010 );
+
+    // Check that writing stops at the end of file.
+    sockets.GetClient().WriteFile(file, 100000);
+    CHECK( sockets.GetClient().LastWriteCount() == 49990 );
+    CHECK( file.Eof() );
+
+    std::string received(99990, '\0');
+    sockets.GetPeer().Read(&received[0], received.size());
+    CHECK( sockets.GetPeer().LastReadCount() == 99990 );
+    CHECK( received == data.substr(10) );
+
+    file.Close();
+    wxRemoveFile(filename);
+}
+
+#endif // wxUSE_FILE
+
 #endif // wxUSE_SOCKETS
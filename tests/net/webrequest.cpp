@@ -21,10 +21,14 @@
 
 #include "wx/webrequest.h"
 #include "wx/filename.h"
+#include "wx/socket.h"
+#include "wx/thread.h"
 #include "wx/wfstream.h"
 
+#include <atomic>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 // This test uses httpbin service and by default uses the mirror at the
 // location below, which seems to be more reliable than the main site at
@@ -542,6 +546,429 @@ TEST_CASE_METHOD(RequestFixture,
     }
 }
 
+// ----------------------------------------------------------------------------
+// Tests using a local HTTP server
+// ----------------------------------------------------------------------------
+
+#if wxUSE_SOCKETS && wxUSE_THREADS
+
+namespace
+{
+
+// Minimal HTTP/1.1 server replying to all requests with the same response and
+// keeping the connections alive, which allows to check how many connections
+// are opened by the client.
+class LocalHTTPServer : public wxThread
+{
+public:
+    explicit LocalHTTPServer(const std::string& body = "Hello")
+        : wxThread(wxTHREAD_JOINABLE),
+          m_body(body)
+    {
+        wxIPV4address addr;
+        addr.LocalHost();
+        addr.Service(0); // Use any free port.
+
+        m_server.reset(new wxSocketServer(addr, wxSOCKET_BLOCK));
+        if ( m_server->IsOk() && m_server->GetLocal(addr) )
+            m_port = addr.Service();
+    }
+
+    ~LocalHTTPServer()
+    {
+        m_stop = true;
+
+        if ( IsRunning() )
+            Wait();
+    }
+
+    bool Start()
+    {
+        return m_port && Run() == wxTHREAD_NO_ERROR;
+    }
+
+    wxString GetURL() const
+    {
+        return wxString::Format("http://127.0.0.1:%u/", m_port);
+    }
+
+    const std::string& GetBody() const { return m_body; }
+
+    int GetConnectionCount() const { return m_numConnections; }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        std::vector<std::unique_ptr<wxThread>> connections;
+
+        while ( !m_stop )
+        {
+            if ( !m_server->WaitForAccept(0, 100) )
+                continue;
+
+            wxSocketBase* const peer = m_server->Accept(false);
+            if ( !peer )
+                continue;
+
+            m_numConnections++;
+
+            connections.emplace_back(new ConnectionThread(peer, m_body, m_stop));
+            connections.back()->Run();
+        }
+
+        for ( const auto& thread : connections )
+            thread->Wait();
+
+        return 0;
+    }
+
+private:
+    // Thread serving all requests sent over a single connection.
+    class ConnectionThread : public wxThread
+    {
+    public:
+        ConnectionThread(wxSocketBase* socket,
+                         const std::string& body,
+                         const std::atomic<bool>& stop)
+            : wxThread(wxTHREAD_JOINABLE),
+              m_socket(socket),
+              m_body(body),
+              m_stop(stop)
+        {
+        }
+
+    protected:
+        virtual ExitCode Entry() override
+        {
+            m_socket->SetFlags(wxSOCKET_BLOCK);
+            m_socket->SetTimeout(1);
+
+            std::string response = wxString::Format
+                                   (
+                                    "HTTP/1.1 200 OK\r\n"
+                                    "Content-Type: application/octet-stream\r\n"
+                                    "Content-Length: %zu\r\n"
+                                    "\r\n",
+                                    m_body.length()
+                                   ).utf8_string();
+            response += m_body;
+
+            std::string received;
+            while ( !m_stop )
+            {
+                char data[1024];
+                m_socket->Read(data, sizeof(data));
+                if ( m_socket->Error() )
+                {
+                    if ( m_socket->LastError() == wxSOCKET_TIMEDOUT )
+                        continue;
+
+                    break;
+                }
+
+                const wxUint32 n = m_socket->LastReadCount();
+                if ( !n )
+                    break;
+
+                received.append(data, n);
+
+                // All our requests have no body, so each of them ends with
+                // an empty line.
+                for ( ;; )
+                {
+                    const size_t pos = received.find("\r\n\r\n");
+                    if ( pos == std::string::npos )
+                        break;
+
+                    received.erase(0, pos + 4);
+                    if ( !WriteAll(response) )
+                        return 0;
+                }
+            }
+
+            return 0;
+        }
+
+    private:
+        // Write all data, waiting for the client if it doesn't read it.
+        bool WriteAll(const std::string& data)
+        {
+            const char* p = data.data();
+            size_t remaining = data.length();
+            while ( remaining && !m_stop )
+            {
+                m_socket->Write(p, remaining);
+                if ( m_socket->Error() &&
+                        m_socket->LastError() != wxSOCKET_TIMEDOUT )
+                    return false;
+
+                const wxUint32 n = m_socket->LastWriteCount();
+                p += n;
+                remaining -= n;
+            }
+
+            return remaining == 0;
+        }
+
+        std::unique_ptr<wxSocketBase> m_socket;
+        const std::string& m_body;
+        const std::atomic<bool>& m_stop;
+    };
+
+    const std::string m_body;
+    std::unique_ptr<wxSocketServer> m_server;
+    unsigned short m_port = 0;
+    std::atomic<int> m_numConnections{0};
+    std::atomic<bool> m_stop{false};
+};
+
+// Handler waiting until all the requests started using it complete and
+// checking that their response body is the expected one.
+class LocalRequestsHandler : public wxTimer
+{
+public:
+    explicit LocalRequestsHandler(const std::string& body)
+        : m_body(body)
+    {
+        Bind(wxEVT_WEBREQUEST_STATE, &LocalRequestsHandler::OnState, this);
+    }
+
+    wxWebRequest Start(wxWebSession& session, const wxString& url)
+    {
+        wxWebRequest request = session.CreateRequest(this, url);
+        request.Start();
+
+        Track();
+
+        return request;
+    }
+
+    // Wait for the request started elsewhere to complete too.
+    void Track() { m_numPending++; }
+
+    // Run the event loop until all requests complete.
+    void WaitAll()
+    {
+        if ( m_numPending > 0 )
+        {
+            StartOnce(30000);
+            m_loop.Run();
+            Stop();
+        }
+
+        CHECK( m_numPending == 0 );
+    }
+
+    int GetCompletedCount() const { return m_numCompleted; }
+
+    void Notify() override
+    {
+        WARN("Exiting loop on timeout");
+        m_loop.Exit();
+    }
+
+private:
+    void OnState(wxWebRequestEvent& event)
+    {
+        switch ( event.GetState() )
+        {
+            case wxWebRequest::State_Idle:
+            case wxWebRequest::State_Active:
+                return;
+
+            case wxWebRequest::State_Completed:
+                // The body is not available if it was passed to a consumer.
+                if ( event.GetRequest().GetStorage() != wxWebRequest::Storage_None )
+                    CHECK( event.GetResponse().AsString() == m_body );
+
+                m_numCompleted++;
+                break;
+
+            case wxWebRequest::State_Unauthorized:
+            case wxWebRequest::State_Failed:
+            case wxWebRequest::State_Cancelled:
+                WARN("Request failed: " << event.GetErrorDescription());
+                break;
+        }
+
+        if ( --m_numPending == 0 && m_loop.IsRunning() )
+            m_loop.Exit();
+    }
+
+    const std::string m_body;
+    wxEventLoop m_loop;
+    int m_numPending = 0;
+    int m_numCompleted = 0;
+};
+
+} // anonymous namespace
+
+TEST_CASE("WebRequest::Local", "[webrequest][local]")
+{
+    LocalHTTPServer server;
+    REQUIRE( server.Start() );
+
+    LocalRequestsHandler handler(server.GetBody());
+
+    // Note that the session must be destroyed before the server and the
+    // handler, so it must be declared after them.
+    wxWebSession session = wxWebSession::New();
+    REQUIRE( session.IsOpened() );
+
+    SECTION("Reuse")
+    {
+        if ( !session.SetMaxConnectionsPerHost(1) )
+        {
+            WARN("Limiting connections not supported by this backend.");
+            return;
+        }
+
+        std::vector<wxWebRequest> requests;
+        for ( int n = 0; n < 5; n++ )
+            requests.push_back(handler.Start(session, server.GetURL()));
+
+        handler.WaitAll();
+        CHECK( handler.GetCompletedCount() == 5 );
+        CHECK( server.GetConnectionCount() == 1 );
+
+        for ( const auto& request : requests )
+            CHECK( request.GetResponse().AsString() == server.GetBody() );
+    }
+
+    SECTION("NoReuse")
+    {
+        if ( !session.EnableConnectionReuse(false) )
+        {
+            WARN("Disabling connection reuse not supported by this backend.");
+            return;
+        }
+
+        for ( int n = 0; n < 3; n++ )
+        {
+            wxWebRequest request = handler.Start(session, server.GetURL());
+            handler.WaitAll();
+        }
+
+        CHECK( handler.GetCompletedCount() == 3 );
+        CHECK( server.GetConnectionCount() == 3 );
+    }
+
+    SECTION("Timing")
+    {
+        wxWebRequest request = handler.Start(session, server.GetURL());
+        handler.WaitAll();
+        REQUIRE( handler.GetCompletedCount() == 1 );
+
+        const wxWebResponse response = request.GetResponse();
+        REQUIRE( response.IsOk() );
+
+        const wxLongLong total = response.GetTiming(wxWebResponse::Timing_Total);
+        if ( total == -1 )
+        {
+            WARN("Timings not supported by this backend.");
+            return;
+        }
+
+        const wxLongLong
+            lookup = response.GetTiming(wxWebResponse::Timing_NameLookup),
+            connect = response.GetTiming(wxWebResponse::Timing_Connect),
+            firstByte = response.GetTiming(wxWebResponse::Timing_FirstByte);
+
+        CHECK( lookup >= 0 );
+        CHECK( connect >= lookup );
+        CHECK( firstByte >= connect );
+        CHECK( total >= firstByte );
+
+        // There is no TLS handshake for plain HTTP.
+        CHECK( response.GetTiming(wxWebResponse::Timing_TLSHandshake) == 0 );
+    }
+}
+
+// Consumer checking the data and pausing the transfer after every chunk.
+class PausingConsumer : public wxWebResponseConsumer
+{
+public:
+    explicit PausingConsumer(const std::string& expected)
+        : m_expected(expected)
+    {
+    }
+
+    void SetRequest(const wxWebRequest& request) { m_request = request; }
+
+    virtual bool OnData(const void* data, size_t size) override
+    {
+        // Refuse every other chunk and resume the transfer asynchronously.
+        m_pauseNext = !m_pauseNext;
+        if ( m_pauseNext )
+        {
+            m_numPauses++;
+            m_request.ResumeTransfer();
+            return false;
+        }
+
+        if ( m_offset + size > m_expected.length() ||
+                memcmp(data, m_expected.data() + m_offset, size) != 0 )
+            m_mismatch = true;
+
+        m_offset += size;
+
+        return true;
+    }
+
+    size_t GetOffset() const { return m_offset; }
+    int GetPauseCount() const { return m_numPauses; }
+    bool HasMismatch() const { return m_mismatch; }
+
+private:
+    const std::string& m_expected;
+    wxWebRequest m_request;
+    size_t m_offset = 0;
+    int m_numPauses = 0;
+    bool m_pauseNext = false;
+    bool m_mismatch = false;
+};
+
+TEST_CASE("WebRequest::Consumer", "[webrequest][local]")
+{
+    std::string body(1024*1024, '\0');
+    for ( size_t n = 0; n < body.length(); n++ )
+        body[n] = static_cast<char>(n % 251);
+
+    LocalHTTPServer server(body);
+    REQUIRE( server.Start() );
+
+    LocalRequestsHandler handler(server.GetBody());
+    PausingConsumer consumer(body);
+
+    wxWebSession session = wxWebSession::New();
+    REQUIRE( session.IsOpened() );
+
+    wxWebRequest request = session.CreateRequest(&handler, server.GetURL());
+    if ( !request.SetDataConsumer(&consumer) )
+    {
+        WARN("Data consumers not supported by this backend.");
+        return;
+    }
+
+    CHECK( request.GetStorage() == wxWebRequest::Storage_None );
+
+    consumer.SetRequest(request);
+    request.Start();
+    handler.Track();
+    handler.WaitAll();
+
+    CHECK( handler.GetCompletedCount() == 1 );
+    CHECK( consumer.GetOffset() == body.length() );
+    CHECK( !consumer.HasMismatch() );
+    CHECK( consumer.GetPauseCount() > 0 );
+    CHECK( request.GetBytesReceived() == static_cast<wxFileOffset>(body.length()) );
+
+    // The consumer keeps a reference to the request, break the cycle.
+    consumer.SetRequest(wxWebRequest());
+}
+
+#endif // wxUSE_SOCKETS && wxUSE_THREADS
+
 using wxWebRequestHeaderMap = std::unordered_map<wxString, wxString>;
 
 namespace wxPrivate
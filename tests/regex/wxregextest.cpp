@@ -196,6 +196,110 @@ TEST_CASE("wxRegEx::Unicode", "[regex][unicode]")
     CHECK( re.GetMatch(cyrillicSmallA) == cyrillicSmallA );
 }
 
+TEST_CASE("wxRegEx::JIT", "[regex][jit]")
+{
+    // This works whether JIT is really available or not.
+    wxRegEx re("([[:digit:]]+)-([[:alpha:]]+)", wxRE_JIT);
+    REQUIRE( re.IsValid() );
+
+    const wxString text("id 1234-abc");
+    REQUIRE( re.Matches(text) );
+    CHECK( re.GetMatch(text, 1) == "1234" );
+    CHECK( re.GetMatch(text, 2) == "abc" );
+    CHECK( !re.Matches("no digits here") );
+
+    wxString s("1-a 2-b 3-c");
+    CHECK( re.Replace(&s, "\\2\\1") == 3 );
+    CHECK( s == "a1 b2 c3" );
+}
+
+TEST_CASE("wxRegEx::Cache", "[regex][cache]")
+{
+    // Compiling the same pattern again must work whether it comes from the
+    // cache or not.
+    for ( int n = 0; n < 2; n++ )
+    {
+        wxRegEx re("f(o+)", wxRE_ICASE);
+        REQUIRE( re.IsValid() );
+        CHECK( re.GetMatchCount() == 2 );
+        REQUIRE( re.Matches("FOO") );
+        CHECK( re.GetMatch("FOO", 1) == "OO" );
+    }
+
+    // The flags are part of the cache key.
+    wxRegEx reCase("f(o+)");
+    REQUIRE( reCase.IsValid() );
+    CHECK( !reCase.Matches("FOO") );
+
+    wxRegEx reNoSub("f(o+)", wxRE_ICASE | wxRE_NOSUB);
+    REQUIRE( reNoSub.IsValid() );
+    CHECK( reNoSub.Matches("FOO") );
+
+    // The compiled code is shared, but the matches are not.
+    wxRegEx re1("[0-9]+"), re2("[0-9]+");
+    REQUIRE( re1.Matches("abc 123") );
+    REQUIRE( re2.Matches("4567") );
+    CHECK( re1.GetMatch("abc 123") == "123" );
+    CHECK( re2.GetMatch("4567") == "4567" );
+
+    // Invalid patterns are not cached and still fail.
+    for ( int n = 0; n < 2; n++ )
+    {
+        wxLogNull noLog;
+        CHECK( !wxRegEx("(unclosed").IsValid() );
+    }
+
+    // Disabling the cache doesn't affect the already existing objects.
+    wxRegEx::SetCacheSize(0);
+    wxRegEx reUncached("[0-9]+");
+    CHECK( reUncached.Matches("42") );
+    CHECK( re1.Matches("42") );
+    wxRegEx::SetCacheSize(32);
+}
+
+TEST_CASE("wxRegEx::MatchesBuffer", "[regex][match]")
+{
+    wxRegEx re("b+$");
+    REQUIRE( re.IsValid() );
+
+    // The buffer doesn't need to be null-terminated and matching must stop at
+    // its end.
+    const wxChar* const text = L"abbbcabb";
+    CHECK( re.Matches(text, 0, 4) );
+    CHECK( !re.Matches(text, 0, 5) );
+    CHECK( re.Matches(text + 5, 0, 3) );
+
+    size_t start, len;
+    REQUIRE( re.GetMatch(&start, &len) );
+    CHECK( start == 1 );
+    CHECK( len == 2 );
+}
+
+TEST_CASE("wxRegEx::MatchesView", "[regex][match]")
+{
+    wxRegEx re("b+$");
+    REQUIRE( re.IsValid() );
+
+    // Matching must stop at the end of the view, even if the string goes on.
+    const wxString head = wxString::FromUTF8("\xd0\x96" "bbb");
+    const wxString text = head + "c" + wxString::FromUTF8("\xd0\x96" "bb");
+    const wxStringView view(text);
+    const size_t lenHead = wxStringView(head).length();
+    CHECK( re.Matches(view.substr(0, lenHead)) );
+    CHECK( !re.Matches(view.substr(0, lenHead + 1)) );
+
+    // And the positions must be relative to the start of the view.
+    const wxStringView tail = view.substr(lenHead + 1);
+    REQUIRE( re.Matches(tail) );
+
+    size_t start, len;
+    REQUIRE( re.GetMatch(&start, &len) );
+    CHECK( wxStringView(tail.data() + start, len) == wxStringView(wxS("bb")) );
+    CHECK( start + len == tail.length() );
+
+    CHECK( !re.Matches(wxStringView()) );
+}
+
 // This pseudo test can be used just to see the version of PCRE being used.
 TEST_CASE("wxRegEx::GetLibraryVersionInfo", "[.]")
 {
@@ -353,3 +353,98 @@ TEST_CASE("wxTextInputStream::GetChar", "[text][input][stream][char]")
         CHECK( tis.GetInputStream().Eof() );
     }
 }
+
+TEST_CASE("wxTextInputStream::ReadLine", "[text][input][stream][line]")
+{
+    SECTION("mixed-eol")
+    {
+        const char buf[] = "foo\nbar\r\nbaz\r\rqux";
+        wxMemoryInputStream mis(buf, strlen(buf));
+        wxTextInputStream tis(mis, " \t", wxConvUTF8);
+
+        CHECK( tis.ReadLine() == "foo" );
+        CHECK( tis.ReadLine() == "bar" );
+        CHECK( tis.ReadLine() == "baz" );
+        CHECK( tis.ReadLine() == "" );
+        CHECK_FALSE( mis.Eof() );
+        CHECK( tis.ReadLine() == "qux" );
+        CHECK( mis.Eof() );
+    }
+
+    SECTION("eof")
+    {
+        const char buf[] = "last\n";
+        wxMemoryInputStream mis(buf, strlen(buf));
+        wxTextInputStream tis(mis);
+
+        CHECK( tis.ReadLine() == "last" );
+        CHECK_FALSE( mis.Eof() );
+        CHECK( tis.ReadLine() == "" );
+        CHECK( mis.Eof() );
+    }
+
+    SECTION("long")
+    {
+        const wxString line = wxString('x', 255) +
+                              wxString::FromUTF8("\xd0\x9f\xd1\x80") +
+                              wxString('y', 1000);
+        const std::string buf = (line + "\r\n" + line).utf8_string();
+        wxMemoryInputStream mis(buf.data(), buf.length());
+        wxTextInputStream tis(mis, " \t", wxConvUTF8);
+
+        CHECK( tis.ReadLine() == line );
+        CHECK( tis.ReadLine() == line );
+        CHECK( mis.Eof() );
+    }
+
+    SECTION("with-other-functions")
+    {
+        const char buf[] = "\xef\xbb\xbfword rest of line\r\nX\rnext";
+        wxMemoryInputStream mis(buf, strlen(buf));
+        wxTextInputStream tis(mis);
+
+        CHECK( tis.ReadWord() == "word" );
+        CHECK( tis.ReadLine() == "rest of line" );
+        CHECK( tis.GetChar() == 'X' );
+        CHECK( tis.GetChar() == '\r' );
+        CHECK( tis.ReadLine() == "next" );
+    }
+
+    // Check that we don't read beyond the end of line when we can't put the
+    // data back into the stream.
+    SECTION("non-seekable")
+    {
+        class NonSeekableStream : public wxMemoryInputStream
+        {
+        public:
+            NonSeekableStream(const char* data, size_t len)
+                : wxMemoryInputStream(data, len)
+            {
+            }
+
+            virtual bool IsSeekable() const override { return false; }
+        };
+
+        const char buf[] = "first\r\nsecond\rthird";
+        NonSeekableStream nss(buf, strlen(buf));
+        wxTextInputStream tis(nss, " \t", wxConvUTF8);
+
+        CHECK( tis.ReadLine() == "first" );
+        CHECK( nss.TellI() == 7 );
+        CHECK( tis.ReadLine() == "second" );
+        CHECK( tis.ReadLine() == "third" );
+        CHECK( nss.Eof() );
+    }
+
+    SECTION("UTF-16")
+    {
+        const char buf[] = "\xff\xfe" "a\0\r\0\n\0" "\x0a\x0d" "\n";
+        wxMemoryInputStream mis(buf, sizeof(buf));
+        wxTextInputStream tis(mis);
+
+        CHECK( tis.ReadLine() == "a" );
+        CHECK( tis.ReadLine() == wxString::FromUTF8("\xe0\xb4\x8a") );
+        CHECK( tis.ReadLine() == "" );
+        CHECK( mis.Eof() );
+    }
+}
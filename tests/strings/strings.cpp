@@ -17,6 +17,7 @@
     #include "wx/wx.h"
 #endif // WX_PRECOMP
 
+#include "wx/hashmap.h"
 #include "wx/private/localeset.h"
 
 #include <errno.h>
@@ -365,6 +366,20 @@ TEST_CASE("StringCaseChanges", "[wxString]")
     CHECK( wxString("ABC").Capitalize() == "Abc" );
 
     CHECK( wxString().Capitalize() == "" );
+
+    // Test strings long enough to use the fast path for ASCII.
+    wxString s4("The Quick Brown Fox Jumps Over The Lazy Dog @[`{ 0123456789");
+    CHECK( s4.Lower() == "the quick brown fox jumps over the lazy dog @[`{ 0123456789" );
+    CHECK( s4.Upper() == "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG @[`{ 0123456789" );
+
+    // And also containing non-ASCII characters in different positions, both
+    // inside the first 8 bytes and after them. Notice that these characters
+    // don't have case to avoid depending on the current locale.
+    wxString s5(L"Th\xbf Quick \x20ac Brown Fox Jumps Over \x2026 The Lazy Dog\xbdEnd");
+    CHECK( s5.Lower() == wxString(L"th\xbf quick \x20ac brown fox jumps over \x2026 the lazy dog\xbdend") );
+    CHECK( s5.Upper() == wxString(L"TH\xbf QUICK \x20ac BROWN FOX JUMPS OVER \x2026 THE LAZY DOG\xbdEND") );
+    CHECK( s5.Lower().CmpNoCase(s5.Upper()) == 0 );
+    CHECK( s5.CmpNoCase(wxString(L"Th\xbf Quick \x20ac Brown Fox Jumps Over \x2026 The Lazy Dog\xbdEnE")) < 0 );
 }
 
 TEST_CASE("StringCompare", "[wxString]")
@@ -477,6 +492,58 @@ TEST_CASE("StringCompareNoCase", "[wxString]")
     CHECK( wxString("!").Cmp("Z") < 0 );
 }
 
+TEST_CASE("StringCompareNoCaseLong", "[wxString]")
+{
+    const wxString s("Some/Config/Path/With/Several/Components");
+
+    CHECK( s.CmpNoCase("some/config/path/with/several/components") == 0 );
+    CHECK( s.CmpNoCase("SOME/CONFIG/PATH/WITH/SEVERAL/COMPONENTS") == 0 );
+    CHECK( s.IsSameAs("sOME/cONFIG/pATH/wITH/sEVERAL/cOMPONENTS", false) );
+
+    // Check that the differences are found in any position.
+    for ( size_t n = 0; n < s.length(); n++ )
+    {
+        wxString t = s.Lower();
+        t[n] = '~';
+        INFO( "Position " << n );
+        CHECK( s.CmpNoCase(t) < 0 );
+        CHECK( t.CmpNoCase(s) > 0 );
+        CHECK( !s.IsSameAs(t, false) );
+
+        t = s.Upper().Left(n);
+        CHECK( s.CmpNoCase(t) > 0 );
+        CHECK( t.CmpNoCase(s) < 0 );
+    }
+
+    // Non-ASCII characters are handled using the CRT functions, which don't
+    // support them in the "C" locale, so try to use a UTF-8 one.
+    wxLocaleSetter setLocale("C.UTF-8");
+    if ( wxTolower(wxUniChar(0xc4)) != wxUniChar(0xe4) )
+    {
+        WARN("Skipping non-ASCII tests as C.UTF-8 locale is not available.");
+        return;
+    }
+
+    // Check the strings with non-ASCII characters in different positions.
+    const wxString u = wxString::FromUTF8("\xc3\x84pfel und Birnen \xc3\x9c" "ber \xd0\x96uk");
+    const wxString l = wxString::FromUTF8("\xc3\xa4PFEL UND BIRNEN \xc3\xbc" "BER \xd0\xb6UK");
+    CHECK( u.CmpNoCase(l) == 0 );
+    CHECK( l.CmpNoCase(u) == 0 );
+    CHECK( u.IsSameAs(l, false) );
+    CHECK( wxStringView(u).IsSameAs(l, false) );
+
+    CHECK( u.CmpNoCase(l + "!") < 0 );
+    CHECK( wxString::FromUTF8("\xc3\xa4").CmpNoCase("b") > 0 );
+    CHECK( wxString("b").CmpNoCase(wxString::FromUTF8("\xc3\x84")) < 0 );
+    CHECK( wxString::FromUTF8("abcdefgh\xc3\xa4").CmpNoCase(wxString::FromUTF8("ABCDEFGH\xc3\xa5")) < 0 );
+
+    CHECK( u.Lower() == wxString::FromUTF8("\xc3\xa4pfel und birnen \xc3\xbc" "ber \xd0\xb6uk") );
+    CHECK( l.Upper() == wxString::FromUTF8("\xc3\x84PFEL UND BIRNEN \xc3\x9c" "BER \xd0\x96UK") );
+
+    const wxStringHashNoCase hash;
+    CHECK( hash(u) == hash(l) );
+}
+
 TEST_CASE("StringContains", "[wxString]")
 {
     static const struct ContainsData
@@ -1121,6 +1188,91 @@ TEST_CASE("StringIndexedAccess", "[wxString]")
     CHECK( (char)s[2] == 'r' );
 }
 
+// Check that indexing long strings with both ASCII and non-ASCII characters
+// works in any order, as the UTF-8 implementation uses different strategies
+// for the different access patterns.
+TEST_CASE("StringIndexedAccessLong", "[wxString]")
+{
+    std::wstring ref(1000, L'a');
+    for ( size_t n = 300; n < ref.length(); n += 3 )
+        ref[n] = L'\x430' + n % 32;
+
+    const wxString s(ref);
+    REQUIRE( s.length() == ref.length() );
+
+    // Backwards.
+    for ( size_t n = ref.length(); n > 0; n-- )
+    {
+        if ( s[n - 1] != ref[n - 1] )
+        {
+            FAIL_CHECK("Mismatch at " << n - 1);
+            break;
+        }
+    }
+
+    // Pseudo-randomly.
+    for ( size_t n = 0, pos = 0; n < ref.length(); n++ )
+    {
+        pos = (pos + 337) % ref.length();
+        if ( s[pos] != ref[pos] )
+        {
+            FAIL_CHECK("Mismatch at " << pos);
+            break;
+        }
+    }
+
+    CHECK( s.Mid(250, 100) == wxString(ref.substr(250, 100)) );
+    CHECK( s.Mid(10, 20) == wxString(ref.substr(10, 20)) );
+
+    // Check that modifying the string after accessing it doesn't leave stale
+    // data in the cache.
+    wxString t(ref);
+    CHECK( t[900] == ref[900] );
+    t.insert(100, wxString(L"\x444\x445"));
+    ref.insert(100, L"\x444\x445");
+    CHECK( t[150] == ref[150] );
+    CHECK( t[101] == ref[101] );
+    CHECK( t[902] == ref[902] );
+
+    t.erase(50, 60);
+    ref.erase(50, 60);
+    CHECK( t[60] == ref[60] );
+    CHECK( t[800] == ref[800] );
+
+    // Appending keeps the cached data for the existing part of the string,
+    // check that it's still correct and also works for the new part.
+    t.append(wxString(L"\x446y"));
+    t += L"\x447z";
+    t += wxUniChar(0x448);
+    t.append(70, wxUniChar(0x449));
+    ref += L"\x446y\x447z\x448";
+    ref.append(70, L'\x449');
+    REQUIRE( t.length() == ref.length() );
+    CHECK( t[800] == ref[800] );
+    CHECK( t[60] == ref[60] );
+    CHECK( t[ref.length() - 75] == ref[ref.length() - 75] );
+    CHECK( t[ref.length() - 1] == ref[ref.length() - 1] );
+
+    // Growing the string with resize() must append the given number of
+    // characters, whatever the length of the existing ones in UTF-8.
+    t.resize(ref.length() + 5, 'r');
+    ref.resize(ref.length() + 5, L'r');
+    REQUIRE( t.length() == ref.length() );
+    CHECK( t == wxString(ref) );
+    CHECK( t[ref.length() - 6] == ref[ref.length() - 6] );
+
+    t.assign(wxString(L"\x444") + wxString(200, 'x'));
+    CHECK( t[100] == 'x' );
+    CHECK( t[0] == L'\x444' );
+    CHECK( t.length() == 201 );
+
+    t = wxString(L"abc");
+    CHECK( t[2] == 'c' );
+    t.insert(1, 1, wxUniChar(0x444));
+    CHECK( t[2] == 'b' );
+    CHECK( t[3] == 'c' );
+}
+
 TEST_CASE("StringBeforeAndAfter", "[wxString]")
 {
     // Construct a string with 2 equal signs in it by concatenating its three
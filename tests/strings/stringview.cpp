@@ -0,0 +1,184 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/strings/stringview.cpp
+// Purpose:     wxStringView unit test
+// Author:      wxWidgets team
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+///////////////////////////////////////////////////////////////////////////////
+
+#include "testprec.h"
+
+
+#ifndef WX_PRECOMP
+    #include "wx/wx.h"
+#endif // WX_PRECOMP
+
+#include "wx/tokenzr.h"
+
+TEST_CASE("wxStringView::Basic", "[string][view]")
+{
+    const wxStringView empty;
+    CHECK( empty.empty() );
+    CHECK( empty.length() == 0 );
+    CHECK( empty.ToString().empty() );
+
+    const wxString s("Hello, world");
+    const wxStringView v(s);
+    CHECK( v.data() == s.wx_str() );
+    CHECK( v.length() == s.length() );
+    CHECK( v.ToString() == s );
+    CHECK( wxString(v) == s );
+
+    CHECK( v.substr(7) == wxS("world") );
+    CHECK( v.substr(0, 5) == wxS("Hello") );
+    CHECK( v.substr(7, 100) == wxS("world") );
+    CHECK( v.substr(v.length()).empty() );
+
+    wxStringView w = v;
+    w.remove_prefix(7);
+    w.remove_suffix(2);
+    CHECK( w == wxS("wor") );
+    CHECK( wxS("wor") == w );
+    CHECK( w != v );
+
+    const wxStringView lit(wxS("literal"));
+    CHECK( lit.length() == 7 );
+
+    const std::basic_string<wxStringCharType> std(wxS("std"));
+    CHECK( wxStringView(std).data() == std.data() );
+}
+
+TEST_CASE("wxStringView::Compare", "[string][view]")
+{
+    const wxStringView abc(wxS("abc")),
+                       abd(wxS("abd")),
+                       ab(wxS("ab")),
+                       ABC(wxS("ABC"));
+
+    CHECK( abc.compare(abc) == 0 );
+    CHECK( abc.compare(abd) < 0 );
+    CHECK( abd.compare(abc) > 0 );
+    CHECK( ab.compare(abc) < 0 );
+    CHECK( abc.compare(ab) > 0 );
+
+    CHECK( ab < abc );
+    CHECK( abd > abc );
+    CHECK( abc <= abc );
+    CHECK( abc >= abc );
+
+    CHECK_FALSE( abc.IsSameAs(ABC) );
+    CHECK( abc.IsSameAs(ABC, false) );
+    CHECK_FALSE( ab.IsSameAs(ABC, false) );
+    CHECK_FALSE( abd.IsSameAs(ABC, false) );
+
+    CHECK( abc.StartsWith(ab) );
+    CHECK_FALSE( ab.StartsWith(abc) );
+    CHECK( abc.EndsWith(wxStringView(wxS("bc"))) );
+    CHECK_FALSE( abc.EndsWith(ab) );
+}
+
+TEST_CASE("wxStringView::Find", "[string][view]")
+{
+    const wxStringView v(wxS("key = value ; comment"));
+
+    CHECK( v.find(wxS('=')) == 4 );
+    CHECK( v.find(wxS('='), 5) == wxStringView::npos );
+    CHECK( v.find(wxS('#')) == wxStringView::npos );
+    CHECK( v.rfind(wxS('e')) == 18 );
+    CHECK( v.rfind(wxS('e'), 17) == 10 );
+    CHECK( v.rfind(wxS('k'), 0) == 0 );
+
+    CHECK( v.find(wxStringView(wxS("value"))) == 6 );
+    CHECK( v.find(wxStringView(wxS("val")), 7) == wxStringView::npos );
+    CHECK( v.find(wxStringView(wxS("comment"))) == 14 );
+    CHECK( v.find(wxStringView(wxS("comments"))) == wxStringView::npos );
+    CHECK( v.find(wxStringView()) == 0 );
+    CHECK( v.find(wxStringView(), 3) == 3 );
+
+    CHECK( v.find_first_of(wxStringView(wxS("=;"))) == 4 );
+    CHECK( v.find_first_not_of(wxStringView(wxS("key "))) == 4 );
+    CHECK( v.find_first_of(wxStringView(wxS("#"))) == wxStringView::npos );
+}
+
+TEST_CASE("wxStringView::ToNumber", "[string][view]")
+{
+    const wxString s("123,-45,0x1f,2.5,abc");
+    wxStringView v(s);
+
+    long l;
+    CHECK( v.substr(0, 3).ToLong(&l) );
+    CHECK( l == 123 );
+    CHECK( v.substr(4, 3).ToLong(&l) );
+    CHECK( l == -45 );
+    CHECK_FALSE( v.substr(0, 4).ToLong(&l) );
+
+    unsigned long ul;
+    CHECK( v.substr(8, 4).ToULong(&ul, 16) );
+    CHECK( ul == 0x1f );
+
+    double d;
+    CHECK( v.substr(13, 3).ToDouble(&d) );
+    CHECK( d == 2.5 );
+    CHECK_FALSE( v.substr(17).ToDouble(&d) );
+
+    // Long strings are handled too.
+    const wxString longNum = wxString(wxS('0'), 100) + wxS("42");
+    CHECK( wxStringView(longNum).ToLong(&l) );
+    CHECK( l == 42 );
+}
+
+TEST_CASE("wxString::ViewOverloads", "[string][view]")
+{
+    wxString s("prefix-body-suffix");
+
+    wxStringView rest;
+    CHECK( s.StartsWith(wxStringView(wxS("prefix-")), &rest) );
+    CHECK( rest == wxS("body-suffix") );
+    CHECK( rest.data() == s.wx_str() + 7 );
+    CHECK_FALSE( s.StartsWith(wxStringView(wxS("body")), &rest) );
+
+    CHECK( s.EndsWith(wxStringView(wxS("-suffix")), &rest) );
+    CHECK( rest == wxS("prefix-body") );
+
+    CHECK( s.Find(wxStringView(wxS("body"))) == 7 );
+    CHECK( s.Find(wxStringView(wxS("none"))) == wxNOT_FOUND );
+
+    CHECK( s.IsSameAs(wxStringView(wxS("PREFIX-BODY-SUFFIX")), false) );
+
+    CHECK( s.GetView(s.begin() + 7, s.begin() + 11) == wxS("body") );
+
+    s += wxStringView(wxS("!?")).substr(0, 1);
+    CHECK( s == "prefix-body-suffix!" );
+
+    // Check that the overloads taking both wxString and wxStringView are not
+    // ambiguous.
+    CHECK( s.StartsWith("prefix") );
+    CHECK( s.IsSameAs(wxString("prefix-body-suffix!")) );
+    CHECK( s.Find("body") == 7 );
+}
+
+TEST_CASE("wxStringTokenizer::GetNextTokenView", "[string][view][tokenizer]")
+{
+    const wxString s("a,,b,");
+
+    wxStringTokenizer tk(s, ",", wxTOKEN_RET_EMPTY_ALL);
+    REQUIRE( tk.HasMoreTokens() );
+    CHECK( tk.GetNextTokenView() == wxS("a") );
+    CHECK( tk.GetNextTokenView().empty() );
+    CHECK( tk.GetLastDelimiter() == ',' );
+    CHECK( tk.GetNextTokenView() == wxS("b") );
+    CHECK( tk.GetNextTokenView().empty() );
+    CHECK( tk.GetLastDelimiter() == '\0' );
+    CHECK_FALSE( tk.HasMoreTokens() );
+
+    wxStringTokenizer tk2("  one two  ", " ");
+    CHECK( tk2.GetNextTokenView() == wxS("one") );
+    CHECK( tk2.GetNextTokenView() == wxS("two") );
+    CHECK_FALSE( tk2.HasMoreTokens() );
+    CHECK( tk2.GetNextTokenView().empty() );
+
+    wxStringTokenizer tk3(wxString::FromUTF8("\xd0\xb0\xd0\xb1:\xd0\xb2"), ":",
+                          wxTOKEN_RET_DELIMS);
+    CHECK( tk3.GetNextTokenView().ToString() == wxString::FromUTF8("\xd0\xb0\xd0\xb1:") );
+    CHECK( tk3.GetNextTokenView().ToString() == wxString::FromUTF8("\xd0\xb2") );
+}
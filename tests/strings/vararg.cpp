@@ -190,6 +190,38 @@ TEST_CASE("RepeatedPrintf", "[wxString][Printf][vararg]")
     CHECK( s == "buffer hi, len 2" );
 }
 
+// The information about the recently used format strings is cached, check
+// that the cache doesn't return stale data.
+TEST_CASE("FormatCache", "[wxString][Format][vararg]")
+{
+    // Reusing the same buffer for different formats must work.
+    char buf[32];
+    strcpy(buf, "%d items");
+    CHECK( wxString::Format(buf, 3) == "3 items" );
+    strcpy(buf, "%s items");
+    CHECK( wxString::Format(buf, "no") == "no items" );
+    strcpy(buf, "%s=%d");
+    CHECK( wxString::Format(buf, "x", 5) == "x=5" );
+    CHECK( wxString::Format(buf, "y", 6) == "y=6" );
+
+    wchar_t wbuf[32];
+    wxStrcpy(wbuf, L"%d items");
+    CHECK( wxString::Format(wbuf, 3) == "3 items" );
+    wxStrcpy(wbuf, L"%s items");
+    CHECK( wxString::Format(wbuf, "no") == "no items" );
+
+    // Non-ASCII format strings must be handled correctly when they're
+    // converted and when the cached conversion is used.
+    const wxString fmt = wxString::FromUTF8("\xc3\xa9t\xc3\xa9 %d");
+    const wxString expected = wxString::FromUTF8("\xc3\xa9t\xc3\xa9 2017");
+    CHECK( wxString::Format(fmt, 2017) == expected );
+    CHECK( wxString::Format(fmt, 2017) == expected );
+
+    const wchar_t* const wfmt = L"\x444\x43e\x440\x43c\x430\x442 %s";
+    CHECK( wxString::Format(wfmt, "x") == wxString(L"\x444\x43e\x440\x43c\x430\x442 x") );
+    CHECK( wxString::Format(wfmt, "y") == wxString(L"\x444\x43e\x440\x43c\x430\x442 y") );
+}
+
 TEST_CASE("ArgsValidation", "[wxString][vararg][error]")
 {
     int written;
@@ -21,6 +21,8 @@
 #include "wx/ffile.h"
 #include "wx/textfile.h"
 
+#include "testfile.h"
+
 #ifdef __VISUALC__
     #define unlink _unlink
 #endif
@@ -327,6 +329,204 @@ void TextFileTestCase::ReadBig()
                           f[NUM_LINES - 1] );
 }
 
+TEST_CASE("wxTextFileReader", "[textfile][reader]")
+{
+    TempFile tf("textfilereader.txt");
+
+    // Helper writing the given data to the file and reopening it for reading.
+    wxFile file;
+    auto createFile = [&](const std::string& data)
+    {
+        REQUIRE( file.Create(tf.GetName(), true) );
+        REQUIRE( file.Write(data.data(), data.size()) == data.size() );
+        file.Close();
+        REQUIRE( file.Open(tf.GetName()) );
+    };
+
+    wxStringView line;
+    wxTextFileType type;
+
+    SECTION("Mixed")
+    {
+        createFile("foo\r\nbar\nbaz\r\rqux");
+
+        wxTextFileReader reader(file);
+        REQUIRE( reader.GetNextLine(&line, &type) );
+        CHECK( line == wxS("foo") );
+        CHECK( type == wxTextFileType_Dos );
+        REQUIRE( reader.GetNextLine(&line, &type) );
+        CHECK( line == wxS("bar") );
+        CHECK( type == wxTextFileType_Unix );
+        REQUIRE( reader.GetNextLine(&line, &type) );
+        CHECK( line == wxS("baz") );
+        CHECK( type == wxTextFileType_Mac );
+        REQUIRE( reader.GetNextLine(&line, &type) );
+        CHECK( line.empty() );
+        CHECK( type == wxTextFileType_Mac );
+        REQUIRE( reader.GetNextLine(&line, &type) );
+        CHECK( line == wxS("qux") );
+        CHECK( type == wxTextFileType_None );
+        CHECK_FALSE( reader.GetNextLine(&line) );
+        CHECK_FALSE( reader.Error() );
+    }
+
+    SECTION("Empty")
+    {
+        createFile("");
+
+        wxTextFileReader reader(file);
+        CHECK_FALSE( reader.GetNextLine(&line) );
+        CHECK_FALSE( reader.Error() );
+    }
+
+    SECTION("BOM")
+    {
+        createFile("\xef\xbb\xbf");
+
+        wxTextFileReader reader(file);
+        CHECK_FALSE( reader.GetNextLine(&line) );
+        CHECK_FALSE( reader.Error() );
+    }
+
+    // Check that CR LF is recognized even if it's split between the chunks
+    // in which the file is read and that the lines longer than a chunk work.
+    SECTION("Long")
+    {
+        const size_t len = 65535;
+        createFile(std::string(len, 'x') + "\r\n" +
+                   std::string(len, 'y') + "\xd0\x9f\n" +
+                   "z");
+
+        wxTextFileReader reader(file, wxConvUTF8);
+        REQUIRE( reader.GetNextLine(&line, &type) );
+        CHECK( line.length() == len );
+        CHECK( type == wxTextFileType_Dos );
+        REQUIRE( reader.GetNextLine(&line, &type) );
+        CHECK( line.ToString() == wxString('y', len) + wxString::FromUTF8("\xd0\x9f") );
+        CHECK( type == wxTextFileType_Unix );
+        REQUIRE( reader.GetNextLine(&line, &type) );
+        CHECK( line == wxS("z") );
+        CHECK_FALSE( reader.GetNextLine(&line) );
+    }
+
+    SECTION("UTF-16")
+    {
+        createFile(std::string("\xff\xfe" "\x1f\x04\x0d\x00\x0a\x00"
+                               "\x0a\x0d" "\x0d\x00", 12));
+
+        wxTextFileReader reader(file);
+        REQUIRE( reader.GetNextLine(&line, &type) );
+        CHECK( line.ToString() == wxString::FromUTF8("\xd0\x9f") );
+        CHECK( type == wxTextFileType_Dos );
+        REQUIRE( reader.GetNextLine(&line, &type) );
+        CHECK( line.ToString() == wxString::FromUTF8("\xe0\xb4\x8a") );
+        CHECK( type == wxTextFileType_Mac );
+        CHECK_FALSE( reader.GetNextLine(&line) );
+        CHECK_FALSE( reader.Error() );
+    }
+
+    // Check that switching to the fallback encoding after the first chunk is
+    // detected and that the file can be read again using it from the start.
+    SECTION("Fallback")
+    {
+        const wxFontEncoding encOld = wxConvAuto::GetFallbackEncoding();
+        wxConvAuto::SetFallbackEncoding(wxFONTENCODING_ISO8859_1);
+
+        const size_t len = 70000;
+        createFile("\xc3\xa9\n" + std::string(len, 'x') + "\n\xe9");
+
+        wxTextFileReader reader(file);
+        REQUIRE( reader.GetNextLine(&line) );
+        CHECK( line.ToString() == wxString::FromUTF8("\xc3\xa9") );
+        REQUIRE( reader.GetNextLine(&line) );
+        CHECK( line.length() == len );
+        CHECK_FALSE( reader.EncodingChanged() );
+        REQUIRE( reader.GetNextLine(&line) );
+        CHECK( line.ToString() == wxString::FromUTF8("\xc3\xa9") );
+        CHECK( reader.EncodingChanged() );
+
+        REQUIRE( reader.Rewind() );
+        CHECK_FALSE( reader.EncodingChanged() );
+        REQUIRE( reader.GetNextLine(&line) );
+        CHECK( line.ToString() == wxString::FromUTF8("\xc3\x83\xc2\xa9") );
+        REQUIRE( reader.GetNextLine(&line) );
+        CHECK( line.length() == len );
+        REQUIRE( reader.GetNextLine(&line) );
+        CHECK( line.ToString() == wxString::FromUTF8("\xc3\xa9") );
+        CHECK_FALSE( reader.GetNextLine(&line) );
+        CHECK_FALSE( reader.EncodingChanged() );
+        CHECK_FALSE( reader.Error() );
+
+        // wxTextFile does it automatically, using the same encoding for the
+        // entire file.
+        file.Close();
+        wxTextFile textFile;
+        REQUIRE( textFile.Open(tf.GetName()) );
+        REQUIRE( textFile.GetLineCount() == 3 );
+        CHECK( textFile[0] == wxString::FromUTF8("\xc3\x83\xc2\xa9") );
+        CHECK( textFile[1].length() == len );
+        CHECK( textFile[2] == wxString::FromUTF8("\xc3\xa9") );
+
+        wxConvAuto::SetFallbackEncoding(encOld);
+    }
+
+    // Switching to the fallback encoding after only ASCII text is harmless.
+    SECTION("FallbackASCII")
+    {
+        const wxFontEncoding encOld = wxConvAuto::GetFallbackEncoding();
+        wxConvAuto::SetFallbackEncoding(wxFONTENCODING_ISO8859_1);
+
+        createFile(std::string(70000, 'x') + "\n\xe9");
+
+        wxTextFileReader reader(file);
+        REQUIRE( reader.GetNextLine(&line) );
+        REQUIRE( reader.GetNextLine(&line) );
+        CHECK( line.ToString() == wxString::FromUTF8("\xc3\xa9") );
+        CHECK_FALSE( reader.EncodingChanged() );
+        CHECK_FALSE( reader.GetNextLine(&line) );
+        CHECK_FALSE( reader.Error() );
+
+        wxConvAuto::SetFallbackEncoding(encOld);
+    }
+
+    // But valid UTF-8 split between the chunks is still detected as such.
+    SECTION("UTF-8")
+    {
+        createFile(std::string(65535, 'x') + "\xc3\xa9\n\xc3\xa9");
+
+        wxTextFileReader reader(file);
+        REQUIRE( reader.GetNextLine(&line) );
+        CHECK( line.ToString() == wxString('x', 65535) + wxString::FromUTF8("\xc3\xa9") );
+        REQUIRE( reader.GetNextLine(&line) );
+        CHECK( line.ToString() == wxString::FromUTF8("\xc3\xa9") );
+        CHECK_FALSE( reader.GetNextLine(&line) );
+        CHECK_FALSE( reader.Error() );
+    }
+
+    SECTION("Many")
+    {
+        static const unsigned NUM_LINES = 100000;
+
+        std::string data;
+        for ( unsigned n = 0; n < NUM_LINES; n++ )
+            data += "Line " + std::to_string(n) + "\n";
+        createFile(data);
+
+        wxTextFileReader reader(file);
+        unsigned n = 0;
+        while ( reader.GetNextLine(&line) )
+        {
+            const wxString expected = wxString::Format("Line %u", n);
+            if ( line != wxStringView(expected) )
+                FAIL_CHECK( "Unexpected line " << n << ": " << line.ToString() );
+            n++;
+        }
+
+        CHECK( n == NUM_LINES );
+        CHECK_FALSE( reader.Error() );
+    }
+}
+
 #ifdef __LINUX__
 
 // Check if using wxTextFile with special files, whose reported size doesn't
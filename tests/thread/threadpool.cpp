@@ -0,0 +1,242 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/thread/threadpool.cpp
+// Purpose:     Unit tests for wxThreadPool and related classes
+// Author:      wxWidgets team
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+#include "wx/threadpool.h"
+
+#include "wx/evtloop.h"
+#include "wx/thread.h"
+#include "wx/time.h"
+
+#include <stdexcept>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// helpers
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Recursively compute the sum of the numbers in [from, to) by splitting the
+// range in two halves and computing them in parallel, to exercise nested task
+// creation and stealing.
+long SumRange(wxTaskGroup& group, long from, long to)
+{
+    if ( to - from <= 100 )
+    {
+        long sum = 0;
+        for ( long n = from; n < to; n++ )
+            sum += n;
+        return sum;
+    }
+
+    const long mid = from + (to - from) / 2;
+
+    wxFuture<long> left = group.Run([&group, from, mid]()
+        {
+            return SumRange(group, from, mid);
+        });
+
+    const long right = SumRange(group, mid, to);
+
+    return left.Get() + right;
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// tests themselves
+// ----------------------------------------------------------------------------
+
+TEST_CASE("wxThreadPool::Submit", "[thread][threadpool]")
+{
+    wxThreadPool pool(4);
+    REQUIRE( pool.GetThreadCount() == 4 );
+    CHECK( !pool.IsWorkerThread() );
+
+    std::vector<wxFuture<int>> futures;
+    for ( int n = 0; n < 100; n++ )
+        futures.push_back(pool.Submit([n]() { return n*n; }));
+
+    for ( int n = 0; n < 100; n++ )
+        CHECK( futures[n].Get() == n*n );
+
+    CHECK( futures[0].GetStatus() == wxTASK_DONE );
+
+    wxFuture<bool> isWorker = pool.Submit([&pool]()
+        {
+            return pool.IsWorkerThread();
+        });
+    CHECK( isWorker.Get() );
+
+    // Check that tasks returning nothing work too.
+    bool executed = false;
+    wxFuture<void> task = pool.Submit([&executed]() { executed = true; });
+    CHECK( task.Wait() );
+    CHECK( executed );
+}
+
+TEST_CASE("wxThreadPool::Cancel", "[thread][threadpool]")
+{
+    wxThreadPool pool(1);
+
+    // Block the only worker to ensure that the next task stays in the queue.
+    std::atomic<bool> release{false};
+    wxFuture<void> blocker = pool.Submit([&release]()
+        {
+            while ( !release )
+                wxMilliSleep(1);
+        });
+
+    bool executed = false;
+    wxFuture<void> task = pool.Submit([&executed]() { executed = true; });
+
+    CHECK( task.Cancel() );
+    CHECK( task.GetStatus() == wxTASK_CANCELLED );
+    CHECK( !task.Wait() );
+
+    release = true;
+    CHECK( blocker.Wait() );
+
+    // It's too late to cancel the task which already finished.
+    CHECK( !blocker.Cancel() );
+    CHECK( blocker.GetStatus() == wxTASK_DONE );
+
+    // Tasks are executed in order for a single worker, so if the cancelled
+    // task were going to run, it would have already done it by now.
+    pool.Submit([]() { }).Wait();
+    CHECK( !executed );
+}
+
+#if wxUSE_EXCEPTIONS
+
+TEST_CASE("wxThreadPool::Exception", "[thread][threadpool]")
+{
+    wxThreadPool pool(2);
+
+    wxFuture<int> task = pool.Submit([]() -> int
+        {
+            throw std::runtime_error("task failed");
+        });
+
+    CHECK( task.Wait() );
+    CHECK( task.GetStatus() == wxTASK_DONE );
+    CHECK_THROWS_AS( task.Get(), std::runtime_error );
+
+    // The worker must have survived the exception.
+    CHECK( pool.Submit([]() { return 17; }).Get() == 17 );
+
+    // And the group containing the failed task must finish too.
+    wxTaskGroup group(pool);
+    std::atomic<int> numExecuted{0};
+    for ( int n = 0; n < 10; n++ )
+    {
+        group.Run([&numExecuted, n]()
+            {
+                numExecuted++;
+                if ( n % 2 )
+                    throw std::runtime_error("odd task failed");
+            });
+    }
+
+    group.Wait();
+    CHECK( numExecuted == 10 );
+}
+
+#endif // wxUSE_EXCEPTIONS
+
+TEST_CASE("wxTaskGroup", "[thread][threadpool]")
+{
+    wxThreadPool pool(4);
+
+    SECTION("Sum")
+    {
+        wxTaskGroup group(pool);
+
+        wxFuture<long> sum = group.Run([&group]()
+            {
+                return SumRange(group, 0, 100000);
+            });
+
+        group.Wait();
+        CHECK( sum.IsFinished() );
+        CHECK( sum.Get() == 100000L * 99999 / 2 );
+    }
+
+    SECTION("Cancel")
+    {
+        std::atomic<int> numExecuted{0};
+
+        wxTaskGroup group(pool);
+        group.Cancel();
+        CHECK( group.IsCancelled() );
+
+        for ( int n = 0; n < 10; n++ )
+            group.Run([&numExecuted]() { numExecuted++; });
+
+        group.Wait();
+        CHECK( numExecuted == 0 );
+    }
+}
+
+TEST_CASE("wxThreadPool::Notify", "[thread][threadpool]")
+{
+    class CompletionHandler : public wxEvtHandler
+    {
+    public:
+        CompletionHandler()
+        {
+            Bind(wxEVT_TASK_COMPLETED, &CompletionHandler::OnCompleted, this);
+        }
+
+        std::vector<int> m_ids;
+        std::vector<int> m_statuses;
+
+    private:
+        void OnCompleted(wxThreadEvent& event)
+        {
+            m_ids.push_back(event.GetId());
+            m_statuses.push_back(event.GetInt());
+        }
+    };
+
+    CompletionHandler handler;
+
+    wxThreadPool pool(2);
+
+    wxFuture<int> task = pool.Submit([]() { return 17; });
+    task.NotifyOnCompletion(&handler, 1);
+
+    // Set the handler after the task completion: the event must still be sent.
+    wxFuture<int> done = pool.Submit([]() { return 42; });
+    CHECK( done.Get() == 42 );
+    done.NotifyOnCompletion(&handler, 2);
+
+    wxEventLoop loop;
+
+    const wxMilliClock_t end = wxGetLocalTimeMillis() + 10000;
+    while ( handler.m_ids.size() < 2 && wxGetLocalTimeMillis() < end )
+    {
+        loop.DispatchTimeout(10);
+        wxTheApp->ProcessPendingEvents();
+    }
+
+    REQUIRE( handler.m_ids.size() == 2 );
+    CHECK( handler.m_ids[0] + handler.m_ids[1] == 3 );
+    CHECK( handler.m_statuses[0] == wxTASK_DONE );
+    CHECK( handler.m_statuses[1] == wxTASK_DONE );
+
+    CHECK( task.Get() == 17 );
+}